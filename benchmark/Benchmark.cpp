@@ -0,0 +1,23 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+
+volatile uint64_t S2Benchmark::gSink = 0;
+
+void S2Benchmark::State::addResult(std::string label, size_t iterations, std::vector<double>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    mResults.push_back(Result{std::move(label), iterations, samples.front(), samples[samples.size() / 2], {}});
+}
+
+std::vector<S2Benchmark::RegisteredBenchmark>& S2Benchmark::registeredBenchmarks()
+{
+    static std::vector<RegisteredBenchmark> benchmarks;
+    return benchmarks;
+}
+
+bool S2Benchmark::registerBenchmark(const char* name, BenchmarkFunction function)
+{
+    registeredBenchmarks().push_back(RegisteredBenchmark{name, function});
+    return true;
+}
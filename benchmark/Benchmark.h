@@ -0,0 +1,101 @@
+#pragma once
+
+#include "MemorySource/SyntheticMemorySource.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace S2Benchmark
+{
+    class State;
+    using BenchmarkFunction = void (*)(State&);
+
+    struct Result
+    {
+        std::string label;
+        size_t iterations;
+        // time per iteration in nanoseconds, or the reported value when unit is not empty
+        double min;
+        double median;
+        std::string unit;
+    };
+
+    // passed to every benchmark, collects the results
+    class State
+    {
+      public:
+        explicit State(size_t runs) : mRuns(runs){};
+
+        // runs `function` `iterations` times, repeated `runs` times, reports time per iteration
+        template <typename Function>
+        void measure(std::string label, size_t iterations, Function&& function)
+        {
+            std::vector<double> samples;
+            samples.reserve(mRuns);
+            for (size_t run = 0; run < mRuns; ++run)
+            {
+                auto start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < iterations; ++i)
+                    function();
+
+                std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+                samples.push_back(elapsed.count() / static_cast<double>(iterations));
+            }
+            addResult(std::move(label), iterations, samples);
+        }
+        // for values that are not time, like counters or ratios
+        void report(std::string label, double value, std::string unit)
+        {
+            mResults.push_back(Result{std::move(label), 0, value, value, std::move(unit)});
+        }
+        const std::vector<Result>& results() const
+        {
+            return mResults;
+        }
+
+      private:
+        void addResult(std::string label, size_t iterations, std::vector<double>& samples);
+
+        size_t mRuns;
+        std::vector<Result> mResults;
+    };
+
+    extern volatile uint64_t gSink;
+    // keeps the compiler from optimizing away the computed value
+    template <typename T>
+    void doNotOptimize(const T& value)
+    {
+        gSink = gSink + static_cast<uint64_t>(reinterpret_cast<const volatile char&>(value));
+    }
+
+    // synthetic memory that counts the reads reaching the "debugger", to show what the caches save
+    class CountingMemorySource : public S2Plugin::SyntheticMemorySource
+    {
+      public:
+        bool read(uintptr_t addr, void* dest, size_t size) override
+        {
+            ++mReads;
+            mBytes += size;
+            return SyntheticMemorySource::read(addr, dest, size);
+        }
+        uint64_t mReads{0};
+        uint64_t mBytes{0};
+    };
+
+    // used by the S2_BENCHMARK macro
+    bool registerBenchmark(const char* name, BenchmarkFunction function);
+
+    struct RegisteredBenchmark
+    {
+        const char* name;
+        BenchmarkFunction function;
+    };
+    std::vector<RegisteredBenchmark>& registeredBenchmarks();
+} // namespace S2Benchmark
+
+#define S2_BENCHMARK(name)                                                                         \
+    static void name(S2Benchmark::State& state);                                                   \
+    [[maybe_unused]] static bool name##Registered = S2Benchmark::registerBenchmark(#name, name); \
+    static void name(S2Benchmark::State& state)
@@ -0,0 +1,88 @@
+#include "Benchmark.h"
+
+#include "Configuration.h"
+#include "Data/Entity.h"
+#include "resource_helpers.h"
+#include <filesystem>
+#include <regex>
+
+using namespace S2Plugin;
+
+S2_BENCHMARK(ConfigurationLoad)
+{
+    auto cacheFile = cacheDirectory() / "Spelunky2.cache";
+    // cold: parse the json files and write the cache
+    state.measure("Configuration::reload (json)", 1,
+                  [&cacheFile]()
+                  {
+                      std::filesystem::remove(cacheFile);
+                      Configuration::reload();
+                  });
+    // warm: json files unchanged, load from the cache
+    state.measure("Configuration::reload (cache)", 1, []() { Configuration::reload(); });
+    state.report("loaded from cache", Configuration::get()->loadedFromCache() ? 1.0 : 0.0, "(1 = yes)");
+}
+
+S2_BENCHMARK(EntityClassResolve)
+{
+    auto config = Configuration::get();
+    if (config == nullptr)
+        return;
+
+    auto& entities = config->entityList();
+    // what Entity::entityClassName did before: regex for every entry of default_entity_types on every call
+    auto regexClassName = [config](const std::string& entityName) -> std::string
+    {
+        for (const auto& [regexStr, entityClassType] : config->defaultEntityClassTypes())
+        {
+            auto r = std::regex(regexStr);
+            if (std::regex_match(entityName, r))
+                return entityClassType;
+        }
+        return "Entity";
+    };
+    size_t mismatches = 0;
+    for (auto& [id, name] : entities.entries())
+        if (regexClassName(name) != config->entityClassName(id))
+            ++mismatches;
+
+    state.report("entity types", static_cast<double>(entities.count()), "ids");
+    state.report("class mismatches between regex and table", static_cast<double>(mismatches), "ids");
+    state.measure("class name of every entity type, regex per call", 1,
+                  [&]()
+                  {
+                      for (auto& [id, name] : entities.entries())
+                          S2Benchmark::doNotOptimize(regexClassName(name).size());
+                  });
+    state.measure("class name of every entity type, table", 100,
+                  [&]()
+                  {
+                      for (uint32_t id = 0; id <= entities.highestID(); ++id)
+                          S2Benchmark::doNotOptimize(config->entityClassName(id).size());
+                  });
+    state.measure("class hierarchy of every entity type, table", 100,
+                  [&]()
+                  {
+                      for (uint32_t id = 0; id <= entities.highestID(); ++id)
+                          S2Benchmark::doNotOptimize(config->classHierarchyOfEntity(id).size());
+                  });
+}
+
+S2_BENCHMARK(ConfigurationLookups)
+{
+    auto config = Configuration::get();
+    if (config == nullptr)
+        return;
+
+    state.measure("offsetForField(State, camera_layer)", 10000, [config]() { S2Benchmark::doNotOptimize(config->offsetForField(MemoryFieldType::State, "camera_layer")); });
+    state.measure("offsetForField(State, camera.adjusted_focus_y)", 10000,
+                  [config]() { S2Benchmark::doNotOptimize(config->offsetForField(MemoryFieldType::State, "camera.adjusted_focus_y")); });
+    state.measure("offsetForField(LevelGen, theme_dwelling)", 10000, [config]() { S2Benchmark::doNotOptimize(config->offsetForField(MemoryFieldType::LevelGen, "theme_dwelling")); });
+    // copy of the fields is not in the offset index, same lookup as before the index
+    auto stateFields = config->typeFields(MemoryFieldType::State);
+    state.measure("offsetForField(State copy, camera_layer) (linear walk)", 10000,
+                  [config, &stateFields]() { S2Benchmark::doNotOptimize(config->offsetForField(stateFields, "camera_layer")); });
+    state.measure("getTypeSize(State)", 10000, [config]() { S2Benchmark::doNotOptimize(config->getTypeSize("State")); });
+    state.measure("classHierarchyOfEntity(CHAR_ANA_SPELUNKY)", 1000, [config]() { S2Benchmark::doNotOptimize(config->classHierarchyOfEntity("CHAR_ANA_SPELUNKY")); });
+    state.measure("getEntityName(194)", 10000, [config]() { S2Benchmark::doNotOptimize(config->getEntityName(194)); });
+}
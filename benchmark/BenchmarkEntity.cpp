@@ -0,0 +1,159 @@
+#include "Benchmark.h"
+
+#include "Data/Entity.h"
+#include "Data/EntitySnapshot.h"
+#include "MemorySource/SyntheticMemorySource.h"
+#include "ReadCache.h"
+#include "read_helpers.h"
+#include <memory>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    constexpr uintptr_t gsEntityDBBase = 0x10000000;
+    constexpr uintptr_t gsEntityDBRecordSize = 0x150;
+    constexpr uintptr_t gsEntitiesBase = 0x20000000;
+    constexpr uint32_t gsEntityCount = 5000;
+    constexpr uint32_t gsEntityTypeCount = 1000;
+
+    // entities laid out like in the game heap: each has a pointer to the EntityDB record, uid, position and layer
+    std::vector<uintptr_t> buildEntities(SyntheticMemorySource& memory)
+    {
+        memory.map(gsEntityDBBase, gsEntityDBRecordSize * gsEntityTypeCount);
+        for (uint32_t id = 0; id < gsEntityTypeCount; ++id)
+            memory.write<uint32_t>(gsEntityDBBase + id * gsEntityDBRecordSize + Entity::DB_TYPE_ID, id);
+
+        memory.map(gsEntitiesBase, gBigEntityBucket * gsEntityCount);
+        std::vector<uintptr_t> entities;
+        entities.reserve(gsEntityCount);
+        for (uint32_t i = 0; i < gsEntityCount; ++i)
+        {
+            uintptr_t entity = gsEntitiesBase + i * gBigEntityBucket;
+            memory.write<uintptr_t>(entity + Entity::TYPE_PTR, gsEntityDBBase + (i % gsEntityTypeCount) * gsEntityDBRecordSize);
+            memory.write<uint32_t>(entity + Entity::UID, i + 100);
+            memory.write<float>(entity + Entity::POS, static_cast<float>(i % 80));
+            memory.write<float>(entity + Entity::POS + 4, static_cast<float>(i / 80));
+            memory.write<uint8_t>(entity + Entity::LAYER, static_cast<uint8_t>(i & 1));
+            entities.push_back(entity);
+        }
+        return entities;
+    }
+
+    // counts the reads that would go to the debugger, the x64dbg source does every request of a bulk read separately
+    void readEntities(const std::vector<uintptr_t>& entities)
+    {
+        for (auto addr : entities)
+        {
+            Entity entity{addr};
+            S2Benchmark::doNotOptimize(entity.uid());
+            S2Benchmark::doNotOptimize(entity.entityTypeID());
+            S2Benchmark::doNotOptimize(entity.position());
+            S2Benchmark::doNotOptimize(entity.layer());
+        }
+    }
+
+    void readEntitiesAbsolute(const std::vector<uintptr_t>& entities)
+    {
+        for (auto addr : entities)
+        {
+            Entity entity{addr};
+            S2Benchmark::doNotOptimize(entity.uid());
+            S2Benchmark::doNotOptimize(entity.entityTypeID());
+            S2Benchmark::doNotOptimize(entity.abs_position());
+            S2Benchmark::doNotOptimize(entity.layer());
+        }
+    }
+
+    void readSnapshot(const std::vector<uintptr_t>& entities)
+    {
+        EntitySnapshot snapshot;
+        for (auto addr : entities)
+            snapshot.addEntity(addr);
+        snapshot.read();
+        for (size_t i = 0; i < snapshot.size(); ++i)
+        {
+            S2Benchmark::doNotOptimize(snapshot.uid(i));
+            S2Benchmark::doNotOptimize(snapshot.entityTypeID(i));
+            S2Benchmark::doNotOptimize(snapshot.abs_position(i));
+            S2Benchmark::doNotOptimize(snapshot.layer(i));
+        }
+    }
+} // namespace
+
+S2_BENCHMARK(EntityRead)
+{
+    auto memory = std::make_unique<SyntheticMemorySource>();
+    auto entities = buildEntities(*memory);
+    MemorySource::set(std::move(memory));
+
+    state.measure("uid/type/position/layer of 5000 entities, direct", 10, [&entities]() { readEntities(entities); });
+    state.measure("uid/type/position/layer of 5000 entities, ReadCache", 10,
+                  [&entities]()
+                  {
+                      ReadCache::Scope scope;
+                      readEntities(entities);
+                  });
+
+    ReadCache::resetCounters();
+    {
+        ReadCache::Scope scope;
+        readEntities(entities);
+    }
+    auto total = ReadCache::hits() + ReadCache::misses();
+    state.report("ReadCache hit rate", total == 0 ? 0.0 : 100.0 * static_cast<double>(ReadCache::hits()) / static_cast<double>(total), "%");
+
+    MemorySource::set(nullptr);
+}
+
+S2_BENCHMARK(EntityBulkRead)
+{
+    auto memory = std::make_unique<S2Benchmark::CountingMemorySource>();
+    auto entities = buildEntities(*memory);
+    // every 10th entity is held by the previous one
+    for (size_t i = 10; i < entities.size(); i += 10)
+        memory->write<uintptr_t>(entities[i] + Entity::OVERLAY, entities[i - 1]);
+    auto counting = memory.get();
+    MemorySource::set(std::move(memory));
+
+    // verify the snapshot against the single reads
+    {
+        EntitySnapshot snapshot;
+        for (auto addr : entities)
+            snapshot.addEntity(addr);
+        snapshot.read();
+        size_t mismatches = 0;
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            Entity entity{entities[i]};
+            if (snapshot.uid(i) != entity.uid() || snapshot.entityTypeID(i) != entity.entityTypeID() || snapshot.layer(i) != entity.layer() ||
+                snapshot.abs_position(i) != entity.abs_position())
+                ++mismatches;
+        }
+        state.report("mismatches", static_cast<double>(mismatches), "entities");
+    }
+
+    state.measure("uid/type/abs position/layer of 5000 entities, ReadCache", 10,
+                  [&entities]()
+                  {
+                      ReadCache::Scope scope;
+                      readEntitiesAbsolute(entities);
+                  });
+    state.measure("uid/type/abs position/layer of 5000 entities, EntitySnapshot", 10, [&entities]() { readSnapshot(entities); });
+
+    counting->mReads = 0;
+    readEntitiesAbsolute(entities);
+    state.report("memory reads, direct", static_cast<double>(counting->mReads), "reads");
+    counting->mReads = 0;
+    {
+        ReadCache::Scope scope;
+        readEntitiesAbsolute(entities);
+    }
+    state.report("memory reads, ReadCache", static_cast<double>(counting->mReads), "reads");
+    counting->mReads = 0;
+    readSnapshot(entities);
+    state.report("memory reads, EntitySnapshot", static_cast<double>(counting->mReads), "reads");
+
+    MemorySource::set(nullptr);
+}
@@ -0,0 +1,116 @@
+#include "Benchmark.h"
+
+#include "Data/EntityUIDTable.h"
+#include "MemorySource/SyntheticMemorySource.h"
+#include "ReadCache.h"
+#include <memory>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    constexpr uintptr_t gsMaskAddr = 0x10000000;
+    constexpr uintptr_t gsTableBase = 0x20000000;
+    constexpr uint32_t gsMask = 0x3FFF;
+    constexpr uint32_t gsEntityCount = 5000;
+    constexpr uint32_t gsLookupCount = 1000;
+
+    // robin hood insert, same probing as the game
+    void insert(std::vector<EntityUIDTable::Entry>& table, uint32_t uid, uintptr_t entity)
+    {
+        EntityUIDTable::Entry entry{EntityUIDTable::hash(uid), 0, entity};
+        uint32_t index = entry.uid_plus_one & gsMask;
+        while (true)
+        {
+            auto& current = table[index];
+            if (current.uid_plus_one == 0)
+            {
+                current = entry;
+                return;
+            }
+            // the poorer one (further from it's ideal index) takes the slot
+            if (((index - entry.uid_plus_one) & gsMask) > ((index - current.uid_plus_one) & gsMask))
+                std::swap(current, entry);
+
+            index = (index + 1u) & gsMask;
+        }
+    }
+
+    void buildTable(SyntheticMemorySource& memory)
+    {
+        std::vector<EntityUIDTable::Entry> table(gsMask + 1u, EntityUIDTable::Entry{0, 0, 0});
+        for (uint32_t uid = 0; uid < gsEntityCount; ++uid)
+            insert(table, uid * 3, 0x30000000 + uid * 0x188);
+
+        memory.map(gsMaskAddr, 0x10);
+        memory.write<uint32_t>(gsMaskAddr, gsMask);
+        memory.write<uintptr_t>(gsMaskAddr + 0x8, gsTableBase);
+        memory.map(gsTableBase, table.size() * sizeof(EntityUIDTable::Entry));
+        memory.write(gsTableBase, table.data(), table.size() * sizeof(EntityUIDTable::Entry));
+    }
+
+    // counts the reads that would go to the debugger
+} // namespace
+
+S2_BENCHMARK(EntityUIDLookup)
+{
+    auto memory = std::make_unique<S2Benchmark::CountingMemorySource>();
+    buildTable(*memory);
+    auto counting = memory.get();
+    MemorySource::set(std::move(memory));
+
+    // every 3rd uid exists, the rest are misses
+    std::vector<uint32_t> uids;
+    for (uint32_t i = 0; i < gsLookupCount; ++i)
+        uids.push_back(i * 7);
+    std::vector<uintptr_t> result(uids.size());
+
+    auto perCall = [&]()
+    {
+        for (size_t i = 0; i < uids.size(); ++i)
+            result[i] = EntityUIDTable::findInMemory(uids[i], gsMaskAddr);
+    };
+    auto batched = [&]()
+    {
+        EntityUIDTable table;
+        table.read(gsMaskAddr);
+        table.find(uids.data(), uids.size(), result.data());
+    };
+
+    size_t mismatches = 0;
+    perCall();
+    auto expected = result;
+    batched();
+    for (size_t i = 0; i < uids.size(); ++i)
+    {
+        uintptr_t correct = uids[i] % 3 == 0 && uids[i] / 3 < gsEntityCount ? 0x30000000 + (uids[i] / 3) * 0x188 : 0;
+        if (result[i] != correct || expected[i] != correct)
+            ++mismatches;
+    }
+    state.report("mismatches", static_cast<double>(mismatches), "uids");
+
+    state.measure("1000 lookups, per call", 20, perCall);
+    state.measure("1000 lookups, per call, ReadCache", 20,
+                  [&]()
+                  {
+                      ReadCache::Scope scope;
+                      perCall();
+                  });
+    state.measure("1000 lookups, batched (table copy included)", 20, batched);
+
+    counting->mReads = 0;
+    perCall();
+    state.report("memory reads, per call", static_cast<double>(counting->mReads), "reads");
+    counting->mReads = 0;
+    {
+        ReadCache::Scope scope;
+        perCall();
+    }
+    state.report("memory reads, per call, ReadCache", static_cast<double>(counting->mReads), "reads");
+    counting->mReads = 0;
+    batched();
+    state.report("memory reads, batched", static_cast<double>(counting->mReads), "reads");
+
+    MemorySource::set(nullptr);
+}
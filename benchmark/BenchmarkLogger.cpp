@@ -0,0 +1,624 @@
+#include "Benchmark.h"
+
+#include "Configuration.h"
+#include "Data/LoggerCapture.h"
+#include "Data/LoggerColumn.h"
+#include "Data/LoggerSampler.h"
+#include "Data/LoggerTrigger.h"
+#include "MemorySource/SyntheticMemorySource.h"
+#include "ReadCache.h"
+#include "ReadPlan.h"
+#include "read_helpers.h"
+#include <any>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    constexpr uintptr_t gsFieldsBase = 0x10000000;
+    constexpr size_t gsFieldCount = 50;
+    constexpr size_t gsSampleCount = 100000;
+
+    struct Field
+    {
+        uintptr_t addr;
+        MemoryFieldType type;
+        std::string uuid;
+    };
+
+    std::vector<Field> buildFields(SyntheticMemorySource& memory)
+    {
+        static const std::array types = {MemoryFieldType::Float, MemoryFieldType::Dword, MemoryFieldType::UnsignedByte, MemoryFieldType::Double, MemoryFieldType::Word, MemoryFieldType::UnsignedQword};
+        // game memory is committed in whole pages
+        memory.map(gsFieldsBase, ReadCache::pageSize);
+        std::vector<Field> fields;
+        for (size_t i = 0; i < gsFieldCount; ++i)
+        {
+            auto& field = fields.emplace_back(Field{gsFieldsBase + i * 8, types[i % types.size()], "{00000000-0000-0000-0000-0000000000" + std::to_string(10 + i) + "}"});
+            switch (field.type)
+            {
+                case MemoryFieldType::UnsignedByte:
+                    memory.write<uint8_t>(field.addr, static_cast<uint8_t>(i));
+                    break;
+                case MemoryFieldType::Word:
+                    memory.write<int16_t>(field.addr, static_cast<int16_t>(-100 * static_cast<int>(i)));
+                    break;
+                case MemoryFieldType::Dword:
+                    memory.write<int32_t>(field.addr, static_cast<int32_t>(i * 1000));
+                    break;
+                case MemoryFieldType::UnsignedQword:
+                    memory.write<uint64_t>(field.addr, i << 40);
+                    break;
+                case MemoryFieldType::Float:
+                    memory.write<float>(field.addr, static_cast<float>(i) * 1.5f);
+                    break;
+                default:
+                    memory.write<double>(field.addr, static_cast<double>(i) * -2.25);
+                    break;
+            }
+        }
+        return fields;
+    }
+
+    // counts the reads that would go to the debugger, the x64dbg source does every request of a bulk read separately
+    // Logger storage before the columns: samples as std::any in a map keyed by the field uuid
+    struct LegacyLogger
+    {
+        std::vector<Field> fields;
+        std::unordered_map<std::string, std::vector<std::any>> samples;
+
+        void start()
+        {
+            samples.clear();
+            for (const auto& field : fields)
+                samples[field.uuid] = {};
+        }
+        void sample()
+        {
+            ReadCache::Scope readCacheScope;
+            for (const auto& field : fields)
+            {
+                switch (field.type)
+                {
+                    case MemoryFieldType::UnsignedByte:
+                        samples[field.uuid].emplace_back(Read<uint8_t>(field.addr));
+                        break;
+                    case MemoryFieldType::Word:
+                        samples[field.uuid].emplace_back(Read<int16_t>(field.addr));
+                        break;
+                    case MemoryFieldType::Dword:
+                        samples[field.uuid].emplace_back(Read<int32_t>(field.addr));
+                        break;
+                    case MemoryFieldType::UnsignedQword:
+                        samples[field.uuid].emplace_back(Read<uint64_t>(field.addr));
+                        break;
+                    case MemoryFieldType::Float:
+                        samples[field.uuid].emplace_back(Read<float>(field.addr));
+                        break;
+                    case MemoryFieldType::Double:
+                        samples[field.uuid].emplace_back(Read<double>(field.addr));
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+        std::pair<int64_t, int64_t> bounds(const Field& field) const
+        {
+            int64_t highest = std::numeric_limits<int64_t>::min();
+            int64_t lowest = std::numeric_limits<int64_t>::max();
+            for (const auto& value : samples.at(field.uuid))
+            {
+                int64_t low;
+                int64_t high;
+                switch (field.type)
+                {
+                    case MemoryFieldType::UnsignedByte:
+                        low = high = std::any_cast<uint8_t>(value);
+                        break;
+                    case MemoryFieldType::Word:
+                        low = high = std::any_cast<int16_t>(value);
+                        break;
+                    case MemoryFieldType::Dword:
+                        low = high = std::any_cast<int32_t>(value);
+                        break;
+                    case MemoryFieldType::UnsignedQword:
+                        low = high = static_cast<int64_t>(std::any_cast<uint64_t>(value));
+                        break;
+                    case MemoryFieldType::Float:
+                        low = static_cast<int64_t>(std::floor(std::any_cast<float>(value)));
+                        high = static_cast<int64_t>(std::ceil(std::any_cast<float>(value)));
+                        break;
+                    default:
+                        low = static_cast<int64_t>(std::floor(std::any_cast<double>(value)));
+                        high = static_cast<int64_t>(std::ceil(std::any_cast<double>(value)));
+                        break;
+                }
+                lowest = std::min(lowest, low);
+                highest = std::max(highest, high);
+            }
+            return {lowest, highest};
+        }
+    };
+} // namespace
+
+S2_BENCHMARK(LoggerSampling)
+{
+    auto memory = std::make_unique<SyntheticMemorySource>();
+    auto fields = buildFields(*memory);
+    MemorySource::set(std::move(memory));
+
+    LegacyLogger legacy{fields, {}};
+    state.measure("50 fields x 100k samples, std::any map", 1,
+                  [&legacy]()
+                  {
+                      legacy.start();
+                      for (size_t i = 0; i < gsSampleCount; ++i)
+                          legacy.sample();
+                  });
+    state.measure("bounds of 50 fields, std::any map", 1,
+                  [&legacy]()
+                  {
+                      for (const auto& field : legacy.fields)
+                          S2Benchmark::doNotOptimize(legacy.bounds(field));
+                  });
+
+    std::vector<LoggerColumn> columns;
+    state.measure("50 fields x 100k samples, typed columns", 1,
+                  [&columns, &fields]()
+                  {
+                      columns.clear();
+                      for (const auto& field : fields)
+                          columns.emplace_back(field.addr, field.type).reserve(gsSampleCount);
+
+                      for (size_t i = 0; i < gsSampleCount; ++i)
+                      {
+                          ReadCache::Scope readCacheScope;
+                          for (auto& column : columns)
+                              column.sample();
+                      }
+                  });
+    state.measure("bounds of 50 fields, typed columns", 1000,
+                  [&columns]()
+                  {
+                      for (const auto& column : columns)
+                          S2Benchmark::doNotOptimize(column.bounds());
+                  });
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        if (legacy.bounds(fields[i]) != columns[i].bounds() || columns[i].size() != gsSampleCount)
+            ++mismatches;
+    }
+    state.report("bounds mismatches", static_cast<double>(mismatches), "fields");
+
+    // std::any stores the small types inline, but every element takes sizeof(std::any) (16 bytes in libstdc++, 64 in MSVC)
+    size_t legacyBytes = 0;
+    for (const auto& [uuid, samples] : legacy.samples)
+        legacyBytes += samples.capacity() * sizeof(std::any);
+    size_t columnBytes = 0;
+    for (const auto& column : columns)
+        columnBytes += column.visitAt(0, [](auto value) { return sizeof(value); }) * column.size();
+    state.report("sample storage, std::any map", static_cast<double>(legacyBytes) / (1024.0 * 1024.0), "MiB");
+    state.report("sample storage, typed columns", static_cast<double>(columnBytes) / (1024.0 * 1024.0), "MiB");
+
+    MemorySource::set(nullptr);
+}
+
+S2_BENCHMARK(LoggerSamplerThread)
+{
+    auto memory = std::make_unique<SyntheticMemorySource>();
+    auto fields = buildFields(*memory);
+    MemorySource::set(std::move(memory));
+
+    // 50 fields every 1 ms for 2 seconds, drained like the GUI does
+    std::vector<LoggerColumn> columns;
+    for (const auto& field : fields)
+        columns.emplace_back(field.addr, field.type).reserve(2100);
+
+    std::vector<uint64_t> sampleIndexes;
+    LoggerSampler sampler;
+    auto cpuStart = std::clock();
+    sampler.start(columns, std::chrono::milliseconds(1), std::chrono::seconds(2));
+    size_t drained = 0;
+    while (!sampler.finished())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        drained += sampler.drain(columns, sampleIndexes);
+    }
+    sampler.stop();
+    drained += sampler.drain(columns, sampleIndexes);
+    // process cpu time, the sampler thread plus the draining
+    double cpu = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    const auto& stats = sampler.statistics();
+    state.report("samples", static_cast<double>(stats.samples), "samples");
+    state.report("samples drained", static_cast<double>(drained), "samples");
+    state.report("dropped", static_cast<double>(stats.dropped), "samples");
+    state.report("missed ticks", static_cast<double>(stats.missed), "ticks");
+    state.report("cpu time of the 2 s run", cpu * 1000.0, "ms");
+    state.report("requested period", stats.requestedPeriod * 1000.0, "us");
+    state.report("mean period", stats.meanPeriod * 1000.0, "us");
+    state.report("jitter (stddev)", stats.jitter * 1000.0, "us");
+    state.report("min period", stats.minPeriod * 1000.0, "us");
+    state.report("max period", stats.maxPeriod * 1000.0, "us");
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        columns[i].visitAt(0, [&](auto first) { mismatches += columns[i].valueAt(columns[i].size() - 1) != static_cast<double>(first) ? 1 : 0; });
+        if (columns[i].size() != drained)
+            ++mismatches;
+    }
+    state.report("column mismatches", static_cast<double>(mismatches), "fields");
+
+    MemorySource::set(nullptr);
+}
+
+S2_BENCHMARK(LoggerReadPlan)
+{
+    auto memory = std::make_unique<S2Benchmark::CountingMemorySource>();
+    auto fields = buildFields(*memory);
+    // a few more fields from a different struct, far from the first one
+    constexpr uintptr_t secondBase = gsFieldsBase + 0x100000;
+    memory->map(secondBase, ReadCache::pageSize);
+    for (uintptr_t offset = 0; offset < 0x100; offset += 0x20)
+    {
+        memory->write<uint32_t>(secondBase + offset, static_cast<uint32_t>(offset));
+        fields.push_back(Field{secondBase + offset, MemoryFieldType::Dword, {}});
+    }
+    auto& counter = *memory;
+    MemorySource::set(std::move(memory));
+
+    constexpr size_t ticks = 100000;
+    std::vector<uint64_t> record(fields.size());
+    auto sizeOf = [](MemoryFieldType type) -> size_t
+    {
+        switch (type)
+        {
+            case MemoryFieldType::UnsignedByte:
+                return 1;
+            case MemoryFieldType::Word:
+                return 2;
+            case MemoryFieldType::Dword:
+            case MemoryFieldType::Float:
+                return 4;
+            default:
+                return 8;
+        }
+    };
+
+    state.measure("58 fields x 100k ticks, read per field", 1,
+                  [&]()
+                  {
+                      for (size_t tick = 0; tick < ticks; ++tick)
+                      {
+                          for (size_t i = 0; i < fields.size(); ++i)
+                              MemorySource::get().read(fields[i].addr, &record[i], sizeOf(fields[i].type));
+                          S2Benchmark::doNotOptimize(record.data());
+                      }
+                  });
+    counter.mReads = 0;
+    for (size_t i = 0; i < fields.size(); ++i)
+        MemorySource::get().read(fields[i].addr, &record[i], sizeOf(fields[i].type));
+    state.report("reads per tick, read per field", static_cast<double>(counter.mReads), "reads");
+
+    state.measure("58 fields x 100k ticks, read cache", 1,
+                  [&]()
+                  {
+                      for (size_t tick = 0; tick < ticks; ++tick)
+                      {
+                          ReadCache::Scope readCacheScope;
+                          for (size_t i = 0; i < fields.size(); ++i)
+                              ReadMemory(fields[i].addr, &record[i], sizeOf(fields[i].type));
+                          S2Benchmark::doNotOptimize(record.data());
+                      }
+                  });
+    counter.mReads = 0;
+    {
+        ReadCache::Scope readCacheScope;
+        for (size_t i = 0; i < fields.size(); ++i)
+            ReadMemory(fields[i].addr, &record[i], sizeOf(fields[i].type));
+    }
+    state.report("reads per tick, read cache", static_cast<double>(counter.mReads), "reads");
+
+    ReadPlan plan;
+    for (const auto& field : fields)
+        plan.add(field.addr, sizeOf(field.type));
+    plan.build(0x1000);
+    state.measure("58 fields x 100k ticks, read plan", 1,
+                  [&]()
+                  {
+                      for (size_t tick = 0; tick < ticks; ++tick)
+                      {
+                          plan.execute();
+                          for (size_t i = 0; i < plan.blockCount(); ++i)
+                              std::memcpy(&record[i], plan.data(i), plan.blockSize(i));
+                          S2Benchmark::doNotOptimize(record.data());
+                      }
+                  });
+    counter.mReads = 0;
+    plan.execute();
+    state.report("reads per tick, read plan", static_cast<double>(counter.mReads), "reads");
+    state.report("bytes per tick, read plan", static_cast<double>(plan.bufferSize()), "bytes");
+
+    MemorySource::set(nullptr);
+}
+
+S2_BENCHMARK(LoggerCaptureFile)
+{
+    auto memory = std::make_unique<SyntheticMemorySource>();
+    auto fields = buildFields(*memory);
+    MemorySource::set(std::move(memory));
+
+    std::vector<LoggerCaptureField> captureFields;
+    std::vector<LoggerColumn> columns;
+    for (const auto& field : fields)
+    {
+        captureFields.push_back(LoggerCaptureField{field.addr, field.type, 0xFF00FF00, field.uuid});
+        columns.emplace_back(field.addr, field.type);
+    }
+    // records as the sampler thread produces them, the sample index is updated for every frame
+    std::vector<uint64_t> record(fields.size() + 1, 0);
+    for (size_t i = 0; i < fields.size(); ++i)
+        ReadMemory(fields[i].addr, &record[i], columns[i].valueSize());
+
+    const auto path = (std::filesystem::temp_directory_path() / "s2benchmark.s2capture").string();
+    constexpr size_t frames = 200000;
+    LoggerCaptureWriter writer;
+    state.measure("stream 50 fields x 200k samples to capture", 1,
+                  [&]()
+                  {
+                      writer.create(path, captureFields, std::chrono::milliseconds(1));
+                      for (size_t i = 0; i < frames; ++i)
+                      {
+                          record[fields.size()] = i;
+                          writer.append(record.data());
+                          // the Logger flushes every drain (50 ms)
+                          if (i % 50 == 0)
+                              writer.flush();
+                      }
+                      writer.close();
+                  });
+    state.report("capture file size", static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0), "MiB");
+
+    LoggerCaptureReader reader;
+    std::vector<LoggerColumn> loaded;
+    std::vector<uint64_t> loadedIndexes;
+    state.measure("reopen capture into columns", 1,
+                  [&]()
+                  {
+                      reader.open(path);
+                      loaded = reader.readColumns();
+                      loadedIndexes = reader.readSampleIndexes();
+                  });
+
+    // what the Logger does now, the samples table and plot only read the chunks they show
+    LoggerCaptureWindow window;
+    state.measure("reopen capture and load the shown window", 1,
+                  [&]()
+                  {
+                      reader.close();
+                      window.clear();
+                      reader.open(path);
+                      window.load(reader, frames / 2, frames / 2 + 1000);
+                  });
+    state.report("samples loaded by the window", static_cast<double>(window.sampleIndexes().size()), "samples");
+
+    size_t mismatches = reader.frameCount() == frames && loadedIndexes.size() == frames && loadedIndexes.back() == frames - 1 ? 0 : 1;
+    for (size_t i = 0; i < fields.size() && i < loaded.size(); ++i)
+    {
+        columns[i].append(record[i]);
+        if (loaded[i].size() != frames || loaded[i].valueAt(frames - 1) != columns[i].valueAt(0) || reader.fields()[i].name != fields[i].uuid)
+            ++mismatches;
+    }
+    state.report("capture mismatches", static_cast<double>(mismatches), "fields");
+
+    const auto csvPath = path + ".csv";
+    state.measure("export 200k samples to csv", 1,
+                  [&]()
+                  {
+                      std::ofstream file(csvPath, std::ios::binary | std::ios::trunc);
+                      exportLoggerCSV(file, reader.fields(), loaded, loadedIndexes, reader.samplePeriod());
+                  });
+    state.report("csv size", static_cast<double>(std::filesystem::file_size(csvPath)) / (1024.0 * 1024.0), "MiB");
+
+    reader.close();
+    std::filesystem::remove(path);
+    std::filesystem::remove(csvPath);
+    MemorySource::set(nullptr);
+}
+
+namespace
+{
+    struct PlotLine
+    {
+        double x1, y1, x2, y2;
+    };
+
+    // what WidgetSamplesPlot::paintEvent did before the level of detail: a line between every two samples
+    void plotFullScan(const LoggerColumn& samples, double drawHeight, std::vector<PlotLine>& lines)
+    {
+        lines.clear();
+        auto [lowerBound, upperBound] = samples.bounds();
+        for (size_t i = 1; i < samples.size(); ++i)
+        {
+            double y1 = (samples.valueAt(i - 1) - lowerBound) / static_cast<double>(upperBound - lowerBound) * drawHeight;
+            double y2 = (samples.valueAt(i) - lowerBound) / static_cast<double>(upperBound - lowerBound) * drawHeight;
+            lines.push_back(PlotLine{static_cast<double>(i - 1), drawHeight - y1, static_cast<double>(i), drawHeight - y2});
+        }
+    }
+
+    // the same as WidgetSamplesPlot::paintEvent, for the columns [firstColumn, lastColumn)
+    void plotLevelOfDetail(const LoggerColumn& samples, double drawHeight, size_t samplesPerPixel, size_t firstColumn, size_t lastColumn, std::vector<PlotLine>& lines)
+    {
+        lines.clear();
+        auto [lowerBound, upperBound] = samples.bounds();
+        double scale = upperBound > lowerBound ? drawHeight / static_cast<double>(upperBound - lowerBound) : 0.0;
+        auto mapY = [&, lowerBound = lowerBound](double value) { return drawHeight - (value - static_cast<double>(lowerBound)) * scale; };
+        double previousX = 0.0;
+        double previousY = 0.0;
+        bool hasPrevious = false;
+        for (size_t column = firstColumn; column < lastColumn; ++column)
+        {
+            size_t first = column * samplesPerPixel;
+            size_t last = std::min(first + samplesPerPixel, samples.size());
+            double firstValue = samples.valueAt(first);
+            double lastValue = samples.valueAt(last - 1);
+            auto x = static_cast<double>(column);
+            if (hasPrevious)
+                lines.push_back(PlotLine{previousX, previousY, x, mapY(firstValue)});
+            if (samplesPerPixel > 1)
+            {
+                auto [low, high] = samples.minMax(first, last);
+                if (low < high)
+                    lines.push_back(PlotLine{x, mapY(low), x, mapY(high)});
+            }
+            previousX = x;
+            previousY = mapY(lastValue);
+            hasPrevious = true;
+        }
+    }
+} // namespace
+
+S2_BENCHMARK(LoggerPlotLOD)
+{
+    constexpr double drawHeight = 400.0;
+    constexpr size_t maxPlotWidth = 8192;
+    constexpr size_t viewportWidth = 1000;
+    std::vector<PlotLine> lines;
+
+    for (size_t count : {size_t{1000}, size_t{100000}, size_t{10000000}})
+    {
+        LoggerColumn samples{0, MemoryFieldType::Float};
+        samples.reserve(count);
+        auto label = [count](const char* text) { return std::to_string(count) + " samples, " + text; };
+
+        state.measure(label("append incl. pyramid"), 1,
+                      [&]()
+                      {
+                          samples.clear();
+                          for (size_t i = 0; i < count; ++i)
+                          {
+                              float value = std::sin(static_cast<float>(i) * 0.001f) * 100.0f + static_cast<float>(i % 7);
+                              uint64_t raw = 0;
+                              std::memcpy(&raw, &value, sizeof(value));
+                              samples.append(raw);
+                          }
+                      });
+
+        state.measure(label("full scan paint"), count >= 10000000 ? 1 : 10, [&]() { plotFullScan(samples, drawHeight, lines); });
+        state.report(label("full scan lines"), static_cast<double>(lines.size()), "lines");
+
+        size_t samplesPerPixel = std::max<size_t>(1, (count + maxPlotWidth - 1) / maxPlotWidth);
+        size_t columnCount = (count + samplesPerPixel - 1) / samplesPerPixel;
+        state.measure(label("lod paint, visible 1000 px"), 100, [&]() { plotLevelOfDetail(samples, drawHeight, samplesPerPixel, 0, std::min(viewportWidth, columnCount), lines); });
+        state.report(label("lod lines, visible 1000 px"), static_cast<double>(lines.size()), "lines");
+        state.measure(label("lod paint, whole plot"), 10, [&]() { plotLevelOfDetail(samples, drawHeight, samplesPerPixel, 0, columnCount, lines); });
+
+        // every column has to cover exactly the samples under it
+        size_t mismatches = 0;
+        for (size_t column = 0; column < columnCount; column += 97)
+        {
+            size_t first = column * samplesPerPixel;
+            size_t last = std::min(first + samplesPerPixel, count);
+            double low = std::numeric_limits<double>::infinity();
+            double high = -std::numeric_limits<double>::infinity();
+            for (size_t i = first; i < last; ++i)
+            {
+                low = std::min(low, samples.valueAt(i));
+                high = std::max(high, samples.valueAt(i));
+            }
+            auto [pyramidLow, pyramidHigh] = samples.minMax(first, last);
+            if (pyramidLow != low || pyramidHigh != high)
+                ++mismatches;
+        }
+        state.report(label("min/max mismatches"), static_cast<double>(mismatches), "columns");
+    }
+}
+
+S2_BENCHMARK(LoggerTriggers)
+{
+    // 50 fields, the first one (a state machine value) changes every 50k samples, the third (a float) drops below zero once
+    constexpr size_t ticks = 1000000;
+    constexpr size_t stateChangePeriod = 50000;
+    std::vector<LoggerColumn> columns;
+    columns.emplace_back(0, MemoryFieldType::State8);
+    columns.emplace_back(0, MemoryFieldType::Flags32);
+    columns.emplace_back(0, MemoryFieldType::Float);
+    while (columns.size() < gsFieldCount)
+        columns.emplace_back(0, MemoryFieldType::Dword);
+
+    LoggerTriggerSettings settings;
+    settings.triggers.push_back(LoggerTrigger{0, LoggerTrigger::Condition::Changed});
+    settings.triggers.push_back(LoggerTrigger{2, LoggerTrigger::Condition::FallsBelow, 0.0});
+    settings.triggers.push_back(LoggerTrigger{1, LoggerTrigger::Condition::BitSet, 0.0, 31});
+    settings.preTrigger = 100;
+    settings.postTrigger = 100;
+
+    std::vector<uint64_t> record(columns.size() + 1, 0);
+    auto sampleAt = [&record](size_t tick)
+    {
+        record.back() = tick;
+        record[0] = static_cast<uint8_t>(static_cast<int8_t>(-static_cast<int>(tick / stateChangePeriod)));
+        // never reaches bit 31
+        record[1] = tick & 0xFF;
+        float health = tick == ticks / 2 + stateChangePeriod / 2 ? -1.0f : 4.0f;
+        std::memcpy(&record[2], &health, sizeof(health));
+        for (size_t i = 3; i + 1 < record.size(); ++i)
+            record[i] = tick + i;
+    };
+
+    size_t kept = 0;
+    auto store = [&kept](const uint64_t* data)
+    {
+        S2Benchmark::doNotOptimize(data);
+        ++kept;
+    };
+    state.measure("1M samples, keep everything", 1,
+                  [&]()
+                  {
+                      kept = 0;
+                      for (size_t tick = 0; tick < ticks; ++tick)
+                      {
+                          sampleAt(tick);
+                          store(record.data());
+                      }
+                  });
+
+    size_t triggers = 0;
+    size_t discarded = 0;
+    state.measure("1M samples, 3 triggers, 100 before/after", 1,
+                  [&]()
+                  {
+                      kept = 0;
+                      LoggerTriggerWindow window{settings, columns};
+                      for (size_t tick = 0; tick < ticks; ++tick)
+                      {
+                          sampleAt(tick);
+                          window.process(record.data(), store);
+                      }
+                      triggers = window.triggerCount();
+                      discarded = window.discarded();
+                  });
+
+    // the state changes 19 times, the health drops and comes back (only the drop triggers)
+    size_t expectedTriggers = (ticks / stateChangePeriod - 1) + 1;
+    state.report("triggers", static_cast<double>(triggers), "triggers");
+    state.report("kept samples", static_cast<double>(kept), "samples");
+    state.report("discarded samples", static_cast<double>(discarded), "samples");
+    state.report("trigger mismatches", static_cast<double>((triggers != expectedTriggers ? 1 : 0) + (kept + discarded != ticks ? 1 : 0) + (kept != expectedTriggers * 201 ? 1 : 0)), "errors");
+}
@@ -0,0 +1,128 @@
+#include "Benchmark.h"
+
+#include "Configuration.h"
+#include "resource_helpers.h"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <unordered_set>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    // MemoryField before the names were interned
+    struct LegacyMemoryField
+    {
+        std::string name;
+        MemoryFieldType type;
+        bool isPointer;
+        std::string jsonName;
+        std::string firstParameterType;
+        std::string secondParameterType;
+        std::string comment;
+        size_t numberOfElements;
+        size_t columns;
+        size_t size;
+    };
+
+    // heap memory used by the string, strings short enough for small string optimization don't allocate
+    size_t stringHeapSize(const std::string& str)
+    {
+        return str.capacity() > std::string{}.capacity() ? str.capacity() + 1 : 0;
+    }
+
+    std::vector<const std::vector<MemoryField>*> allStructs(Configuration& config)
+    {
+        std::vector<const std::vector<MemoryField>*> structs;
+        std::ifstream file(resourcesDirectory() / "Spelunky2.json");
+        auto json = nlohmann::ordered_json::parse(file, nullptr, true, true);
+        for (auto& [key, value] : json["fields"].items())
+        {
+            if (auto type = Configuration::getBuiltInType(key); type != MemoryFieldType::None)
+                structs.push_back(&config.typeFields(type));
+            else
+                structs.push_back(&config.typeFieldsOfDefaultStruct(key));
+        }
+        for (auto& [key, value] : config.entityClassHierarchy())
+            structs.push_back(&config.typeFieldsOfEntitySubclass(key));
+
+        return structs;
+    }
+} // namespace
+
+S2_BENCHMARK(MemoryFieldLayout)
+{
+    auto config = Configuration::get();
+    if (config == nullptr)
+        return;
+
+    auto structs = allStructs(*config);
+    size_t fieldCount = 0;
+    size_t legacyHeap = 0;
+    std::unordered_set<uint32_t> uniqueNames;
+    size_t internedHeap = 0;
+    std::vector<std::string> jsonNames;
+    for (auto fields : structs)
+    {
+        for (auto& field : *fields)
+        {
+            ++fieldCount;
+            for (auto str : {field.name, field.jsonName, field.firstParameterType, field.secondParameterType, field.comment})
+            {
+                legacyHeap += stringHeapSize(std::string{str.str()});
+                if (uniqueNames.insert(str.id()).second)
+                    internedHeap += sizeof(std::string) + stringHeapSize(str.str());
+            }
+            jsonNames.emplace_back(field.jsonName.empty() ? field.firstParameterType.str() : field.jsonName.str());
+        }
+    }
+    state.report("fields in json", static_cast<double>(fieldCount), "fields");
+    state.report("sizeof(MemoryField) before", sizeof(LegacyMemoryField), "bytes");
+    state.report("sizeof(MemoryField) after", sizeof(MemoryField), "bytes");
+    state.report("all fields before", static_cast<double>(fieldCount * sizeof(LegacyMemoryField) + legacyHeap) / 1024.0, "KiB");
+    state.report("all fields after (incl. interned strings)", static_cast<double>(fieldCount * sizeof(MemoryField) + internedHeap) / 1024.0, "KiB");
+
+    // the type checks done for every row in the tree views
+    std::unordered_set<std::string> legacyStructs;
+    std::vector<std::string> legacyPointerTypes;
+    for (auto& name : jsonNames)
+    {
+        if (config->isJsonStruct(name))
+            legacyStructs.insert(name);
+        if (config->isPermanentPointer(name))
+            legacyPointerTypes.push_back(name);
+    }
+    state.measure("isJsonStruct + isPermanentPointer, all fields, string hash (before)", 10,
+                  [&]()
+                  {
+                      for (auto& name : jsonNames)
+                      {
+                          S2Benchmark::doNotOptimize(legacyStructs.find(name) != legacyStructs.end());
+                          S2Benchmark::doNotOptimize(std::find(legacyPointerTypes.begin(), legacyPointerTypes.end(), name) != legacyPointerTypes.end());
+                      }
+                  });
+    state.measure("isJsonStruct + isPermanentPointer, all fields, interned (after)", 10,
+                  [&]()
+                  {
+                      for (auto fields : structs)
+                      {
+                          for (auto& field : *fields)
+                          {
+                              auto& type = field.jsonName.empty() ? field.firstParameterType : field.jsonName;
+                              S2Benchmark::doNotOptimize(config->isJsonStruct(type));
+                              S2Benchmark::doNotOptimize(config->isPermanentPointer(type));
+                          }
+                      }
+                  });
+    state.measure("copy all fields", 10,
+                  [&]()
+                  {
+                      for (auto fields : structs)
+                      {
+                          std::vector<MemoryField> copy = *fields;
+                          S2Benchmark::doNotOptimize(copy.size());
+                      }
+                  });
+}
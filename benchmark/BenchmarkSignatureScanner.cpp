@@ -0,0 +1,338 @@
+#include "Benchmark.h"
+
+#include "LookupCache.h"
+#include "MemorySource/SyntheticMemorySource.h"
+#include "SignatureScanner.h"
+#include "read_helpers.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    constexpr uintptr_t gsCodeBase = 0x140001000;
+    constexpr size_t gsCodeSize = 40ull * 1024 * 1024;
+
+    struct TestSignature
+    {
+        const char* pattern;
+        int32_t displacementOffset;
+        int32_t instructionEnd;
+        bool hasTarget;
+    };
+    // same as the lookups in Lookup.cpp
+    constexpr TestSignature gsSignatures[] = {
+        {"C6 80 39 01 00 00 00 48", 10, 14, true},
+        {"A4 84 E4 CA DA BF 4E 83", -30, -26, true},
+        {"4C 89 C6 41 89 CF 8B 1D", 8, 12, true},
+        {"48 8B 05 ?? ?? ?? ?? 80 B8 00 02 00 00 FF", 3, 7, true},
+        {"FE FF FF FF 66 C7 05", 7, 13, true},
+        {"48 6B C3 2C 48 8D 15 ?? ?? ?? ?? 48", 7, 11, true},
+        {"48 8D 15 ?? ?? ?? ?? 4C 8B 0C CA", 3, 7, true},
+        {"48 8D 0D ?? ?? ?? ?? 48 89 0D ?? ?? ?? ?? 48 C7 05", 3, 7, true},
+        {"C6 00 00 48 C7 40 18 00 00 00 00", 0, 0, false},
+        {"41 C6 47 6B 01", 0, 0, false},
+        {"90 83 C1 FF", 6, 10, true},
+        {"F3 41 0F 11 47 38 8B 05", 8, 12, true},
+    };
+
+    // bytes with roughly the distribution of x86-64 code, a lot of REX prefixes, movs and zeros
+    std::vector<uint8_t> makeCodeImage(size_t size)
+    {
+        static const uint8_t common[] = {0x00, 0x00, 0x00, 0x48, 0x48, 0x8B, 0x89, 0x0F, 0xFF, 0xCC, 0x41, 0x4C, 0x8D, 0xE8, 0x24, 0x83, 0xC3, 0x90};
+        std::vector<uint8_t> code(size);
+        uint64_t x = 0x9E3779B97F4A7C15ull;
+        for (auto& b : code)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            b = (x >> 8) % 10 < 4 ? common[(x >> 16) % sizeof(common)] : static_cast<uint8_t>(x >> 24);
+        }
+        return code;
+    }
+
+    std::vector<uint8_t> makeRandomImage(size_t size, uint64_t seed)
+    {
+        std::vector<uint8_t> data(size);
+        uint64_t x = seed;
+        for (auto& b : data)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            b = static_cast<uint8_t>(x >> 24);
+        }
+        return data;
+    }
+
+    size_t naiveFind(const BytePattern& pattern, const uint8_t* data, size_t size)
+    {
+        for (size_t i = 0; i + pattern.size() <= size; ++i)
+            if (pattern.matches(data + i))
+                return i;
+
+        return BytePattern::npos;
+    }
+
+    // how x64dbg's FindMem works: the range is read from the debuggee into a buffer and searched byte by byte
+    uintptr_t findMem(const std::vector<uint8_t>& memory, std::vector<uint8_t>& buffer, const BytePattern& pattern)
+    {
+        std::memcpy(buffer.data(), memory.data(), memory.size());
+        for (size_t i = 0; i + pattern.size() <= buffer.size(); ++i)
+            if (pattern.matches(buffer.data() + i))
+                return gsCodeBase + i;
+
+        return 0;
+    }
+} // namespace
+
+S2_BENCHMARK(SignatureScan)
+{
+    auto memory = makeCodeImage(gsCodeSize);
+    // signatures spread over the last quarter of the image, the lookups are in the code after the bundle
+    constexpr size_t signatureCount = sizeof(gsSignatures) / sizeof(gsSignatures[0]);
+    std::vector<BytePattern> patterns(signatureCount);
+    for (size_t i = 0; i < signatureCount; ++i)
+    {
+        patterns[i].parse(gsSignatures[i].pattern);
+        size_t at = gsCodeSize - gsCodeSize / 4 + i * (gsCodeSize / 4 / signatureCount);
+        for (size_t b = 0; b < patterns[i].size(); ++b)
+            if (patterns[i].mask[b] != 0)
+                memory[at + b] = patterns[i].bytes[b];
+    }
+
+    std::vector<uint8_t> buffer(memory.size());
+    // before: every lookup does its own FindMem over the whole range
+    auto findEach = [&]()
+    {
+        std::vector<uintptr_t> targets(signatureCount, 0);
+        for (size_t i = 0; i < signatureCount; ++i)
+        {
+            auto match = findMem(memory, buffer, patterns[i]);
+            if (match == 0)
+                continue;
+
+            auto& signature = gsSignatures[i];
+            if (!signature.hasTarget)
+            {
+                targets[i] = match;
+                continue;
+            }
+            int32_t displacement;
+            std::memcpy(&displacement, memory.data() + (match - gsCodeBase) + signature.displacementOffset, sizeof(displacement));
+            targets[i] = match + signature.instructionEnd + displacement;
+        }
+        return targets;
+    };
+
+    // after: one copy, one pass for all the signatures
+    SignatureScanner scanner;
+    for (auto& signature : gsSignatures)
+    {
+        if (signature.hasTarget)
+            scanner.add(signature.pattern, signature.displacementOffset, signature.instructionEnd);
+        else
+            scanner.add(signature.pattern);
+    }
+    auto scanAll = [&](size_t threads)
+    {
+        std::memcpy(buffer.data(), memory.data(), memory.size());
+        scanner.scan(buffer.data(), buffer.size(), gsCodeBase, 0, threads);
+        std::vector<uintptr_t> targets(signatureCount, 0);
+        for (size_t i = 0; i < signatureCount; ++i)
+            targets[i] = gsSignatures[i].hasTarget ? scanner.target(i) : scanner.match(i);
+
+        return targets;
+    };
+
+    // at least 4 so the chunk split and merge are checked on small machines too
+    size_t threads = (std::max)(std::thread::hardware_concurrency(), 4u);
+    auto before = findEach();
+    auto parallel = scanAll(threads);
+    std::vector<std::chrono::nanoseconds> resolveTimes;
+    for (size_t i = 0; i < signatureCount; ++i)
+        resolveTimes.push_back(scanner.resolveTime(i));
+    auto after = scanAll(1);
+    size_t notFound = 0;
+    for (auto target : after)
+        notFound += target == 0 ? 1 : 0;
+    state.report("signatures", static_cast<double>(signatureCount), "signatures");
+    state.report("signatures not found", static_cast<double>(notFound), "signatures");
+    state.report("results mismatch", before == after ? 0.0 : 1.0, "bool");
+    state.report("results mismatch, threaded", before == parallel ? 0.0 : 1.0, "bool");
+    state.report("threads", static_cast<double>(threads), "threads");
+    for (size_t i = 0; i < signatureCount; ++i)
+        state.report("resolve time, threaded, signature " + std::to_string(i), std::chrono::duration<double, std::milli>(resolveTimes[i]).count(), "ms");
+    state.report("bytes copied, FindMem per signature", static_cast<double>(memory.size() * signatureCount), "bytes");
+    state.report("bytes copied, single pass", static_cast<double>(memory.size()), "bytes");
+
+    state.measure("resolve 12 signatures in 40 MB, FindMem each (before)", 1, [&]() { S2Benchmark::doNotOptimize(findEach()[0]); });
+    state.measure("resolve 12 signatures in 40 MB, single pass", 1, [&]() { S2Benchmark::doNotOptimize(scanAll(1)[0]); });
+    state.measure("resolve 12 signatures in 40 MB, single pass, threaded (after)", 1, [&]() { S2Benchmark::doNotOptimize(scanAll(threads)[0]); });
+}
+
+S2_BENCHMARK(LookupCacheStartup)
+{
+    // spel2.exe like module: PE header, then 7 MB of code with after_bundle and the signatures in the last part
+    constexpr uintptr_t moduleBase = 0x140000000;
+    constexpr uintptr_t codeStart = moduleBase + 0x1000;
+    constexpr size_t codeSize = 7ull * 1024 * 1024;
+    constexpr uint32_t ntHeadersOffset = 0x100;
+    constexpr char afterBundlePattern[] = "55 41 57 41 56 41 55 41 54";
+    constexpr size_t signatureCount = sizeof(gsSignatures) / sizeof(gsSignatures[0]);
+
+    auto memory = std::make_unique<S2Benchmark::CountingMemorySource>();
+    memory->map(moduleBase, 0x1000);
+    memory->write<uint32_t>(moduleBase + 0x3C, ntHeadersOffset);
+    memory->write<uint32_t>(moduleBase + ntHeadersOffset + 8, 0x5F3A1C2Du);
+    auto image = makeCodeImage(codeSize);
+    auto place = [&](const char* pattern, size_t at)
+    {
+        BytePattern bytes;
+        bytes.parse(pattern);
+        for (size_t b = 0; b < bytes.size(); ++b)
+            if (bytes.mask[b] != 0)
+                image[at + b] = bytes.bytes[b];
+    };
+    size_t afterBundleOffset = codeSize / 2;
+    place(afterBundlePattern, afterBundleOffset);
+    for (size_t i = 0; i < signatureCount; ++i)
+        place(gsSignatures[i].pattern, afterBundleOffset + 0x1000 + i * (codeSize / 2 / signatureCount));
+    std::memcpy(memory->map(codeStart, codeSize), image.data(), codeSize);
+    auto& counter = *memory;
+    MemorySource::set(std::move(memory));
+
+    auto cachePath = std::filesystem::temp_directory_path() / "s2benchmark_lookups.cache";
+    std::error_code ec;
+    std::filesystem::remove(cachePath, ec);
+
+    SignatureScanner scanner;
+    for (auto& signature : gsSignatures)
+    {
+        if (signature.hasTarget)
+            scanner.add(signature.pattern, signature.displacementOffset, signature.instructionEnd);
+        else
+            scanner.add(signature.pattern);
+    }
+    // what Spelunky2::get does: the cache key, then the cached locations probed or the full scan
+    auto cacheKey = [&]()
+    {
+        LookupCache::Key key;
+        key.timestamp = Read<uint32_t>(moduleBase + Read<uint32_t>(moduleBase + 0x3C) + 8);
+        std::vector<uint8_t> sample(0x2000 + sizeof(codeSize));
+        ReadMemory(codeStart, sample.data(), 0x1000);
+        ReadMemory(codeStart + codeSize - 0x1000, sample.data() + 0x1000, 0x1000);
+        std::memcpy(sample.data() + 0x2000, &codeSize, sizeof(codeSize));
+        key.codeHash = LookupCache::hashCode(sample.data(), sample.size());
+        return key;
+    };
+    auto fullScan = [&](const LookupCache::Key& key)
+    {
+        std::vector<uint8_t> code(codeSize);
+        ReadMemory(codeStart, code.data(), codeSize);
+        SignatureScanner afterBundleScanner;
+        auto afterBundleId = afterBundleScanner.add(afterBundlePattern);
+        afterBundleScanner.scan(code.data(), code.size(), codeStart);
+        auto afterBundle = afterBundleScanner.match(afterBundleId);
+        scanner.scan(code.data(), code.size(), codeStart, afterBundle - codeStart);
+
+        std::vector<uint32_t> rvas{static_cast<uint32_t>(afterBundle - moduleBase)};
+        for (size_t id = 0; id < signatureCount; ++id)
+            rvas.push_back(scanner.match(id) == 0 ? 0 : static_cast<uint32_t>(scanner.match(id) - moduleBase));
+        LookupCache::save(cachePath, key, rvas);
+        return afterBundle;
+    };
+    auto probeCached = [&](const LookupCache::Key& key) -> uintptr_t
+    {
+        std::vector<uint32_t> rvas;
+        if (!LookupCache::load(cachePath, key, rvas) || rvas.size() != signatureCount + 1)
+            return 0;
+
+        SignatureScanner afterBundleScanner;
+        auto afterBundleId = afterBundleScanner.add(afterBundlePattern);
+        if (!afterBundleScanner.probe(afterBundleId, moduleBase + rvas[0]))
+            return 0;
+
+        for (size_t id = 0; id < signatureCount; ++id)
+            if (rvas[id + 1] != 0 && !scanner.probe(id, moduleBase + rvas[id + 1]))
+                return 0;
+
+        return moduleBase + rvas[0];
+    };
+    auto targets = [&]()
+    {
+        std::vector<uintptr_t> result;
+        for (size_t id = 0; id < signatureCount; ++id)
+            result.push_back(gsSignatures[id].hasTarget ? scanner.target(id) : scanner.match(id));
+        return result;
+    };
+
+    counter.mReads = counter.mBytes = 0;
+    auto key = cacheKey();
+    auto scannedAfterBundle = fullScan(key);
+    auto scanned = targets();
+    state.report("reads, full scan", static_cast<double>(counter.mReads), "reads");
+    state.report("bytes read, full scan", static_cast<double>(counter.mBytes), "bytes");
+
+    counter.mReads = counter.mBytes = 0;
+    key = cacheKey();
+    auto cachedAfterBundle = probeCached(key);
+    auto cached = targets();
+    state.report("reads, cached and probed", static_cast<double>(counter.mReads), "reads");
+    state.report("bytes read, cached and probed", static_cast<double>(counter.mBytes), "bytes");
+    state.report("results mismatch", scannedAfterBundle == cachedAfterBundle && scanned == cached ? 0.0 : 1.0, "bool");
+
+    // a different build of the game has a different timestamp, falls back to the full scan
+    auto otherBuild = key;
+    ++otherBuild.timestamp;
+    state.report("other build uses the cache", probeCached(otherBuild) != 0 ? 1.0 : 0.0, "bool");
+
+    state.measure("resolve lookups at attach, full scan (before)", 1, [&]() { S2Benchmark::doNotOptimize(fullScan(cacheKey())); });
+    state.measure("resolve lookups at attach, cached (after)", 20, [&]() { S2Benchmark::doNotOptimize(probeCached(cacheKey())); });
+
+    std::filesystem::remove(cachePath, ec);
+    MemorySource::set(nullptr);
+}
+
+S2_BENCHMARK(PatternFind)
+{
+    constexpr PatternEngine engines[] = {PatternEngine::Scalar, PatternEngine::SSE2, PatternEngine::AVX2};
+    constexpr const char* engineNames[] = {"scalar", "sse2", "avx2"};
+
+    // results of the engines are checked against the naive matcher in tests/TestBytePattern.cpp
+    state.report("avx2 supported", BytePattern::bestEngine() == PatternEngine::AVX2 ? 1.0 : 0.0, "bool");
+
+    // the pattern only at the end, the whole stream is searched
+    constexpr size_t streamSize = 8ull * 1024 * 1024;
+    struct Stream
+    {
+        const char* name;
+        std::vector<uint8_t> data;
+    };
+    Stream streams[] = {{"random", makeRandomImage(streamSize, 0x9E3779B97F4A7C15ull)}, {"x86-64", makeCodeImage(streamSize)}};
+    constexpr const char* patterns[] = {"48 8B 05 ?? ?? ?? ?? 80 B8 00 02 00 00 FF", "F3 41 0F 11 47 38 8B 05"};
+    for (auto& stream : streams)
+    {
+        for (auto text : patterns)
+        {
+            BytePattern pattern;
+            pattern.parse(text);
+            for (size_t b = 0; b < pattern.size(); ++b)
+                if (pattern.mask[b] != 0)
+                    stream.data[streamSize - pattern.size() + b] = pattern.bytes[b];
+
+            std::string label = std::string{"find "} + std::to_string(pattern.size()) + " byte pattern in 8 MB " + stream.name + ", ";
+            state.measure(label + "naive (before)", 1, [&]() { S2Benchmark::doNotOptimize(naiveFind(pattern, stream.data.data(), streamSize)); });
+            for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e)
+                state.measure(label + engineNames[e], 1, [&]() { S2Benchmark::doNotOptimize(pattern.find(stream.data.data(), streamSize, engines[e])); });
+        }
+    }
+}
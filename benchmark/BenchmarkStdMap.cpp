@@ -0,0 +1,158 @@
+#include "Benchmark.h"
+
+#include "Data/StdMap.h"
+#include "Data/StdMapSnapshot.h"
+#include "MemorySource/SyntheticMemorySource.h"
+#include "read_helpers.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    constexpr uintptr_t gsMapAddr = 0x10000000;
+    constexpr uintptr_t gsHeapBase = 0x20000000;
+    constexpr uint32_t gsNodeCount = 100000;
+    // like the entities_by_mask map: uint32 key and 24 byte value (EntityList), key at 0x20 and value at 0x28
+    constexpr size_t gsNodeSize = 0x40;
+
+    struct Value
+    {
+        uint64_t data[3];
+    };
+
+    // counts the reads that would go to the debugger, the x64dbg source does every request of a bulk read separately
+    // MSVC _Tree image: head node with the root as parent and the leftmost/rightmost as left/right, nil children point at the head
+    // nodes are allocated in random order over the heap, the tree is balanced (the red/black colors are not used by the readers)
+    void buildMap(SyntheticMemorySource& memory)
+    {
+        uintptr_t head = gsHeapBase;
+        memory.map(gsMapAddr, 0x10);
+        memory.map(gsHeapBase, (gsNodeCount + 1) * gsNodeSize);
+        memory.write<uintptr_t>(gsMapAddr, head);
+        memory.write<uint64_t>(gsMapAddr + 8, gsNodeCount);
+        memory.write<uint8_t>(head + 0x19, 1);
+
+        // node of the n-th key, in allocation order
+        std::vector<uint32_t> slots(gsNodeCount);
+        std::iota(slots.begin(), slots.end(), 1u);
+        std::shuffle(slots.begin(), slots.end(), std::mt19937{1234});
+        auto nodeAddr = [&slots](size_t keyIndex) { return gsHeapBase + slots[keyIndex] * gsNodeSize; };
+
+        // builds subtree of the keys [begin, end) under parent, returns its root
+        auto build = [&](auto& self, size_t begin, size_t end, uintptr_t parent) -> uintptr_t
+        {
+            if (begin >= end)
+                return head;
+
+            size_t middle = begin + (end - begin) / 2;
+            uintptr_t node = nodeAddr(middle);
+            memory.write<uintptr_t>(node + 0x8, parent);
+            memory.write<uintptr_t>(node, self(self, begin, middle, node));
+            memory.write<uintptr_t>(node + 0x10, self(self, middle + 1, end, node));
+            memory.write<uint32_t>(node + 0x20, static_cast<uint32_t>(middle * 3 + 7));
+            memory.write<Value>(node + 0x28, Value{{middle, middle * 2, middle * 3}});
+            return node;
+        };
+        memory.write<uintptr_t>(head + 0x8, build(build, 0, gsNodeCount, head));
+        memory.write<uintptr_t>(head, nodeAddr(0));
+        memory.write<uintptr_t>(head + 0x10, nodeAddr(gsNodeCount - 1));
+    }
+
+    struct Entry
+    {
+        uint32_t key;
+        uintptr_t valuePtr;
+        Value value;
+    };
+
+    // what the views did: StdMap iterator, few reads per node and step
+    std::vector<Entry> iterateStdMap()
+    {
+        std::vector<Entry> entries;
+        StdMap<uint32_t, Value> map{gsMapAddr};
+        for (auto it = map.begin(); it != map.end(); ++it)
+            entries.push_back(Entry{it.key(), it.value_ptr(), it.value()});
+
+        return entries;
+    }
+
+    std::vector<Entry> readSnapshot()
+    {
+        std::vector<Entry> entries;
+        StdMapSnapshot map{sizeof(uint32_t), alignof(uint32_t), sizeof(Value), alignof(Value)};
+        map.read(gsMapAddr);
+        entries.reserve(map.size());
+        for (size_t i = 0; i < map.size(); ++i)
+            entries.push_back(Entry{map.key<uint32_t>(i), map.valuePtr(i), map.value<Value>(i)});
+
+        return entries;
+    }
+
+    bool operator==(const Entry& a, const Entry& b)
+    {
+        return a.key == b.key && a.valuePtr == b.valuePtr && std::memcmp(&a.value, &b.value, sizeof(Value)) == 0;
+    }
+} // namespace
+
+S2_BENCHMARK(StdMapRead)
+{
+    auto memory = std::make_unique<S2Benchmark::CountingMemorySource>();
+    buildMap(*memory);
+    auto counting = memory.get();
+    MemorySource::set(std::move(memory));
+
+    // 100 lookups, half of them keys that are not in the map
+    std::vector<uint32_t> lookups;
+    for (uint32_t i = 0; i < 100; ++i)
+        lookups.push_back(i % 2 == 0 ? (i * 997 % gsNodeCount) * 3 + 7 : i * 997 * 3 + 8);
+
+    auto findStdMap = [&lookups]()
+    {
+        StdMap<uint32_t, Value> map{gsMapAddr};
+        size_t found = 0;
+        for (auto key : lookups)
+            found += map.find(key) != map.end() ? 1 : 0;
+        return found;
+    };
+    StdMapSnapshot snapshot{sizeof(uint32_t), alignof(uint32_t), 0, alignof(Value)};
+    auto findSnapshot = [&lookups, &snapshot]()
+    {
+        size_t found = 0;
+        for (auto key : lookups)
+            found += snapshot.find(key) != StdMapSnapshot::npos ? 1 : 0;
+        return found;
+    };
+
+    snapshot.read(gsMapAddr);
+    auto before = iterateStdMap();
+    auto after = readSnapshot();
+    state.report("nodes", static_cast<double>(after.size()), "nodes");
+    state.report("results mismatch", before == after ? 0.0 : 1.0, "bool");
+    state.report("find results mismatch", findStdMap() == findSnapshot() && findStdMap() == lookups.size() / 2 ? 0.0 : 1.0, "bool");
+
+    counting->mReads = 0;
+    iterateStdMap();
+    state.report("memory reads, iterate StdMap", static_cast<double>(counting->mReads), "reads");
+    counting->mReads = 0;
+    readSnapshot();
+    state.report("memory reads, StdMapSnapshot", static_cast<double>(counting->mReads), "reads");
+    counting->mReads = 0;
+    findStdMap();
+    state.report("memory reads, 100 finds StdMap", static_cast<double>(counting->mReads), "reads");
+    counting->mReads = 0;
+    findSnapshot();
+    state.report("memory reads, 100 finds StdMapSnapshot (already read)", static_cast<double>(counting->mReads), "reads");
+
+    state.measure("key/value of 100k node map, StdMap iterator (before)", 1, []() { S2Benchmark::doNotOptimize(iterateStdMap().size()); });
+    state.measure("key/value of 100k node map, StdMapSnapshot (after)", 1, []() { S2Benchmark::doNotOptimize(readSnapshot().size()); });
+    state.measure("100 finds in 100k node map, StdMap", 10, [&findStdMap]() { S2Benchmark::doNotOptimize(findStdMap()); });
+    state.measure("100 finds in 100k node map, StdMapSnapshot (already read)", 10, [&findSnapshot]() { S2Benchmark::doNotOptimize(findSnapshot()); });
+
+    MemorySource::set(nullptr);
+}
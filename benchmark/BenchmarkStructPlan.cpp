@@ -0,0 +1,157 @@
+#include "Benchmark.h"
+
+#include "Configuration.h"
+#include "MemorySource/SyntheticMemorySource.h"
+#include "ReadCache.h"
+#include "ReadPlan.h"
+#include "StructPlan.h"
+#include "read_helpers.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    constexpr uintptr_t gsDatabaseBase = 0x30000000;
+    constexpr uint32_t gsRecordCount = 1000;
+
+    // raw bits of the decoded value, integer sum does not depend on the order the fields are added in
+    template <typename T>
+    uint64_t checksum(T value)
+    {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(T));
+        return bits;
+    }
+
+    // how the views decode a field today, size and type switch for every field
+    uint64_t readField(const MemoryField& field, uintptr_t addr)
+    {
+        switch (field.type)
+        {
+            case MemoryFieldType::Byte:
+            case MemoryFieldType::State8:
+                return checksum(Read<int8_t>(addr));
+            case MemoryFieldType::UnsignedByte:
+            case MemoryFieldType::Flags8:
+            case MemoryFieldType::CharacterDBID:
+                return checksum(Read<uint8_t>(addr));
+            case MemoryFieldType::Word:
+            case MemoryFieldType::State16:
+                return checksum(Read<int16_t>(addr));
+            case MemoryFieldType::UnsignedWord:
+            case MemoryFieldType::Flags16:
+            case MemoryFieldType::UTF16Char:
+                return checksum(Read<uint16_t>(addr));
+            case MemoryFieldType::Dword:
+            case MemoryFieldType::State32:
+            case MemoryFieldType::TextureDBID:
+                return checksum(Read<int32_t>(addr));
+            case MemoryFieldType::UnsignedDword:
+            case MemoryFieldType::Flags32:
+            case MemoryFieldType::ParticleDBID:
+            case MemoryFieldType::EntityDBID:
+            case MemoryFieldType::StringsTableID:
+                return checksum(Read<uint32_t>(addr));
+            case MemoryFieldType::Qword:
+                return checksum(Read<int64_t>(addr));
+            case MemoryFieldType::UnsignedQword:
+                return checksum(Read<uint64_t>(addr));
+            case MemoryFieldType::Float:
+                return checksum(Read<float>(addr));
+            case MemoryFieldType::Double:
+                return checksum(Read<double>(addr));
+            case MemoryFieldType::Bool:
+                return checksum(Read<uint8_t>(addr) != 0);
+            default:
+                return 0;
+        }
+    }
+
+    uint64_t readFields(Configuration& config, const std::vector<MemoryField>& fields, uintptr_t addr)
+    {
+        uint64_t sum = 0;
+        for (auto& field : fields)
+        {
+            if (field.isPointer)
+                sum += checksum(Read<uintptr_t>(addr));
+            else if (field.type == MemoryFieldType::DefaultStructType)
+                sum += readFields(config, config.typeFieldsOfDefaultStruct(field.jsonName), addr);
+            else if (auto& children = config.typeFields(field.type); !children.empty())
+                sum += readFields(config, children, addr);
+            else if (field.type != MemoryFieldType::Skip)
+                sum += readField(field, addr);
+
+            addr += field.get_size();
+        }
+        return sum;
+    }
+} // namespace
+
+S2_BENCHMARK(StructPlanDecode)
+{
+    auto config = Configuration::get();
+    if (config == nullptr)
+        return;
+
+    auto& fields = config->typeFields(MemoryFieldType::EntityDB);
+    auto& plans = config->structPlans();
+    auto planId = config->structPlanId(fields);
+    if (planId == StructPlans::noPlan)
+        return;
+
+    size_t recordSize = plans.plan(planId).size;
+    size_t databaseSize = recordSize * gsRecordCount;
+    auto memory = std::make_unique<S2Benchmark::CountingMemorySource>();
+    memory->map(gsDatabaseBase, (databaseSize + ReadCache::pageSize - 1) & ~(ReadCache::pageSize - 1));
+    for (size_t offset = 0; offset + sizeof(uint32_t) <= databaseSize; offset += sizeof(uint32_t))
+        memory->write<uint32_t>(gsDatabaseBase + offset, static_cast<uint32_t>(offset * 2654435761u) & 0x7F7F7F7F);
+    auto& counter = *memory;
+    MemorySource::set(std::move(memory));
+
+    size_t fieldCount = 0;
+    std::vector<uint8_t> record(recordSize);
+    plans.forEachField(planId, record.data(), record.size(), [&](const StructPlanInstruction&, size_t, const uint8_t*) { ++fieldCount; });
+    state.report("EntityDB record size", static_cast<double>(recordSize), "bytes");
+    state.report("EntityDB decoded fields per record", static_cast<double>(fieldCount), "fields");
+
+    // before: every field read on its own (thru the page cache) and decoded by a type switch
+    auto decodeFields = [&]()
+    {
+        ReadCache::Scope readCacheScope;
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < gsRecordCount; ++i)
+            sum += readFields(*config, fields, gsDatabaseBase + i * recordSize);
+        return sum;
+    };
+    // after: all records in one bulk read, the compiled plan executed over the buffer
+    ReadPlan readPlan;
+    for (uint32_t i = 0; i < gsRecordCount; ++i)
+        readPlan.add(gsDatabaseBase + i * recordSize, recordSize);
+    readPlan.build(0x1000, 0x100000);
+    auto decodePlan = [&]()
+    {
+        readPlan.execute();
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < gsRecordCount; ++i)
+            plans.forEachField(planId, readPlan.data(i), recordSize,
+                               [&sum](const StructPlanInstruction& instruction, size_t, const uint8_t* data)
+                               { decodeField(instruction.decoder, data, [&sum](auto value) { sum += checksum(value); }); });
+        return sum;
+    };
+
+    counter.mReads = 0;
+    auto before = decodeFields();
+    state.report("reads per decode, per field", static_cast<double>(counter.mReads), "reads");
+    counter.mReads = 0;
+    auto after = decodePlan();
+    state.report("reads per decode, struct plan", static_cast<double>(counter.mReads), "reads");
+    state.report("checksum mismatch", before == after ? 0.0 : 1.0, "bool");
+
+    state.measure("decode 1000 EntityDB records, per field (before)", 20, [&]() { S2Benchmark::doNotOptimize(decodeFields()); });
+    state.measure("decode 1000 EntityDB records, struct plan (after)", 20, [&]() { S2Benchmark::doNotOptimize(decodePlan()); });
+
+    MemorySource::set(nullptr);
+}
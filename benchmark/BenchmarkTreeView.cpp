@@ -0,0 +1,312 @@
+#include "Benchmark.h"
+
+#include "Configuration.h"
+#include "Data/Entity.h"
+#include "MemorySource/SyntheticMemorySource.h"
+#include "ReadCache.h"
+#include "RowRefresh.h"
+#include "SnapshotDiff.h"
+#include "StructPlan.h"
+#include "read_helpers.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    constexpr uintptr_t gsStructBase = 0x20000000;
+
+    // bytes the value of the row is read from, the flag rows show the bits of the parent
+    size_t rowSize(const RowRefresh::Row& row)
+    {
+        auto size = row.isPointer ? sizeof(uintptr_t) : Configuration::getBuiltInTypeSize(row.type);
+        return (std::min)((std::max)(size, size_t{1}), sizeof(uint64_t));
+    }
+
+    uint64_t readRow(const RowRefresh::Row& row)
+    {
+        uint64_t value = 0;
+        ReadMemory(row.address, &value, rowSize(row));
+        return value;
+    }
+
+    // the rows of the struct with every inline struct and the flags expanded, from the compiled plan
+    // returns the size of the struct
+    size_t planRows(const Configuration& config, const std::vector<MemoryField>& fields, uintptr_t addr, std::vector<RowRefresh::Row>& rows)
+    {
+        auto& plans = config.structPlans();
+        auto planId = config.structPlanId(fields);
+        if (planId == StructPlans::noPlan)
+            return 0;
+
+        std::vector<uint8_t> layout(plans.plan(planId).size);
+        plans.forEachField(planId, layout.data(), layout.size(),
+                           [&](const StructPlanInstruction& instruction, size_t offset, const uint8_t*)
+                           {
+                               RowRefresh::Row row;
+                               row.type = instruction.field->type;
+                               row.address = addr + offset;
+                               row.isPointer = instruction.field->isPointer;
+                               rows.push_back(row);
+                               if (row.isPointer)
+                                   return;
+
+                               size_t flags = 0;
+                               switch (row.type)
+                               {
+                                   case MemoryFieldType::Flags32:
+                                   case MemoryFieldType::Flags16:
+                                   case MemoryFieldType::Flags8:
+                                       flags = instruction.size * 8;
+                                       break;
+                                   default:
+                                       break;
+                               }
+                               row.type = MemoryFieldType::Flag;
+                               rows.insert(rows.end(), flags, row);
+                           });
+        return layout.size();
+    }
+
+    // value and text the tree item shows
+    struct ShownRow
+    {
+        uint64_t value{0};
+        bool stale{false};
+        char text[24]{};
+    };
+
+    void updateShownRow(const RowRefresh::Row& row, ShownRow& shown)
+    {
+        auto value = readRow(row);
+        if (value != shown.value)
+        {
+            shown.value = value;
+            std::snprintf(shown.text, sizeof(shown.text), "0x%016llX", static_cast<unsigned long long>(value));
+        }
+        shown.stale = false;
+    }
+} // namespace
+
+S2_BENCHMARK(TreeViewSnapshotDiff)
+{
+    auto config = Configuration::get();
+    if (config == nullptr)
+        return;
+
+    std::vector<RowRefresh::Row> rows;
+    size_t structSize = planRows(*config, config->typeFields(MemoryFieldType::State), gsStructBase, rows);
+    if (structSize == 0)
+        return;
+
+    auto memory = std::make_unique<S2Benchmark::CountingMemorySource>();
+    memory->map(gsStructBase, (structSize + ReadCache::pageSize - 1) & ~(ReadCache::pageSize - 1));
+    auto& counter = *memory;
+    MemorySource::set(std::move(memory));
+
+    // a game frame changes a small part of the struct, every 100th row here
+    uint32_t frame = 0;
+    auto nextFrame = [&]()
+    {
+        ++frame;
+        for (size_t i = frame % 100; i < rows.size(); i += 100)
+            counter.write<uint8_t>(rows[i].address, static_cast<uint8_t>(frame + i));
+    };
+
+    // before: every row read and compared with the value it shows
+    std::vector<uint64_t> shown(rows.size());
+    size_t touched = 0;
+    auto refreshAll = [&]()
+    {
+        ReadCache::Scope readCacheScope;
+        touched = 0;
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            ++touched;
+            auto value = readRow(rows[i]);
+            if (value != shown[i])
+                shown[i] = value;
+        }
+    };
+    // after: the struct is read at once, rows the RowRefresh skips are not touched
+    SnapshotDiff snapshot;
+    auto refreshDiff = [&]()
+    {
+        ReadCache::Scope readCacheScope;
+        touched = 0;
+        RowRefresh refresh;
+        if (snapshot.update(gsStructBase, structSize))
+        {
+            snapshot.primeReadCache();
+            refresh.snapshot = &snapshot;
+        }
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            if (refresh.action(rows[i]) == RowRefreshAction::Skip)
+                continue;
+
+            ++touched;
+            auto value = readRow(rows[i]);
+            if (value != shown[i])
+                shown[i] = value;
+        }
+    };
+
+    size_t valueRows = 0;
+    for (auto& row : rows)
+        valueRows += RowRefresh::isValueOnly(row) ? 1 : 0;
+    state.report("State size", static_cast<double>(structSize), "bytes");
+    state.report("State rows", static_cast<double>(rows.size()), "rows");
+    state.report("State rows showing just their own bytes", static_cast<double>(valueRows), "rows");
+
+    refreshAll();
+    nextFrame();
+    counter.mReads = 0;
+    refreshAll();
+    state.report("reads per refresh, every row", static_cast<double>(counter.mReads), "reads");
+    state.report("rows touched per refresh, every row", static_cast<double>(touched), "rows");
+
+    refreshDiff();
+    nextFrame();
+    counter.mReads = 0;
+    refreshDiff();
+    state.report("reads per refresh, snapshot diff", static_cast<double>(counter.mReads), "reads");
+    state.report("rows touched per refresh, snapshot diff", static_cast<double>(touched), "rows");
+
+    // verify the shown values against the memory
+    size_t errors = 0;
+    for (size_t i = 0; i < rows.size(); ++i)
+        errors += shown[i] != readRow(rows[i]) ? 1 : 0;
+    state.report("stale rows", static_cast<double>(errors), "rows");
+    // no wall time here, the loops above only stand in for updateRow to count the rows and reads
+
+    MemorySource::set(nullptr);
+}
+
+S2_BENCHMARK(TreeViewVisibleRows)
+{
+    auto config = Configuration::get();
+    if (config == nullptr)
+        return;
+
+    // fully expanded Player, every class of the hierarchy
+    std::vector<RowRefresh::Row> rows;
+    size_t entitySize = 0;
+    auto hierarchy = Entity::classHierarchy("Player");
+    for (auto it = hierarchy.rbegin(); it != hierarchy.rend(); ++it)
+        entitySize += planRows(*config, config->typeFieldsOfEntitySubclass(*it), gsStructBase + entitySize, rows);
+    if (rows.empty())
+        return;
+
+    auto memory = std::make_unique<S2Benchmark::CountingMemorySource>();
+    memory->map(gsStructBase, (entitySize + ReadCache::pageSize - 1) & ~(ReadCache::pageSize - 1));
+    auto& counter = *memory;
+    MemorySource::set(std::move(memory));
+
+    // a game frame changes every 10th row
+    uint32_t frame = 0;
+    auto nextFrame = [&]()
+    {
+        ++frame;
+        for (size_t i = frame % 10; i < rows.size(); i += 10)
+            counter.write<uint8_t>(rows[i].address, static_cast<uint8_t>(frame + i));
+    };
+
+    // 40 rows of 20 pixels on screen
+    constexpr int viewportHeight = 800;
+    constexpr int rowHeight = 20;
+    auto visible = VisibleRowRange::around(0, viewportHeight, rowHeight);
+
+    std::vector<ShownRow> shown(rows.size());
+    size_t touched = 0;
+    // what updateTree does with the rows, without the snapshot so only the culling is measured
+    auto refresh = [&](bool cull)
+    {
+        ReadCache::Scope readCacheScope;
+        touched = 0;
+        RowRefresh rowRefresh;
+        rowRefresh.cull = cull;
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            auto row = rows[i];
+            row.stale = shown[i].stale;
+            row.visible = visible.contains(i);
+            if (rowRefresh.action(row) == RowRefreshAction::Cull)
+            {
+                shown[i].stale = true;
+                continue;
+            }
+            ++touched;
+            updateShownRow(row, shown[i]);
+        }
+    };
+    // before: every row of the expanded tree updated each tick
+    auto refreshAll = [&]() { refresh(false); };
+    // after: rows out of the view only marked stale
+    auto refreshVisible = [&]() { refresh(true); };
+    // scrolling updates the stale rows that came into the view, refreshStaleRows
+    auto scrollTo = [&](size_t row)
+    {
+        ReadCache::Scope readCacheScope;
+        visible = VisibleRowRange::around(row, viewportHeight, rowHeight);
+        for (size_t i = visible.begin; i < visible.end && i < rows.size(); ++i)
+        {
+            if (shown[i].stale)
+                updateShownRow(rows[i], shown[i]);
+        }
+    };
+
+    // 100 ms auto refresh, cpu time spent refreshing per second
+    auto cpuUsage = [&](auto&& refresh)
+    {
+        constexpr int ticks = 200;
+        auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; ++tick)
+        {
+            nextFrame();
+            refresh();
+        }
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return milliseconds * 1000.0 / ticks * 10.0;
+    };
+
+    state.report("Player expanded rows", static_cast<double>(rows.size()), "rows");
+    state.report("rows kept updated around the view", static_cast<double>(visible.end - visible.begin), "rows");
+    refreshAll();
+    state.report("rows updated per tick, every row", static_cast<double>(touched), "rows");
+    refreshVisible();
+    state.report("rows updated per tick, visible rows", static_cast<double>(touched), "rows");
+    state.report("auto-refresh cpu at 100 ms, every row (before)", cpuUsage(refreshAll), "us/s");
+    state.report("auto-refresh cpu at 100 ms, visible rows (after)", cpuUsage(refreshVisible), "us/s");
+
+    // scroll thru the whole tree, every row has to show the current value once it is in the view
+    size_t errors = 0;
+    size_t pageRows = static_cast<size_t>(viewportHeight / rowHeight);
+    for (size_t row = 0; row < rows.size(); row += pageRows)
+    {
+        scrollTo(row);
+        for (size_t i = row; i < rows.size() && i < row + pageRows; ++i)
+            errors += shown[i].stale || shown[i].value != readRow(rows[i]) ? 1 : 0;
+    }
+    state.report("stale rows in view after scrolling", static_cast<double>(errors), "rows");
+    visible = VisibleRowRange::around(0, viewportHeight, rowHeight);
+
+    state.measure("refresh Player, every row (before)", 100,
+                  [&]()
+                  {
+                      nextFrame();
+                      refreshAll();
+                  });
+    state.measure("refresh Player, visible rows (after)", 100,
+                  [&]()
+                  {
+                      nextFrame();
+                      refreshVisible();
+                  });
+
+    MemorySource::set(nullptr);
+}
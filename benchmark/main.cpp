@@ -0,0 +1,68 @@
+#include "Benchmark.h"
+
+#include "resource_helpers.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+static void printResult(const S2Benchmark::Result& result)
+{
+    auto formatTime = [](double ns, char* buffer, size_t size)
+    {
+        if (ns >= 1e6)
+            std::snprintf(buffer, size, "%10.3f ms", ns / 1e6);
+        else if (ns >= 1e3)
+            std::snprintf(buffer, size, "%10.3f us", ns / 1e3);
+        else
+            std::snprintf(buffer, size, "%10.3f ns", ns);
+    };
+    if (!result.unit.empty())
+    {
+        std::printf("    %-60s %14.2f %s\n", result.label.c_str(), result.min, result.unit.c_str());
+        return;
+    }
+    char min[32];
+    char median[32];
+    formatTime(result.min, min, sizeof(min));
+    formatTime(result.median, median, sizeof(median));
+    std::printf("    %-60s min %s   median %s   (x%zu)\n", result.label.c_str(), min, median, result.iterations);
+}
+
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    std::string resources = S2_RESOURCES_DIR;
+    size_t runs = 5;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--resources") == 0 && i + 1 < argc)
+            resources = argv[++i];
+        else if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc)
+            runs = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        else
+            filter = argv[i];
+    }
+    S2Plugin::setResourcesDirectory(resources);
+    // keep the generated configuration cache out of the resources folder
+    auto cacheDirectory = std::filesystem::temp_directory_path() / "s2benchmark";
+    std::filesystem::create_directories(cacheDirectory);
+    S2Plugin::setCacheDirectory(cacheDirectory);
+
+    auto benchmarks = S2Benchmark::registeredBenchmarks();
+    std::sort(benchmarks.begin(), benchmarks.end(), [](auto& a, auto& b) { return std::strcmp(a.name, b.name) < 0; });
+    for (auto& benchmark : benchmarks)
+    {
+        if (!filter.empty() && std::string(benchmark.name).find(filter) == std::string::npos)
+            continue;
+
+        std::printf("%s\n", benchmark.name);
+        S2Benchmark::State state{runs};
+        benchmark.function(state);
+        for (auto& result : state.results())
+            printResult(result);
+    }
+    return 0;
+}
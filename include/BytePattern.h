@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace S2Plugin
+{
+    enum class PatternEngine : uint8_t
+    {
+        Best, // AVX2 when the cpu supports it, Scalar otherwise
+        Scalar,
+        SSE2,
+        AVX2,
+    };
+
+    // "48 8B 05 ?? ?? ?? ??" compiled into bytes and a mask, ?? matches any byte
+    struct BytePattern
+    {
+        static constexpr size_t npos = ~size_t{0};
+
+        std::vector<uint8_t> bytes;
+        // 0xFF for the fixed bytes, 0 for the wildcards
+        std::vector<uint8_t> mask;
+        // fixed bytes the candidates are filtered by before the whole pattern is compared
+        // the first fixed byte and the one least likely to show up in x86-64 code
+        size_t firstFixed{0};
+        size_t rareFixed{0};
+
+        // returns false for a malformed pattern, the pattern is empty then
+        bool parse(std::string_view pattern);
+        size_t size() const noexcept
+        {
+            return bytes.size();
+        }
+        // data has to have at least size() bytes
+        bool matches(const uint8_t* data) const
+        {
+            for (size_t i = 0; i < bytes.size(); ++i)
+                if ((data[i] & mask[i]) != bytes[i])
+                    return false;
+
+            return true;
+        }
+        // offset of the first match, npos if not found
+        // the vector engines compare the two filter bytes for 16 or 32 positions at once, engine not supported by the cpu falls back to the best one
+        size_t find(const uint8_t* data, size_t size, PatternEngine engine = PatternEngine::Best) const;
+
+        static PatternEngine bestEngine();
+        // how common the byte is in x86-64 code, 0 for the rare ones
+        static uint8_t commonness(uint8_t b);
+    };
+} // namespace S2Plugin
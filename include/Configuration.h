@@ -1,8 +1,10 @@
 #pragma once
 
-#include "data/IDNameList.h"
-#include <QColor>
-#include <QMetaEnum>
+#include "Data/IDNameList.h"
+#include "FieldOffsetIndex.h"
+#include "StructPlan.h"
+#include "InternedString.h"
+#include <algorithm>
 #include <cstdint>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -12,47 +14,6 @@
 
 namespace S2Plugin
 {
-    constexpr uint8_t gsColField = 0;
-    constexpr uint8_t gsColValue = 1;
-    constexpr uint8_t gsColValueHex = 2;
-    constexpr uint8_t gsColComparisonValue = 3;
-    constexpr uint8_t gsColComparisonValueHex = 4;
-    constexpr uint8_t gsColMemoryAddress = 5;
-    constexpr uint8_t gsColMemoryAddressDelta = 6;
-    constexpr uint8_t gsColType = 7;
-    constexpr uint8_t gsColComment = 8;
-
-    /*
-     * [[ Roles explanation: ]]
-     * The first 5 roles are all saved to the name field
-     * those are used as information about the row
-     * memory address in the name field are used just for row update and shouldn't really be used for anything else
-     *
-     * value, comparison value, memoryAddress and delta fields all should contain the `gsRoleRawValue` data
-     * (may differ with some special types)
-     *
-     * valueHex and comparison valueHex contain `gsRoleRawValue` only when it's a pointer (used for update check and click event)
-     * value and comparison value also contain `gsRoleMemoryAddress` for field editing purposes
-     * for pointers, that will be the pointer value, not memory address of the pointer
-     *
-     * The rest of the roles are type specific
-     */
-
-    constexpr uint16_t gsRoleType = Qt::UserRole + 0;
-    constexpr uint16_t gsRoleMemoryAddress = Qt::UserRole + 1;
-    constexpr uint16_t gsRoleComparisonMemoryAddress = Qt::UserRole + 2;
-    constexpr uint16_t gsRoleIsPointer = Qt::UserRole + 3;
-    constexpr uint16_t gsRoleUID = Qt::UserRole + 4;
-    constexpr uint16_t gsRoleRawValue = Qt::UserRole + 5;
-
-    constexpr uint16_t gsRoleFlagIndex = Qt::UserRole + 6;
-    constexpr uint16_t gsRoleRefName = Qt::UserRole + 7; // ref name for flags, states and vtable
-    constexpr uint16_t gsRoleStdContainerFirstParameterType = Qt::UserRole + 8;
-    constexpr uint16_t gsRoleStdContainerSecondParameterType = Qt::UserRole + 9;
-    constexpr uint16_t gsRoleSize = Qt::UserRole + 10;
-    constexpr uint16_t gsRoleColumns = Qt::UserRole + 11;       // for Matrix
-    constexpr uint16_t gsRoleEntityAddress = Qt::UserRole + 12; // for entity uid to not look for the uid twice
-
     // new types need to be added to
     // - the MemoryFieldType enum
     // - gsMemoryFieldType in Configuration.cpp
@@ -64,7 +25,7 @@ namespace S2Plugin
     // new subclasses of Entity can just be added to the class hierarchy in Spelunky2Entities.json
     // and have its fields defined there
 
-    enum class MemoryFieldType
+    enum class MemoryFieldType : uint8_t
     {
         None = 0, // special type just for error handling
         Dummy,    // dummy type for uses like fake parent type in StdMap
@@ -152,28 +113,30 @@ namespace S2Plugin
         VirtualFunction(size_t i, std::string n, std::string p, std::string r, std::string t) : index(i), name(n), params(p), returnValue(r), type(t){};
     };
 
-    struct MemoryField // TODO this got big over time, consider size optimizations
+    // kept small since the fields are stored for every struct in json and copied around a lot by the views
+    // all the names are interned, the strings are shared between all the fields
+    struct MemoryField
     {
-        std::string name;
-        MemoryFieldType type{MemoryFieldType::None};
-        bool isPointer{false};
-
+        InternedString name;
         // jsonName only if applicable: if a type is not a MemoryFieldType, but fully defined in the json file
         // then save its name so we can compare later
-        std::string jsonName;
+        InternedString jsonName;
         // parameter types for stuff like vectors, maps etc.
-        std::string firstParameterType;
-        std::string secondParameterType;
-        std::string comment;
-        // size in bytes
-        size_t get_size() const;
+        InternedString firstParameterType;
+        InternedString secondParameterType;
+        InternedString comment;
         union
         {
             // length, size of array etc.
-            size_t numberOfElements{0};
+            uint32_t numberOfElements{0};
             // row count for matrix
-            size_t rows;
+            uint32_t rows;
         };
+        MemoryFieldType type{MemoryFieldType::None};
+        bool isPointer{false};
+
+        // size in bytes
+        size_t get_size() const;
         // For checking duplicate names
         bool operator==(const MemoryField& other) const
         {
@@ -181,7 +144,7 @@ namespace S2Plugin
         }
         void setNumColumns(size_t num)
         {
-            columns = num;
+            columns = static_cast<uint16_t>(num);
         };
         size_t getNumColumns() const
         {
@@ -190,22 +153,23 @@ namespace S2Plugin
 
       private:
         // column count for matrix
-        size_t columns{0};
-        size_t size{0};
+        uint16_t columns{0};
+        uint32_t size{0};
         friend class Configuration;
+        friend class ConfigurationCache;
     };
+    static_assert(sizeof(MemoryField) <= 32);
+
+    constexpr uint32_t gsRoomCodeDefaultColor = 0xFFC0C0C0; // Qt::lightGray
 
     struct RoomCode
     {
         uint16_t id;
         std::string name;
-        QColor color;
-        RoomCode(uint16_t _id, std::string _name, QColor _color) : id(_id), name(_name), color(_color){};
+        uint32_t color; // 0xAARRGGBB, same as QRgb
+        RoomCode(uint16_t _id, std::string _name, uint32_t _color) : id(_id), name(_name), color(_color){};
     };
 
-    Q_DECLARE_METATYPE(S2Plugin::MemoryFieldType);
-    Q_DECLARE_METATYPE(std::string);
-
     class Configuration
     {
       public:
@@ -216,6 +180,11 @@ namespace S2Plugin
         {
             return get() != nullptr;
         }
+        // true if the configuration was loaded from the binary cache instead of the json files
+        bool loadedFromCache() const noexcept
+        {
+            return mLoadedFromCache;
+        }
         // Accessors
         const std::unordered_map<std::string, std::string>& entityClassHierarchy() const noexcept
         {
@@ -239,10 +208,21 @@ namespace S2Plugin
         }
         //
         std::vector<std::string> classHierarchyOfEntity(const std::string& entityName) const;
+        // class resolved from default_entity_types when loading, "Entity" for unknown ids
+        const std::string& entityClassName(uint32_t entityTypeID) const
+        {
+            return entityClassOfType(entityTypeID).hierarchy.front();
+        }
+        // from the class of the entity to "Entity"
+        const std::vector<std::string>& classHierarchyOfEntity(uint32_t entityTypeID) const
+        {
+            return entityClassOfType(entityTypeID).hierarchy;
+        }
 
         const std::vector<MemoryField>& typeFields(const MemoryFieldType& type) const;
         const std::vector<MemoryField>& typeFieldsOfEntitySubclass(const std::string& type) const;
         const std::vector<MemoryField>& typeFieldsOfDefaultStruct(const std::string& type) const;
+        const std::vector<MemoryField>& typeFieldsOfDefaultStruct(InternedString type) const;
         std::vector<VirtualFunction> virtualFunctionsOfType(const std::string& field) const;
 
         bool isEntitySubclass(const std::string& type) const;
@@ -254,9 +234,20 @@ namespace S2Plugin
         static bool isPointerType(MemoryFieldType type);
         MemoryField nameToMemoryField(const std::string& typeName) const;
 
+        // fieldUID is dotted path, pointers on the way are dereferenced, array and matrix elements can be addressed with [index] and [row][column]
         uintptr_t offsetForField(const std::vector<MemoryField>& fields, std::string_view fieldUID, uintptr_t base_addr = 0) const;
         uintptr_t offsetForField(MemoryFieldType type, std::string_view fieldUID, uintptr_t base_addr = 0) const;
 
+        // compiled plan of the struct, StructPlans::noPlan for field vectors not owned by the Configuration
+        uint32_t structPlanId(const std::vector<MemoryField>& fields) const
+        {
+            return mStructPlans.id(fields);
+        }
+        const StructPlans& structPlans() const noexcept
+        {
+            return mStructPlans;
+        }
+
         // equivalent to alignof operator
         uint8_t getAlignment(const std::string& type) const;
         uint8_t getAlignment(MemoryFieldType type) const;
@@ -271,22 +262,28 @@ namespace S2Plugin
         RoomCode roomCodeForID(uint16_t code) const;
         std::string getEntityName(uint32_t type) const;
 
-        bool isPermanentPointer(const std::string& type) const
+        bool isPermanentPointer(InternedString type) const
+        {
+            return type.id() < mTypeLookup.size() && mTypeLookup[type.id()].permanentPointer;
+        }
+        bool isPermanentPointer(std::string_view type) const
         {
-            return std::find(mPointerTypes.begin(), mPointerTypes.end(), type) != mPointerTypes.end();
+            return isPermanentPointer(InternedString::lookup(type));
         }
-        bool isPermanentPointer(const std::string_view type) const
+        bool isJsonStruct(InternedString type) const
         {
-            return std::find(mPointerTypes.begin(), mPointerTypes.end(), type) != mPointerTypes.end();
+            return findStruct(type) != nullptr;
         }
-        bool isJsonStruct(const std::string& type) const
+        bool isJsonStruct(std::string_view type) const
         {
-            return mTypeFieldsStructs.find(type) != mTypeFieldsStructs.end();
+            return isJsonStruct(InternedString::lookup(type));
         }
 
       private:
         static Configuration* ptr;
         bool initializedCorrectly = false;
+        bool mLoadedFromCache = false;
+        uint64_t mJsonHash{0};
 
         std::unordered_map<std::string, std::string> mEntityClassHierarchy;
         std::vector<std::pair<std::string, std::string>> mDefaultEntityClassTypes;
@@ -307,10 +304,41 @@ namespace S2Plugin
 
         std::unordered_map<uint16_t, RoomCode> mRoomCodes;
 
+        // indexed by InternedString::id() of the type name, so the checks done for every field don't need to hash the name
+        struct TypeLookup
+        {
+            const std::vector<MemoryField>* structFields{nullptr};
+            bool permanentPointer{false};
+        };
+        std::vector<TypeLookup> mTypeLookup;
+
+        struct EntityClass
+        {
+            std::vector<std::string> hierarchy;
+        };
+        // unique classes, first one is always "Entity"
+        std::vector<EntityClass> mEntityClasses;
+        // indexed by entity type id, index into mEntityClasses
+        std::vector<uint16_t> mEntityTypeClasses;
+        FieldOffsetIndex mOffsetIndex;
+        StructPlans mStructPlans;
+
         void processEntitiesJSON(nlohmann::ordered_json& json);
         void processJSON(nlohmann::ordered_json& json);
         void processRoomCodesJSON(nlohmann::ordered_json& json);
         MemoryField populateMemoryField(const nlohmann::ordered_json& field, const std::string& struct_name);
+        void buildTypeLookup();
+        void buildEntityClasses();
+        const EntityClass& entityClassOfType(uint32_t entityTypeID) const
+        {
+            return mEntityClasses[entityTypeID < mEntityTypeClasses.size() ? mEntityTypeClasses[entityTypeID] : 0];
+        }
+        const std::vector<MemoryField>* findStruct(InternedString type) const
+        {
+            return type.id() < mTypeLookup.size() ? mTypeLookup[type.id()].structFields : nullptr;
+        }
+        // resolves all the lazily calculated sizes and saves the cache, needs to be the current configuration
+        void updateCache();
 
         EntityNamesList entityNames;
         ParticleEmittersList particleEmitters;
@@ -319,5 +347,8 @@ namespace S2Plugin
         ~Configuration(){};
         Configuration(const Configuration&) = delete;
         Configuration& operator=(const Configuration&) = delete;
+        friend class ConfigurationCache;
+        friend class FieldOffsetIndex;
+        friend class StructPlans;
     };
 } // namespace S2Plugin
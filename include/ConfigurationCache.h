@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace S2Plugin
+{
+    class Configuration;
+    struct MemoryField;
+
+    // Binary cache of everything Configuration builds from the json files (fields, refs, alignments, virtual functions, struct sizes ...)
+    // keyed by hash of the json files content, so the json only needs to be parsed again when one of the files changes
+    // the cache file is memory mapped when loading
+    class ConfigurationCache
+    {
+      public:
+        static constexpr uint32_t magic = 0x43433253; // "S2CC"
+        // bump when changing the data stored in Configuration or the file layout
+        static constexpr uint32_t version = 1;
+
+        static uint64_t hashFiles(const std::vector<std::filesystem::path>& files);
+        // returns false if the cache is missing, outdated or corrupted, the configuration is left empty then
+        static bool load(Configuration& config, const std::filesystem::path& path, uint64_t hash);
+        static bool save(const Configuration& config, const std::filesystem::path& path, uint64_t hash);
+
+      private:
+        class Writer;
+        class Reader;
+        static void writeField(Writer& writer, const MemoryField& field);
+        static MemoryField readField(Reader& reader);
+    };
+} // namespace S2Plugin
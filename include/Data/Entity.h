@@ -12,6 +12,16 @@ namespace S2Plugin
     class Entity
     {
       public:
+        enum ENTITY_OFFSETS
+        {
+            UID = 0x38,
+            LAYER = 0xA0,
+            TYPE_PTR = 0x8,
+            DB_TYPE_ID = 0x14,
+            POS = 0x40,
+            OVERLAY = 0x10,
+        };
+
         explicit Entity(uintptr_t addr) : mEntityPtr(addr){};
         Entity() = delete;
 
@@ -19,10 +29,7 @@ namespace S2Plugin
         uint32_t entityTypeID() const;
         std::string entityTypeName() const;
         static std::vector<std::string> classHierarchy(std::string validClassName);
-        std::vector<std::string> classHierarchy() const
-        {
-            return classHierarchy(entityClassName());
-        }
+        std::vector<std::string> classHierarchy() const;
 
         uint8_t layer() const;
         uint32_t uid() const;
@@ -35,15 +42,5 @@ namespace S2Plugin
 
       private:
         uintptr_t mEntityPtr;
-
-        enum ENTITY_OFFSETS
-        {
-            UID = 0x38,
-            LAYER = 0xA0,
-            TYPE_PTR = 0x8,
-            DB_TYPE_ID = 0x14,
-            POS = 0x40,
-            OVERLAY = 0x10,
-        };
     };
 } // namespace S2Plugin
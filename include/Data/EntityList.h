@@ -3,7 +3,6 @@
 // #include "Entity.h"
 // #include <utility>
 
-#include "pluginmain.h"
 #include "read_helpers.h"
 #include <cstdint>
 #include <vector>
@@ -16,7 +15,7 @@ namespace S2Plugin
       public:
         explicit EntityList(uintptr_t address)
         {
-            Script::Memory::Read(address, this, sizeof(EntityList), nullptr);
+            ReadMemory(address, this, sizeof(EntityList));
         };
         uintptr_t entities() const
         {
@@ -141,14 +140,14 @@ namespace S2Plugin
         {
             std::vector<uintptr_t> result;
             result.resize(size());
-            Script::Memory::Read(entities(), result.data(), size() * sizeof(uintptr_t), nullptr);
+            ReadMemory(entities(), result.data(), size() * sizeof(uintptr_t));
             return result;
         }
         std::vector<uint32_t> getAllUids() const
         {
             std::vector<uint32_t> result;
             result.resize(size());
-            Script::Memory::Read(uids(), result.data(), size() * sizeof(uint32_t), nullptr);
+            ReadMemory(uids(), result.data(), size() * sizeof(uint32_t));
             return result;
         }
 
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace S2Plugin
+{
+    class EntityList;
+
+    // Header fields of many entities read in a few bulk reads
+    // stored as structure of arrays, the entity type ids and absolute positions are resolved from the already read data
+    // this should only ever be used as temporary, the data is as old as the last read()
+    class EntitySnapshot
+    {
+      public:
+        // adds all the (non null) entities from the list, up to maxCount
+        void addList(const EntityList& list, uint32_t maxCount = UINT32_MAX);
+        // slot is the address of the pointer to the entity, if known
+        void addEntity(uintptr_t entity, uintptr_t slot = 0);
+        // reads the headers of all the added entities
+        void read();
+        void clear();
+
+        size_t size() const noexcept
+        {
+            return mPtrs.size();
+        }
+        bool empty() const noexcept
+        {
+            return mPtrs.empty();
+        }
+        uintptr_t ptr(size_t index) const
+        {
+            return mPtrs[index];
+        }
+        uintptr_t slot(size_t index) const
+        {
+            return mSlots[index];
+        }
+        uintptr_t vtable(size_t index) const
+        {
+            return mVTables[index];
+        }
+        uintptr_t typePtr(size_t index) const
+        {
+            return mTypePtrs[index];
+        }
+        uintptr_t overlay(size_t index) const
+        {
+            return mOverlays[index];
+        }
+        uint32_t uid(size_t index) const
+        {
+            return mUids[index];
+        }
+        uint32_t entityTypeID(size_t index) const
+        {
+            return mTypeIDs[index];
+        }
+        uint8_t layer(size_t index) const
+        {
+            return mLayers[index];
+        }
+        std::pair<float, float> position(size_t index) const
+        {
+            return {mX[index], mY[index]};
+        }
+        std::pair<float, float> abs_position(size_t index) const
+        {
+            return {mAbsX[index], mAbsY[index]};
+        }
+
+      private:
+        void readHeaders(const std::vector<uint32_t>& order);
+        void resolveTypeIDs();
+        void resolveAbsolutePositions(const std::vector<uint32_t>& order);
+
+        std::vector<uintptr_t> mPtrs;
+        std::vector<uintptr_t> mSlots;
+        std::vector<uintptr_t> mVTables;
+        std::vector<uintptr_t> mTypePtrs;
+        std::vector<uintptr_t> mOverlays;
+        std::vector<uint32_t> mUids;
+        std::vector<uint32_t> mTypeIDs;
+        std::vector<uint8_t> mLayers;
+        std::vector<float> mX;
+        std::vector<float> mY;
+        std::vector<float> mAbsX;
+        std::vector<float> mAbsY;
+    };
+} // namespace S2Plugin
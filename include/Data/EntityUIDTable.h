@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace S2Plugin
+{
+    // Copy of the game's uid -> entity robin hood table (State.uid_to_entity_mask and the entries pointer after it)
+    // the whole table is read at once, so any number of uids can be resolved without touching the game memory
+    class EntityUIDTable
+    {
+      public:
+        // maskAddr is the address of State.uid_to_entity_mask
+        // returns false if the table could not be read, the table is empty then
+        bool read(uintptr_t maskAddr);
+        void clear();
+        bool empty() const noexcept
+        {
+            return mEntries.empty();
+        }
+        // returns 0 if not found
+        uintptr_t find(uint32_t uid) const;
+        void find(const uint32_t* uids, size_t count, uintptr_t* result) const;
+
+        // walks the table in the game memory entry by entry, cheaper than reading the whole table for a single lookup
+        static uintptr_t findInMemory(uint32_t uid, uintptr_t maskAddr);
+
+        // layout of the entry in the game memory
+        struct Entry
+        {
+            uint32_t uid_plus_one; // actually hash of the uid + 1
+            uint32_t padding;
+            uintptr_t entity;
+        };
+        // lowbias32 of uid + 1, ported from overlunky
+        static constexpr uint32_t hash(uint32_t uid)
+        {
+            uint32_t x = uid + 1u;
+            x ^= x >> 16;
+            x *= 0x7feb352d;
+            x ^= x >> 15;
+            x *= 0x846ca68b;
+            x ^= x >> 16;
+            return x;
+        }
+
+      private:
+        std::vector<Entry> mEntries;
+        uint32_t mMask{0};
+    };
+} // namespace S2Plugin
@@ -1,10 +1,10 @@
 #pragma once
 
-#include <QStringList>
 #include <cstdint>
 #include <regex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace S2Plugin
 {
@@ -24,7 +24,7 @@ namespace S2Plugin
         {
             return mEntries.size();
         }
-        const QStringList& names() const noexcept
+        const std::vector<std::string>& names() const noexcept
         {
             return mNames;
         }
@@ -39,7 +39,8 @@ namespace S2Plugin
 
       private:
         std::unordered_map<uint32_t, std::string> mEntries;
-        QStringList mNames;
+        std::unordered_map<std::string, uint32_t> mIDs;
+        std::vector<std::string> mNames;
         uint32_t mHighestID = 0;
 
         IDNameList() = default;
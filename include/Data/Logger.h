@@ -1,11 +1,14 @@
 #pragma once
 
+#include "Data/LoggerCapture.h"
+#include "Data/LoggerColumn.h"
+#include "Data/LoggerSampler.h"
 #include <QColor>
 #include <QObject>
-#include <any>
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 class QTimer;
@@ -13,7 +16,6 @@ class QTimer;
 namespace S2Plugin
 {
     class ItemModelLoggerFields;
-    enum class MemoryFieldType;
 
     struct LoggerField
     {
@@ -50,36 +52,93 @@ namespace S2Plugin
             mFields.at(fieldIndex).color = newColor;
         }
 
-        const std::vector<std::any>& samplesForField(const std::string& fieldUUID) const
+        // kept samples starting at sample `first`, the columns and sample indexes are relative to it
+        // the columns are in the field order, empty when the fields changed since the last logging
+        struct SampleRange
         {
-            return mSamples.at(fieldUUID);
-        }
+            size_t first;
+            const std::vector<LoggerColumn>& columns;
+            // sampler tick of every sample, not contiguous when the triggers left some samples out
+            const std::vector<uint64_t>& sampleIndexes;
+        };
+        // the samples table and the plot each keep their own part of a capture
+        enum class SampleWindow : uint8_t
+        {
+            Table,
+            Plot,
+        };
+        // at least the samples [first, last), samples kept in memory are all returned, the ones of a capture are read thru the window
+        // valid until the next call for the same window or the samples change
+        SampleRange samples(SampleWindow window, size_t first, size_t last) const;
         size_t sampleCount() const noexcept
         {
-            for (const auto& [uuid, samples] : mSamples)
-            {
-                return samples.size();
-            }
-            return 0;
+            if (mReader.isOpen())
+                return static_cast<size_t>(mReader.frameCount());
+
+            return mSamples.empty() || mSampleIndexes.size() != mSamples.front().size() ? 0 : mSampleIndexes.size();
         }
-        std::pair<int64_t, int64_t> sampleBounds(const LoggerField& field) const;
 
-        void start(int samplePeriod, int duration);
+        // with triggers, only the samples around them are kept (used by the next start)
+        void setTriggers(const LoggerTriggerSettings& triggers)
+        {
+            mTriggers = triggers;
+        }
+        const LoggerTriggerSettings& triggers() const noexcept
+        {
+            return mTriggers;
+        }
+
+        // samplePeriod in milliseconds, duration in seconds
+        // with capturePath the samples are streamed into the capture file instead of memory, zero duration samples until stop
+        // returns false if the capture file could not be created
+        bool start(int samplePeriod, int duration, const std::string& capturePath = {});
+        // ends the sampling early, samplingEnded is emitted as usual
+        void stop();
+        // moves the samples collected by the sampler thread into the columns (or the capture file), GUI thread only
+        void drain();
+        bool isCapturing() const
+        {
+            return mCapture.isOpen();
+        }
+        uint64_t capturedSamples() const noexcept
+        {
+            return mCapture.frameCount();
+        }
+        // replaces the fields and samples with the ones from the capture file, game does not need to run
+        // the capture stays open, only the samples shown are read
+        bool openCapture(const std::string& path);
+        // csv or json, depending on the extension
+        bool exportSamples(const std::string& path) const;
+        // achieved period and jitter of the last run, valid after samplingEnded (readsPerSample is valid right after start)
+        const LoggerSampler::Statistics& samplingStatistics() const noexcept
+        {
+            return mSampler.statistics();
+        }
 
       signals:
         void samplingEnded();
         void fieldsChanged();
 
       private slots:
-        void sample();
-        void durationEnded();
+        void drainTick();
 
       private:
+        std::vector<LoggerCaptureField> captureFields() const;
+        // samples are kept in memory again (or there are none)
+        void closeCapture();
+
         std::vector<LoggerField> mFields;
+        LoggerTriggerSettings mTriggers;
         ItemModelLoggerFields* mTableModel = nullptr;
 
-        QTimer* mSampleTimer;
-        QTimer* mDurationTimer;
-        std::unordered_map<std::string, std::vector<std::any>> mSamples; // field uuid -> value
+        QTimer* mDrainTimer{nullptr};
+        LoggerSampler mSampler;
+        LoggerCaptureWriter mCapture;
+        std::chrono::nanoseconds mSamplePeriod{0};
+        std::vector<LoggerColumn> mSamples; // one column per field
+        std::vector<uint64_t> mSampleIndexes; // one per sample
+        // capture written by the last run or opened, the samples are not loaded into the columns above
+        LoggerCaptureReader mReader;
+        mutable std::array<LoggerCaptureWindow, 2> mWindows;
     };
 } // namespace S2Plugin
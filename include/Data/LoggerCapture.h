@@ -0,0 +1,148 @@
+#pragma once
+
+#include "MappedFile.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace S2Plugin
+{
+    enum class MemoryFieldType : uint8_t;
+    class LoggerColumn;
+
+    // logged field as stored in the capture
+    struct LoggerCaptureField
+    {
+        uintptr_t memoryAddr;
+        MemoryFieldType type;
+        // 0xAARRGGBB
+        uint32_t color;
+        std::string name;
+    };
+
+    // Logger capture file: header with the field descriptions followed by fixed size frames
+    // one frame is one sample of all the fields: the sample index (uint64) followed by the values packed in the field order with their own size
+    // the sample index is the sampler tick, frames are not contiguous when triggers left some of the samples out
+    // the frame count in the header is updated on every flush, a capture that was not closed properly keeps all the flushed frames
+
+    // streams the samples into a memory mapped file, the samples don't need to stay in memory
+    class LoggerCaptureWriter
+    {
+      public:
+        bool create(const std::string& path, const std::vector<LoggerCaptureField>& fields, std::chrono::nanoseconds samplePeriod);
+        // record holds one raw value per field followed by the sample index (as produced by LoggerSampler)
+        bool append(const uint64_t* record);
+        // writes the current frame count into the header
+        void flush();
+        void close();
+
+        bool isOpen() const
+        {
+            return mFile.isOpen();
+        }
+        const std::string& path() const noexcept
+        {
+            return mPath;
+        }
+        uint64_t frameCount() const noexcept
+        {
+            return mFrameCount;
+        }
+        // some frame could not be written (disk full)
+        bool failed() const noexcept
+        {
+            return mFailed;
+        }
+
+      private:
+        MappedFileWriter mFile;
+        std::string mPath;
+        std::vector<uint8_t> mFieldSizes;
+        size_t mFrameSize{0};
+        uint64_t mFrameCount{0};
+        bool mFailed{false};
+    };
+
+    // reads capture back thru memory mapping, no game needed
+    class LoggerCaptureReader
+    {
+      public:
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const
+        {
+            return mFile.isOpen();
+        }
+        const std::vector<LoggerCaptureField>& fields() const noexcept
+        {
+            return mFields;
+        }
+        uint64_t frameCount() const noexcept
+        {
+            return mFrameCount;
+        }
+        std::chrono::nanoseconds samplePeriod() const noexcept
+        {
+            return mSamplePeriod;
+        }
+        // one column per field with the samples [first, first + count)
+        std::vector<LoggerColumn> readColumns(uint64_t first = 0, uint64_t count = UINT64_MAX) const;
+        // sample index of the frames [first, first + count)
+        std::vector<uint64_t> readSampleIndexes(uint64_t first = 0, uint64_t count = UINT64_MAX) const;
+
+      private:
+        MappedFile mFile;
+        std::vector<LoggerCaptureField> mFields;
+        std::vector<uint8_t> mFieldSizes;
+        const uint8_t* mFrames{nullptr};
+        size_t mFrameSize{0};
+        uint64_t mFrameCount{0};
+        std::chrono::nanoseconds mSamplePeriod{0};
+    };
+
+    // samples [first, first + count) of a capture, so the samples table and plot don't need the whole capture in memory
+    // read in aligned chunks, scrolling a bit further does not read again, the columns carry their own min/max pyramid
+    class LoggerCaptureWindow
+    {
+      public:
+        static constexpr uint64_t chunk = 4096;
+
+        // makes sure the samples [first, last) are loaded, returns true when it had to read them
+        bool load(const LoggerCaptureReader& reader, uint64_t first, uint64_t last);
+        void clear();
+
+        bool contains(uint64_t first, uint64_t last) const noexcept
+        {
+            return first >= mFirst && last <= mFirst + mSampleIndexes.size();
+        }
+        // sample of the capture at column index 0
+        uint64_t first() const noexcept
+        {
+            return mFirst;
+        }
+        const std::vector<LoggerColumn>& columns() const noexcept
+        {
+            return mColumns;
+        }
+        const std::vector<uint64_t>& sampleIndexes() const noexcept
+        {
+            return mSampleIndexes;
+        }
+
+      private:
+        uint64_t mFirst{0};
+        std::vector<LoggerColumn> mColumns;
+        std::vector<uint64_t> mSampleIndexes;
+    };
+
+    // exports the samples as one row per sample, columns in the same order as the fields
+    // the time of a sample is its sample index times the period
+    bool exportLoggerCSV(std::ostream& out, const std::vector<LoggerCaptureField>& fields, const std::vector<LoggerColumn>& columns, const std::vector<uint64_t>& sampleIndexes,
+                         std::chrono::nanoseconds samplePeriod);
+    bool exportLoggerJSON(std::ostream& out, const std::vector<LoggerCaptureField>& fields, const std::vector<LoggerColumn>& columns, const std::vector<uint64_t>& sampleIndexes,
+                          std::chrono::nanoseconds samplePeriod);
+} // namespace S2Plugin
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "MinMaxPyramid.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace S2Plugin
+{
+    enum class MemoryFieldType : uint8_t;
+
+    // Samples of one logged field, stored as contiguous array of the field's own type
+    // bounds and statistics are updated while sampling, so they are free to query
+    class LoggerColumn
+    {
+      public:
+        LoggerColumn(uintptr_t memoryAddr, MemoryFieldType type);
+
+        static bool isSupported(MemoryFieldType type);
+
+        // reserve for the whole logging duration to avoid reallocations while sampling
+        void reserve(size_t count);
+        // reads the current value from memory and appends it
+        void sample();
+        // appends value sampled elsewhere, rawValue holds the value bytes as read from memory (valueSize bytes)
+        void append(uint64_t rawValue);
+        void clear();
+
+        size_t size() const noexcept
+        {
+            return std::visit([](const auto& samples) { return samples.size(); }, mSamples);
+        }
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+        uintptr_t memoryAddr() const noexcept
+        {
+            return mMemoryAddr;
+        }
+        // size of one sample in memory
+        size_t valueSize() const noexcept;
+        bool isFloatingPoint() const noexcept
+        {
+            return std::visit([](const auto& samples) { return std::is_floating_point_v<typename std::decay_t<decltype(samples)>::value_type>; }, mSamples);
+        }
+        bool isSigned() const noexcept
+        {
+            return std::visit([](const auto& samples) { return std::is_signed_v<typename std::decay_t<decltype(samples)>::value_type>; }, mSamples);
+        }
+        // calls the function with the sample in it's original type
+        template <typename Function>
+        decltype(auto) visitAt(size_t index, Function&& function) const
+        {
+            return std::visit([&](const auto& samples) -> decltype(auto) { return function(samples[index]); }, mSamples);
+        }
+        double valueAt(size_t index) const
+        {
+            return visitAt(index, [](auto value) { return static_cast<double>(value); });
+        }
+        // lowest and highest value of the samples [first, last), for plotting many samples in one pixel
+        // {inf, -inf} when there is no finite value
+        std::pair<double, double> minMax(size_t first, size_t last) const
+        {
+            return std::visit([&](const auto& samples) { return mPyramid.range(first, last, [&samples](size_t index) { return static_cast<double>(samples[index]); }); }, mSamples);
+        }
+        // lowest and highest value, floating point values are rounded outwards
+        std::pair<int64_t, int64_t> bounds() const;
+        double minimum() const noexcept
+        {
+            return mMinimum;
+        }
+        double maximum() const noexcept
+        {
+            return mMaximum;
+        }
+        double mean() const noexcept
+        {
+            auto count = size();
+            return count == 0 ? 0.0 : mSum / static_cast<double>(count);
+        }
+
+      private:
+        using Samples = std::variant<std::vector<int8_t>, std::vector<uint8_t>, std::vector<int16_t>, std::vector<uint16_t>, std::vector<int32_t>, std::vector<uint32_t>, std::vector<int64_t>,
+                                     std::vector<uint64_t>, std::vector<float>, std::vector<double>>;
+
+        template <typename T>
+        void add(std::vector<T>& samples, T value);
+
+        uintptr_t mMemoryAddr;
+        Samples mSamples;
+        MinMaxPyramid mPyramid;
+        int64_t mLowest;
+        int64_t mHighest;
+        double mMinimum;
+        double mMaximum;
+        double mSum{0.0};
+    };
+} // namespace S2Plugin
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Data/LoggerTrigger.h"
+#include "ReadPlan.h"
+#include "SampleRingBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace S2Plugin
+{
+    class LoggerCaptureWriter;
+    class LoggerColumn;
+
+    // Samples the Logger fields on a dedicated thread, independent from the GUI event loop
+    // every tick produces one record (the raw value of every field and the sample index) into a ring buffer, the GUI drains it into the columns
+    // the sample index counts all the ticks, so it still shows the time of the sample when the triggers leave some of them out
+    // the fields are read with a ReadPlan built at start, so the fields from the same struct cost a single debugger call
+    class LoggerSampler
+    {
+      public:
+        // in milliseconds
+        struct Statistics
+        {
+            size_t samples{0};
+            // samples lost because the ring buffer was full (GUI not draining fast enough)
+            size_t dropped{0};
+            // ticks skipped because the sampler fell behind, the sample index jumps over them
+            size_t missed{0};
+            // debugger calls per sample, fields next to each other are read together
+            size_t readsPerSample{0};
+            // with triggers, samples outside of the trigger windows are not kept
+            size_t triggers{0};
+            size_t discarded{0};
+            double requestedPeriod{0.0};
+            double meanPeriod{0.0};
+            // standard deviation of the period
+            double jitter{0.0};
+            double minPeriod{0.0};
+            double maxPeriod{0.0};
+        };
+
+        LoggerSampler() = default;
+        ~LoggerSampler();
+        LoggerSampler(const LoggerSampler&) = delete;
+        LoggerSampler& operator=(const LoggerSampler&) = delete;
+
+        // columns provide the address and size of the fields, they are not touched by the sampler thread
+        // zero duration samples until stop is called
+        // with triggers only the samples around them are kept
+        void start(const std::vector<LoggerColumn>& columns, std::chrono::nanoseconds period, std::chrono::nanoseconds duration, const LoggerTriggerSettings& triggers = {});
+        // stops the thread, returns after it has finished
+        void stop();
+        // true when the duration has elapsed or stop was called
+        bool finished() const noexcept
+        {
+            return mFinished.load(std::memory_order_acquire);
+        }
+        // consumer side, appends all the sampled records to the columns and their sample index to sampleIndexes, returns the number of records
+        size_t drain(std::vector<LoggerColumn>& columns, std::vector<uint64_t>& sampleIndexes);
+        // consumer side, appends all the sampled records to the capture file instead
+        size_t drain(LoggerCaptureWriter& capture);
+        // valid once finished
+        const Statistics& statistics() const noexcept
+        {
+            return mStatistics;
+        }
+
+      private:
+        void run(std::chrono::nanoseconds period, std::chrono::nanoseconds duration);
+
+        ReadPlan mReadPlan;
+        std::unique_ptr<LoggerTriggerWindow> mTriggerWindow;
+        std::unique_ptr<SampleRingBuffer> mBuffer;
+        std::vector<uint64_t> mDrainBuffer;
+        std::thread mThread;
+        std::atomic<bool> mStop{false};
+        std::atomic<bool> mFinished{true};
+        Statistics mStatistics;
+    };
+} // namespace S2Plugin
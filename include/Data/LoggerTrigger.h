@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace S2Plugin
+{
+    class LoggerColumn;
+
+    // condition on one of the logged fields, compares the current sample with the previous one
+    struct LoggerTrigger
+    {
+        enum class Condition : uint8_t
+        {
+            Changed,
+            RisesAbove,
+            FallsBelow,
+            BitSet,
+            BitCleared,
+        };
+
+        size_t fieldIndex{0};
+        Condition condition{Condition::Changed};
+        // for RisesAbove and FallsBelow
+        double threshold{0.0};
+        // for BitSet and BitCleared, zero based
+        uint8_t bit{0};
+    };
+
+    struct LoggerTriggerSettings
+    {
+        // any of them fires the trigger, no triggers means everything is kept
+        std::vector<LoggerTrigger> triggers;
+        // samples kept before and after every trigger
+        size_t preTrigger{0};
+        size_t postTrigger{0};
+    };
+
+    // Keeps only the samples around the triggers, evaluated on the sampler thread
+    // the samples before a trigger wait in a ring buffer, the window is extended when it triggers again
+    class LoggerTriggerWindow
+    {
+      public:
+        // the columns provide the type of the fields, triggers for fields that don't exist are ignored
+        LoggerTriggerWindow(const LoggerTriggerSettings& settings, const std::vector<LoggerColumn>& columns);
+
+        bool active() const noexcept
+        {
+            return !mTriggers.empty();
+        }
+        // record is the raw value of every column followed by the sample index (as produced by LoggerSampler)
+        // store(const uint64_t* record) is called for every record to keep, in order, the held back ones keep their own sample index
+        template <typename StoreFunction>
+        void process(const uint64_t* record, StoreFunction&& store)
+        {
+            bool fired = mHasPrevious && evaluate(record);
+            std::memcpy(mPrevious.data(), record, mPrevious.size() * sizeof(uint64_t));
+            mHasPrevious = true;
+            if (fired)
+            {
+                ++mTriggerCount;
+                // oldest first
+                for (size_t i = 0; i < mHistoryCount; ++i)
+                {
+                    size_t slot = (mHistoryNext + mPreTrigger - mHistoryCount + i) % mPreTrigger;
+                    store(mHistory.data() + slot * mRecordWords);
+                }
+                mHistoryCount = 0;
+                // the current sample and postTrigger after it
+                mPostRemaining = mPostTrigger + 1;
+            }
+            if (mPostRemaining != 0)
+            {
+                store(record);
+                --mPostRemaining;
+            }
+            else if (mPreTrigger != 0)
+            {
+                if (mHistoryCount == mPreTrigger)
+                    ++mDiscarded;
+                else
+                    ++mHistoryCount;
+                std::memcpy(mHistory.data() + mHistoryNext * mRecordWords, record, mRecordWords * sizeof(uint64_t));
+                mHistoryNext = (mHistoryNext + 1) % mPreTrigger;
+            }
+            else
+            {
+                ++mDiscarded;
+            }
+        }
+        size_t triggerCount() const noexcept
+        {
+            return mTriggerCount;
+        }
+        // samples that were not kept, including the ones still waiting for a trigger
+        size_t discarded() const noexcept
+        {
+            return mDiscarded + mHistoryCount;
+        }
+
+      private:
+        struct Trigger
+        {
+            size_t field;
+            LoggerTrigger::Condition condition;
+            double threshold;
+            uint64_t mask;
+            uint8_t size;
+            bool isFloatingPoint;
+            bool isSigned;
+        };
+
+        bool evaluate(const uint64_t* record) const;
+        double decode(const Trigger& trigger, uint64_t raw) const;
+
+        std::vector<Trigger> mTriggers;
+        size_t mRecordWords;
+        size_t mPreTrigger;
+        size_t mPostTrigger;
+        std::vector<uint64_t> mPrevious;
+        bool mHasPrevious{false};
+        std::vector<uint64_t> mHistory;
+        size_t mHistoryNext{0};
+        size_t mHistoryCount{0};
+        size_t mPostRemaining{0};
+        size_t mTriggerCount{0};
+        size_t mDiscarded{0};
+    };
+} // namespace S2Plugin
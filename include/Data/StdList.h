@@ -1,6 +1,6 @@
 #pragma once
 
-#include "pluginmain.h"
+#include "read_helpers.h"
 #include <cstdint>
 
 namespace S2Plugin
@@ -17,11 +17,11 @@ namespace S2Plugin
 
             Node prev() const
             {
-                return Node{Script::Memory::ReadQword(nodeAddress)};
+                return Node{Read<uintptr_t>(nodeAddress)};
             }
             Node next() const
             {
-                return Node{Script::Memory::ReadQword(nodeAddress + sizeof(uintptr_t))};
+                return Node{Read<uintptr_t>(nodeAddress + sizeof(uintptr_t))};
             }
             uintptr_t value_ptr() const noexcept
             {
@@ -100,7 +100,7 @@ namespace S2Plugin
         }
         bool isValid() const
         {
-            return Script::Memory::IsValidPtr(_end.next().address()) && Script::Memory::IsValidPtr(_end.prev().address());
+            return IsValidPtr(_end.next().address()) && IsValidPtr(_end.prev().address());
         }
 
       private:
@@ -115,7 +115,7 @@ namespace S2Plugin
 
         StdList(uintptr_t address)
         {
-            Script::Memory::Read(address, this, sizeof(StdList), nullptr);
+            ReadMemory(address, this, sizeof(StdList));
         }
         Node begin() const
         {
@@ -1,7 +1,9 @@
 #pragma once
 
-#include "pluginmain.h"
+#include "read_helpers.h"
+#include <algorithm>
 #include <cstdint>
+#include <tuple>
 #include <utility>
 
 namespace S2Plugin
@@ -18,6 +20,62 @@ namespace S2Plugin
         };
     } // namespace
 
+    // offsets of the key and value in the tree node
+    inline std::pair<size_t, size_t> stdMapNodeOffsets(size_t keySize, uint8_t keyAlignment, uint8_t valueAlignment) noexcept
+    {
+        // key and value in map are treated as std::pair
+        // we need to figure out if it's placed right after the bucket flags
+        // or if there is a padding added for alignment
+        // the issue is, if key or value are a structs, we need to know their alignments, not just their size
+
+        uint8_t alignment = std::max(keyAlignment, valueAlignment);
+        size_t keyOffset;
+        switch (alignment)
+        {
+            case 0:
+            case 1:
+            case 2:
+                keyOffset = 0x1A; // 3 pointers and 2 bool field
+                break;
+            case 3:
+            case 4:
+                keyOffset = 0x1C;
+                break;
+            case 5:
+            case 6:
+            case 7:
+            case 8:
+            default:
+                keyOffset = 0x20;
+                break;
+        }
+        size_t offset = keyOffset + keySize;
+        // dealing with the padding between key and value
+        size_t valueOffset;
+        switch (valueAlignment)
+        {
+            case 0:
+            case 1:
+                valueOffset = offset;
+                break;
+            case 2:
+                valueOffset = (offset + 1) & ~1;
+                break;
+            case 3:
+            case 4:
+                valueOffset = (offset + 3) & ~3;
+                break;
+            case 5:
+            case 6:
+            case 7:
+            case 8:
+            default:
+                valueOffset = (offset + 7) & ~7;
+                break;
+        }
+        return {keyOffset, valueOffset};
+    }
+
     template <class Key = _EmptyType, class Value = _EmptyType>
     struct StdMap
     {
@@ -26,7 +84,7 @@ namespace S2Plugin
         explicit StdMap(uintptr_t addr, std::enable_if_t<!std::is_same_v<K, _EmptyType> || !std::is_same_v<V, _EmptyType>, int> = 0)
         {
             uintptr_t data[2];
-            Script::Memory::Read(addr, &data, sizeof(data), nullptr);
+            ReadMemory(addr, &data, sizeof(data));
             head = Node{data[0]};
             mSize = data[1];
             head.set_offsets();
@@ -36,7 +94,7 @@ namespace S2Plugin
         StdMap(uintptr_t addr, uint8_t keyAlignment, uint8_t valueAlignment, size_t keySize)
         {
             uintptr_t data[2];
-            Script::Memory::Read(addr, &data, sizeof(data), nullptr);
+            ReadMemory(addr, &data, sizeof(data));
             head = Node{data[0]};
             mSize = data[1];
             head.set_offsets(keySize, keyAlignment, valueAlignment);
@@ -45,16 +103,17 @@ namespace S2Plugin
         struct Node
         {
             Node(const Node& t) : node_ptr(t.node_ptr), key_offset(t.key_offset), value_offset(t.value_offset){};
+            Node& operator=(const Node& t) = default;
             Key key() const
             {
                 Key tmp{};
-                Script::Memory::Read(key_ptr(), &tmp, sizeof(Key), nullptr);
+                ReadMemory(key_ptr(), &tmp, sizeof(Key));
                 return tmp;
             }
             Value value() const
             {
                 Value tmp{};
-                Script::Memory::Read(value_ptr(), &tmp, sizeof(Value), nullptr);
+                ReadMemory(value_ptr(), &tmp, sizeof(Value));
                 return tmp;
             }
             uintptr_t key_ptr() const
@@ -67,32 +126,32 @@ namespace S2Plugin
             }
             Node left() const
             {
-                auto left_addr = Script::Memory::ReadQword(node_ptr);
+                auto left_addr = Read<uintptr_t>(node_ptr);
                 Node copy = *this;
                 copy.node_ptr = left_addr;
                 return copy;
             }
             Node parent() const
             {
-                auto parent_addr = Script::Memory::ReadQword(node_ptr + 0x8);
+                auto parent_addr = Read<uintptr_t>(node_ptr + 0x8);
                 Node copy = *this;
                 copy.node_ptr = parent_addr;
                 return copy;
             }
             Node right() const
             {
-                auto right_addr = Script::Memory::ReadQword(node_ptr + 0x10);
+                auto right_addr = Read<uintptr_t>(node_ptr + 0x10);
                 Node copy = *this;
                 copy.node_ptr = right_addr;
                 return copy;
             }
             bool color() const
             {
-                return (bool)Script::Memory::ReadByte(node_ptr + 0x18);
+                return (bool)Read<uint8_t>(node_ptr + 0x18);
             }
             bool is_nil() const
             {
-                return (bool)Script::Memory::ReadByte(node_ptr + 0x19);
+                return (bool)Read<uint8_t>(node_ptr + 0x19);
             }
             // returning value ptr instead of value itself since it's more useful for us
             std::pair<Key, uintptr_t> operator*()
@@ -161,55 +220,7 @@ namespace S2Plugin
             explicit Node(size_t addr) : node_ptr(addr){};
             void set_offsets(size_t keytype_size = sizeof(Key), uint8_t key_alignment = alignof(Key), uint8_t value_alignment = alignof(Value)) noexcept
             {
-                // key and value in map are treated as std::pair
-                // we need to figure out if it's placed right after the bucket flags
-                // or if there is a padding added for alignment
-                // the issue is, if key or value are a structs, we need to know their alignments, not just their size
-
-                uint8_t alignment = std::max(key_alignment, value_alignment);
-
-                switch (alignment)
-                {
-                    case 0:
-                    case 1:
-                    case 2:
-                        key_offset = 0x1A; // 3 pointers and 2 bool field
-                        break;
-                    case 3:
-                    case 4:
-                        key_offset = 0x1C;
-                        break;
-                    case 5:
-                    case 6:
-                    case 7:
-                    case 8:
-                    default:
-                        key_offset = 0x20;
-                        break;
-                }
-                size_t offset = key_offset + keytype_size;
-                // dealing with the padding between key and value
-                switch (value_alignment)
-                {
-                    case 0:
-                    case 1:
-                        value_offset = offset;
-                        break;
-                    case 2:
-                        value_offset = (offset + 1) & ~1;
-                        break;
-                    case 3:
-                    case 4:
-                        value_offset = (offset + 3) & ~3;
-                        break;
-                    case 5:
-                    case 6:
-                    case 7:
-                    case 8:
-                    default:
-                        value_offset = (offset + 7) & ~7;
-                        break;
-                }
+                std::tie(key_offset, value_offset) = stdMapNodeOffsets(keytype_size, key_alignment, value_alignment);
             }
             uintptr_t node_ptr{0};
             size_t key_offset{0};
@@ -260,7 +271,7 @@ namespace S2Plugin
         }
         bool contains(Key k) const
         {
-            Node f = find(v);
+            Node f = find(k);
             if (f == end())
                 return false;
             else
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace S2Plugin
+{
+    // Whole std::map (or std::set) read in one go, instead of few reads per node for every step of the StdMap iterator
+    // the tree is walked breadth first, all the nodes of one level are read with a single bulk read (neighbouring nodes merged into one range)
+    // the entries are kept in the map order, so find is a binary search and pagination just an index
+    // this should only ever be used as temporary, the data is as old as the last read()
+    class StdMapSnapshot
+    {
+      public:
+        static constexpr size_t npos = ~size_t{0};
+
+        // alignments as for the StdMap, value alignment 0 for std::set
+        // value bytes are only copied when valueSize is not 0, valuePtr works either way
+        StdMapSnapshot(size_t keySize, uint8_t keyAlignment, size_t valueSize, uint8_t valueAlignment);
+
+        // returns false if the tree could not be read whole (or does not match the size of the map), the snapshot is empty then
+        bool read(uintptr_t mapAddr);
+        void clear();
+
+        size_t size() const noexcept
+        {
+            return mNodes.size();
+        }
+        bool empty() const noexcept
+        {
+            return mNodes.empty();
+        }
+        uintptr_t nodePtr(size_t index) const
+        {
+            return mNodes[index];
+        }
+        uintptr_t keyPtr(size_t index) const
+        {
+            return mNodes[index] + mKeyOffset;
+        }
+        uintptr_t valuePtr(size_t index) const
+        {
+            return mNodes[index] + mValueOffset;
+        }
+        const uint8_t* keyData(size_t index) const
+        {
+            return mEntries.data() + index * entrySize();
+        }
+        const uint8_t* valueData(size_t index) const
+        {
+            return mEntries.data() + index * entrySize() + mKeySize;
+        }
+        template <typename Key>
+        Key key(size_t index) const
+        {
+            Key key;
+            std::memcpy(&key, keyData(index), sizeof(Key));
+            return key;
+        }
+        template <typename Value>
+        Value value(size_t index) const
+        {
+            Value value;
+            std::memcpy(&value, valueData(index), sizeof(Value));
+            return value;
+        }
+        // index of the key, npos if not in the map, Key needs to be ordered the same as in the map (std::less)
+        template <typename Key>
+        size_t find(Key k) const
+        {
+            size_t first = 0;
+            size_t count = size();
+            while (count > 0)
+            {
+                size_t step = count / 2;
+                if (key<Key>(first + step) < k)
+                {
+                    first += step + 1;
+                    count -= step + 1;
+                }
+                else
+                    count = step;
+            }
+            return first < size() && key<Key>(first) == k ? first : npos;
+        }
+
+      private:
+        size_t entrySize() const noexcept
+        {
+            return mKeySize + mValueSize;
+        }
+
+        size_t mKeySize;
+        size_t mValueSize;
+        size_t mKeyOffset;
+        size_t mValueOffset;
+        // in the map order
+        std::vector<uintptr_t> mNodes;
+        // key and value bytes of every node, in the map order
+        std::vector<uint8_t> mEntries;
+    };
+} // namespace S2Plugin
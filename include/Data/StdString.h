@@ -1,6 +1,6 @@
 #pragma once
 
-#include "pluginmain.h"
+#include "read_helpers.h"
 #include <cstdint>
 #include <string>
 
@@ -12,7 +12,7 @@ namespace S2Plugin
         explicit StdBasicString(size_t addr) : addr(addr){};
         size_t size() const
         {
-            return Script::Memory::ReadQword(addr + 0x10);
+            return Read<uintptr_t>(addr + 0x10);
         }
         size_t length() const
         {
@@ -20,7 +20,7 @@ namespace S2Plugin
         }
         size_t capacity() const
         {
-            return Script::Memory::ReadQword(addr + 0x18);
+            return Read<uintptr_t>(addr + 0x18);
         }
         size_t begin() const
         {
@@ -39,7 +39,7 @@ namespace S2Plugin
             // test if string is in SSO mode (Short String Optimization)
             // note: this is implementation specific, for std::string MSVC the capacity will be 15, for clang it might be as high as 22
             if (capacity() > std::basic_string<T>{}.capacity())
-                return Script::Memory::ReadQword(addr);
+                return Read<uintptr_t>(addr);
 
             return addr;
         }
@@ -51,7 +51,7 @@ namespace S2Plugin
             buffer.resize(string_length);
             if (string_length != 0)
             {
-                Script::Memory::Read(string_addr, buffer.data(), string_length * sizeof(T), nullptr);
+                ReadMemory(string_addr, buffer.data(), string_length * sizeof(T));
             }
             return buffer;
         }
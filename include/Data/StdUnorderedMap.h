@@ -1,6 +1,6 @@
 #pragma once
 
-#include "pluginmain.h"
+#include "read_helpers.h"
 #include <cstdint>
 #include <utility>
 
@@ -37,7 +37,7 @@ namespace S2Plugin
                     break;
             }
             uintptr_t data[2];
-            Script::Memory::Read(address + sizeof(uintptr_t), &data, sizeof(data), nullptr);
+            ReadMemory(address + sizeof(uintptr_t), &data, sizeof(data));
             _end.mNodeAddress = data[0];
             _end.mValueOffset = offset;
             mSize = data[1];
@@ -65,20 +65,20 @@ namespace S2Plugin
             }
             Node next() const
             {
-                return Node(Script::Memory::ReadQword(mNodeAddress), mValueOffset);
+                return Node(Read<uintptr_t>(mNodeAddress), mValueOffset);
             }
             Node prev() const
             {
-                return Node(Script::Memory::ReadQword(mNodeAddress + sizeof(uintptr_t)), mValueOffset);
+                return Node(Read<uintptr_t>(mNodeAddress + sizeof(uintptr_t)), mValueOffset);
             }
             Node& operator++()
             {
-                mNodeAddress = Script::Memory::ReadQword(mNodeAddress);
+                mNodeAddress = Read<uintptr_t>(mNodeAddress);
                 return *this;
             }
             Node& operator--()
             {
-                mNodeAddress = Script::Memory::ReadQword(mNodeAddress + sizeof(uintptr_t));
+                mNodeAddress = Read<uintptr_t>(mNodeAddress + sizeof(uintptr_t));
                 return *this;
             }
             bool operator==(const Node& other) const
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct MemoryField;
+    class Configuration;
+
+    // Flattened field offsets for the structs from json, built once per Configuration
+    // every struct maps each dotted path that does not go thru a pointer ("camera.focus_x") to its offset
+    // so resolving a path needs one hash lookup per segment and a memory read only for the pointer hops
+    class FieldOffsetIndex
+    {
+      public:
+        struct Entry
+        {
+            uintptr_t offset;
+            const MemoryField* field;
+            // fields of the pointed to struct, or of the element type for Array and Matrix
+            const std::vector<MemoryField>* children{nullptr};
+            size_t elementSize{0};
+            bool elementIsPointer{false};
+        };
+
+        void build(const Configuration& config);
+        void clear();
+        // only the field vectors owned by the Configuration are indexed
+        bool contains(const std::vector<MemoryField>& fields) const
+        {
+            return mStructs.find(&fields) != mStructs.end();
+        }
+        // resolves path like "layer0.entities_by_mask" or "items[3].x", pointers are dereferenced along the way (except the last field)
+        // Array element is addressed by [index], Matrix element by [row][column]
+        // returns nullopt if the path does not exist
+        std::optional<uintptr_t> resolve(const std::vector<MemoryField>& fields, std::string_view path, uintptr_t addr) const;
+
+      private:
+        using Paths = std::unordered_map<std::string_view, Entry>;
+
+        void addFields(const Configuration& config, Paths& paths, const std::vector<MemoryField>& fields, const std::string& prefix, uintptr_t offset);
+
+        std::unordered_map<const std::vector<MemoryField>*, Paths> mStructs;
+        // storage for the keys, deque does not move the strings when growing
+        std::deque<std::string> mPathNames;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace S2Plugin
+{
+    // Handle to a string in the global string pool, used for the type and field names in MemoryField
+    // equal strings always get the same id, so comparing two interned strings is just comparing the ids
+    // the pool only grows, strings are never removed from it, so only intern names that come from the json config
+    // names built at runtime (container elements, uids, array indexes) should stay std::string
+    // note: interning is thread safe, reading the string is lock free
+    class InternedString
+    {
+      public:
+        InternedString() = default;
+        explicit InternedString(std::string_view str) : mID(intern(str)){};
+        InternedString& operator=(std::string_view str)
+        {
+            mID = intern(str);
+            return *this;
+        }
+        InternedString& operator=(char c)
+        {
+            mID = intern(std::string_view{&c, 1});
+            return *this;
+        }
+
+        // returns empty string when `str` was never interned, does not add it to the pool
+        static InternedString lookup(std::string_view str);
+
+        const std::string& str() const noexcept;
+        operator const std::string&() const noexcept
+        {
+            return str();
+        }
+        std::string_view view() const noexcept
+        {
+            return str();
+        }
+        const char* c_str() const noexcept
+        {
+            return str().c_str();
+        }
+        size_t size() const noexcept
+        {
+            return str().size();
+        }
+        bool empty() const noexcept
+        {
+            return mID == 0;
+        }
+        // stable for the whole session, usable as array index, 0 is the empty string
+        uint32_t id() const noexcept
+        {
+            return mID;
+        }
+
+        bool operator==(const InternedString& other) const noexcept
+        {
+            return mID == other.mID;
+        }
+        bool operator!=(const InternedString& other) const noexcept
+        {
+            return mID != other.mID;
+        }
+
+      private:
+        static uint32_t intern(std::string_view str);
+
+        uint32_t mID{0};
+    };
+
+    inline bool operator==(const InternedString& lhs, std::string_view rhs)
+    {
+        return lhs.view() == rhs;
+    }
+    inline bool operator==(std::string_view lhs, const InternedString& rhs)
+    {
+        return lhs == rhs.view();
+    }
+    inline bool operator!=(const InternedString& lhs, std::string_view rhs)
+    {
+        return lhs.view() != rhs;
+    }
+    inline bool operator!=(std::string_view lhs, const InternedString& rhs)
+    {
+        return lhs != rhs.view();
+    }
+    inline std::string operator+(const std::string& lhs, const InternedString& rhs)
+    {
+        return lhs + rhs.str();
+    }
+    inline std::string operator+(const InternedString& lhs, std::string_view rhs)
+    {
+        std::string result{lhs.str()};
+        result += rhs;
+        return result;
+    }
+    inline std::string operator+(const InternedString& lhs, char rhs)
+    {
+        return lhs.str() + rhs;
+    }
+    std::ostream& operator<<(std::ostream& stream, const InternedString& str);
+} // namespace S2Plugin
+
+template <>
+struct std::hash<S2Plugin::InternedString>
+{
+    size_t operator()(const S2Plugin::InternedString& str) const noexcept
+    {
+        return std::hash<uint32_t>{}(str.id());
+    }
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace S2Plugin
+{
+    // Locations of the lookups (after_bundle and the signatures) resolved in the previous sessions, as offsets from the module base
+    // keyed by the PE timestamp and hash of the .text section samples, kept for the last few builds of the game
+    // the locations are only a hint, every one is probed before use and a full scan is done if any of them does not match
+    class LookupCache
+    {
+      public:
+        static constexpr uint32_t magic = 0x434C3253; // "S2LC"
+        // bump when changing the file layout
+        static constexpr uint32_t version = 1;
+        static constexpr size_t maxBuilds = 8;
+
+        struct Key
+        {
+            uint32_t timestamp{0};
+            uint64_t codeHash{0};
+
+            bool operator==(const Key& other) const
+            {
+                return timestamp == other.timestamp && codeHash == other.codeHash;
+            }
+        };
+
+        static uint64_t hashCode(const void* data, size_t size);
+        // returns false if there is no entry for the build, 0 in rvas for the lookups that were not found
+        static bool load(const std::filesystem::path& path, const Key& key, std::vector<uint32_t>& rvas);
+        // replaces the entry of the build, the oldest build is dropped if there is more than maxBuilds
+        static bool save(const std::filesystem::path& path, const Key& key, const std::vector<uint32_t>& rvas);
+
+      private:
+        struct Entry
+        {
+            Key key;
+            std::vector<uint32_t> rvas;
+        };
+        static std::vector<Entry> readEntries(const std::filesystem::path& path);
+    };
+} // namespace S2Plugin
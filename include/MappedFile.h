@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace S2Plugin
+{
+    // read only memory mapping of a whole file
+    class MappedFile
+    {
+      public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& path)
+        {
+            open(path);
+        }
+        ~MappedFile()
+        {
+            close();
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const
+        {
+            return mData != nullptr;
+        }
+        const uint8_t* data() const
+        {
+            return mData;
+        }
+        size_t size() const
+        {
+            return mSize;
+        }
+
+      private:
+        uint8_t* mData{nullptr};
+        size_t mSize{0};
+#ifdef _WIN32
+        void* mFile{nullptr};
+        void* mMapping{nullptr};
+#endif
+    };
+
+    // append only file written thru memory mapped views
+    // the file grows in chunks, so appending is just a memcpy most of the time, close() truncates it to the written size
+    class MappedFileWriter
+    {
+      public:
+        static constexpr size_t defaultChunkSize = 4 * 1024 * 1024;
+
+        MappedFileWriter() = default;
+        ~MappedFileWriter()
+        {
+            close();
+        }
+        MappedFileWriter(const MappedFileWriter&) = delete;
+        MappedFileWriter& operator=(const MappedFileWriter&) = delete;
+
+        // creates new or truncates existing file
+        bool create(const std::string& path, size_t chunkSize = defaultChunkSize);
+        void close();
+
+        // returns the place to write the next size bytes to, nullptr if the file could not grow
+        // the pointer is only valid until the next call
+        uint8_t* append(size_t size);
+        // overwrites already appended data (like a header)
+        bool writeAt(uint64_t offset, const void* data, size_t size);
+
+        bool isOpen() const
+        {
+#ifdef _WIN32
+            return mFile != nullptr;
+#else
+            return mFd != -1;
+#endif
+        }
+        // appended bytes
+        uint64_t size() const
+        {
+            return mSize;
+        }
+
+      private:
+        // maps view that contains [offset, offset + size), grows the file if needed
+        bool mapView(uint64_t offset, size_t size);
+        void unmapView();
+        bool resize(uint64_t size);
+
+        uint8_t* mView{nullptr};
+        uint64_t mViewOffset{0};
+        size_t mViewSize{0};
+        uint64_t mSize{0};
+        uint64_t mFileSize{0};
+        size_t mChunkSize{defaultChunkSize};
+#ifdef _WIN32
+        void* mFile{nullptr};
+        void* mMapping{nullptr};
+#else
+        int mFd{-1};
+#endif
+    };
+} // namespace S2Plugin
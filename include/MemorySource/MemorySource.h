@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace S2Plugin
+{
+    struct MemoryReadRequest
+    {
+        uintptr_t addr;
+        void* dest;
+        size_t size;
+    };
+
+    // Backend for all the game memory reads
+    // the live debugger is just one of the implementations, the rest allow to use the data layer without x64dbg
+    class MemorySource
+    {
+      public:
+        virtual ~MemorySource() = default;
+
+        // returns false if the memory could not be read, the destination is zeroed then
+        virtual bool read(uintptr_t addr, void* dest, size_t size) = 0;
+        // returns the number of successful reads
+        virtual size_t readBulk(const MemoryReadRequest* requests, size_t count);
+        virtual bool isValidPtr(uintptr_t addr) = 0;
+
+        // current source, never null
+        static MemorySource& get();
+        // replaces the current source, passing nullptr restores the default (empty) one
+        // not thread safe, should only be done when nothing is reading the memory
+        static void set(std::unique_ptr<MemorySource> source);
+    };
+} // namespace S2Plugin
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "MemorySource/MemorySource.h"
+#include <atomic>
+#include <vector>
+
+namespace S2Plugin
+{
+    // base for the sources that keep the whole memory image as a list of regions in the plugin process
+    class RegionMemorySource : public MemorySource
+    {
+      public:
+        bool read(uintptr_t addr, void* dest, size_t size) override;
+        bool isValidPtr(uintptr_t addr) override;
+
+      protected:
+        struct Region
+        {
+            uintptr_t base;
+            size_t size;
+            uint8_t* data;
+        };
+        // regions must not overlap
+        void addRegion(uintptr_t base, size_t size, uint8_t* data);
+        void clearRegions()
+        {
+            mRegions.clear();
+            mLastRegion.store(0, std::memory_order_relaxed);
+        }
+        // returns nullptr if the address is not mapped
+        const Region* findRegion(uintptr_t addr) const;
+
+      private:
+        // sorted by base
+        std::vector<Region> mRegions;
+        // last found region, reads tend to stay in the same one
+        // only a hint, atomic since the sources are read from the sampler and scan threads too
+        mutable std::atomic<size_t> mLastRegion{0};
+    };
+} // namespace S2Plugin
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "MemorySource/RegionMemorySource.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace S2Plugin
+{
+    // memory image saved to a file, the file is memory mapped so opening even big snapshots is instant
+    // file layout (little endian):
+    //   header: magic "S2MS", uint32 version, uint64 region count
+    //   region table: uint64 base, uint64 size, uint64 file offset (for each region)
+    //   region data
+    class SnapshotMemorySource : public RegionMemorySource
+    {
+      public:
+        static constexpr uint32_t magic = 0x534D3253; // "S2MS"
+        static constexpr uint32_t version = 1;
+
+        explicit SnapshotMemorySource(const std::string& path);
+
+        bool isOpen() const
+        {
+            return mFile.isOpen();
+        }
+        // reads given regions (base, size) from the source and saves them as snapshot file
+        // regions that can't be read are skipped
+        static bool capture(const std::string& path, MemorySource& source, const std::vector<std::pair<uintptr_t, size_t>>& regions);
+
+      private:
+        void close();
+
+        MappedFile mFile;
+    };
+} // namespace S2Plugin
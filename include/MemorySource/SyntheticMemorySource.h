@@ -0,0 +1,27 @@
+#pragma once
+
+#include "MemorySource/RegionMemorySource.h"
+#include <memory>
+#include <vector>
+
+namespace S2Plugin
+{
+    // memory built by hand in the plugin process, for benchmarks and tests
+    class SyntheticMemorySource : public RegionMemorySource
+    {
+      public:
+        // allocates zeroed region, returns pointer to it's data
+        uint8_t* map(uintptr_t base, size_t size);
+        // returns false if the range is not fully mapped
+        bool write(uintptr_t addr, const void* src, size_t size);
+        template <typename T>
+        bool write(uintptr_t addr, const T& value)
+        {
+            return write(addr, &value, sizeof(T));
+        }
+        void clear();
+
+      private:
+        std::vector<std::unique_ptr<uint8_t[]>> mBuffers;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "MemorySource/MemorySource.h"
+
+namespace S2Plugin
+{
+    // reads from the process attached to x64dbg
+    class X64dbgMemorySource : public MemorySource
+    {
+      public:
+        bool read(uintptr_t addr, void* dest, size_t size) override;
+        bool isValidPtr(uintptr_t addr) override;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace S2Plugin
+{
+    // Minimum and maximum of any range of samples without visiting every sample
+    // level 0 holds min/max of every branching samples, every next level of branching blocks of the level below
+    // it's built incrementally while the samples are appended, the samples themselves are not stored
+    // the values are kept as double, the same value valueAt gives for any column type, ~2.3 byte per sample
+    class MinMaxPyramid
+    {
+      public:
+        static constexpr size_t branching = 8;
+
+        // non finite values are counted, but never part of the min/max
+        void append(double value);
+        void clear();
+
+        size_t size() const noexcept
+        {
+            return mSize;
+        }
+        // min and max of the samples [first, last), sample(index) has to return the sample value
+        // only the unaligned ends touch the samples directly, the rest is taken from the levels
+        // returns {inf, -inf} when there is no finite value in the range
+        template <typename SampleFunction>
+        std::pair<double, double> range(size_t first, size_t last, SampleFunction&& sample) const
+        {
+            double low = std::numeric_limits<double>::infinity();
+            double high = -std::numeric_limits<double>::infinity();
+            if (last > mSize)
+                last = mSize;
+
+            auto takeSample = [&](size_t index)
+            {
+                double value = sample(index);
+                if (std::isfinite(value))
+                {
+                    low = value < low ? value : low;
+                    high = value > high ? value : high;
+                }
+            };
+            auto takeBlock = [&](const Block& block)
+            {
+                low = block.low < low ? block.low : low;
+                high = block.high > high ? block.high : high;
+            };
+
+            // the samples themselves, up to the first level alignment
+            size_t nextBlockSize = branching;
+            if (mLevels.empty())
+            {
+                for (; first < last; ++first)
+                    takeSample(first);
+                return {low, high};
+            }
+            for (; first < last && first % nextBlockSize != 0; ++first)
+                takeSample(first);
+            for (; last > first && last % nextBlockSize != 0; --last)
+                takeSample(last - 1);
+
+            size_t blockSize = nextBlockSize;
+            for (size_t level = 0; first < last; ++level)
+            {
+                const auto& blocks = mLevels[level];
+                if (level + 1 == mLevels.size())
+                {
+                    // top level, no more aligning
+                    for (; first < last; first += blockSize)
+                        takeBlock(blocks[first / blockSize]);
+                    break;
+                }
+                nextBlockSize = blockSize * branching;
+                for (; first < last && first % nextBlockSize != 0; first += blockSize)
+                    takeBlock(blocks[first / blockSize]);
+                for (; last > first && last % nextBlockSize != 0; last -= blockSize)
+                    takeBlock(blocks[last / blockSize - 1]);
+                blockSize = nextBlockSize;
+            }
+            return {low, high};
+        }
+
+      private:
+        struct Block
+        {
+            double low{std::numeric_limits<double>::infinity()};
+            double high{-std::numeric_limits<double>::infinity()};
+        };
+
+        std::vector<std::vector<Block>> mLevels;
+        size_t mSize{0};
+    };
+} // namespace S2Plugin
@@ -31,6 +31,7 @@ class QTreeWidget;
 
 namespace S2Plugin
 {
+    class ReadPlan;
     using ID_type = uint32_t;
 
     class AbstractDatabaseView : public QWidget
@@ -84,7 +85,10 @@ namespace S2Plugin
 
         void populateComparisonTableWidget(const QVariant& fieldData);
         void populateComparisonTreeWidget(const QVariant& fieldData);
-        size_t populateComparisonComboBox(const std::vector<MemoryField>& fields, size_t offset = 0, std::string prefix = {});
-        static std::pair<QString, QVariant> valueForField(const QVariant& data, uintptr_t addr);
+        // adds the fields of the compiled struct plan, fields of the structs inside of the record with "struct." prefix
+        void populateComparisonComboBox(uint32_t planId, size_t offset = 0, std::string prefix = {});
+        // the chosen field of every valid record, read in bulk, plan.data(i) is the value of ids[i]
+        void readComparisonValues(const QVariant& fieldData, std::vector<ID_type>& ids, ReadPlan& plan) const;
+        static std::pair<QString, QVariant> valueForField(const QVariant& data, const uint8_t* buffer);
     };
 } // namespace S2Plugin
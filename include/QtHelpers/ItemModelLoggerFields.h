@@ -28,6 +28,14 @@ namespace S2Plugin
         {
             endInsertRows();
         }
+        void resetRows()
+        {
+            beginResetModel();
+        }
+        void resetRowsEnd()
+        {
+            endResetModel();
+        }
         Qt::ItemFlags flags(const QModelIndex&) const override
         {
             return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
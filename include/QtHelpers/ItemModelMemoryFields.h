@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Configuration.h"
+#include <QStandardItemModel>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace S2Plugin
+{
+    class TreeViewMemoryFields;
+
+    // Model for the TreeViewMemoryFields
+    // struct fields are only added as items when the struct is expanded for the first time
+    // until then the struct row only keeps the fields it will have, big structs (State, LevelGen) open without creating items for every collapsed subtree
+    // rows that are added are still nine QStandardItems each, with the display strings set when the row is updated, not produced in data()
+    class ItemModelMemoryFields : public QStandardItemModel
+    {
+        Q_OBJECT
+      public:
+        struct PendingChildren
+        {
+            std::vector<MemoryField> fields;
+            std::string name;
+            size_t delta;
+            uint8_t deltaPrefixCount;
+        };
+
+        ItemModelMemoryFields(TreeViewMemoryFields* tree, QObject* parent = nullptr) : QStandardItemModel(parent), mTree(tree){};
+
+        bool hasChildren(const QModelIndex& parent = QModelIndex()) const override
+        {
+            return QStandardItemModel::hasChildren(parent) || hasPendingChildren(itemFromIndex(parent));
+        }
+        bool canFetchMore(const QModelIndex& parent) const override
+        {
+            return hasPendingChildren(itemFromIndex(parent));
+        }
+        void fetchMore(const QModelIndex& parent) override;
+
+        void setPendingChildren(const QStandardItem* item, PendingChildren children)
+        {
+            mPendingChildren.insert_or_assign(item, std::move(children));
+        }
+        bool hasPendingChildren(const QStandardItem* item) const
+        {
+            return item != nullptr && mPendingChildren.find(item) != mPendingChildren.end();
+        }
+        // removes the pending children, returns false if there were none
+        bool takePendingChildren(const QStandardItem* item, PendingChildren& children);
+        void clearPendingChildren()
+        {
+            mPendingChildren.clear();
+        }
+        size_t pendingCount() const noexcept
+        {
+            return mPendingChildren.size();
+        }
+
+      private:
+        TreeViewMemoryFields* mTree;
+        std::unordered_map<const QStandardItem*, PendingChildren> mPendingChildren;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Configuration.h"
+#include <QMetaType>
+#include <cstdint>
+#include <string>
+
+namespace S2Plugin
+{
+    constexpr uint8_t gsColField = 0;
+    constexpr uint8_t gsColValue = 1;
+    constexpr uint8_t gsColValueHex = 2;
+    constexpr uint8_t gsColComparisonValue = 3;
+    constexpr uint8_t gsColComparisonValueHex = 4;
+    constexpr uint8_t gsColMemoryAddress = 5;
+    constexpr uint8_t gsColMemoryAddressDelta = 6;
+    constexpr uint8_t gsColType = 7;
+    constexpr uint8_t gsColComment = 8;
+
+    /*
+     * [[ Roles explanation: ]]
+     * The first 5 roles are all saved to the name field
+     * those are used as information about the row
+     * memory address in the name field are used just for row update and shouldn't really be used for anything else
+     *
+     * value, comparison value, memoryAddress and delta fields all should contain the `gsRoleRawValue` data
+     * (may differ with some special types)
+     *
+     * valueHex and comparison valueHex contain `gsRoleRawValue` only when it's a pointer (used for update check and click event)
+     * value and comparison value also contain `gsRoleMemoryAddress` for field editing purposes
+     * for pointers, that will be the pointer value, not memory address of the pointer
+     *
+     * The rest of the roles are type specific
+     */
+
+    constexpr uint16_t gsRoleType = Qt::UserRole + 0;
+    constexpr uint16_t gsRoleMemoryAddress = Qt::UserRole + 1;
+    constexpr uint16_t gsRoleComparisonMemoryAddress = Qt::UserRole + 2;
+    constexpr uint16_t gsRoleIsPointer = Qt::UserRole + 3;
+    constexpr uint16_t gsRoleUID = Qt::UserRole + 4;
+    constexpr uint16_t gsRoleRawValue = Qt::UserRole + 5;
+
+    constexpr uint16_t gsRoleFlagIndex = Qt::UserRole + 6;
+    constexpr uint16_t gsRoleRefName = Qt::UserRole + 7; // ref name for flags, states and vtable
+    constexpr uint16_t gsRoleStdContainerFirstParameterType = Qt::UserRole + 8;
+    constexpr uint16_t gsRoleStdContainerSecondParameterType = Qt::UserRole + 9;
+    constexpr uint16_t gsRoleSize = Qt::UserRole + 10;
+    constexpr uint16_t gsRoleColumns = Qt::UserRole + 11;       // for Matrix
+    constexpr uint16_t gsRoleEntityAddress = Qt::UserRole + 12; // for entity uid to not look for the uid twice
+    constexpr uint16_t gsRoleStale = Qt::UserRole + 13;         // row was out of the view during refresh, updated when scrolled into view
+    constexpr uint16_t gsRoleCellStyle = Qt::UserRole + 14;     // CellStyle, for the StyledItemDelegateMemoryFields
+
+    // how the text of the cell is drawn, the tree stores plain text and the style instead of html
+    enum class CellStyle : uint8_t
+    {
+        Plain = 0,
+        Link,         // blue underlined, clickable address or record
+        CodeLink,     // green underlined, pointer into the game code
+        Muted,        // grey, nullptr and bad ptr
+        MutedLink,    // grey underlined, [Expand] and empty containers
+        CollapseLink, // dark magenta underlined, [Collapse]
+        Bold,
+        True,  // green
+        False, // red
+        Flags, // Y/N for every bit of gsRoleRawValue, the text is not used
+    };
+
+    Q_DECLARE_METATYPE(S2Plugin::MemoryFieldType);
+    Q_DECLARE_METATYPE(std::string);
+} // namespace S2Plugin
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QSize>
+#include <QStyledItemDelegate>
+
+class QModelIndex;
+class QPainter;
+class QStyleOptionViewItem;
+
+namespace S2Plugin
+{
+    // Draws the cells of the memory field trees straight with QPainter
+    // colors and underline come from the gsRoleCellStyle of the cell, flags are drawn from the raw value
+    // no QTextDocument layout for every cell on every paint like with StyledItemDelegateHTML
+    class StyledItemDelegateMemoryFields : public QStyledItemDelegate
+    {
+        Q_OBJECT
+      public:
+        using QStyledItemDelegate::QStyledItemDelegate;
+
+      protected:
+        void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+        QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    };
+} // namespace S2Plugin
@@ -1,19 +1,23 @@
 #pragma once
 
 #include "Configuration.h"
+#include "RowRefresh.h"
+#include "SnapshotDiff.h"
 #include <QTreeView>
 #include <array>
 #include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_set>
 #include <vector>
 
-class QStandardItemModel;
 class QStandardItem;
 
 namespace S2Plugin
 {
+    class ItemModelMemoryFields;
+
     constexpr char* gsDragDropMemoryField_UID = "uid";
     constexpr char* gsDragDropMemoryField_Address = "addr";
     constexpr char* gsDragDropMemoryField_Type = "type";
@@ -50,12 +54,28 @@ namespace S2Plugin
     {
         Q_OBJECT
       public:
+        struct RefreshStatistics
+        {
+            uint32_t rowsTouched{0};
+            uint32_t rowsSkipped{0};
+            uint32_t rowsCulled{0};
+            size_t changedBytes{0};
+            size_t snapshotSize{0};
+            double milliseconds{0.0};
+        };
+
         explicit TreeViewMemoryFields(QWidget* parent = nullptr);
 
         void addMemoryFields(const std::vector<MemoryField>& fields, const std::string& mainName, uintptr_t structAddr, size_t initialDelta = 0, uint8_t deltaPrefixCount = 0,
                              QStandardItem* parent = nullptr);
         QStandardItem* addMemoryField(const MemoryField& field, const std::string& fieldNameOverride, uintptr_t memoryAddress, size_t delta, uint8_t deltaPrefixCount = 0,
                                       QStandardItem* parent = nullptr);
+        // same as addMemoryField but shows `name` instead of field.name, for rows named at runtime (container elements, uids, array indexes)
+        // so those names don't end up in the InternedString pool, which never shrinks
+        QStandardItem* addNamedMemoryField(const MemoryField& field, const std::string& name, const std::string& fieldNameOverride, uintptr_t memoryAddress, size_t delta,
+                                           uint8_t deltaPrefixCount = 0, QStandardItem* parent = nullptr);
+        // one row of the matrix as an array field, shows all of the elements
+        static MemoryField matrixRowField(const MemoryField& matrix);
         void clear();
         void updateTableHeader(bool restoreColumnWidths = true);
         void setEnableChangeHighlighting(bool b) noexcept
@@ -71,6 +91,15 @@ namespace S2Plugin
                        bool disableChangeHighlightingForField = false);
         void labelAll(std::string_view prefix);
         void expandLast();
+        const RefreshStatistics& refreshStatistics() const noexcept
+        {
+            return mRefreshStatistics;
+        }
+        void setShowRefreshStatistics(bool b);
+        // adds the struct fields that were left out until the item is expanded, returns false if there were none
+        bool fetchChildren(QStandardItem* item);
+        // adds all of the fields of the whole tree, for when every field has to be visited
+        void fetchAllChildren(QStandardItem* parent = nullptr);
 
       public slots:
         void labelAll() // for the slots so we don't corrupt the parameters
@@ -91,6 +120,8 @@ namespace S2Plugin
         void startDrag(Qt::DropActions supportedActions) override;
         void drawBranches(QPainter* painter, const QRect& rect, const QModelIndex& index) const override;
         void mouseMoveEvent(QMouseEvent* event) override;
+        void keyPressEvent(QKeyEvent* event) override;
+        void paintEvent(QPaintEvent* event) override;
       signals:
         void memoryFieldValueUpdated(int row, QStandardItem* parent);
         void levelGenRoomsPointerClicked();
@@ -98,6 +129,21 @@ namespace S2Plugin
 
       private:
         bool isItemClickable(const QModelIndex& index) const;
+        // struct fields are added as items on the first expand
+        void addChildFields(const std::vector<MemoryField>& fields, const std::string& mainName, size_t delta, uint8_t deltaPrefixCount, QStandardItem* parent);
+        // reads the root struct for the snapshot diff, returns false if there is nothing to diff
+        bool updateSnapshot(SnapshotDiff& snapshot, uintptr_t rootAddr);
+        void resetSnapshots() noexcept
+        {
+            mSnapshot.reset();
+            mComparisonSnapshot.reset();
+        }
+        // rows updated between the ticks read the root struct from the snapshots, so the next diff compares with what they show
+        void primeSnapshotReads() const;
+        // rows in the viewport plus a margin above and below, returns false if the tree is not visible
+        bool collectVisibleRows();
+        // updates the rows skipped by the refresh that are now in the view
+        void refreshStaleRows();
 
       public:
         ColumnFilter mActiveColumns;
@@ -106,6 +152,20 @@ namespace S2Plugin
         bool mEnableChangeHighlighting = true;
         bool mDrawTopBranch = true;
         std::array<int, 9> mSavedColumnWidths = {};
-        QStandardItemModel* mModel;
+        ItemModelMemoryFields* mModel;
+
+        // root struct range relative to the first row, from the fields added at the top level
+        size_t mRootDeltaBegin{SIZE_MAX};
+        size_t mRootDeltaEnd{0};
+        // the root struct from the previous refresh, rows with unchanged bytes are not touched
+        SnapshotDiff mSnapshot;
+        SnapshotDiff mComparisonSnapshot;
+        // skipping and culling rows is only valid inside of updateTree, the snapshots are from the same tick then
+        // culled rows are only marked with gsRoleStale
+        RowRefresh mRowRefresh;
+        bool mSnapshotComparisonActive{false};
+        std::unordered_set<const QStandardItem*> mVisibleRows;
+        bool mShowRefreshStatistics{false};
+        RefreshStatistics mRefreshStatistics;
     };
 } // namespace S2Plugin
@@ -21,6 +21,7 @@ namespace S2Plugin
         void toggleAutoRefresh(bool checked);
       protected slots:
         void autoRefreshIntervalChanged(int val);
+        void refreshTick();
 
       private:
         QPushButton* mRefreshButton;
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Data/LoggerTrigger.h"
+#include <QWidget>
+
+class QSpinBox;
+class QTableWidget;
+
+namespace S2Plugin
+{
+    class Logger;
+
+    // editor of the Logger triggers, every change is applied to the Logger right away
+    class WidgetLoggerTriggers : public QWidget
+    {
+        Q_OBJECT
+      public:
+        explicit WidgetLoggerTriggers(Logger* logger, QWidget* parent = nullptr);
+
+      public slots:
+        // rebuilds the rows from the Logger, the triggers of removed fields are gone by now
+        void fieldsChanged();
+
+      private slots:
+        void addTrigger();
+        void removeTrigger();
+        void apply();
+
+      private:
+        void addRow(const LoggerTrigger& trigger);
+
+        Logger* mLogger;
+        QTableWidget* mTable;
+        QSpinBox* mPreTriggerSpinBox;
+        QSpinBox* mPostTriggerSpinBox;
+    };
+} // namespace S2Plugin
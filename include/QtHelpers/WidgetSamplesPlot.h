@@ -3,6 +3,8 @@
 #include <QMouseEvent>
 #include <QPoint>
 #include <QWidget>
+#include <cstddef>
+#include <utility>
 
 namespace S2Plugin
 {
@@ -37,7 +39,17 @@ namespace S2Plugin
         }
 
       private:
+        // x axis is the position of the kept sample, so the windows kept by the triggers are not squeezed by the gaps between them
+        // the gaps are marked with a dotted line instead
+        // more than one when the samples don't fit into the maximum plot width
+        size_t samplesPerPixel() const;
+        // kept samples [first, last) under the pixel column
+        std::pair<size_t, size_t> samplesInColumn(size_t column, size_t samplesPerPixel) const;
+
         Logger* mLogger;
+        // part of the capture the y axis was scaled to
+        size_t mPlottedFirst{0};
+        size_t mPlottedCount{0};
         QPoint mCurrentMousePos = QPoint();
     };
 } // namespace S2Plugin
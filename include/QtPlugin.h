@@ -12,6 +12,7 @@ namespace QtPlugin
     void ShowTab();
     void MenuPrepare(int hMenu);
     void MenuEntry(int hMenu);
+    void Attach();
     void Detach();
 } // namespace QtPlugin
 
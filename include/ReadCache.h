@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace S2Plugin
+{
+    // Page granular cache for the debugger memory reads
+    // the cache is only used inside of a ReadCache::Scope, every outermost scope starts with empty cache
+    // so the data is never older than the current refresh tick
+    // debug events (pause/resume) invalidate the cache for all threads
+    // note: cache is per thread, so background threads don't interfere with the GUI
+    class ReadCache
+    {
+      public:
+        static constexpr size_t pageSize = 0x1000;
+
+        // RAII helper, use at the start of refresh tick
+        // scopes can be nested, only the outermost one clears the cache
+        struct Scope
+        {
+            Scope();
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+        static bool isActive() noexcept;
+        // returns false if the memory could not be read, the destination is zeroed then
+        // reads bigger than a page are not cached and go directly to the debugger
+        static bool read(uintptr_t addr, void* dest, size_t size);
+        // hands over memory that was already read in bulk for this tick, only the pages fully inside of the range are cached
+        // does nothing outside of a scope
+        static void prime(uintptr_t addr, const void* data, size_t size);
+        // invalidate cache for the current thread
+        static void invalidate();
+        // invalidate cache for all threads, safe to call from any thread
+        static void invalidateAll() noexcept;
+        // changes every time the cached data is dropped (new outermost scope, invalidation)
+        // inside of a scope, data derived from the game memory can be kept for as long as the serial stays the same
+        static uint64_t serial() noexcept;
+
+        static uint64_t hits() noexcept;
+        static uint64_t misses() noexcept;
+        static void resetCounters() noexcept;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "MemorySource/MemorySource.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace S2Plugin
+{
+    // Reads many small blocks of memory in as few debugger calls as possible
+    // the blocks are sorted by address and the ones closer than maxGap are merged into one contiguous range
+    // planned once, then can be executed any number of times (like every Logger tick) without allocations
+    class ReadPlan
+    {
+      public:
+        // returns index of the block
+        size_t add(uintptr_t addr, size_t size);
+        // merges the blocks into ranges, reading the gap between blocks is cheaper than another debugger call
+        // ranges are not merged beyond maxRangeSize, unless the blocks overlap
+        void build(size_t maxGap, size_t maxRangeSize = 0x10000);
+        // reads all the ranges in a single bulk read
+        // if some of the ranges were not readable, every block is read alone so only the unreadable ones are zeroed
+        // returns false if some block could not be read
+        bool execute();
+        void clear();
+
+        const uint8_t* data(size_t block) const
+        {
+            return mBuffer.get() + mBlocks[block].bufferOffset;
+        }
+        size_t blockSize(size_t block) const
+        {
+            return mBlocks[block].size;
+        }
+        size_t blockCount() const noexcept
+        {
+            return mBlocks.size();
+        }
+        // number of reads one execute costs (when everything is readable)
+        size_t rangeCount() const noexcept
+        {
+            return mRequests.size();
+        }
+        size_t bufferSize() const noexcept
+        {
+            return mBufferSize;
+        }
+
+      private:
+        struct Block
+        {
+            uintptr_t addr;
+            size_t size;
+            size_t bufferOffset;
+        };
+        std::vector<Block> mBlocks;
+        std::vector<MemoryReadRequest> mRequests;
+        std::unique_ptr<uint8_t[]> mBuffer;
+        size_t mBufferSize{0};
+    };
+} // namespace S2Plugin
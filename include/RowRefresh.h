@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Configuration.h"
+#include "SnapshotDiff.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace S2Plugin
+{
+    // types where the displayed value depends only on the bytes of the field, without children or lookups in other memory
+    bool isSnapshotComparable(MemoryFieldType type);
+
+    enum class RowRefreshAction : uint8_t
+    {
+        Update,
+        // same bytes as in the previous refresh, only the change highlight is cleared
+        Skip,
+        // out of the view, marked stale and updated once it's scrolled into the view
+        Cull,
+    };
+
+    // rows in the viewport plus a margin above and below, so short scrolls don't need to catch up
+    struct VisibleRowRange
+    {
+        static constexpr size_t margin = 16;
+
+        // rows from `margin` rows above the first one in the viewport
+        static size_t rowCount(int viewportHeight, int rowHeight)
+        {
+            return static_cast<size_t>(viewportHeight > 0 ? viewportHeight : 0) / static_cast<size_t>(rowHeight > 1 ? rowHeight : 1) + 1 + 2 * margin;
+        }
+        // for the rows in one flat list, firstInView is the first row in the viewport
+        static VisibleRowRange around(size_t firstInView, int viewportHeight, int rowHeight)
+        {
+            size_t begin = firstInView > margin ? firstInView - margin : 0;
+            return {begin, begin + rowCount(viewportHeight, rowHeight)};
+        }
+        bool contains(size_t row) const noexcept
+        {
+            return row >= begin && row < end;
+        }
+
+        size_t begin;
+        size_t end;
+    };
+
+    // What TreeViewMemoryFields::updateRow does with a row, set up once per updateTree
+    struct RowRefresh
+    {
+        struct Row
+        {
+            MemoryFieldType type{MemoryFieldType::None};
+            uintptr_t address{0};
+            // 0 when the comparison columns are hidden
+            uintptr_t comparisonAddress{0};
+            bool isPointer{false};
+            // the row is moved to a new struct
+            bool newAddress{false};
+            // the row missed the previous refreshes, the snapshot can't tell if it changed
+            bool stale{false};
+            bool visible{true};
+        };
+
+        // snapshots of the root struct from the same tick, nullptr when the rows can't be skipped
+        const SnapshotDiff* snapshot{nullptr};
+        const SnapshotDiff* comparisonSnapshot{nullptr};
+        // value rows out of the view are left behind, only for the plain refresh where no row gets a new address
+        bool cull{false};
+
+        // row showing just its own bytes
+        static bool isValueOnly(const Row& row)
+        {
+            return !row.isPointer && !row.newAddress && isSnapshotComparable(row.type);
+        }
+        // flag rows only show the value of the parent, which is always updated
+        static bool isCullable(const Row& row)
+        {
+            return isValueOnly(row) || row.type == MemoryFieldType::Flag;
+        }
+        RowRefreshAction action(const Row& row) const;
+    };
+} // namespace S2Plugin
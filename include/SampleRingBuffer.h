@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace S2Plugin
+{
+    // Lock-free single producer, single consumer queue of fixed size records
+    // every record is recordWords of uint64_t, the capacity is rounded up to power of two
+    // push is only ever called from the producer thread, pop only from the consumer thread
+    class SampleRingBuffer
+    {
+      public:
+        SampleRingBuffer(size_t capacity, size_t recordWords);
+
+        // returns false if the buffer is full, the record is dropped then
+        bool push(const uint64_t* record) noexcept;
+        // copies up to maxRecords records into dest, returns the number of records copied
+        size_t pop(uint64_t* dest, size_t maxRecords) noexcept;
+
+        size_t capacity() const noexcept
+        {
+            return mMask + 1;
+        }
+        size_t recordWords() const noexcept
+        {
+            return mRecordWords;
+        }
+        // approximate when called from other thread than the consumer
+        size_t size() const noexcept
+        {
+            return mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_acquire);
+        }
+
+      private:
+        std::unique_ptr<uint64_t[]> mData;
+        size_t mMask;
+        size_t mRecordWords;
+        // producer and consumer positions on separate cache lines, they only ever grow
+        alignas(64) std::atomic<size_t> mHead{0};
+        alignas(64) std::atomic<size_t> mTail{0};
+        // each side keeps a copy of the other position to not touch the other cache line on every call
+        alignas(64) size_t mCachedTail{0};
+        alignas(64) size_t mCachedHead{0};
+    };
+} // namespace S2Plugin
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "BytePattern.h"
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace S2Plugin
+{
+    // Finds the first match of every registered signature in a single pass over a local copy of the code
+    // every signature is anchored on two fixed bytes, a position is only checked against the signatures with the same two bytes
+    // the rip relative target of the instruction in the signature is resolved from the same copy
+    class SignatureScanner
+    {
+      public:
+        // returns id of the signature, the ids are given in the order the signatures are added
+        size_t add(std::string_view pattern);
+        // displacementOffset: offset of the rel32 from the start of the match (can be negative)
+        // instructionEnd: offset of the end of the instruction the rel32 is relative to
+        size_t add(std::string_view pattern, int32_t displacementOffset, int32_t instructionEnd);
+
+        // data is the copy of the memory at base, matches are only looked for from the `from` offset on
+        // the displacements can be read from anywhere in the data
+        // with more than one thread the data is split in chunks scanned at the same time, the earliest match in the data wins
+        // the results are merged and set only after all the chunks are done
+        void scan(const uint8_t* data, size_t size, uintptr_t base, size_t from = 0, size_t threads = 1);
+        // checks the signature at the address in the game memory (like location from the previous session) instead of scanning
+        // if it matches, the signature is resolved the same as by the scan
+        bool probe(size_t id, uintptr_t match);
+        void clearResults();
+
+        // address of the first match, 0 if not found
+        uintptr_t match(size_t id) const
+        {
+            return mSignatures[id].match;
+        }
+        // address the rel32 points to, 0 if not found or the signature has no rel32
+        uintptr_t target(size_t id) const
+        {
+            return mSignatures[id].target;
+        }
+        // time from the start of the scan to when the match was found, zero if not found or probed
+        std::chrono::nanoseconds resolveTime(size_t id) const
+        {
+            return mSignatures[id].resolveTime;
+        }
+        size_t count() const noexcept
+        {
+            return mSignatures.size();
+        }
+
+      private:
+        struct Signature
+        {
+            BytePattern pattern;
+            int32_t displacementOffset{0};
+            int32_t instructionEnd{0};
+            bool hasTarget{false};
+            // offset of the two anchor bytes in the pattern, noAnchor if the pattern has no two fixed bytes in a row
+            size_t anchor{0};
+            uintptr_t match{0};
+            uintptr_t target{0};
+            std::chrono::nanoseconds resolveTime{0};
+        };
+        static constexpr size_t noAnchor = ~size_t{0};
+        static constexpr size_t notFound = ~size_t{0};
+        // chunk of the data per thread is at least this big, smaller ones are not worth the thread
+        static constexpr size_t minChunkSize = 0x100000;
+
+        // match offsets (notFound if none) of the signatures starting in [begin, end), the data after end is only read by the compare
+        void scanRange(const uint8_t* data, size_t size, size_t begin, size_t end, std::vector<size_t>& matches, std::vector<std::chrono::nanoseconds>& times,
+                       std::chrono::steady_clock::time_point started) const;
+        void buildIndex();
+        void resolve(Signature& signature, const uint8_t* data, size_t size, uintptr_t base, size_t start);
+
+        std::vector<Signature> mSignatures;
+        // signatures indexed by the two anchor bytes (little endian), mBucketStart[key] to mBucketStart[key + 1] in mBuckets
+        std::vector<uint32_t> mBucketStart;
+        std::vector<uint32_t> mBuckets;
+        std::bitset<0x10000> mAnchors;
+        // looked for after the single pass
+        std::vector<uint32_t> mUnanchored;
+        size_t mMaxAnchor{0};
+        bool mIndexDirty{true};
+    };
+} // namespace S2Plugin
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace S2Plugin
+{
+    // Copy of one memory range, kept between the refresh ticks to tell which bytes changed since the previous tick
+    // the range is read in whole pages, so it can be handed over to the ReadCache and the following reads are free
+    // changes are tracked with 8 byte granularity
+    class SnapshotDiff
+    {
+      public:
+        // reads the range (aligned to whole pages), returns false if it could not be read
+        // after the first update, range change, failed read or reset() everything is reported as changed
+        bool update(uintptr_t addr, size_t size);
+        // true if any of the bytes changed in the last update, ranges not covered by the snapshot are always changed
+        bool changed(uintptr_t addr, size_t size) const;
+        bool contains(uintptr_t addr, size_t size) const noexcept
+        {
+            return mValid && addr >= mAddr && size <= mData.size() && addr - mAddr <= mData.size() - size;
+        }
+        // hands the copy over to the ReadCache, reads in the current scope see the memory as of the last update
+        // reads between the ticks have to see the same bytes the next update compares against, does nothing after reset()
+        void primeReadCache() const;
+        // next update reports everything as changed
+        void reset() noexcept
+        {
+            mValid = false;
+            mAllChanged = true;
+        }
+
+        uintptr_t address() const noexcept
+        {
+            return mAddr;
+        }
+        size_t size() const noexcept
+        {
+            return mData.size();
+        }
+        const uint8_t* data() const noexcept
+        {
+            return mData.data();
+        }
+        // number of changed bytes in the last update (rounded to the 8 byte granularity)
+        size_t changedBytes() const noexcept
+        {
+            return mAllChanged ? mData.size() : mChangedWords * sizeof(uint64_t);
+        }
+
+      private:
+        std::vector<uint8_t> mData;
+        std::vector<uint8_t> mPrevious;
+        // one bit for every 8 bytes
+        std::vector<uint64_t> mChanged;
+        size_t mChangedWords{0};
+        uintptr_t mAddr{0};
+        bool mValid{false};
+        bool mAllChanged{true};
+    };
+} // namespace S2Plugin
@@ -6,8 +6,12 @@
 #include "Data/StringsTable.h"
 #include "Data/TextureDB.h"
 #include "Data/VirtualTableLookup.h"
+#include "SignatureScanner.h"
 #include <QString>
 #include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
 
 namespace S2Plugin
 {
@@ -15,7 +19,12 @@ namespace S2Plugin
 
     struct Spelunky2
     {
+        // takes the result of the background job if one was started, otherwise resolves the lookups on the calling thread
+        // returns nullptr (and tells so) while the background job is still running, it never waits for it
         static Spelunky2* get();
+        // starts resolving the lookups on a background thread when the debugger attaches, so the first view does not block the GUI with the scan
+        // errors are kept and displayed by get(), call from the GUI thread only
+        static void resolveInBackground();
         static void reset();
         static bool is_loaded()
         {
@@ -62,15 +71,26 @@ namespace S2Plugin
         const VirtualTableLookup& get_VirtualTableLookup();
         //
 
+        // pattern like "48 8B 05 ?? ?? ?? ??", 0 for start searches from the after_bundle, returns 0 if not found
         uintptr_t find(const char* pattern, uintptr_t start = 0, size_t size = 0) const;
         uintptr_t find_between(const char* pattern, uintptr_t start = 0, uintptr_t end = 0) const;
 
         const QString& themeNameOfOffset(uintptr_t offset);
+        // inside of a ReadCache::Scope the uid table is copied once and reused for all the lookups in the scope
         uintptr_t findEntityByUID(uint32_t uid, uintptr_t statePtr = 0);
 
       private:
         static Spelunky2* ptr;
 
+        struct Attached
+        {
+            Spelunky2* spelunky2{nullptr};
+            std::string error;
+        };
+        static std::future<Attached> attachJob;
+        // creates the instance and resolves the lookups, thread safe, returns nullptr and the message in error on failure
+        static Spelunky2* load(std::string& error);
+
         uintptr_t codeSectionStart{0};
         size_t codeSectionSize{0};
         uintptr_t afterBundle{0};
@@ -91,7 +111,33 @@ namespace S2Plugin
         StringsTable mStringsTable;
         VirtualTableLookup mVirtualTableLookup;
 
-        static uintptr_t getAfterBundle(uintptr_t sectionStart, size_t sectionSize);
+        // signatures of the lookups, found in a single pass over the copy of the code when attaching
+        // same order as added to the scanner in addSignatures
+        enum SIGNATURE : size_t
+        {
+            GAME_MANAGER,
+            ENTITY_DB,
+            TEXTURE_DB,
+            ONLINE,
+            PARTICLE_DB,
+            CHARACTER_DB,
+            STRINGS_TABLE,
+            VIRTUAL_TABLE,
+            GAME_API,
+            HUD,
+            SAVE_STATES,
+            DEBUG_SETTINGS,
+        };
+        SignatureScanner mSignatures;
+
+        static uintptr_t getAfterBundle(const std::vector<uint8_t>& code, uintptr_t codeStart);
+        void addSignatures();
+        void logResolveTimes() const;
+        // sets after_bundle and the signatures from the locations cached in the previous session
+        // returns false if any of them does not match the code any more
+        bool probeLookups(uintptr_t moduleBase, const std::vector<uint32_t>& rvas);
+        // after_bundle followed by the signature matches, 0 for the ones not found
+        std::vector<uint32_t> lookupRVAs(uintptr_t moduleBase) const;
 
         Spelunky2() = default;
         ~Spelunky2(){};
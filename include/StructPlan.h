@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct MemoryField;
+    class Configuration;
+
+    // how the bytes of a field are turned into a value, None for the fields that are not a single number
+    enum class FieldDecoder : uint8_t
+    {
+        None,
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float,
+        Double,
+        Bool,
+    };
+
+    struct StructPlanInstruction
+    {
+        uint32_t offset;
+        uint32_t size;
+        // plan of the struct this field is (or points to), StructPlans::noPlan if none
+        uint32_t childPlan;
+        FieldDecoder decoder;
+        // field is a pointer, childPlan applies to the memory it points to
+        bool pointerHop;
+        const MemoryField* field;
+    };
+
+    struct StructPlan
+    {
+        std::vector<StructPlanInstruction> instructions;
+        size_t size{0};
+    };
+
+    // Every struct from json compiled into a flat list of fields with the offsets, sizes and decoders resolved, built once per Configuration
+    // the struct is read with one bulk read and the plan is executed over the buffer, no type switch or size calculation per field
+    class StructPlans
+    {
+      public:
+        static constexpr uint32_t noPlan = (std::numeric_limits<uint32_t>::max)();
+
+        void build(const Configuration& config);
+        void clear();
+        // only the field vectors owned by the Configuration have a plan
+        uint32_t id(const std::vector<MemoryField>& fields) const
+        {
+            auto it = mIds.find(&fields);
+            return it == mIds.end() ? noPlan : it->second;
+        }
+        const StructPlan& plan(uint32_t id) const
+        {
+            return mPlans[id];
+        }
+
+        // calls func(instruction, offset, data + offset) for every field, fields of the structs inside of the struct are visited instead of the struct itself
+        // offset is from the start of the buffer, fields that don't fit in the buffer are not visited
+        template <typename Func>
+        void forEachField(uint32_t id, const uint8_t* data, size_t dataSize, Func&& func, size_t baseOffset = 0) const
+        {
+            for (auto& instruction : mPlans[id].instructions)
+            {
+                size_t offset = baseOffset + instruction.offset;
+                if (!instruction.pointerHop && instruction.decoder == FieldDecoder::None && instruction.childPlan != noPlan)
+                {
+                    forEachField(instruction.childPlan, data, dataSize, func, offset);
+                    continue;
+                }
+                if (offset + instruction.size > dataSize)
+                    continue;
+
+                func(instruction, offset, data + offset);
+            }
+        }
+
+      private:
+        void compile(const Configuration& config, const std::vector<MemoryField>& fields, StructPlan& plan) const;
+        uint32_t childPlan(const Configuration& config, const MemoryField& field) const;
+
+        std::vector<StructPlan> mPlans;
+        std::unordered_map<const std::vector<MemoryField>*, uint32_t> mIds;
+    };
+
+    // calls func with the value decoded as the matching c++ type, returns false for FieldDecoder::None
+    template <typename Func>
+    bool decodeField(FieldDecoder decoder, const uint8_t* data, Func&& func)
+    {
+        auto decode = [&](auto value)
+        {
+            std::memcpy(&value, data, sizeof(value));
+            func(value);
+            return true;
+        };
+        switch (decoder)
+        {
+            case FieldDecoder::Int8:
+                return decode(int8_t{});
+            case FieldDecoder::UInt8:
+                return decode(uint8_t{});
+            case FieldDecoder::Int16:
+                return decode(int16_t{});
+            case FieldDecoder::UInt16:
+                return decode(uint16_t{});
+            case FieldDecoder::Int32:
+                return decode(int32_t{});
+            case FieldDecoder::UInt32:
+                return decode(uint32_t{});
+            case FieldDecoder::Int64:
+                return decode(int64_t{});
+            case FieldDecoder::UInt64:
+                return decode(uint64_t{});
+            case FieldDecoder::Float:
+                return decode(float{});
+            case FieldDecoder::Double:
+                return decode(double{});
+            case FieldDecoder::Bool:
+                // any non zero byte is true, copying it straight into bool would not be a valid bool
+                func(*data != 0);
+                return true;
+            case FieldDecoder::None:
+                break;
+        }
+        return false;
+    }
+} // namespace S2Plugin
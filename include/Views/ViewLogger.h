@@ -2,6 +2,8 @@
 
 #include <QWidget>
 
+class QCheckBox;
+class QLabel;
 class QLineEdit;
 class QPushButton;
 class QTabWidget;
@@ -34,7 +36,12 @@ namespace S2Plugin
         // TOP LAYOUT
         QLineEdit* mSamplePeriodLineEdit;
         QLineEdit* mDurationLineEdit;
+        QCheckBox* mCaptureCheckBox;
         QPushButton* mStartButton;
+        QPushButton* mStopButton;
+        QPushButton* mOpenCaptureButton;
+        QPushButton* mExportButton;
+        QLabel* mStatisticsLabel;
 
         // TABS
         QTabWidget* mMainTabWidget;
@@ -48,5 +55,8 @@ namespace S2Plugin
         ItemModelLoggerSamples* mSamplesTableModel;
 
         void startLogging();
+        void openCapture();
+        void exportSamples();
+        void showError(const QString& text);
     };
 } // namespace S2Plugin
@@ -3,6 +3,7 @@
 #include "Configuration.h"
 #include <QWidget>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace S2Plugin
@@ -34,6 +35,7 @@ namespace S2Plugin
       private:
         WidgetPagination* mPagination;
         MemoryField mArray;
+        std::string mArrayName;
         uintptr_t mArrayAddress;
     };
     class ViewMatrix : public ViewStruct
@@ -47,7 +49,8 @@ namespace S2Plugin
 
       private:
         WidgetPagination* mPagination;
-        MemoryField mMatrix;
+        MemoryField mMatrixRow;
+        std::string mMatrixName;
         uintptr_t mMatrixAddress;
     };
 } // namespace S2Plugin
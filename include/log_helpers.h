@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+// dprintf and displayError for the code shared with the headless core (s2core)
+// s2core only declares them, the plugin implements them in pluginmain.cpp (x64dbg log and message box)
+// and the headless executables link s2console (log_helpers.cpp) which prints them to the console
+void logPrintf(const char* fmt, ...);
+void displayError(const char* fmt, ...);
+void displayError(std::string message);
+
+#define dprintf(x, ...) logPrintf(x, ##__VA_ARGS__)
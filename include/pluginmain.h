@@ -8,6 +8,7 @@
 #endif // PLUGIN_NAME
 #define PLUGIN_VERSION 16
 
+#include "log_helpers.h"
 #include <string>
 #include <windows.h>
 
@@ -59,7 +60,6 @@
 
 #define Cmd(x) DbgCmdExecDirect(x)
 #define Eval(x) DbgValFromString(x)
-#define dprintf(x, ...) _plugin_logprintf("[" PLUGIN_NAME "] " x, __VA_ARGS__)
 #define dputs(x) _plugin_logputs("[" PLUGIN_NAME "] " x)
 #define PLUG_EXPORT extern "C" __declspec(dllexport)
 
@@ -74,5 +74,3 @@ namespace S2Plugin
     extern int hMenuStack;
 } // namespace S2Plugin
 
-void displayError(const char* fmt, ...);
-void displayError(std::string message);
@@ -1,34 +1,39 @@
 #pragma once
 
-#include "pluginmain.h"
+#include "MemorySource/MemorySource.h"
+#include "ReadCache.h"
+#include "log_helpers.h"
 #include <cstdint>
 #include <string>
+#include <type_traits>
 
 namespace S2Plugin
 {
+    // reads thru the ReadCache when there is an active ReadCache::Scope, otherwise directly from the current MemorySource
+    inline bool ReadMemory(uintptr_t addr, void* dest, size_t size)
+    {
+        if (ReadCache::isActive())
+            return ReadCache::read(addr, dest, size);
+
+        return MemorySource::get().read(addr, dest, size);
+    }
+
+    inline bool IsValidPtr(uintptr_t addr)
+    {
+        return MemorySource::get().isValidPtr(addr);
+    }
+
     template <typename T>
     [[nodiscard]] inline T Read(uintptr_t addr)
     {
-        if constexpr (sizeof(T) == 1)
-        {
-            return static_cast<T>(Script::Memory::ReadByte(addr));
-        }
-        else if constexpr (sizeof(T) == 2)
-        {
-            return static_cast<T>(Script::Memory::ReadWord(addr));
-        }
-        else if constexpr (sizeof(T) == 4)
-        {
-            return static_cast<T>(Script::Memory::ReadDword(addr));
-        }
-        else if constexpr (sizeof(T) == 8)
+        if constexpr (std::is_same_v<T, bool>)
         {
-            return static_cast<T>(Script::Memory::ReadQword(addr));
+            return Read<uint8_t>(addr) != 0;
         }
         else
         {
             T x{};
-            Script::Memory::Read(addr, &x, sizeof(T), nullptr);
+            ReadMemory(addr, &x, sizeof(T));
             return x;
         }
     }
@@ -51,10 +56,8 @@ namespace S2Plugin
         }
         std::basic_string<T> str;
         str.resize(size);
-        size_t read_size = 0;
-        Script::Memory::Read(addr, str.data(), size * char_size, &read_size);
-        if (size * char_size != read_size)
-            dprintf("[ReadConstBasicString] read (bytes): %d expected: %d\n", read_size, size * char_size);
+        if (!ReadMemory(addr, str.data(), size * char_size))
+            dprintf("[ReadConstBasicString] failed to read (bytes): %d\n", size * char_size);
         return str;
     }
     [[nodiscard]] inline std::string ReadConstString(uintptr_t addr)
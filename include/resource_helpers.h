@@ -0,0 +1,15 @@
+#pragma once
+
+#include <filesystem>
+
+namespace S2Plugin
+{
+    // directory with the json and txt files (Spelunky2.json, Spelunky2Entities.txt etc.)
+    // defaults to the "plugins" folder next to the executable (x64dbg.exe)
+    const std::filesystem::path& resourcesDirectory();
+    // override used by the headless tools, has to be set before the Configuration is loaded
+    void setResourcesDirectory(std::filesystem::path path);
+    // where the generated files (binary configuration cache) are stored, defaults to resourcesDirectory()
+    const std::filesystem::path& cacheDirectory();
+    void setCacheDirectory(std::filesystem::path path);
+} // namespace S2Plugin
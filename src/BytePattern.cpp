@@ -0,0 +1,258 @@
+#include "BytePattern.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define S2_PATTERN_X64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define S2_TARGET_AVX2
+#else
+#define S2_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+    int hexDigit(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        return -1;
+    }
+
+    size_t scalarFind(const S2Plugin::BytePattern& pattern, const uint8_t* data, size_t last)
+    {
+        const uint8_t rareByte = pattern.bytes[pattern.rareFixed];
+        const uint8_t firstByte = pattern.bytes[pattern.firstFixed];
+        size_t i = 0;
+        while (i <= last)
+        {
+            auto found = static_cast<const uint8_t*>(std::memchr(data + i + pattern.rareFixed, rareByte, last - i + 1));
+            if (found == nullptr)
+                break;
+
+            i = static_cast<size_t>(found - data) - pattern.rareFixed;
+            if (data[i + pattern.firstFixed] == firstByte && pattern.matches(data + i))
+                return i;
+
+            ++i;
+        }
+        return S2Plugin::BytePattern::npos;
+    }
+
+#ifdef S2_PATTERN_X64
+    inline uint32_t lowestBit(uint32_t bits)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return index;
+#else
+        return static_cast<uint32_t>(__builtin_ctz(bits));
+#endif
+    }
+
+    size_t sse2Find(const S2Plugin::BytePattern& pattern, const uint8_t* data, size_t last)
+    {
+        const __m128i first = _mm_set1_epi8(static_cast<char>(pattern.bytes[pattern.firstFixed]));
+        const __m128i rare = _mm_set1_epi8(static_cast<char>(pattern.bytes[pattern.rareFixed]));
+        size_t i = 0;
+        // 16 candidate positions per step, the loads stay inside the data as long as the last candidate does
+        for (; i + 16 <= last + 1; i += 16)
+        {
+            __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + pattern.firstFixed));
+            __m128i blockRare = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + pattern.rareFixed));
+            auto bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockRare, rare))));
+            while (bits != 0)
+            {
+                size_t candidate = i + lowestBit(bits);
+                if (pattern.matches(data + candidate))
+                    return candidate;
+
+                bits &= bits - 1;
+            }
+        }
+        auto tail = scalarFind(pattern, data + i, last - i);
+        return tail == S2Plugin::BytePattern::npos ? tail : i + tail;
+    }
+
+    S2_TARGET_AVX2 size_t avx2Find(const S2Plugin::BytePattern& pattern, const uint8_t* data, size_t last)
+    {
+        const __m256i first = _mm256_set1_epi8(static_cast<char>(pattern.bytes[pattern.firstFixed]));
+        const __m256i rare = _mm256_set1_epi8(static_cast<char>(pattern.bytes[pattern.rareFixed]));
+        size_t i = 0;
+        for (; i + 32 <= last + 1; i += 32)
+        {
+            __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + pattern.firstFixed));
+            __m256i blockRare = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + pattern.rareFixed));
+            auto bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockRare, rare))));
+            while (bits != 0)
+            {
+                size_t candidate = i + lowestBit(bits);
+                if (pattern.matches(data + candidate))
+                    return candidate;
+
+                bits &= bits - 1;
+            }
+        }
+        auto tail = sse2Find(pattern, data + i, last - i);
+        return tail == S2Plugin::BytePattern::npos ? tail : i + tail;
+    }
+
+    bool cpuHasAVX2()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        __cpuid(info, 1);
+        // OSXSAVE and AVX, then check that the os saves the ymm registers
+        constexpr int osxsaveAndAVX = (1 << 27) | (1 << 28);
+        if ((info[2] & osxsaveAndAVX) != osxsaveAndAVX || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+} // namespace
+
+uint8_t S2Plugin::BytePattern::commonness(uint8_t b)
+{
+    switch (b)
+    {
+        case 0x00:
+        case 0x48:
+            return 9;
+        case 0x89:
+        case 0x8B:
+            return 8;
+        case 0xFF:
+            return 7;
+        case 0x0F:
+        case 0xCC:
+            return 6;
+        case 0x4C:
+        case 0x8D:
+        case 0x24:
+        case 0x44:
+        case 0x83:
+        case 0xE8:
+            return 5;
+        case 0x01:
+        case 0x05:
+        case 0x41:
+        case 0x49:
+        case 0xC0:
+        case 0xC3:
+        case 0x85:
+        case 0x74:
+        case 0x08:
+        case 0x10:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+bool S2Plugin::BytePattern::parse(std::string_view pattern)
+{
+    bytes.clear();
+    mask.clear();
+    firstFixed = 0;
+    rareFixed = 0;
+    size_t i = 0;
+    while (i < pattern.size())
+    {
+        if (pattern[i] == ' ')
+        {
+            ++i;
+            continue;
+        }
+        if (pattern[i] == '?')
+        {
+            bytes.push_back(0);
+            mask.push_back(0);
+            i += (i + 1 < pattern.size() && pattern[i + 1] == '?') ? 2 : 1;
+            continue;
+        }
+        int high = hexDigit(pattern[i]);
+        int low = i + 1 < pattern.size() ? hexDigit(pattern[i + 1]) : -1;
+        if (high < 0 || low < 0)
+        {
+            bytes.clear();
+            mask.clear();
+            return false;
+        }
+        bytes.push_back(static_cast<uint8_t>(high << 4 | low));
+        mask.push_back(0xFF);
+        i += 2;
+    }
+
+    // the least common fixed byte, the later one on a tie so it's further away from the first one
+    bool haveFixed = false;
+    for (size_t index = 0; index < bytes.size(); ++index)
+    {
+        if (mask[index] == 0)
+            continue;
+
+        if (!haveFixed)
+        {
+            firstFixed = index;
+            rareFixed = index;
+            haveFixed = true;
+        }
+        else if (commonness(bytes[index]) <= commonness(bytes[rareFixed]))
+            rareFixed = index;
+    }
+    return !bytes.empty();
+}
+
+S2Plugin::PatternEngine S2Plugin::BytePattern::bestEngine()
+{
+#ifdef S2_PATTERN_X64
+    // without AVX2 the memchr skip of the scalar search is as fast as the SSE2 loop, or faster on some cpus
+    static const PatternEngine best = cpuHasAVX2() ? PatternEngine::AVX2 : PatternEngine::Scalar;
+    return best;
+#else
+    return PatternEngine::Scalar;
+#endif
+}
+
+size_t S2Plugin::BytePattern::find(const uint8_t* data, size_t size, PatternEngine engine) const
+{
+    if (bytes.empty() || size < bytes.size())
+        return npos;
+
+    // only wildcards
+    if (mask[firstFixed] == 0)
+        return 0;
+
+    // last offset the pattern can start at
+    size_t last = size - bytes.size();
+    if (engine == PatternEngine::Best || (engine == PatternEngine::AVX2 && bestEngine() != PatternEngine::AVX2))
+        engine = bestEngine();
+
+    switch (engine)
+    {
+#ifdef S2_PATTERN_X64
+        case PatternEngine::AVX2:
+            return avx2Find(*this, data, last);
+        case PatternEngine::SSE2:
+            return sse2Find(*this, data, last);
+#endif
+        default:
+            return scalarFind(*this, data, last);
+    }
+}
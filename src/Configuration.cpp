@@ -1,11 +1,13 @@
 #include "Configuration.h"
 
-#include "pluginmain.h"
-#include <QDir>
-#include <QFileInfo>
-#include <QString>
+#include "ConfigurationCache.h"
+#include "log_helpers.h"
+#include "read_helpers.h"
+#include "resource_helpers.h"
+#include <filesystem>
 #include <fstream>
 #include <regex>
+#include <tuple>
 
 using nlohmann::ordered_json;
 
@@ -165,7 +167,12 @@ S2Plugin::Configuration* S2Plugin::Configuration::get()
     {
         auto new_config = new Configuration{};
         if (new_config->initializedCorrectly)
+        {
             ptr = new_config;
+            ptr->updateCache();
+            ptr->mOffsetIndex.build(*ptr);
+            ptr->mStructPlans.build(*ptr);
+        }
         else
             delete new_config;
     }
@@ -179,6 +186,9 @@ bool S2Plugin::Configuration::reload()
     {
         delete ptr;
         ptr = new_config;
+        ptr->updateCache();
+        ptr->mOffsetIndex.build(*ptr);
+        ptr->mStructPlans.build(*ptr);
         return true;
     }
 
@@ -188,43 +198,51 @@ bool S2Plugin::Configuration::reload()
 
 S2Plugin::Configuration::Configuration()
 {
-    char buffer[MAX_PATH + 1] = {0};
-    GetModuleFileNameA(nullptr, buffer, MAX_PATH);
-    static const auto path = QFileInfo(QString(buffer)).dir().filePath("plugins/Spelunky2.json");
-    static const auto pathENT = QFileInfo(QString(buffer)).dir().filePath("plugins/Spelunky2Entities.json");
-    static const auto pathRC = QFileInfo(QString(buffer)).dir().filePath("plugins/Spelunky2RoomCodes.json");
-    if (!QFile(path).exists())
+    static const auto path = resourcesDirectory() / "Spelunky2.json";
+    static const auto pathENT = resourcesDirectory() / "Spelunky2Entities.json";
+    static const auto pathRC = resourcesDirectory() / "Spelunky2RoomCodes.json";
+    if (!std::filesystem::exists(path))
     {
-        displayError("Could not find " + path.toStdString());
+        displayError("Could not find " + path.string());
         initializedCorrectly = false;
         return;
     }
-    if (!QFile(pathENT).exists())
+    if (!std::filesystem::exists(pathENT))
     {
-        displayError("Could not find " + pathENT.toStdString());
+        displayError("Could not find " + pathENT.string());
         initializedCorrectly = false;
         return;
     }
-    if (!QFile(pathRC).exists())
+    if (!std::filesystem::exists(pathRC))
     {
-        displayError("Could not find " + pathRC.toStdString());
+        displayError("Could not find " + pathRC.string());
         initializedCorrectly = false;
         return;
     }
 
+    mJsonHash = ConfigurationCache::hashFiles({path, pathENT, pathRC});
+    if (mJsonHash != 0 && ConfigurationCache::load(*this, cacheDirectory() / "Spelunky2.cache", mJsonHash))
+    {
+        buildTypeLookup();
+        buildEntityClasses();
+        mLoadedFromCache = true;
+        initializedCorrectly = true;
+        return;
+    }
+
     try
     {
-        std::ifstream fpRC(pathRC.toStdString());
+        std::ifstream fpRC(pathRC);
         auto jRC = ordered_json::parse(fpRC, nullptr, true, true);
         processRoomCodesJSON(jRC);
         fpRC.close();
 
-        std::ifstream fp(path.toStdString());
+        std::ifstream fp(path);
         auto j = ordered_json::parse(fp, nullptr, true, true);
         processJSON(j);
         fp.close();
 
-        std::ifstream fpENT(pathENT.toStdString());
+        std::ifstream fpENT(pathENT);
         auto jENT = ordered_json::parse(fpENT, nullptr, true, true);
         processEntitiesJSON(jENT);
 
@@ -235,6 +253,8 @@ S2Plugin::Configuration::Configuration()
             {25, "unknown_25"}, {26, "unknown_26"}, {27, "unknown_27"}, {28, "unknown_28"}, {29, "unknown_29"}, {30, "unknown_30"}, {31, "unknown_31"}, {32, "unknown_32"}};
 
         mRefs.emplace("unknown", unknown_flags);
+        buildTypeLookup();
+        buildEntityClasses();
     }
     catch (const ordered_json::exception& e)
     {
@@ -257,6 +277,27 @@ S2Plugin::Configuration::Configuration()
     initializedCorrectly = true;
 }
 
+void S2Plugin::Configuration::updateCache()
+{
+    if (mLoadedFromCache || mJsonHash == 0)
+        return;
+
+    // sizes are calculated on first use, do all of them now so they end up in the cache
+    for (auto& [type, fields] : mTypeFieldsMain)
+        for (auto& field : fields)
+            field.get_size();
+
+    for (auto& [name, fields] : mTypeFieldsEntitySubclasses)
+        getTypeSize(name, true);
+
+    for (auto& [name, fields] : mTypeFieldsStructs)
+        getTypeSize(name);
+
+    auto cachePath = cacheDirectory() / "Spelunky2.cache";
+    if (!ConfigurationCache::save(*this, cachePath, mJsonHash))
+        dprintf("could not save configuration cache (%s)\n", cachePath.string().c_str());
+}
+
 template <class T>
 inline T value_or(const nlohmann::ordered_json& j, const std::string name, T value_if_not_found)
 {
@@ -287,7 +328,7 @@ S2Plugin::MemoryField S2Plugin::Configuration::populateMemoryField(const nlohman
     }
 
     if (field.contains("offset"))
-        memField.size = field["offset"].get<size_t>();
+        memField.size = field["offset"].get<uint32_t>();
 
     // exception since StdSet is just StdMap without the value
     if (fieldTypeStr == "StdMap")
@@ -476,7 +517,7 @@ S2Plugin::MemoryField S2Plugin::Configuration::populateMemoryField(const nlohman
         {
             if (field.contains("length"))
             {
-                memField.numberOfElements = field["length"].get<size_t>();
+                memField.numberOfElements = field["length"].get<uint32_t>();
                 memField.size = memField.numberOfElements * 2;
                 break;
             }
@@ -484,26 +525,26 @@ S2Plugin::MemoryField S2Plugin::Configuration::populateMemoryField(const nlohman
                 throw std::runtime_error("Missing `length` or `offset` parameter for UTF16StringFixedSize (" + struct_name + "." + memField.name + ")");
 
             memField.numberOfElements = memField.size / 2;
-            memField.name += "[" + std::to_string(memField.numberOfElements) + "]";
+            memField.name = memField.name + "[" + std::to_string(memField.numberOfElements) + "]";
             break;
         }
         case MemoryFieldType::UTF8StringFixedSize:
         {
             if (field.contains("length"))
-                memField.size = field["length"].get<size_t>();
+                memField.size = field["length"].get<uint32_t>();
 
             if (memField.size == 0)
                 throw std::runtime_error("Missing valid `length` or `offset` parameter for UTF8StringFixedSize (" + struct_name + "." + memField.name + ")");
 
             memField.numberOfElements = memField.size;
-            memField.name += "[" + std::to_string(memField.numberOfElements) + "]";
+            memField.name = memField.name + "[" + std::to_string(memField.numberOfElements) + "]";
             break;
         }
         case MemoryFieldType::Array:
         {
             if (field.contains("length"))
             {
-                memField.numberOfElements = field["length"].get<size_t>();
+                memField.numberOfElements = field["length"].get<uint32_t>();
                 if (memField.numberOfElements == 0)
                     throw std::runtime_error("Length 0 not allowed for Array type (" + struct_name + "." + memField.name + ")");
             }
@@ -526,7 +567,7 @@ S2Plugin::MemoryField S2Plugin::Configuration::populateMemoryField(const nlohman
 
             if (field.contains("row"))
             {
-                memField.rows = field["row"].get<size_t>();
+                memField.rows = field["row"].get<uint32_t>();
                 if (memField.rows == 0)
                     throw std::runtime_error("Size 0 not allowed for Matrix type (" + struct_name + "." + memField.name + ")");
             }
@@ -535,7 +576,7 @@ S2Plugin::MemoryField S2Plugin::Configuration::populateMemoryField(const nlohman
 
             if (field.contains("col"))
             {
-                memField.columns = field["col"].get<size_t>();
+                memField.columns = field["col"].get<uint16_t>();
                 if (memField.columns == 0)
                     throw std::runtime_error("Size 0 not allowed for Matrix type (" + struct_name + "." + memField.name + ")");
             }
@@ -618,6 +659,9 @@ void S2Plugin::Configuration::processJSON(ordered_json& j)
     for (const auto& t : j["pointer_types"])
         mPointerTypes.emplace_back(t.get<std::string>());
 
+    // fields use isPermanentPointer while parsing
+    buildTypeLookup();
+
     for (const auto& t : j["journal_pages"])
         mJournalPages.emplace_back(t.get<std::string>());
 
@@ -667,40 +711,112 @@ void S2Plugin::Configuration::processJSON(ordered_json& j)
 
 std::vector<std::string> S2Plugin::Configuration::classHierarchyOfEntity(const std::string& entityName) const
 {
-    std::vector<std::string> returnVec;
-    std::string entityClass;
-    for (const auto& [regexStr, entityClassType] : mDefaultEntityClassTypes)
+    return classHierarchyOfEntity(entityNames.idForName(entityName));
+}
+
+void S2Plugin::Configuration::buildEntityClasses()
+{
+    mEntityClasses.clear();
+    mEntityTypeClasses.clear();
+
+    std::unordered_map<std::string, uint16_t> classIndexes;
+    auto addClass = [&](const std::string& className) -> uint16_t
     {
-        auto r = std::regex(regexStr);
-        if (std::regex_match(entityName, r))
+        auto [it, inserted] = classIndexes.emplace(className, static_cast<uint16_t>(mEntityClasses.size()));
+        if (!inserted)
+            return it->second;
+
+        auto& hierarchy = mEntityClasses.emplace_back().hierarchy;
+        std::string p = className;
+        while (p != "Entity" && !p.empty())
         {
-            entityClass = entityClassType;
-            break;
+            hierarchy.emplace_back(p);
+            auto parent = mEntityClassHierarchy.find(p);
+            if (parent == mEntityClassHierarchy.end())
+            {
+                dprintf("unknown entity class in hierarchy (%s)\n", p.c_str());
+                break;
+            }
+            p = parent->second;
         }
+        hierarchy.emplace_back("Entity");
+        return it->second;
+    };
+    addClass("Entity");
+
+    // most of the default_entity_types are just the full name, only the rest needs regex
+    // the first matching entry wins, so keep the order of them
+    std::unordered_map<std::string_view, std::pair<size_t, uint16_t>> exactNames;
+    std::vector<std::tuple<size_t, std::regex, uint16_t>> patterns;
+    for (size_t order = 0; order < mDefaultEntityClassTypes.size(); ++order)
+    {
+        auto& [regexStr, className] = mDefaultEntityClassTypes[order];
+        auto classIndex = addClass(className);
+        if (regexStr.find_first_of(".*+?[](){}|^$\\") == std::string::npos)
+            exactNames.emplace(regexStr, std::make_pair(order, classIndex));
+        else
+            patterns.emplace_back(order, std::regex(regexStr), classIndex);
     }
-    if (!entityClass.empty())
+
+    mEntityTypeClasses.assign(static_cast<size_t>(entityNames.highestID()) + 1, 0);
+    for (auto& [id, name] : entityNames.entries())
     {
-        std::string p = std::move(entityClass);
-        while (p != "Entity" && !p.empty())
+        size_t bestOrder = mDefaultEntityClassTypes.size();
+        if (auto it = exactNames.find(name); it != exactNames.end())
         {
-            returnVec.emplace_back(p);
-            p = mEntityClassHierarchy.at(p); // TODO: (at) will throw exception if the element is not found
+            bestOrder = it->second.first;
+            mEntityTypeClasses[id] = it->second.second;
+        }
+        for (auto& [order, regex, classIndex] : patterns)
+        {
+            if (order > bestOrder)
+                break;
+
+            if (std::regex_match(name, regex))
+            {
+                mEntityTypeClasses[id] = classIndex;
+                break;
+            }
         }
     }
-    returnVec.emplace_back("Entity");
-    return returnVec;
 }
 
 const std::vector<S2Plugin::MemoryField>& S2Plugin::Configuration::typeFieldsOfDefaultStruct(const std::string& type) const
 {
-    auto it = mTypeFieldsStructs.find(type);
-    if (it == mTypeFieldsStructs.end())
+    if (auto fields = findStruct(InternedString::lookup(type)); fields != nullptr)
+        return *fields;
+
+    dprintf("unknown key requested in Configuration::typeFieldsOfDefaultStruct() (t=%s)\n", type.c_str());
+    static std::vector<S2Plugin::MemoryField> empty; // just to return valid object
+    return empty;
+}
+
+const std::vector<S2Plugin::MemoryField>& S2Plugin::Configuration::typeFieldsOfDefaultStruct(InternedString type) const
+{
+    if (auto fields = findStruct(type); fields != nullptr)
+        return *fields;
+
+    dprintf("unknown key requested in Configuration::typeFieldsOfDefaultStruct() (t=%s)\n", type.c_str());
+    static std::vector<S2Plugin::MemoryField> empty; // just to return valid object
+    return empty;
+}
+
+void S2Plugin::Configuration::buildTypeLookup()
+{
+    mTypeLookup.clear();
+    auto lookup = [this](const std::string& name) -> TypeLookup&
     {
-        dprintf("unknown key requested in Configuration::typeFieldsOfDefaultStruct() (t=%s)\n", type.c_str());
-        static std::vector<S2Plugin::MemoryField> empty; // just to return valid object
-        return empty;
-    }
-    return it->second;
+        auto id = InternedString{name}.id();
+        if (id >= mTypeLookup.size())
+            mTypeLookup.resize(id + 1);
+
+        return mTypeLookup[id];
+    };
+    for (auto& name : mPointerTypes)
+        lookup(name).permanentPointer = true;
+
+    for (auto& [name, fields] : mTypeFieldsStructs)
+        lookup(name).structFields = &fields;
 }
 
 const std::vector<S2Plugin::MemoryField>& S2Plugin::Configuration::typeFields(const MemoryFieldType& type) const
@@ -974,12 +1090,12 @@ size_t S2Plugin::MemoryField::get_size() const
     {
         if (type == MemoryFieldType::Array)
         {
-            const_cast<MemoryField*>(this)->size = numberOfElements * Configuration::get()->getTypeSize(firstParameterType);
+            const_cast<MemoryField*>(this)->size = static_cast<uint32_t>(numberOfElements * Configuration::get()->getTypeSize(firstParameterType));
             return size;
         }
         if (type == MemoryFieldType::Matrix)
         {
-            const_cast<MemoryField*>(this)->size = rows * columns * Configuration::get()->getTypeSize(firstParameterType);
+            const_cast<MemoryField*>(this)->size = static_cast<uint32_t>(rows * columns * Configuration::get()->getTypeSize(firstParameterType));
             return size;
         }
         if (jsonName.empty())
@@ -989,10 +1105,10 @@ size_t S2Plugin::MemoryField::get_size() const
             {
                 new_size += field.get_size();
             }
-            const_cast<MemoryField*>(this)->size = new_size;
+            const_cast<MemoryField*>(this)->size = static_cast<uint32_t>(new_size);
             return size;
         }
-        const_cast<MemoryField*>(this)->size = Configuration::get()->getTypeSize(jsonName, type == MemoryFieldType::EntitySubclass);
+        const_cast<MemoryField*>(this)->size = static_cast<uint32_t>(Configuration::get()->getTypeSize(jsonName, type == MemoryFieldType::EntitySubclass));
     }
     return size;
 }
@@ -1027,31 +1143,30 @@ size_t S2Plugin::Configuration::getBuiltInTypeSize(MemoryFieldType type)
 void S2Plugin::Configuration::processRoomCodesJSON(nlohmann::ordered_json& j)
 {
     using namespace std::string_literals;
-    std::unordered_map<std::string, QColor> colors;
+    std::unordered_map<std::string, uint32_t> colors;
 
-    auto getColor = [&colors](std::string colorName) -> QColor
+    auto getColor = [&colors](std::string colorName) -> uint32_t
     {
         if (auto it = colors.find(colorName); it != colors.end())
         {
             return it->second;
         }
-        return QColor(Qt::lightGray);
+        return gsRoomCodeDefaultColor;
     };
 
     for (const auto& [colorName, colorDetails] : j["colors"].items())
     {
-        QColor c;
-        c.setRed(colorDetails["r"].get<uint8_t>());
-        c.setGreen(colorDetails["g"].get<uint8_t>());
-        c.setBlue(colorDetails["b"].get<uint8_t>());
-        c.setAlpha(colorDetails["a"].get<uint8_t>());
+        uint32_t c = static_cast<uint32_t>(colorDetails["a"].get<uint8_t>()) << 24;
+        c |= static_cast<uint32_t>(colorDetails["r"].get<uint8_t>()) << 16;
+        c |= static_cast<uint32_t>(colorDetails["g"].get<uint8_t>()) << 8;
+        c |= static_cast<uint32_t>(colorDetails["b"].get<uint8_t>());
         colors[colorName] = c;
     }
     for (const auto& [roomCodeStr, roomDetails] : j["roomcodes"].items())
     {
         auto id = static_cast<uint16_t>(std::stoul(roomCodeStr, 0, 16));
-        QColor color = roomDetails.contains("color") ? getColor(roomDetails["color"].get<std::string>()) : QColor(Qt::lightGray);
-        mRoomCodes.emplace(id, RoomCode(id, value_or(roomDetails, "name", "Unnamed room code"s), std::move(color)));
+        uint32_t color = roomDetails.contains("color") ? getColor(roomDetails["color"].get<std::string>()) : gsRoomCodeDefaultColor;
+        mRoomCodes.emplace(id, RoomCode(id, value_or(roomDetails, "name", "Unnamed room code"s), color));
     }
 }
 
@@ -1061,7 +1176,7 @@ S2Plugin::RoomCode S2Plugin::Configuration::roomCodeForID(uint16_t code) const
     {
         return it->second;
     }
-    return RoomCode(code, "Unknown room code", QColor(Qt::lightGray));
+    return RoomCode(code, "Unknown room code", gsRoomCodeDefaultColor);
 }
 
 std::string S2Plugin::Configuration::getEntityName(uint32_t type) const
@@ -1077,12 +1192,20 @@ std::string S2Plugin::Configuration::getEntityName(uint32_t type) const
 
 uintptr_t S2Plugin::Configuration::offsetForField(MemoryFieldType type, std::string_view fieldUID, uintptr_t addr) const
 {
-    // TODO: maybe cache
     return offsetForField(typeFields(type), fieldUID, addr);
 }
 
 uintptr_t S2Plugin::Configuration::offsetForField(const std::vector<MemoryField>& fields, std::string_view fieldUID, uintptr_t addr) const
 {
+    if (mOffsetIndex.contains(fields))
+    {
+        if (auto offset = mOffsetIndex.resolve(fields, fieldUID, addr); offset.has_value())
+            return offset.value();
+
+        dprintf("Failed to locate: (%s) in json\n", std::string(fieldUID).c_str());
+        return 0;
+    }
+    // fields not owned by the Configuration, walk them
     // [Known Issue]: can't get element from an Array or Matrix
     bool last = false;
     size_t currentDelimiter = fieldUID.find('.');
@@ -1105,7 +1228,7 @@ uintptr_t S2Plugin::Configuration::offsetForField(const std::vector<MemoryField>
                 return offset;
             }
             if (field.isPointer)
-                offset = Script::Memory::ReadQword(offset);
+                offset = Read<uintptr_t>(offset);
 
             if (field.jsonName.empty())
             {
@@ -1153,7 +1276,7 @@ S2Plugin::MemoryField S2Plugin::Configuration::nameToMemoryField(const std::stri
     {
         field.type = type;
         field.isPointer = isPointerType(type);
-        field.size = getBuiltInTypeSize(type);
+        field.size = static_cast<uint32_t>(getBuiltInTypeSize(type));
     }
     return field;
 }
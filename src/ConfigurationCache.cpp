@@ -0,0 +1,389 @@
+#include "ConfigurationCache.h"
+
+#include "Configuration.h"
+#include "MappedFile.h"
+#include "log_helpers.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+    constexpr uint64_t gsFNVOffsetBasis = 0xcbf29ce484222325ull;
+    constexpr uint64_t gsFNVPrime = 0x100000001b3ull;
+
+    uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+    {
+        auto bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= gsFNVPrime;
+        }
+        return hash;
+    }
+
+    // smallest encoded MemoryField: 5 empty strings, type, isPointer and 3 sizes
+    constexpr size_t gsMinFieldSize = 5 * sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint8_t) + 3 * sizeof(uint64_t);
+    // smallest encoded ref: value and an empty string
+    constexpr size_t gsMinRefSize = sizeof(int64_t) + sizeof(uint32_t);
+
+    struct CacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t hash;
+    };
+} // namespace
+
+class S2Plugin::ConfigurationCache::Writer
+{
+  public:
+    template <typename T>
+    void write(T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        mBuffer.insert(mBuffer.end(), bytes, bytes + sizeof(T));
+    }
+    void write(const std::string& str)
+    {
+        write(static_cast<uint32_t>(str.size()));
+        mBuffer.insert(mBuffer.end(), str.begin(), str.end());
+    }
+    void write(const S2Plugin::MemoryField& field)
+    {
+        writeField(*this, field);
+    }
+    const std::vector<uint8_t>& buffer() const
+    {
+        return mBuffer;
+    }
+
+  private:
+    std::vector<uint8_t> mBuffer;
+};
+
+class S2Plugin::ConfigurationCache::Reader
+{
+  public:
+    Reader(const uint8_t* data, size_t size) : mCurrent(data), mEnd(data + size){};
+
+    template <typename T>
+    T read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+    std::string readString()
+    {
+        auto size = read<uint32_t>();
+        return std::string(reinterpret_cast<const char*>(take(size)), size);
+    }
+    // element count of a list, checked against the bytes left so a corrupted count can't reserve gigabytes
+    uint32_t readCount(size_t minElementSize)
+    {
+        auto count = read<uint32_t>();
+        if (count > static_cast<size_t>(mEnd - mCurrent) / minElementSize)
+            throw std::runtime_error("element count larger than the file");
+
+        return count;
+    }
+    S2Plugin::MemoryField readField()
+    {
+        return ConfigurationCache::readField(*this);
+    }
+
+  private:
+    const uint8_t* take(size_t size)
+    {
+        if (static_cast<size_t>(mEnd - mCurrent) < size)
+            throw std::runtime_error("unexpected end of file");
+
+        auto data = mCurrent;
+        mCurrent += size;
+        return data;
+    }
+
+    const uint8_t* mCurrent;
+    const uint8_t* mEnd;
+};
+
+void S2Plugin::ConfigurationCache::writeField(Writer& writer, const MemoryField& field)
+{
+    writer.write(field.name.str());
+    writer.write(static_cast<uint32_t>(field.type));
+    writer.write(static_cast<uint8_t>(field.isPointer));
+    writer.write(field.jsonName.str());
+    writer.write(field.firstParameterType.str());
+    writer.write(field.secondParameterType.str());
+    writer.write(field.comment.str());
+    writer.write(static_cast<uint64_t>(field.numberOfElements));
+    writer.write(static_cast<uint64_t>(field.columns));
+    writer.write(static_cast<uint64_t>(field.size));
+}
+
+S2Plugin::MemoryField S2Plugin::ConfigurationCache::readField(Reader& reader)
+{
+    MemoryField field;
+    field.name = reader.readString();
+    field.type = static_cast<MemoryFieldType>(reader.read<uint32_t>());
+    field.isPointer = reader.read<uint8_t>() != 0;
+    field.jsonName = reader.readString();
+    field.firstParameterType = reader.readString();
+    field.secondParameterType = reader.readString();
+    field.comment = reader.readString();
+    field.numberOfElements = static_cast<uint32_t>(reader.read<uint64_t>());
+    field.columns = static_cast<uint16_t>(reader.read<uint64_t>());
+    field.size = static_cast<uint32_t>(reader.read<uint64_t>());
+    return field;
+}
+
+uint64_t S2Plugin::ConfigurationCache::hashFiles(const std::vector<std::filesystem::path>& files)
+{
+    uint64_t hash = gsFNVOffsetBasis;
+    // the cache also depends on the built in types table
+    const uint32_t buildInfo[] = {version, static_cast<uint32_t>(MemoryFieldType::StdUnorderedMap), static_cast<uint32_t>(sizeof(uintptr_t))};
+    hash = hashBytes(hash, buildInfo, sizeof(buildInfo));
+    for (auto& path : files)
+    {
+        MappedFile file{path.string()};
+        if (!file.isOpen())
+            return 0;
+
+        hash = hashBytes(hash, file.data(), file.size());
+    }
+    return hash;
+}
+
+bool S2Plugin::ConfigurationCache::load(Configuration& config, const std::filesystem::path& path, uint64_t hash)
+{
+    MappedFile file{path.string()};
+    if (!file.isOpen() || file.size() < sizeof(CacheHeader))
+        return false;
+
+    CacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != magic || header.version != version || header.hash != hash)
+        return false;
+
+    Reader reader{file.data() + sizeof(header), file.size() - sizeof(header)};
+    try
+    {
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto key = reader.readString();
+            config.mEntityClassHierarchy.emplace(std::move(key), reader.readString());
+        }
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto key = reader.readString();
+            config.mDefaultEntityClassTypes.emplace_back(std::move(key), reader.readString());
+        }
+        auto readFields = [&reader]()
+        {
+            auto fieldCount = reader.readCount(gsMinFieldSize);
+            std::vector<MemoryField> fields;
+            fields.reserve(fieldCount);
+            for (; fieldCount > 0; --fieldCount)
+                fields.emplace_back(reader.readField());
+
+            return fields;
+        };
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto type = static_cast<MemoryFieldType>(reader.read<uint32_t>());
+            config.mTypeFieldsMain.emplace(type, readFields());
+        }
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto key = reader.readString();
+            config.mTypeFieldsEntitySubclasses.emplace(std::move(key), readFields());
+        }
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto key = reader.readString();
+            config.mTypeFieldsStructs.emplace(std::move(key), readFields());
+        }
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+            config.mPointerTypes.emplace_back(reader.readString());
+
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+            config.mJournalPages.emplace_back(reader.readString());
+
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto key = reader.readString();
+            config.mTypeFieldsStructsSizes.emplace(std::move(key), static_cast<size_t>(reader.read<uint64_t>()));
+        }
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto& functions = config.mVirtualFunctions[reader.readString()];
+            for (auto functionCount = reader.read<uint32_t>(); functionCount > 0; --functionCount)
+            {
+                auto index = static_cast<size_t>(reader.read<uint64_t>());
+                auto name = reader.readString();
+                auto params = reader.readString();
+                auto returnValue = reader.readString();
+                functions.emplace_back(index, std::move(name), std::move(params), std::move(returnValue), reader.readString());
+            }
+        }
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto key = reader.readString();
+            config.mAlignments.emplace(std::move(key), reader.read<uint8_t>());
+        }
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto& refs = config.mRefs[reader.readString()];
+            auto refCount = reader.readCount(gsMinRefSize);
+            refs.reserve(refs.size() + refCount);
+            for (; refCount > 0; --refCount)
+            {
+                auto value = reader.read<int64_t>();
+                refs.emplace_back(value, reader.readString());
+            }
+        }
+        for (auto count = reader.read<uint32_t>(); count > 0; --count)
+        {
+            auto id = reader.read<uint16_t>();
+            auto name = reader.readString();
+            config.mRoomCodes.emplace(id, RoomCode(id, std::move(name), reader.read<uint32_t>()));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        dprintf("failed to load configuration cache (%s)\n", e.what());
+        config.mEntityClassHierarchy.clear();
+        config.mDefaultEntityClassTypes.clear();
+        config.mTypeFieldsMain.clear();
+        config.mTypeFieldsEntitySubclasses.clear();
+        config.mTypeFieldsStructs.clear();
+        config.mPointerTypes.clear();
+        config.mJournalPages.clear();
+        config.mTypeFieldsStructsSizes.clear();
+        config.mVirtualFunctions.clear();
+        config.mAlignments.clear();
+        config.mRefs.clear();
+        config.mRoomCodes.clear();
+        return false;
+    }
+    return true;
+}
+
+bool S2Plugin::ConfigurationCache::save(const Configuration& config, const std::filesystem::path& path, uint64_t hash)
+{
+    Writer writer;
+    auto writeCount = [&writer](size_t count) { writer.write(static_cast<uint32_t>(count)); };
+    auto writeFields = [&writer, &writeCount](const std::vector<MemoryField>& fields)
+    {
+        writeCount(fields.size());
+        for (auto& field : fields)
+            writer.write(field);
+    };
+
+    writeCount(config.mEntityClassHierarchy.size());
+    for (auto& [key, value] : config.mEntityClassHierarchy)
+    {
+        writer.write(key);
+        writer.write(value);
+    }
+    writeCount(config.mDefaultEntityClassTypes.size());
+    for (auto& [key, value] : config.mDefaultEntityClassTypes)
+    {
+        writer.write(key);
+        writer.write(value);
+    }
+    writeCount(config.mTypeFieldsMain.size());
+    for (auto& [type, fields] : config.mTypeFieldsMain)
+    {
+        writer.write(static_cast<uint32_t>(type));
+        writeFields(fields);
+    }
+    writeCount(config.mTypeFieldsEntitySubclasses.size());
+    for (auto& [key, fields] : config.mTypeFieldsEntitySubclasses)
+    {
+        writer.write(key);
+        writeFields(fields);
+    }
+    writeCount(config.mTypeFieldsStructs.size());
+    for (auto& [key, fields] : config.mTypeFieldsStructs)
+    {
+        writer.write(key);
+        writeFields(fields);
+    }
+    writeCount(config.mPointerTypes.size());
+    for (auto& name : config.mPointerTypes)
+        writer.write(name);
+
+    writeCount(config.mJournalPages.size());
+    for (auto& name : config.mJournalPages)
+        writer.write(name);
+
+    writeCount(config.mTypeFieldsStructsSizes.size());
+    for (auto& [key, size] : config.mTypeFieldsStructsSizes)
+    {
+        writer.write(key);
+        writer.write(static_cast<uint64_t>(size));
+    }
+    writeCount(config.mVirtualFunctions.size());
+    for (auto& [key, functions] : config.mVirtualFunctions)
+    {
+        writer.write(key);
+        writeCount(functions.size());
+        for (auto& function : functions)
+        {
+            writer.write(static_cast<uint64_t>(function.index));
+            writer.write(function.name);
+            writer.write(function.params);
+            writer.write(function.returnValue);
+            writer.write(function.type);
+        }
+    }
+    writeCount(config.mAlignments.size());
+    for (auto& [key, alignment] : config.mAlignments)
+    {
+        writer.write(key);
+        writer.write(alignment);
+    }
+    writeCount(config.mRefs.size());
+    for (auto& [key, refs] : config.mRefs)
+    {
+        writer.write(key);
+        writeCount(refs.size());
+        for (auto& [value, name] : refs)
+        {
+            writer.write(value);
+            writer.write(name);
+        }
+    }
+    writeCount(config.mRoomCodes.size());
+    for (auto& [id, roomCode] : config.mRoomCodes)
+    {
+        writer.write(id);
+        writer.write(roomCode.name);
+        writer.write(roomCode.color);
+    }
+
+    // write to temporary file first, so other instance never maps half written cache
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        CacheHeader header{magic, version, hash};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(writer.buffer().data()), static_cast<std::streamsize>(writer.buffer().size()));
+        if (!file.good())
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    return !ec;
+}
@@ -11,7 +11,7 @@ void S2Plugin::CPPGenerator::generate(const std::string& typeName, CPPSyntaxHigh
 
     std::vector<std::string> dependencies;
     std::string parentClassName = "";
-    std::vector<MemoryField> fields;
+    const std::vector<MemoryField>* fields;
     auto config = Configuration::get();
     if (config->isEntitySubclass(className))
     {
@@ -20,7 +20,7 @@ void S2Plugin::CPPGenerator::generate(const std::string& typeName, CPPSyntaxHigh
         {
             parentClassName = hierarchy.at(className);
         }
-        fields = config->typeFieldsOfEntitySubclass(className);
+        fields = &config->typeFieldsOfEntitySubclass(className);
 
         // add the parents to the dependencies
         std::string p = parentClassName;
@@ -36,7 +36,7 @@ void S2Plugin::CPPGenerator::generate(const std::string& typeName, CPPSyntaxHigh
     }
     else if (auto& vec = config->typeFieldsOfDefaultStruct(className); !vec.empty())
     {
-        fields = vec;
+        fields = &vec;
     }
     else
     {
@@ -57,7 +57,7 @@ void S2Plugin::CPPGenerator::generate(const std::string& typeName, CPPSyntaxHigh
     mSS << "\n";
     mSS << "{\n";
     mSS << "\tpublic:\n";
-    for (const auto& field : fields)
+    for (const auto& field : *fields)
     {
         mSS << "\t\t";
 
@@ -1,8 +1,8 @@
 #include "Data/Entity.h"
 
 #include "Configuration.h"
-#include "pluginmain.h"
-#include <regex>
+#include "log_helpers.h"
+#include "read_helpers.h"
 
 std::string S2Plugin::Entity::entityTypeName() const
 {
@@ -11,24 +11,17 @@ std::string S2Plugin::Entity::entityTypeName() const
 
 std::string S2Plugin::Entity::entityClassName() const
 {
-    auto entityName = entityTypeName();
-    for (const auto& [regexStr, entityClassType] : Configuration::get()->defaultEntityClassTypes())
-    {
-        auto r = std::regex(regexStr);
-        if (std::regex_match(entityName, r))
-            return entityClassType;
-    }
-    return "Entity";
+    return Configuration::get()->entityClassName(entityTypeID());
 }
 
 uint32_t S2Plugin::Entity::entityTypeID() const
 {
-    uintptr_t entityDBPtr = Script::Memory::ReadQword(mEntityPtr + ENTITY_OFFSETS::TYPE_PTR);
+    uintptr_t entityDBPtr = Read<uintptr_t>(mEntityPtr + ENTITY_OFFSETS::TYPE_PTR);
     if (entityDBPtr == 0)
     {
         return 0;
     }
-    return Script::Memory::ReadDword(entityDBPtr + ENTITY_OFFSETS::DB_TYPE_ID);
+    return Read<uint32_t>(entityDBPtr + ENTITY_OFFSETS::DB_TYPE_ID);
 }
 
 std::vector<std::string> S2Plugin::Entity::classHierarchy(std::string validClassName)
@@ -50,19 +43,24 @@ std::vector<std::string> S2Plugin::Entity::classHierarchy(std::string validClass
     return hierarchy;
 }
 
+std::vector<std::string> S2Plugin::Entity::classHierarchy() const
+{
+    return Configuration::get()->classHierarchyOfEntity(entityTypeID());
+}
+
 uint32_t S2Plugin::Entity::uid() const
 {
-    return Script::Memory::ReadDword(mEntityPtr + ENTITY_OFFSETS::UID);
+    return Read<uint32_t>(mEntityPtr + ENTITY_OFFSETS::UID);
 }
 
 uint8_t S2Plugin::Entity::layer() const
 {
-    return Script::Memory::ReadByte(mEntityPtr + ENTITY_OFFSETS::LAYER);
+    return Read<uint8_t>(mEntityPtr + ENTITY_OFFSETS::LAYER);
 }
 
 std::pair<float, float> S2Plugin::Entity::position() const
 {
-    auto entityPosition = Script::Memory::ReadQword(mEntityPtr + ENTITY_OFFSETS::POS);
+    auto entityPosition = Read<uintptr_t>(mEntityPtr + ENTITY_OFFSETS::POS);
     // illegal :)
     auto returnValue = reinterpret_cast<std::pair<float, float>&>(entityPosition);
     return returnValue;
@@ -71,7 +69,7 @@ std::pair<float, float> S2Plugin::Entity::position() const
 std::pair<float, float> S2Plugin::Entity::abs_position() const
 {
     std::pair<float, float> returnValue;
-    auto overlay = Script::Memory::ReadQword(mEntityPtr + ENTITY_OFFSETS::OVERLAY);
+    auto overlay = Read<uintptr_t>(mEntityPtr + ENTITY_OFFSETS::OVERLAY);
     if (overlay == 0)
     {
         returnValue = position();
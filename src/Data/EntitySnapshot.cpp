@@ -0,0 +1,174 @@
+#include "Data/EntitySnapshot.h"
+
+#include "Data/Entity.h"
+#include "Data/EntityList.h"
+#include "ReadPlan.h"
+#include "read_helpers.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+namespace
+{
+    // everything from the vtable up to the layer
+    constexpr size_t gsHeaderSize = S2Plugin::Entity::LAYER + sizeof(uint8_t);
+    // neighbouring entities closer than this are read as one block, reading the gap is cheaper than another debugger call
+    constexpr size_t gsMaxGap = S2Plugin::gBigEntityBucket;
+    constexpr size_t gsMaxRangeSize = 0x10000;
+    // guard against overlay loops in corrupted memory
+    constexpr uint32_t gsMaxOverlayDepth = 16;
+
+    template <typename T>
+    T get(const uint8_t* header, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, header + offset, sizeof(T));
+        return value;
+    }
+} // namespace
+
+void S2Plugin::EntitySnapshot::addList(const EntityList& list, uint32_t maxCount)
+{
+    uint32_t count = (std::min)(list.size(), maxCount);
+    std::vector<uintptr_t> entities(count);
+    ReadMemory(list.entities(), entities.data(), count * sizeof(uintptr_t));
+    mPtrs.reserve(mPtrs.size() + count);
+    mSlots.reserve(mSlots.size() + count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (entities[i] != 0)
+            addEntity(entities[i], list.entities() + i * sizeof(uintptr_t));
+    }
+}
+
+void S2Plugin::EntitySnapshot::addEntity(uintptr_t entity, uintptr_t slot)
+{
+    mPtrs.push_back(entity);
+    mSlots.push_back(slot);
+}
+
+void S2Plugin::EntitySnapshot::read()
+{
+    size_t count = mPtrs.size();
+    mVTables.assign(count, 0);
+    mTypePtrs.assign(count, 0);
+    mOverlays.assign(count, 0);
+    mUids.assign(count, 0);
+    mTypeIDs.assign(count, 0);
+    mLayers.assign(count, 0);
+    mX.assign(count, 0.0f);
+    mY.assign(count, 0.0f);
+    mAbsX.assign(count, 0.0f);
+    mAbsY.assign(count, 0.0f);
+    if (count == 0)
+        return;
+
+    // indexes sorted by the entity address
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return mPtrs[a] < mPtrs[b]; });
+
+    readHeaders(order);
+    resolveTypeIDs();
+    resolveAbsolutePositions(order);
+}
+
+void S2Plugin::EntitySnapshot::clear()
+{
+    mPtrs.clear();
+    mSlots.clear();
+    mVTables.clear();
+    mTypePtrs.clear();
+    mOverlays.clear();
+    mUids.clear();
+    mTypeIDs.clear();
+    mLayers.clear();
+    mX.clear();
+    mY.clear();
+    mAbsX.clear();
+    mAbsY.clear();
+}
+
+void S2Plugin::EntitySnapshot::readHeaders(const std::vector<uint32_t>& order)
+{
+    ReadPlan plan;
+    for (auto index : order)
+        plan.add(mPtrs[index], gsHeaderSize);
+    plan.build(gsMaxGap, gsMaxRangeSize);
+    plan.execute();
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        const uint8_t* header = plan.data(i);
+        auto index = order[i];
+        mVTables[index] = get<uintptr_t>(header, 0);
+        mTypePtrs[index] = get<uintptr_t>(header, Entity::TYPE_PTR);
+        mOverlays[index] = get<uintptr_t>(header, Entity::OVERLAY);
+        mUids[index] = get<uint32_t>(header, Entity::UID);
+        mX[index] = get<float>(header, Entity::POS);
+        mY[index] = get<float>(header, Entity::POS + sizeof(float));
+        mLayers[index] = get<uint8_t>(header, Entity::LAYER);
+    }
+}
+
+void S2Plugin::EntitySnapshot::resolveTypeIDs()
+{
+    // there are far less entity types than entities, read every EntityDB record just once
+    std::unordered_map<uintptr_t, uint32_t> typeIndexes;
+    for (auto typePtr : mTypePtrs)
+    {
+        if (typePtr != 0)
+            typeIndexes.try_emplace(typePtr, 0);
+    }
+    ReadPlan plan;
+    for (auto& [typePtr, index] : typeIndexes)
+        index = static_cast<uint32_t>(plan.add(typePtr + Entity::DB_TYPE_ID, sizeof(uint32_t)));
+    plan.build(gsMaxGap, gsMaxRangeSize);
+    plan.execute();
+    std::vector<uint32_t> typeIDs(plan.blockCount());
+    for (size_t i = 0; i < typeIDs.size(); ++i)
+        typeIDs[i] = get<uint32_t>(plan.data(i), 0);
+
+    for (size_t i = 0; i < mTypePtrs.size(); ++i)
+    {
+        if (mTypePtrs[i] != 0)
+            mTypeIDs[i] = typeIDs[typeIndexes[mTypePtrs[i]]];
+    }
+}
+
+void S2Plugin::EntitySnapshot::resolveAbsolutePositions(const std::vector<uint32_t>& order)
+{
+    auto findEntity = [&](uintptr_t addr) -> int64_t
+    {
+        auto it = std::lower_bound(order.begin(), order.end(), addr, [this](uint32_t index, uintptr_t value) { return mPtrs[index] < value; });
+        if (it == order.end() || mPtrs[*it] != addr)
+            return -1;
+        return *it;
+    };
+
+    for (size_t i = 0; i < mPtrs.size(); ++i)
+    {
+        float x = mX[i];
+        float y = mY[i];
+        uintptr_t overlay = mOverlays[i];
+        // the overlay (entity we are attached to) is usually in the snapshot as well, otherwise read just the fields we need
+        for (uint32_t depth = 0; overlay != 0 && depth < gsMaxOverlayDepth; ++depth)
+        {
+            if (auto index = findEntity(overlay); index >= 0)
+            {
+                x += mX[static_cast<size_t>(index)];
+                y += mY[static_cast<size_t>(index)];
+                overlay = mOverlays[static_cast<size_t>(index)];
+            }
+            else
+            {
+                auto [overlayX, overlayY] = Entity{overlay}.position();
+                x += overlayX;
+                y += overlayY;
+                overlay = Read<uintptr_t>(overlay + Entity::OVERLAY);
+            }
+        }
+        mAbsX[i] = x;
+        mAbsY[i] = y;
+    }
+}
@@ -0,0 +1,90 @@
+#include "Data/EntityUIDTable.h"
+
+#include "read_helpers.h"
+
+namespace
+{
+    // anything bigger is most likely garbage (table not initialized yet, wrong offset)
+    constexpr uint32_t gsMaxMask = 0xFFFFF;
+
+    // ported from overlunky
+    // getEntry(index) returns the Entry at the index
+    template <typename GetEntry>
+    uintptr_t probe(uint32_t uid, uint32_t mask, GetEntry&& getEntry)
+    {
+        const uint32_t target_uid_plus_one = S2Plugin::EntityUIDTable::hash(uid);
+        uint32_t cur_index = target_uid_plus_one & mask;
+        // the table is never full, the bound just guards against garbage data
+        for (uint32_t i = 0; i <= mask; ++i)
+        {
+            const S2Plugin::EntityUIDTable::Entry entry = getEntry(cur_index);
+            if (entry.uid_plus_one == target_uid_plus_one)
+                return entry.entity;
+
+            if (entry.uid_plus_one == 0)
+                return 0;
+
+            if (((cur_index - target_uid_plus_one) & mask) > ((cur_index - entry.uid_plus_one) & mask))
+                return 0;
+
+            cur_index = (cur_index + 1u) & mask;
+        }
+        return 0;
+    }
+
+    bool isValidMask(uint32_t mask)
+    {
+        return mask <= gsMaxMask && (mask & (mask + 1u)) == 0;
+    }
+} // namespace
+
+bool S2Plugin::EntityUIDTable::read(uintptr_t maskAddr)
+{
+    clear();
+    const uint32_t mask = Read<uint32_t>(maskAddr);
+    const uintptr_t data = Read<uintptr_t>(maskAddr + 0x8u);
+    if (data == 0 || !isValidMask(mask))
+        return false;
+
+    mEntries.resize(static_cast<size_t>(mask) + 1u);
+    if (!ReadMemory(data, mEntries.data(), mEntries.size() * sizeof(Entry)))
+    {
+        mEntries.clear();
+        return false;
+    }
+    mMask = mask;
+    return true;
+}
+
+void S2Plugin::EntityUIDTable::clear()
+{
+    mEntries.clear();
+    mMask = 0;
+}
+
+uintptr_t S2Plugin::EntityUIDTable::find(uint32_t uid) const
+{
+    if (uid == ~0u || mEntries.empty())
+        return 0;
+
+    return probe(uid, mMask, [this](uint32_t index) { return mEntries[index]; });
+}
+
+void S2Plugin::EntityUIDTable::find(const uint32_t* uids, size_t count, uintptr_t* result) const
+{
+    for (size_t i = 0; i < count; ++i)
+        result[i] = find(uids[i]);
+}
+
+uintptr_t S2Plugin::EntityUIDTable::findInMemory(uint32_t uid, uintptr_t maskAddr)
+{
+    if (uid == ~0u)
+        return 0;
+
+    const uint32_t mask = Read<uint32_t>(maskAddr);
+    const uintptr_t data = Read<uintptr_t>(maskAddr + 0x8u);
+    if (data == 0 || !isValidMask(mask))
+        return 0;
+
+    return probe(uid, mask, [data](uint32_t index) { return Read<Entry>(data + index * sizeof(Entry)); });
+}
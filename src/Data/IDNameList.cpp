@@ -1,24 +1,21 @@
 #include "Data/IDNameList.h"
 
-#include "pluginmain.h"
-#include <QDir>
-#include <QFile>
-#include <QFileInfo>
+#include "log_helpers.h"
+#include "resource_helpers.h"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
 S2Plugin::IDNameList::IDNameList(const std::string& relFilePath, const std::regex& regex)
 {
-    char buffer[MAX_PATH] = {0};
-    GetModuleFileNameA(nullptr, buffer, MAX_PATH);
-    auto pathQStr = QFileInfo(QString(buffer)).dir().filePath(QString::fromStdString(relFilePath));
-    if (!QFile(pathQStr).exists())
+    auto path = resourcesDirectory() / relFilePath;
+    if (!std::filesystem::exists(path))
     {
         displayError((relFilePath + " not found").c_str());
         return;
     }
 
-    std::ifstream fp(pathQStr.toStdString());
+    std::ifstream fp(path);
     while (fp)
     {
         std::string line;
@@ -32,7 +29,8 @@ S2Plugin::IDNameList::IDNameList(const std::string& relFilePath, const std::rege
             uint32_t id = std::stoul(m[1].str());
             auto name = m[2].str();
             mEntries[id] = name;
-            mNames << QString::fromStdString(name);
+            mIDs[name] = id;
+            mNames.emplace_back(name);
             mHighestID = std::max(mHighestID, id);
         }
     }
@@ -41,9 +39,8 @@ S2Plugin::IDNameList::IDNameList(const std::string& relFilePath, const std::rege
 
 uint32_t S2Plugin::IDNameList::idForName(const std::string& searchName) const
 {
-    for (const auto& [id, name] : mEntries)
-        if (name == searchName)
-            return id;
+    if (auto it = mIDs.find(searchName); it != mIDs.end())
+        return it->second;
 
     return 0;
 }
@@ -59,8 +56,8 @@ std::string S2Plugin::IDNameList::nameForID(uint32_t id) const
 
 static const std::regex regexEntityLine("^([0-9]+): ENT_TYPE_(.*?)$", std::regex_constants::ECMAScript);
 
-S2Plugin::EntityNamesList::EntityNamesList() : IDNameList("plugins/Spelunky2Entities.txt", regexEntityLine) {}
+S2Plugin::EntityNamesList::EntityNamesList() : IDNameList("Spelunky2Entities.txt", regexEntityLine) {}
 
 static const std::regex regexParticleLine("^([0-9]+): PARTICLEEMITTER_(.*?)$", std::regex_constants::ECMAScript);
 
-S2Plugin::ParticleEmittersList::ParticleEmittersList() : IDNameList("plugins/Spelunky2ParticleEmitters.txt", regexParticleLine) {}
+S2Plugin::ParticleEmittersList::ParticleEmittersList() : IDNameList("Spelunky2ParticleEmitters.txt", regexParticleLine) {}
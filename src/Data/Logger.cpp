@@ -1,10 +1,13 @@
 #include "Data/Logger.h"
 
-#include "Configuration.h"
 #include "QtHelpers/ItemModelLoggerFields.h"
-#include "pluginmain.h"
-#include "read_helpers.h"
+#include "log_helpers.h"
 #include <QTimer>
+#include <QUuid>
+#include <algorithm>
+#include <fstream>
+
+static const int gsDrainPeriod = 50; // milliseconds
 
 void S2Plugin::Logger::addField(const LoggerField& field)
 {
@@ -14,6 +17,8 @@ void S2Plugin::Logger::addField(const LoggerField& field)
         mFields.emplace_back(field);
         mTableModel->appendRowEnd();
         mSamples.clear();
+        mSampleIndexes.clear();
+        closeCapture();
         emit fieldsChanged();
     }
 }
@@ -25,233 +30,176 @@ void S2Plugin::Logger::removeFieldAt(int fieldIndex)
         mTableModel->removeRow(fieldIndex);
         mFields.erase(mFields.begin() + fieldIndex);
         mTableModel->removeRowEnd();
+        // triggers refer to the fields by index
+        auto& triggers = mTriggers.triggers;
+        triggers.erase(std::remove_if(triggers.begin(), triggers.end(), [fieldIndex](const LoggerTrigger& trigger) { return trigger.fieldIndex == static_cast<size_t>(fieldIndex); }), triggers.end());
+        for (auto& trigger : triggers)
+        {
+            if (trigger.fieldIndex > static_cast<size_t>(fieldIndex))
+                --trigger.fieldIndex;
+        }
         mSamples.clear();
+        mSampleIndexes.clear();
+        closeCapture();
         emit fieldsChanged();
     }
 }
 
-void S2Plugin::Logger::start(int samplePeriod, int duration)
+bool S2Plugin::Logger::start(int samplePeriod, int duration, const std::string& capturePath)
 {
+    mSampler.stop();
+    mCapture.close();
+    closeCapture();
     mSamples.clear();
+    mSampleIndexes.clear();
+    mSamplePeriod = std::chrono::milliseconds(samplePeriod);
 
-    mSampleTimer = new QTimer(this);
-    mDurationTimer = new QTimer(this);
-    QObject::connect(mSampleTimer, &QTimer::timeout, this, &Logger::sample);
-    QObject::connect(mDurationTimer, &QTimer::timeout, this, &Logger::durationEnded);
-
-    mSampleTimer->setTimerType(Qt::PreciseTimer);
-    mSampleTimer->setInterval(samplePeriod);
+    if (!capturePath.empty())
+    {
+        if (!mCapture.create(capturePath, captureFields(), mSamplePeriod))
+            return false;
+    }
 
-    mDurationTimer->setTimerType(Qt::PreciseTimer);
-    mDurationTimer->setSingleShot(true);
-    mDurationTimer->setInterval(duration * 1000);
+    // sampling itself runs on the sampler thread, the timer just collects the samples
+    if (mDrainTimer == nullptr)
+    {
+        mDrainTimer = new QTimer(this);
+        mDrainTimer->setInterval(gsDrainPeriod);
+        QObject::connect(mDrainTimer, &QTimer::timeout, this, &Logger::drainTick);
+    }
 
+    // reserve for the whole duration, so there are no allocations while sampling
+    // when capturing, the columns only describe the fields, the samples go to the file
+    // with triggers there is no telling how many samples will be kept
+    size_t expectedSamples = samplePeriod > 0 && duration > 0 && !mCapture.isOpen() && mTriggers.triggers.empty() ? static_cast<size_t>(duration) * 1000u / static_cast<size_t>(samplePeriod) + 1u : 0;
+    mSamples.reserve(mFields.size());
     for (const auto& field : mFields)
     {
-        std::vector<std::any> v;
-        mSamples[field.uuid] = v;
+        auto& column = mSamples.emplace_back(field.memoryAddr, field.type);
+        column.reserve(expectedSamples);
     }
+    mSampleIndexes.reserve(expectedSamples);
 
-    mDurationTimer->start();
-    mSampleTimer->start();
+    mSampler.start(mSamples, mSamplePeriod, std::chrono::seconds(duration), mTriggers);
+    mDrainTimer->start();
+    return true;
 }
 
-void S2Plugin::Logger::sample()
+void S2Plugin::Logger::stop()
 {
-    for (const auto& field : mFields)
+    mSampler.stop();
+    if (mDrainTimer != nullptr && mDrainTimer->isActive())
+        drainTick();
+}
+
+void S2Plugin::Logger::drain()
+{
+    if (mCapture.isOpen())
+    {
+        mSampler.drain(mCapture);
+        mCapture.flush();
+    }
+    else
+        mSampler.drain(mSamples, mSampleIndexes);
+}
+
+void S2Plugin::Logger::drainTick()
+{
+    drain();
+    if (mCapture.failed())
     {
-        switch (field.type)
+        dprintf("could not write to the Logger capture file, sampling stopped (%s)\n", mCapture.path().c_str());
+        mSampler.stop();
+    }
+    if (mSampler.finished())
+    {
+        mDrainTimer->stop();
+        mSampler.stop();
+        // samples pushed between the last drain and the end of sampling
+        drain();
+        if (mCapture.isOpen())
         {
-            case MemoryFieldType::Byte:
-            case MemoryFieldType::State8:
-            {
-                int8_t value = Read<int8_t>(field.memoryAddr);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::UnsignedByte:
-            case MemoryFieldType::Bool:
-            case MemoryFieldType::Flags8:
-            case MemoryFieldType::CharacterDBID:
-            {
-                uint8_t value = Read<uint8_t>(field.memoryAddr);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::Word:
-            case MemoryFieldType::State16:
-            {
-                int16_t value = Read<int16_t>(field.memoryAddr);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::UnsignedWord:
-            case MemoryFieldType::Flags16:
-            {
-                uint16_t value = Read<uint16_t>(field.memoryAddr);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::Dword:
-            case MemoryFieldType::State32:
-            case MemoryFieldType::EntityUID:
-            case MemoryFieldType::TextureDBID:
-            {
-                int32_t value = Read<int32_t>(field.memoryAddr);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::UnsignedDword:
-            case MemoryFieldType::Flags32:
-            case MemoryFieldType::EntityDBID:
-            case MemoryFieldType::ParticleDBID:
-            case MemoryFieldType::StringsTableID:
-            {
-                uint32_t value = Read<uint32_t>(field.memoryAddr);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::Float:
-            {
-                uint32_t tmp = Script::Memory::ReadDword(field.memoryAddr);
-                float value = reinterpret_cast<float&>(tmp);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::Double:
-            {
-                uint64_t tmp = Script::Memory::ReadQword(field.memoryAddr);
-                double value = reinterpret_cast<double&>(tmp);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::Qword:
-            {
-                int64_t value = Read<int64_t>(field.memoryAddr);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::UnsignedQword:
-            {
-                uint64_t value = Read<uint64_t>(field.memoryAddr);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
+            mCapture.close();
+            // the samples table and plot read only the part they show thru the mapping
+            if (!mReader.open(mCapture.path()))
+                dprintf("could not open the Logger capture file for reading (%s)\n", mCapture.path().c_str());
         }
+        emit samplingEnded();
     }
 }
 
-void S2Plugin::Logger::durationEnded()
+bool S2Plugin::Logger::openCapture(const std::string& path)
 {
-    mSampleTimer->stop();
-    emit samplingEnded();
+    if (!mSampler.finished() || mTableModel == nullptr)
+        return false;
+
+    LoggerCaptureReader reader;
+    if (!reader.open(path))
+        return false;
+
+    mTableModel->resetRows();
+    mFields.clear();
+    mTriggers.triggers.clear();
+    for (const auto& field : reader.fields())
+        mFields.push_back(LoggerField{field.memoryAddr, field.name, field.type, QColor::fromRgba(field.color), QUuid::createUuid().toString().toStdString()});
+    mTableModel->resetRowsEnd();
+    mSamplePeriod = reader.samplePeriod();
+    mSamples.clear();
+    mSampleIndexes.clear();
+    // checked above, the samples are read from the member reader from now on
+    reader.close();
+    closeCapture();
+    if (!mReader.open(path))
+        return false;
+
+    emit fieldsChanged();
+    return true;
 }
 
-std::pair<int64_t, int64_t> S2Plugin::Logger::sampleBounds(const LoggerField& field) const
+bool S2Plugin::Logger::exportSamples(const std::string& path) const
 {
-    int64_t highest = std::numeric_limits<int64_t>::min(); // for all intents and purposes, the values should reasonably all fit in 2^64 / 2
-    int64_t lowest = std::numeric_limits<int64_t>::max();
-    if (mSamples.count(field.uuid) > 0)
-    {
-        const auto& samples = mSamples.at(field.uuid);
-        for (const auto& value : samples)
-        {
-            if (field.type == MemoryFieldType::Float)
-            {
-                int64_t v_ceil = std::ceil(std::any_cast<float>(value));
-                int64_t v_floor = std::floor(std::any_cast<float>(value));
-                if (v_ceil > highest)
-                {
-                    highest = v_ceil;
-                }
-                if (v_floor < lowest)
-                {
-                    lowest = v_floor;
-                }
-            }
-            else if (field.type == MemoryFieldType::Double)
-            {
-                int64_t v_ceil = std::ceil(std::any_cast<double>(value));
-                int64_t v_floor = std::floor(std::any_cast<double>(value));
-                if (v_ceil > highest)
-                {
-                    highest = v_ceil;
-                }
-                if (v_floor < lowest)
-                {
-                    lowest = v_floor;
-                }
-            }
-            else
-            {
-                int64_t v = 0;
-                switch (field.type)
-                {
-                    case MemoryFieldType::Byte:
-                    case MemoryFieldType::State8:
-                    {
-                        v = std::any_cast<int8_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedByte:
-                    case MemoryFieldType::Bool:
-                    case MemoryFieldType::Flags8:
-                    case MemoryFieldType::CharacterDBID:
-                    {
-                        v = std::any_cast<uint8_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::Word:
-                    case MemoryFieldType::State16:
-                    {
-                        v = std::any_cast<int16_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedWord:
-                    case MemoryFieldType::Flags16:
-                    {
-                        v = std::any_cast<uint16_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::Dword:
-                    case MemoryFieldType::State32:
-                    case MemoryFieldType::EntityUID:
-                    case MemoryFieldType::TextureDBID:
-                    {
-                        v = std::any_cast<int32_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedDword:
-                    case MemoryFieldType::Flags32:
-                    case MemoryFieldType::EntityDBID:
-                    case MemoryFieldType::ParticleDBID:
-                    case MemoryFieldType::StringsTableID:
-                    {
-                        v = std::any_cast<uint32_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::Qword:
-                    {
-                        v = std::any_cast<int64_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedQword:
-                    {
-                        v = static_cast<int64_t>(std::any_cast<uint64_t>(value));
-                        // [Known Issue]: there is no way to represent all unsigned 64bit values in signed 64bit variable
-                        // and standard does not provide bigger type to properly compare and determinate biggest and lowest values from the two types
-                        if (v < 0)
-                            v = std::numeric_limits<int64_t>::max();
-                        break;
-                    }
-                }
-                if (v > highest)
-                    highest = v;
+    auto fields = captureFields();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
 
-                if (v < lowest)
-                    lowest = v;
-            }
-        }
+    bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    // the whole capture is needed only for the export, it's not kept
+    if (mReader.isOpen())
+    {
+        auto columns = mReader.readColumns();
+        auto sampleIndexes = mReader.readSampleIndexes();
+        return json ? exportLoggerJSON(file, fields, columns, sampleIndexes, mSamplePeriod) : exportLoggerCSV(file, fields, columns, sampleIndexes, mSamplePeriod);
     }
-    return std::make_pair(lowest, highest);
+    // fields added after the sampling have no samples yet
+    if (mSamples.size() != mFields.size())
+        return json ? exportLoggerJSON(file, fields, {}, {}, mSamplePeriod) : exportLoggerCSV(file, fields, {}, {}, mSamplePeriod);
+
+    return json ? exportLoggerJSON(file, fields, mSamples, mSampleIndexes, mSamplePeriod) : exportLoggerCSV(file, fields, mSamples, mSampleIndexes, mSamplePeriod);
+}
+
+S2Plugin::Logger::SampleRange S2Plugin::Logger::samples(SampleWindow window, size_t first, size_t last) const
+{
+    if (!mReader.isOpen())
+        return {0, mSamples, mSampleIndexes};
+
+    auto& captureWindow = mWindows[static_cast<size_t>(window)];
+    captureWindow.load(mReader, first, last);
+    return {static_cast<size_t>(captureWindow.first()), captureWindow.columns(), captureWindow.sampleIndexes()};
+}
+
+void S2Plugin::Logger::closeCapture()
+{
+    mReader.close();
+    for (auto& window : mWindows)
+        window.clear();
+}
+
+std::vector<S2Plugin::LoggerCaptureField> S2Plugin::Logger::captureFields() const
+{
+    std::vector<LoggerCaptureField> fields;
+    fields.reserve(mFields.size());
+    for (const auto& field : mFields)
+        fields.push_back(LoggerCaptureField{field.memoryAddr, field.type, static_cast<uint32_t>(field.color.rgba()), field.name});
+    return fields;
 }
@@ -0,0 +1,397 @@
+#include "Data/LoggerCapture.h"
+
+#include "Configuration.h"
+#include "Data/LoggerColumn.h"
+#include "log_helpers.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+
+namespace
+{
+    constexpr char gsMagic[4] = {'S', '2', 'L', 'C'};
+    constexpr uint32_t gsVersion = 2;
+    // sanity limit for corrupted files
+    constexpr uint32_t gsMaxFields = 0x10000;
+
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t fieldCount;
+        uint32_t frameSize;
+        int64_t samplePeriod; // nanoseconds
+        uint64_t frameCount;
+        uint64_t dataOffset;
+    };
+    // followed by the name
+    struct FieldHeader
+    {
+        uint64_t memoryAddr;
+        uint32_t color;
+        uint16_t nameLength;
+        // MemoryFieldType
+        uint8_t type;
+        uint8_t reserved;
+    };
+
+    // frames start 8 byte aligned
+    constexpr uint64_t alignData(uint64_t offset)
+    {
+        return (offset + 7) & ~uint64_t{7};
+    }
+
+    size_t fieldSize(S2Plugin::MemoryFieldType type)
+    {
+        // the same size as the sampler reads
+        return S2Plugin::LoggerColumn{0, type}.valueSize();
+    }
+
+    template <typename T>
+    void writeNumber(std::ostream& out, T value, bool json)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // json has no representation for these
+            if (json && !std::isfinite(value))
+            {
+                out << "null";
+                return;
+            }
+        }
+        // shortest representation that reads back as the same value
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.write(buffer, result.ptr - buffer);
+    }
+
+    void writeCSVString(std::ostream& out, const std::string& str)
+    {
+        if (str.find_first_of(",\"\n\r") == std::string::npos)
+        {
+            out << str;
+            return;
+        }
+        out << '"';
+        for (char c : str)
+        {
+            if (c == '"')
+                out << '"';
+            out << c;
+        }
+        out << '"';
+    }
+
+    double sampleTime(std::chrono::nanoseconds samplePeriod, uint64_t index)
+    {
+        return std::chrono::duration<double, std::milli>(samplePeriod).count() * static_cast<double>(index);
+    }
+} // namespace
+
+bool S2Plugin::LoggerCaptureWriter::create(const std::string& path, const std::vector<LoggerCaptureField>& fields, std::chrono::nanoseconds samplePeriod)
+{
+    close();
+    if (!mFile.create(path))
+        return false;
+
+    mPath = path;
+    mFieldSizes.clear();
+    mFrameSize = sizeof(uint64_t);
+    mFrameCount = 0;
+    mFailed = false;
+    for (auto& field : fields)
+    {
+        mFieldSizes.push_back(static_cast<uint8_t>(fieldSize(field.type)));
+        mFrameSize += mFieldSizes.back();
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, gsMagic, sizeof(gsMagic));
+    header.version = gsVersion;
+    header.fieldCount = static_cast<uint32_t>(fields.size());
+    header.frameSize = static_cast<uint32_t>(mFrameSize);
+    header.samplePeriod = samplePeriod.count();
+    header.frameCount = 0;
+    uint64_t dataOffset = sizeof(FileHeader);
+    for (auto& field : fields)
+        dataOffset += sizeof(FieldHeader) + std::min<size_t>(field.name.size(), UINT16_MAX);
+    header.dataOffset = alignData(dataOffset);
+
+    auto append = [this](const void* data, size_t size)
+    {
+        if (size == 0)
+            return true;
+        auto dest = mFile.append(size);
+        if (dest == nullptr)
+            return false;
+        std::memcpy(dest, data, size);
+        return true;
+    };
+    bool success = append(&header, sizeof(header));
+    for (auto& field : fields)
+    {
+        FieldHeader fieldHeader{};
+        fieldHeader.memoryAddr = field.memoryAddr;
+        fieldHeader.color = field.color;
+        fieldHeader.nameLength = static_cast<uint16_t>(std::min<size_t>(field.name.size(), UINT16_MAX));
+        fieldHeader.type = static_cast<uint8_t>(field.type);
+        success = success && append(&fieldHeader, sizeof(fieldHeader)) && append(field.name.data(), fieldHeader.nameLength);
+    }
+    if (success && header.dataOffset != dataOffset)
+    {
+        auto padding = mFile.append(header.dataOffset - dataOffset);
+        if (padding == nullptr)
+            success = false;
+        else
+            std::memset(padding, 0, header.dataOffset - dataOffset);
+    }
+    if (!success)
+    {
+        dprintf("could not write the Logger capture header (%s)\n", path.c_str());
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool S2Plugin::LoggerCaptureWriter::append(const uint64_t* record)
+{
+    auto dest = mFile.append(mFrameSize);
+    if (dest == nullptr)
+    {
+        mFailed = true;
+        return false;
+    }
+
+    std::memcpy(dest, &record[mFieldSizes.size()], sizeof(uint64_t));
+    dest += sizeof(uint64_t);
+    for (size_t i = 0; i < mFieldSizes.size(); ++i)
+    {
+        // the raw value holds the bytes as read from memory, the low bytes on little endian
+        std::memcpy(dest, &record[i], mFieldSizes[i]);
+        dest += mFieldSizes[i];
+    }
+    ++mFrameCount;
+    return true;
+}
+
+void S2Plugin::LoggerCaptureWriter::flush()
+{
+    if (isOpen())
+        mFile.writeAt(offsetof(FileHeader, frameCount), &mFrameCount, sizeof(mFrameCount));
+}
+
+void S2Plugin::LoggerCaptureWriter::close()
+{
+    flush();
+    mFile.close();
+}
+
+bool S2Plugin::LoggerCaptureReader::open(const std::string& path)
+{
+    close();
+    if (!mFile.open(path))
+        return false;
+
+    auto fail = [this, &path](const char* reason)
+    {
+        dprintf("invalid Logger capture %s: %s\n", path.c_str(), reason);
+        close();
+        return false;
+    };
+
+    const uint8_t* data = mFile.data();
+    const size_t size = mFile.size();
+    FileHeader header;
+    if (size < sizeof(header))
+        return fail("file too small");
+
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, gsMagic, sizeof(gsMagic)) != 0)
+        return fail("not a capture file");
+    if (header.version != gsVersion)
+        return fail("unsupported version");
+    if (header.fieldCount > gsMaxFields || header.dataOffset > size)
+        return fail("corrupted header");
+
+    size_t offset = sizeof(header);
+    size_t frameSize = sizeof(uint64_t);
+    for (uint32_t i = 0; i < header.fieldCount; ++i)
+    {
+        FieldHeader fieldHeader;
+        if (offset + sizeof(fieldHeader) > header.dataOffset)
+            return fail("corrupted field description");
+
+        std::memcpy(&fieldHeader, data + offset, sizeof(fieldHeader));
+        offset += sizeof(fieldHeader);
+        if (offset + fieldHeader.nameLength > header.dataOffset)
+            return fail("corrupted field description");
+
+        auto type = static_cast<MemoryFieldType>(fieldHeader.type);
+        if (!LoggerColumn::isSupported(type))
+            return fail("unsupported field type");
+
+        auto& field = mFields.emplace_back();
+        field.memoryAddr = static_cast<uintptr_t>(fieldHeader.memoryAddr);
+        field.type = type;
+        field.color = fieldHeader.color;
+        field.name.assign(reinterpret_cast<const char*>(data + offset), fieldHeader.nameLength);
+        offset += fieldHeader.nameLength;
+        mFieldSizes.push_back(static_cast<uint8_t>(fieldSize(type)));
+        frameSize += mFieldSizes.back();
+    }
+    if (frameSize != header.frameSize)
+        return fail("frame size does not match the fields");
+
+    mFrames = data + header.dataOffset;
+    mFrameSize = frameSize;
+    mSamplePeriod = std::chrono::nanoseconds(header.samplePeriod);
+    // the file can end with a part of unflushed chunk, only trust what is both counted and present
+    mFrameCount = std::min<uint64_t>(header.frameCount, (size - header.dataOffset) / frameSize);
+    return true;
+}
+
+void S2Plugin::LoggerCaptureReader::close()
+{
+    mFile.close();
+    mFields.clear();
+    mFieldSizes.clear();
+    mFrames = nullptr;
+    mFrameSize = 0;
+    mFrameCount = 0;
+    mSamplePeriod = std::chrono::nanoseconds{0};
+}
+
+std::vector<S2Plugin::LoggerColumn> S2Plugin::LoggerCaptureReader::readColumns(uint64_t first, uint64_t count) const
+{
+    first = std::min(first, mFrameCount);
+    count = std::min(count, mFrameCount - first);
+
+    std::vector<LoggerColumn> columns;
+    columns.reserve(mFields.size());
+    for (auto& field : mFields)
+        columns.emplace_back(field.memoryAddr, field.type).reserve(static_cast<size_t>(count));
+
+    const uint8_t* frame = mFrames + first * mFrameSize;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        frame += sizeof(uint64_t);
+        for (size_t field = 0; field < columns.size(); ++field)
+        {
+            uint64_t raw = 0;
+            std::memcpy(&raw, frame, mFieldSizes[field]);
+            columns[field].append(raw);
+            frame += mFieldSizes[field];
+        }
+    }
+    return columns;
+}
+
+std::vector<uint64_t> S2Plugin::LoggerCaptureReader::readSampleIndexes(uint64_t first, uint64_t count) const
+{
+    first = std::min(first, mFrameCount);
+    count = std::min(count, mFrameCount - first);
+
+    std::vector<uint64_t> indexes(static_cast<size_t>(count));
+    const uint8_t* frame = mFrames + first * mFrameSize;
+    for (auto& index : indexes)
+    {
+        std::memcpy(&index, frame, sizeof(index));
+        frame += mFrameSize;
+    }
+    return indexes;
+}
+
+bool S2Plugin::LoggerCaptureWindow::load(const LoggerCaptureReader& reader, uint64_t first, uint64_t last)
+{
+    last = std::min(last, reader.frameCount());
+    first = std::min(first, last);
+    if (contains(first, last) && !mColumns.empty())
+        return false;
+
+    mFirst = first / chunk * chunk;
+    uint64_t end = std::min((last + chunk - 1) / chunk * chunk, reader.frameCount());
+    mColumns = reader.readColumns(mFirst, end - mFirst);
+    mSampleIndexes = reader.readSampleIndexes(mFirst, end - mFirst);
+    return true;
+}
+
+void S2Plugin::LoggerCaptureWindow::clear()
+{
+    mFirst = 0;
+    mColumns.clear();
+    mSampleIndexes.clear();
+}
+
+bool S2Plugin::exportLoggerCSV(std::ostream& out, const std::vector<LoggerCaptureField>& fields, const std::vector<LoggerColumn>& columns, const std::vector<uint64_t>& sampleIndexes,
+                               std::chrono::nanoseconds samplePeriod)
+{
+    out << "time_ms";
+    for (auto& field : fields)
+    {
+        out << ',';
+        writeCSVString(out, field.name);
+    }
+    out << '\n';
+
+    size_t rows = columns.empty() ? 0 : std::min(columns.front().size(), sampleIndexes.size());
+    for (size_t row = 0; row < rows; ++row)
+    {
+        writeNumber(out, sampleTime(samplePeriod, sampleIndexes[row]), false);
+        for (auto& column : columns)
+        {
+            out << ',';
+            column.visitAt(row, [&out](auto value) { writeNumber(out, value, false); });
+        }
+        out << '\n';
+    }
+    return out.good();
+}
+
+bool S2Plugin::exportLoggerJSON(std::ostream& out, const std::vector<LoggerCaptureField>& fields, const std::vector<LoggerColumn>& columns, const std::vector<uint64_t>& sampleIndexes,
+                                std::chrono::nanoseconds samplePeriod)
+{
+    // written by hand instead of building the whole document in memory, captures can be big
+    out << "{\n  \"sample_period_ms\": ";
+    writeNumber(out, std::chrono::duration<double, std::milli>(samplePeriod).count(), true);
+    out << ",\n  \"fields\": [";
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        auto& field = fields[i];
+        char address[32];
+        std::snprintf(address, sizeof(address), "0x%016llX", static_cast<unsigned long long>(field.memoryAddr));
+        out << (i == 0 ? "\n    " : ",\n    ");
+        out << "{\"name\": " << nlohmann::json(field.name).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+        out << ", \"address\": \"" << address << "\"";
+        out << ", \"type\": \"" << Configuration::getCPPTypeName(field.type) << "\"}";
+    }
+    size_t rows = columns.empty() ? 0 : std::min(columns.front().size(), sampleIndexes.size());
+    // time_ms = sample_index * sample_period_ms
+    out << "\n  ],\n  \"sample_indexes\": [";
+    for (size_t row = 0; row < rows; ++row)
+    {
+        if (row != 0)
+            out << ", ";
+        writeNumber(out, sampleIndexes[row], true);
+    }
+    out << "],\n  \"samples\": [";
+
+    for (size_t row = 0; row < rows; ++row)
+    {
+        out << (row == 0 ? "\n    [" : ",\n    [");
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            if (i != 0)
+                out << ", ";
+            columns[i].visitAt(row, [&out](auto value) { writeNumber(out, value, true); });
+        }
+        out << ']';
+    }
+    out << "\n  ]\n}\n";
+    return out.good();
+}
@@ -0,0 +1,185 @@
+#include "Data/LoggerColumn.h"
+
+#include "Configuration.h"
+#include "read_helpers.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+S2Plugin::LoggerColumn::LoggerColumn(uintptr_t memoryAddr, MemoryFieldType type)
+    : mMemoryAddr(memoryAddr), mLowest(std::numeric_limits<int64_t>::max()), mHighest(std::numeric_limits<int64_t>::min()), mMinimum(std::numeric_limits<double>::infinity()),
+      mMaximum(-std::numeric_limits<double>::infinity())
+{
+    switch (type)
+    {
+        case MemoryFieldType::Byte:
+        case MemoryFieldType::State8:
+            mSamples = std::vector<int8_t>{};
+            break;
+        case MemoryFieldType::UnsignedByte:
+        case MemoryFieldType::Bool:
+        case MemoryFieldType::Flags8:
+        case MemoryFieldType::CharacterDBID:
+            mSamples = std::vector<uint8_t>{};
+            break;
+        case MemoryFieldType::Word:
+        case MemoryFieldType::State16:
+            mSamples = std::vector<int16_t>{};
+            break;
+        case MemoryFieldType::UnsignedWord:
+        case MemoryFieldType::Flags16:
+            mSamples = std::vector<uint16_t>{};
+            break;
+        case MemoryFieldType::Dword:
+        case MemoryFieldType::State32:
+        case MemoryFieldType::EntityUID:
+        case MemoryFieldType::TextureDBID:
+            mSamples = std::vector<int32_t>{};
+            break;
+        case MemoryFieldType::UnsignedDword:
+        case MemoryFieldType::Flags32:
+        case MemoryFieldType::EntityDBID:
+        case MemoryFieldType::ParticleDBID:
+        case MemoryFieldType::StringsTableID:
+            mSamples = std::vector<uint32_t>{};
+            break;
+        case MemoryFieldType::Qword:
+            mSamples = std::vector<int64_t>{};
+            break;
+        case MemoryFieldType::UnsignedQword:
+            mSamples = std::vector<uint64_t>{};
+            break;
+        case MemoryFieldType::Float:
+            mSamples = std::vector<float>{};
+            break;
+        case MemoryFieldType::Double:
+            mSamples = std::vector<double>{};
+            break;
+        default:
+            dprintf("unsupported type in LoggerColumn (%d)\n", static_cast<int>(type));
+            break;
+    }
+}
+
+bool S2Plugin::LoggerColumn::isSupported(MemoryFieldType type)
+{
+    switch (type)
+    {
+        case MemoryFieldType::Byte:
+        case MemoryFieldType::UnsignedByte:
+        case MemoryFieldType::Bool:
+        case MemoryFieldType::Flags8:
+        case MemoryFieldType::State8:
+        case MemoryFieldType::CharacterDBID:
+        case MemoryFieldType::Word:
+        case MemoryFieldType::UnsignedWord:
+        case MemoryFieldType::Flags16:
+        case MemoryFieldType::State16:
+        case MemoryFieldType::Dword:
+        case MemoryFieldType::UnsignedDword:
+        case MemoryFieldType::Float:
+        case MemoryFieldType::Flags32:
+        case MemoryFieldType::State32:
+        case MemoryFieldType::EntityDBID:
+        case MemoryFieldType::EntityUID:
+        case MemoryFieldType::ParticleDBID:
+        case MemoryFieldType::TextureDBID:
+        case MemoryFieldType::StringsTableID:
+        case MemoryFieldType::Qword:
+        case MemoryFieldType::UnsignedQword:
+        case MemoryFieldType::Double:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void S2Plugin::LoggerColumn::reserve(size_t count)
+{
+    std::visit([count](auto& samples) { samples.reserve(count); }, mSamples);
+}
+
+void S2Plugin::LoggerColumn::sample()
+{
+    std::visit(
+        [this](auto& samples)
+        {
+            using T = typename std::decay_t<decltype(samples)>::value_type;
+            add(samples, Read<T>(mMemoryAddr));
+        },
+        mSamples);
+}
+
+void S2Plugin::LoggerColumn::append(uint64_t rawValue)
+{
+    std::visit(
+        [this, rawValue](auto& samples)
+        {
+            using T = typename std::decay_t<decltype(samples)>::value_type;
+            T value;
+            std::memcpy(&value, &rawValue, sizeof(T));
+            add(samples, value);
+        },
+        mSamples);
+}
+
+size_t S2Plugin::LoggerColumn::valueSize() const noexcept
+{
+    return std::visit([](const auto& samples) { return sizeof(typename std::decay_t<decltype(samples)>::value_type); }, mSamples);
+}
+
+template <typename T>
+void S2Plugin::LoggerColumn::add(std::vector<T>& samples, T value)
+{
+    samples.push_back(value);
+    mPyramid.append(static_cast<double>(value));
+
+    int64_t lowest;
+    int64_t highest;
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        // keep the bounds usable when the memory is garbage
+        if (!std::isfinite(value))
+            return;
+
+        lowest = static_cast<int64_t>(std::floor(value));
+        highest = static_cast<int64_t>(std::ceil(value));
+    }
+    else if constexpr (std::is_same_v<T, uint64_t>)
+    {
+        // [Known Issue]: there is no way to represent all unsigned 64bit values in signed 64bit variable
+        lowest = highest = value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) ? std::numeric_limits<int64_t>::max() : static_cast<int64_t>(value);
+    }
+    else
+    {
+        lowest = highest = static_cast<int64_t>(value);
+    }
+    if (lowest < mLowest)
+        mLowest = lowest;
+    if (highest > mHighest)
+        mHighest = highest;
+
+    auto asDouble = static_cast<double>(value);
+    if (asDouble < mMinimum)
+        mMinimum = asDouble;
+    if (asDouble > mMaximum)
+        mMaximum = asDouble;
+    mSum += asDouble;
+}
+
+void S2Plugin::LoggerColumn::clear()
+{
+    std::visit([](auto& samples) { samples.clear(); }, mSamples);
+    mPyramid.clear();
+    mLowest = std::numeric_limits<int64_t>::max();
+    mHighest = std::numeric_limits<int64_t>::min();
+    mMinimum = std::numeric_limits<double>::infinity();
+    mMaximum = -std::numeric_limits<double>::infinity();
+    mSum = 0.0;
+}
+
+std::pair<int64_t, int64_t> S2Plugin::LoggerColumn::bounds() const
+{
+    return std::make_pair(mLowest, mHighest);
+}
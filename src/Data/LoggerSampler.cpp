@@ -0,0 +1,239 @@
+#include "Data/LoggerSampler.h"
+
+#include "Data/LoggerCapture.h"
+#include "Data/LoggerColumn.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+namespace
+{
+    // the sleep wakes up this much early, the rest of the wait is spent spinning
+    // short enough that the sampler thread doesn't burn a core on the short periods
+    constexpr auto gsSpinThreshold = std::chrono::microseconds(200);
+    // ring buffer holds at least this much time worth of samples, the GUI drains it much more often
+    constexpr auto gsBufferedTime = std::chrono::seconds(2);
+    constexpr size_t gsMinBufferCapacity = 1024;
+    // fields closer than this are read as one range, reading the gap is cheaper than another debugger call
+    constexpr size_t gsMaxGap = 0x1000;
+    constexpr size_t gsMaxRangeSize = 0x10000;
+
+    // sleep with better than the default ~15 ms resolution of Windows, a high resolution waitable timer (Windows 10 1803+)
+    // or the system timer resolution raised to 1 ms for the time of the run
+    class PreciseSleep
+    {
+      public:
+        PreciseSleep()
+        {
+#ifdef _WIN32
+            mTimer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+            if (mTimer == nullptr)
+                mRaisedResolution = timeBeginPeriod(1) == TIMERR_NOERROR;
+#endif
+        }
+        ~PreciseSleep()
+        {
+#ifdef _WIN32
+            if (mTimer != nullptr)
+                CloseHandle(mTimer);
+            if (mRaisedResolution)
+                timeEndPeriod(1);
+#endif
+        }
+        PreciseSleep(const PreciseSleep&) = delete;
+        PreciseSleep& operator=(const PreciseSleep&) = delete;
+
+        void sleepFor(std::chrono::nanoseconds duration)
+        {
+#ifdef _WIN32
+            if (mTimer != nullptr)
+            {
+                // relative due time in 100 ns units
+                LARGE_INTEGER due;
+                due.QuadPart = -static_cast<LONGLONG>(duration.count() / 100);
+                if (SetWaitableTimerEx(mTimer, &due, 0, nullptr, nullptr, nullptr, 0))
+                {
+                    WaitForSingleObject(mTimer, INFINITE);
+                    return;
+                }
+            }
+#endif
+            std::this_thread::sleep_for(duration);
+        }
+
+      private:
+#ifdef _WIN32
+        HANDLE mTimer{nullptr};
+        bool mRaisedResolution{false};
+#endif
+    };
+} // namespace
+
+S2Plugin::LoggerSampler::~LoggerSampler()
+{
+    stop();
+}
+
+void S2Plugin::LoggerSampler::start(const std::vector<LoggerColumn>& columns, std::chrono::nanoseconds period, std::chrono::nanoseconds duration, const LoggerTriggerSettings& triggers)
+{
+    stop();
+
+    mReadPlan.clear();
+    for (const auto& column : columns)
+        mReadPlan.add(column.memoryAddr(), column.valueSize());
+    mReadPlan.build(gsMaxGap, gsMaxRangeSize);
+    mTriggerWindow = std::make_unique<LoggerTriggerWindow>(triggers, columns);
+
+    size_t capacity = gsMinBufferCapacity;
+    if (period.count() > 0)
+        capacity = std::max(capacity, static_cast<size_t>(std::chrono::nanoseconds(gsBufferedTime).count() / period.count()));
+    // the values followed by the sample index
+    mBuffer = std::make_unique<SampleRingBuffer>(capacity, mReadPlan.blockCount() + 1);
+    mDrainBuffer.resize(mBuffer->capacity() * mBuffer->recordWords());
+
+    mStatistics = Statistics{};
+    mStatistics.requestedPeriod = std::chrono::duration<double, std::milli>(period).count();
+    mStatistics.readsPerSample = mReadPlan.rangeCount();
+    mStop.store(false, std::memory_order_relaxed);
+    mFinished.store(false, std::memory_order_release);
+    mThread = std::thread(&LoggerSampler::run, this, period, duration);
+}
+
+void S2Plugin::LoggerSampler::stop()
+{
+    mStop.store(true, std::memory_order_release);
+    if (mThread.joinable())
+        mThread.join();
+}
+
+size_t S2Plugin::LoggerSampler::drain(std::vector<LoggerColumn>& columns, std::vector<uint64_t>& sampleIndexes)
+{
+    if (mBuffer == nullptr || columns.size() != mReadPlan.blockCount())
+        return 0;
+
+    size_t total = 0;
+    const size_t words = mBuffer->recordWords();
+    while (size_t count = mBuffer->pop(mDrainBuffer.data(), mBuffer->capacity()))
+    {
+        for (size_t field = 0; field < columns.size(); ++field)
+        {
+            auto& column = columns[field];
+            for (size_t record = 0; record < count; ++record)
+                column.append(mDrainBuffer[record * words + field]);
+        }
+        for (size_t record = 0; record < count; ++record)
+            sampleIndexes.push_back(mDrainBuffer[record * words + columns.size()]);
+        total += count;
+    }
+    return total;
+}
+
+size_t S2Plugin::LoggerSampler::drain(LoggerCaptureWriter& capture)
+{
+    if (mBuffer == nullptr)
+        return 0;
+
+    size_t total = 0;
+    const size_t words = mBuffer->recordWords();
+    while (size_t count = mBuffer->pop(mDrainBuffer.data(), mBuffer->capacity()))
+    {
+        for (size_t record = 0; record < count; ++record)
+        {
+            if (!capture.append(&mDrainBuffer[record * words]))
+                return total;
+            ++total;
+        }
+    }
+    return total;
+}
+
+void S2Plugin::LoggerSampler::run(std::chrono::nanoseconds period, std::chrono::nanoseconds duration)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<uint64_t> record(mBuffer->recordWords(), 0);
+    const auto start = Clock::now();
+    const auto end = duration.count() > 0 ? start + duration : Clock::time_point::max();
+    auto next = start;
+    Clock::time_point previous{};
+    // Welford's online mean and variance of the period
+    double mean = 0.0;
+    double m2 = 0.0;
+    size_t intervals = 0;
+    uint64_t sampleIndex = 0;
+    PreciseSleep sleep;
+    auto store = [this](const uint64_t* data)
+    {
+        if (mBuffer->push(data))
+            ++mStatistics.samples;
+        else
+            ++mStatistics.dropped;
+    };
+
+    while (!mStop.load(std::memory_order_acquire))
+    {
+        const auto now = Clock::now();
+        if (now >= end)
+            break;
+
+        if (previous != Clock::time_point{})
+        {
+            double interval = std::chrono::duration<double, std::milli>(now - previous).count();
+            ++intervals;
+            double delta = interval - mean;
+            mean += delta / static_cast<double>(intervals);
+            m2 += delta * (interval - mean);
+            mStatistics.minPeriod = intervals == 1 ? interval : std::min(mStatistics.minPeriod, interval);
+            mStatistics.maxPeriod = std::max(mStatistics.maxPeriod, interval);
+        }
+        previous = now;
+
+        mReadPlan.execute();
+        for (size_t i = 0; i < mReadPlan.blockCount(); ++i)
+        {
+            record[i] = 0;
+            std::memcpy(&record[i], mReadPlan.data(i), mReadPlan.blockSize(i));
+        }
+        record[mReadPlan.blockCount()] = sampleIndex++;
+        if (mTriggerWindow->active())
+            mTriggerWindow->process(record.data(), store);
+        else
+            store(record.data());
+
+        next += period;
+        // fell behind (debugger paused the game, slow reads, late wake up), the ticks closer than half a period are skipped
+        // instead of sampled in a burst, the phase stays the same and the sample index still counts the ticks so the time of the samples is right
+        if (const auto behind = Clock::now() + period / 2 - next; behind > Clock::duration::zero() && period.count() > 0)
+        {
+            auto missed = static_cast<uint64_t>(behind / period) + 1;
+            next += missed * period;
+            sampleIndex += missed;
+            mStatistics.missed += missed;
+        }
+
+        while (!mStop.load(std::memory_order_relaxed))
+        {
+            const auto remaining = next - Clock::now();
+            if (remaining <= Clock::duration::zero())
+                break;
+            if (remaining > gsSpinThreshold)
+                sleep.sleepFor(remaining - gsSpinThreshold);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    mStatistics.triggers = mTriggerWindow->triggerCount();
+    mStatistics.discarded = mTriggerWindow->discarded();
+    mStatistics.meanPeriod = mean;
+    mStatistics.jitter = intervals > 1 ? std::sqrt(m2 / static_cast<double>(intervals - 1)) : 0.0;
+    mFinished.store(true, std::memory_order_release);
+}
@@ -0,0 +1,77 @@
+#include "Data/LoggerTrigger.h"
+
+#include "Data/LoggerColumn.h"
+
+S2Plugin::LoggerTriggerWindow::LoggerTriggerWindow(const LoggerTriggerSettings& settings, const std::vector<LoggerColumn>& columns)
+    : mRecordWords(columns.size() + 1), mPreTrigger(settings.preTrigger), mPostTrigger(settings.postTrigger), mPrevious(columns.size(), 0)
+{
+    for (const auto& trigger : settings.triggers)
+    {
+        if (trigger.fieldIndex >= columns.size())
+            continue;
+
+        const auto& column = columns[trigger.fieldIndex];
+        auto size = static_cast<uint8_t>(column.valueSize());
+        uint64_t mask = trigger.bit < size * 8 ? uint64_t{1} << trigger.bit : 0;
+        mTriggers.push_back(Trigger{trigger.fieldIndex, trigger.condition, trigger.threshold, mask, size, column.isFloatingPoint(), column.isSigned()});
+    }
+    if (active())
+        mHistory.resize(mPreTrigger * mRecordWords);
+}
+
+bool S2Plugin::LoggerTriggerWindow::evaluate(const uint64_t* record) const
+{
+    for (const auto& trigger : mTriggers)
+    {
+        uint64_t previous = mPrevious[trigger.field];
+        uint64_t current = record[trigger.field];
+        switch (trigger.condition)
+        {
+            case LoggerTrigger::Condition::Changed:
+                if (previous != current)
+                    return true;
+                break;
+            case LoggerTrigger::Condition::RisesAbove:
+                if (decode(trigger, previous) <= trigger.threshold && decode(trigger, current) > trigger.threshold)
+                    return true;
+                break;
+            case LoggerTrigger::Condition::FallsBelow:
+                if (decode(trigger, previous) >= trigger.threshold && decode(trigger, current) < trigger.threshold)
+                    return true;
+                break;
+            case LoggerTrigger::Condition::BitSet:
+                if ((previous & trigger.mask) == 0 && (current & trigger.mask) != 0)
+                    return true;
+                break;
+            case LoggerTrigger::Condition::BitCleared:
+                if ((previous & trigger.mask) != 0 && (current & trigger.mask) == 0)
+                    return true;
+                break;
+        }
+    }
+    return false;
+}
+
+double S2Plugin::LoggerTriggerWindow::decode(const Trigger& trigger, uint64_t raw) const
+{
+    // the raw value holds just the value bytes, upper bytes are zero
+    if (trigger.isFloatingPoint)
+    {
+        if (trigger.size == sizeof(float))
+        {
+            float value;
+            std::memcpy(&value, &raw, sizeof(value));
+            return value;
+        }
+        double value;
+        std::memcpy(&value, &raw, sizeof(value));
+        return value;
+    }
+    if (trigger.isSigned && trigger.size < sizeof(uint64_t))
+    {
+        // sign extend
+        unsigned shift = 64 - trigger.size * 8;
+        return static_cast<double>(static_cast<int64_t>(raw << shift) >> shift);
+    }
+    return trigger.isSigned ? static_cast<double>(static_cast<int64_t>(raw)) : static_cast<double>(raw);
+}
@@ -1,16 +1,83 @@
 #include "Spelunky2.h"
 #include "pluginmain.h"
 #include "read_helpers.h"
+#include <chrono>
 #include <memory>
+#include <thread>
 
-uintptr_t S2Plugin::Spelunky2::getAfterBundle(uintptr_t sectionStart, size_t sectionSize)
+static constexpr const char* gsAfterBundlePattern = "55 41 57 41 56 41 55 41 54";
+
+uintptr_t S2Plugin::Spelunky2::getAfterBundle(const std::vector<uint8_t>& code, uintptr_t codeStart)
+{
+    SignatureScanner scanner;
+    auto id = scanner.add(gsAfterBundlePattern);
+    scanner.scan(code.data(), code.size(), codeStart, 0, std::thread::hardware_concurrency());
+    return scanner.match(id);
+}
+
+void S2Plugin::Spelunky2::addSignatures()
+{
+    // pattern, offset of the rel32 and end of the instruction it's relative to
+    mSignatures.add("C6 80 39 01 00 00 00 48", 10, 14);                          // GAME_MANAGER
+    mSignatures.add("A4 84 E4 CA DA BF 4E 83", -30, -26);                        // ENTITY_DB
+    mSignatures.add("4C 89 C6 41 89 CF 8B 1D", 8, 12);                           // TEXTURE_DB
+    mSignatures.add("48 8B 05 ?? ?? ?? ?? 80 B8 00 02 00 00 FF", 3, 7);          // ONLINE
+    mSignatures.add("FE FF FF FF 66 C7 05", 7, 13);                              // PARTICLE_DB, Spelunky 1.20.4d, 1.23.1b: last id = 0xDB 219
+    mSignatures.add("48 6B C3 2C 48 8D 15 ?? ?? ?? ?? 48", 7, 11);               // CHARACTER_DB
+    mSignatures.add("48 8D 15 ?? ?? ?? ?? 4C 8B 0C CA", 3, 7);                   // STRINGS_TABLE
+    mSignatures.add("48 8D 0D ?? ?? ?? ?? 48 89 0D ?? ?? ?? ?? 48 C7 05", 3, 7); // VIRTUAL_TABLE
+    mSignatures.add("C6 00 00 48 C7 40 18 00 00 00 00");                         // GAME_API
+    mSignatures.add("41 C6 47 6B 01");                                           // HUD
+    mSignatures.add("90 83 C1 FF", 6, 10);                                       // SAVE_STATES
+    mSignatures.add("F3 41 0F 11 47 38 8B 05", 8, 12);                           // DEBUG_SETTINGS
+}
+
+void S2Plugin::Spelunky2::logResolveTimes() const
+{
+    // same order as SIGNATURE
+    static constexpr const char* signatureNames[] = {"GameManager", "EntityDB", "TextureDB", "Online", "ParticleDB", "CharacterDB",
+                                                     "StringsTable", "VirtualTable", "GameAPI", "Hud", "SaveStates", "DebugSettings"};
+    for (size_t id = 0; id < mSignatures.count(); ++id)
+    {
+        if (mSignatures.match(id) == 0)
+            dprintf("lookup %s: not found\n", signatureNames[id]);
+        else
+            dprintf("lookup %s: resolved in %.3f ms\n", signatureNames[id], std::chrono::duration<double, std::milli>(mSignatures.resolveTime(id)).count());
+    }
+}
+
+bool S2Plugin::Spelunky2::probeLookups(uintptr_t moduleBase, const std::vector<uint32_t>& rvas)
 {
-    constexpr size_t sevenMegs = 7ull * 1024 * 1024;
-    auto Spelunky2AfterBundle = Script::Pattern::FindMem(sectionStart + sectionSize - sevenMegs, sevenMegs, "55 41 57 41 56 41 55 41 54");
-    if (Spelunky2AfterBundle == 0)
-        displayError("Lookup error: unable to find 'after_bundle' location");
+    if (rvas.size() != mSignatures.count() + 1 || rvas[0] == 0)
+        return false;
+
+    SignatureScanner afterBundleScanner;
+    auto afterBundleId = afterBundleScanner.add(gsAfterBundlePattern);
+    if (!afterBundleScanner.probe(afterBundleId, moduleBase + rvas[0]))
+        return false;
 
-    return Spelunky2AfterBundle;
+    // the ones not found last time are not found in the same build either
+    for (size_t id = 0; id < mSignatures.count(); ++id)
+    {
+        if (rvas[id + 1] != 0 && !mSignatures.probe(id, moduleBase + rvas[id + 1]))
+            return false;
+    }
+    afterBundle = moduleBase + rvas[0];
+    afterBundleSize = codeSectionStart + codeSectionSize - afterBundle;
+    return true;
+}
+
+std::vector<uint32_t> S2Plugin::Spelunky2::lookupRVAs(uintptr_t moduleBase) const
+{
+    std::vector<uint32_t> rvas;
+    rvas.reserve(mSignatures.count() + 1);
+    rvas.push_back(static_cast<uint32_t>(afterBundle - moduleBase));
+    for (size_t id = 0; id < mSignatures.count(); ++id)
+    {
+        auto match = mSignatures.match(id);
+        rvas.push_back(match == 0 ? 0 : static_cast<uint32_t>(match - moduleBase));
+    }
+    return rvas;
 }
 
 uintptr_t S2Plugin::Spelunky2::get_GameManagerPtr(bool quiet)
@@ -18,8 +85,8 @@ uintptr_t S2Plugin::Spelunky2::get_GameManagerPtr(bool quiet)
     if (mGameManagerPtr != 0)
         return mGameManagerPtr;
 
-    auto instructionOffset = Script::Pattern::FindMem(afterBundle, afterBundleSize, "C6 80 39 01 00 00 00 48");
-    if (instructionOffset == 0)
+    auto offsetPtr = mSignatures.target(GAME_MANAGER);
+    if (offsetPtr == 0)
     {
         if (!quiet)
             displayError("Lookup error: unable to find GameManager");
@@ -27,8 +94,6 @@ uintptr_t S2Plugin::Spelunky2::get_GameManagerPtr(bool quiet)
         return 0;
     }
 
-    auto pcOffset = Script::Memory::ReadDword(instructionOffset + 10);
-    auto offsetPtr = instructionOffset + pcOffset + 14;
     mGameManagerPtr = Script::Memory::ReadQword(offsetPtr);
     if (!Script::Memory::IsValidPtr(mGameManagerPtr))
     {
@@ -45,14 +110,13 @@ const S2Plugin::EntityDB& S2Plugin::Spelunky2::get_EntityDB()
     if (mEntityDB.ptr != 0)
         return mEntityDB;
 
-    auto instructionEntitiesPtr = Script::Pattern::FindMem(afterBundle, afterBundleSize, "A4 84 E4 CA DA BF 4E 83");
-    if (instructionEntitiesPtr == 0)
+    auto entitiesPtr = mSignatures.target(ENTITY_DB);
+    if (entitiesPtr == 0)
     {
         displayError("Lookup error: unable to find EntityDB");
         return mEntityDB;
     }
 
-    auto entitiesPtr = instructionEntitiesPtr - 33 + 7 + (duint)Script::Memory::ReadDword(instructionEntitiesPtr - 30);
     mEntityDB.ptr = Script::Memory::ReadQword(entitiesPtr);
     if (!Script::Memory::IsValidPtr(mEntityDB.ptr))
     {
@@ -68,14 +132,13 @@ S2Plugin::TextureDB& S2Plugin::Spelunky2::get_TextureDB()
     if (mTextureDB.ptr != 0)
         return mTextureDB;
 
-    auto instructionPtr = Script::Pattern::FindMem(afterBundle, afterBundleSize, "4C 89 C6 41 89 CF 8B 1D");
-    if (instructionPtr == 0)
+    auto textureStartAddress = mSignatures.target(TEXTURE_DB);
+    if (textureStartAddress == 0)
     {
         displayError("Lookup error: unable to find TextureDB");
         return mTextureDB;
     }
 
-    auto textureStartAddress = instructionPtr + 12 + (duint)Script::Memory::ReadDword(instructionPtr + 8);
     auto textureCount = Script::Memory::ReadQword(textureStartAddress);
     if (textureCount == 0)
     {
@@ -92,14 +155,13 @@ uintptr_t S2Plugin::Spelunky2::get_OnlinePtr()
     if (mOnlinePtr != 0)
         return mOnlinePtr;
 
-    auto instructionOffset = Script::Pattern::FindMem(afterBundle, afterBundleSize, "48 8B 05 ?? ?? ?? ?? 80 B8 00 02 00 00 FF");
-    if (instructionOffset == 0)
+    auto onlinePointer = mSignatures.target(ONLINE);
+    if (onlinePointer == 0)
     {
         displayError("Lookup error: unable to find Online");
         return mOnlinePtr;
     }
-    auto relativeOffset = Script::Memory::ReadDword(instructionOffset + 3);
-    mOnlinePtr = Script::Memory::ReadQword(instructionOffset + 7 + relativeOffset);
+    mOnlinePtr = Script::Memory::ReadQword(onlinePointer);
     if (!Script::Memory::IsValidPtr(mOnlinePtr))
     {
         displayError("Lookup error: Online not yet initialized");
@@ -114,14 +176,13 @@ const S2Plugin::ParticleDB& S2Plugin::Spelunky2::get_ParticleDB()
     if (mParticleDB.ptr != 0)
         return mParticleDB;
 
-    // Spelunky 1.20.4d, 1.23.1b: last id = 0xDB 219
-    auto instructionOffset = Script::Pattern::FindMem(afterBundle, afterBundleSize, "FE FF FF FF 66 C7 05");
-    if (instructionOffset == 0)
+    auto particleDBAddress = mSignatures.target(PARTICLE_DB);
+    if (particleDBAddress == 0)
     {
         displayError("Lookup error: unable to find ParticleDB (1)");
         return mParticleDB;
     }
-    mParticleDB.ptr = instructionOffset + 13 + (duint)Script::Memory::ReadDword(instructionOffset + 7);
+    mParticleDB.ptr = particleDBAddress;
     if (!Script::Memory::IsValidPtr(mParticleDB.ptr))
     {
         displayError("Lookup error: unable to find ParticleDB (2)");
@@ -135,13 +196,13 @@ const S2Plugin::CharacterDB& S2Plugin::Spelunky2::get_CharacterDB()
     if (mCharacterDB.ptr != 0)
         return mCharacterDB;
 
-    auto instructionOffset = Script::Pattern::FindMem(afterBundle, afterBundleSize, "48 6B C3 2C 48 8D 15 ?? ?? ?? ?? 48");
-    if (instructionOffset == 0)
+    auto characterDBAddress = mSignatures.target(CHARACTER_DB);
+    if (characterDBAddress == 0)
     {
         displayError("Lookup error: unable to find CharacterDB (1)");
         return mCharacterDB;
     }
-    mCharacterDB.ptr = instructionOffset + 11 + (duint)Script::Memory::ReadDword(instructionOffset + 7);
+    mCharacterDB.ptr = characterDBAddress;
     if (!Script::Memory::IsValidPtr(mCharacterDB.ptr))
     {
         displayError("Lookup error: unable to find CharacterDB (2)");
@@ -169,16 +230,14 @@ const S2Plugin::StringsTable& S2Plugin::Spelunky2::get_StringsTable(bool quiet)
     if (mStringsTable.ptr != 0)
         return mStringsTable;
 
-    auto instructionOffset = Script::Pattern::FindMem(afterBundle, afterBundleSize, "48 8D 15 ?? ?? ?? ?? 4C 8B 0C CA");
-    if (instructionOffset == 0)
+    auto addr = mSignatures.target(STRINGS_TABLE);
+    if (addr == 0)
     {
         if (!quiet)
             displayError("Lookup error: unable to find StringsTable");
 
         return mStringsTable;
     }
-    auto relativeOffset = Script::Memory::ReadDword(instructionOffset + 3);
-    auto addr = instructionOffset + 7 + relativeOffset;
     if (Script::Memory::ReadQword(addr) == 0)
     {
         if (!quiet)
@@ -200,15 +259,14 @@ const S2Plugin::VirtualTableLookup& S2Plugin::Spelunky2::get_VirtualTableLookup(
     mVirtualTableLookup.mOffsetToTableEntries.reserve(gsAmountOfPointers);
 
     // From 1.23.2 on, the base isn't on D3Dcompile any more, so just look up the first pointer by pattern
-    auto instructionOffset = Script::Pattern::FindMem(afterBundle, afterBundleSize, "48 8D 0D ?? ?? ?? ?? 48 89 0D ?? ?? ?? ?? 48 C7 05");
-    if (instructionOffset == 0)
+    auto tableStartAddress = mSignatures.target(VIRTUAL_TABLE);
+    if (tableStartAddress == 0)
     {
         displayError("Lookup error: unable to find VirtualTable start (1)");
         return mVirtualTableLookup;
     }
 
-    auto pcOffset = Script::Memory::ReadDword(instructionOffset + 3);
-    mVirtualTableLookup.mTableStartAddress = instructionOffset + pcOffset + 7;
+    mVirtualTableLookup.mTableStartAddress = tableStartAddress;
     if (!Script::Memory::IsValidPtr(mVirtualTableLookup.mTableStartAddress))
     {
         displayError("Lookup error: unable to find VirtualTable start (2)");
@@ -237,13 +295,13 @@ uintptr_t S2Plugin::Spelunky2::get_GameAPIPtr()
     if (mGameAPIPtr != 0)
         return mGameAPIPtr;
 
-    auto instructionAddress = Script::Pattern::FindMem(afterBundle, afterBundleSize, "C6 00 00 48 C7 40 18 00 00 00 00");
+    auto instructionAddress = mSignatures.match(GAME_API);
     if (instructionAddress == 0)
     {
         displayError("Lookup error: unable to find GameAPI (1)");
         return mGameAPIPtr;
     }
-    instructionAddress = Script::Pattern::FindMem(instructionAddress - 0x30, 0x30, "48 8B 05");
+    instructionAddress = find("48 8B 05", instructionAddress - 0x30, 0x30);
     if (instructionAddress == 0)
     {
         displayError("Lookup error: unable to find GameAPI (2)");
@@ -266,13 +324,13 @@ uintptr_t S2Plugin::Spelunky2::get_HudPtr()
     if (mHudPtr != 0)
         return mHudPtr;
 
-    auto instructionAddress = Script::Pattern::FindMem(afterBundle, afterBundleSize, "41 C6 47 6B 01");
+    auto instructionAddress = mSignatures.match(HUD);
     if (instructionAddress == 0)
     {
         displayError("Lookup error: unable to find Hud (1)");
         return mHudPtr;
     }
-    instructionAddress = Script::Pattern::FindMem(instructionAddress + 5, 0x24, "48 8D 0D");
+    instructionAddress = find("48 8D 0D", instructionAddress + 5, 0x24);
     if (instructionAddress == 0)
     {
         displayError("Lookup error: unable to find Hud (2)");
@@ -294,14 +352,13 @@ uintptr_t S2Plugin::Spelunky2::get_SaveStatesPtr()
     if (mSaveStatesPtr != 0)
         return mSaveStatesPtr;
 
-    auto instructionAddress = Script::Pattern::FindMem(afterBundle, afterBundleSize, "90 83 C1 FF");
-    if (instructionAddress == 0)
+    auto saveStatesAddress = mSignatures.target(SAVE_STATES);
+    if (saveStatesAddress == 0)
     {
         displayError("Lookup error: unable to find SaveStates (1)");
         return mSaveStatesPtr;
     }
-    auto relativeOffset = Script::Memory::ReadDword(instructionAddress + 6);
-    mSaveStatesPtr = instructionAddress + 10 + relativeOffset;
+    mSaveStatesPtr = saveStatesAddress;
     if (!Script::Memory::IsValidPtr(mSaveStatesPtr))
     {
         displayError("Lookup error: unable to find SaveStates (2)");
@@ -315,14 +372,13 @@ uintptr_t S2Plugin::Spelunky2::get_DebugSettingsPtr()
     if (mDebugSettingsPtr != 0)
         return mDebugSettingsPtr;
 
-    auto instructionAddress = Script::Pattern::FindMem(afterBundle, afterBundleSize, "F3 41 0F 11 47 38 8B 05");
-    if (instructionAddress == 0)
+    auto debugSettingsAddress = mSignatures.target(DEBUG_SETTINGS);
+    if (debugSettingsAddress == 0)
     {
         displayError("Lookup error: unable to find DebugSettings (1)");
         return mDebugSettingsPtr;
     }
-    auto relativeOffset = Script::Memory::ReadDword(instructionAddress + 8);
-    mDebugSettingsPtr = instructionAddress + 12 + relativeOffset;
+    mDebugSettingsPtr = debugSettingsAddress;
     if (!Script::Memory::IsValidPtr(mDebugSettingsPtr))
     {
         displayError("Lookup error: unable to find DebugSettings (2)");
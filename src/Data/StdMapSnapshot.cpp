@@ -0,0 +1,127 @@
+#include "Data/StdMapSnapshot.h"
+
+#include "Data/StdMap.h"
+#include "ReadPlan.h"
+#include "read_helpers.h"
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+namespace
+{
+    // the nodes are allocated one by one on the heap, the ones close together are read as one range
+    constexpr size_t gsMaxGap = 0x1000;
+    constexpr size_t gsMaxRangeSize = 0x10000;
+    constexpr size_t gsLeftOffset = 0x0;
+    constexpr size_t gsParentOffset = 0x8;
+    constexpr size_t gsRightOffset = 0x10;
+    constexpr uint32_t gsNoChild = ~uint32_t{0};
+    // the size comes from the game memory, don't trust it with the allocation
+    constexpr size_t gsMaxReserve = 0x10000;
+
+    uintptr_t getPtr(const uint8_t* node, size_t offset)
+    {
+        uintptr_t ptr;
+        std::memcpy(&ptr, node + offset, sizeof(ptr));
+        return ptr;
+    }
+} // namespace
+
+S2Plugin::StdMapSnapshot::StdMapSnapshot(size_t keySize, uint8_t keyAlignment, size_t valueSize, uint8_t valueAlignment) : mKeySize(keySize), mValueSize(valueSize)
+{
+    std::tie(mKeyOffset, mValueOffset) = stdMapNodeOffsets(keySize, keyAlignment, valueAlignment);
+}
+
+void S2Plugin::StdMapSnapshot::clear()
+{
+    mNodes.clear();
+    mEntries.clear();
+}
+
+bool S2Plugin::StdMapSnapshot::read(uintptr_t mapAddr)
+{
+    clear();
+    // the map is just the head node (end) and the size, the head's parent is the root
+    // all the nil children point at the head
+    uintptr_t map[2];
+    if (!ReadMemory(mapAddr, &map, sizeof(map)) || map[0] == 0)
+        return false;
+
+    uintptr_t head = map[0];
+    size_t mapSize = map[1];
+    uintptr_t root = Read<uintptr_t>(head + gsParentOffset);
+    if (mapSize == 0 || root == head)
+        return true;
+
+    const size_t nodeSize = (mValueSize == 0 ? mKeyOffset + mKeySize : mValueOffset + mValueSize);
+    const size_t entry = entrySize();
+    // in the breadth first order, the children are always after the parent
+    std::vector<uintptr_t> nodes{root};
+    std::vector<uint32_t> left;
+    std::vector<uint32_t> right;
+    std::vector<uint8_t> entries;
+    size_t reserve = (std::min)(mapSize, gsMaxReserve);
+    nodes.reserve(reserve);
+    left.reserve(reserve);
+    right.reserve(reserve);
+    entries.reserve(reserve * entry);
+
+    auto addChild = [&nodes, head](uintptr_t child)
+    {
+        if (child == head || child == 0)
+            return gsNoChild;
+
+        nodes.push_back(child);
+        return static_cast<uint32_t>(nodes.size() - 1);
+    };
+
+    size_t levelBegin = 0;
+    while (levelBegin < nodes.size())
+    {
+        size_t levelEnd = nodes.size();
+        ReadPlan plan;
+        for (size_t index = levelBegin; index < levelEnd; ++index)
+            plan.add(nodes[index], nodeSize);
+        plan.build(gsMaxGap, gsMaxRangeSize);
+        if (!plan.execute())
+            return false;
+
+        for (size_t index = levelBegin; index < levelEnd; ++index)
+        {
+            const uint8_t* node = plan.data(index - levelBegin);
+            entries.insert(entries.end(), node + mKeyOffset, node + mKeyOffset + mKeySize);
+            if (mValueSize != 0)
+                entries.insert(entries.end(), node + mValueOffset, node + mValueOffset + mValueSize);
+
+            left.push_back(addChild(getPtr(node, gsLeftOffset)));
+            right.push_back(addChild(getPtr(node, gsRightOffset)));
+        }
+        // more nodes than the map says, corrupted memory or a loop in the tree
+        if (nodes.size() > mapSize)
+            return false;
+
+        levelBegin = levelEnd;
+    }
+    if (nodes.size() != mapSize)
+        return false;
+
+    // in order walk of the local copy
+    mNodes.reserve(nodes.size());
+    mEntries.reserve(entries.size());
+    std::vector<uint32_t> stack;
+    uint32_t current = 0;
+    while (current != gsNoChild || !stack.empty())
+    {
+        while (current != gsNoChild)
+        {
+            stack.push_back(current);
+            current = left[current];
+        }
+        current = stack.back();
+        stack.pop_back();
+        mNodes.push_back(nodes[current]);
+        mEntries.insert(mEntries.end(), entries.begin() + current * entry, entries.begin() + (current + 1) * entry);
+        current = right[current];
+    }
+    return true;
+}
@@ -20,7 +20,7 @@ QString S2Plugin::StringsTable::stringForIndex(uint32_t idx) const
 
 uintptr_t S2Plugin::StringsTable::stringAddressOfIndex(uint32_t idx) const
 {
-    return Script::Memory::ReadQword(addressOfIndex(idx));
+    return Read<uintptr_t>(addressOfIndex(idx));
 }
 
 uintptr_t S2Plugin::StringsTable::count(bool recount) const
@@ -34,10 +34,10 @@ uintptr_t S2Plugin::StringsTable::count(bool recount) const
 
     for (uint idx = 0; idx < expectedMax / data.size(); ++idx)
     {
-        Script::Memory::Read(ptr + idx * data.size() * sizeof(uintptr_t), data.data(), data.size() * sizeof(uintptr_t), nullptr);
+        ReadMemory(ptr + idx * data.size() * sizeof(uintptr_t), data.data(), data.size() * sizeof(uintptr_t));
         for (uint dataIdx = 0; dataIdx < data.size(); ++dataIdx)
         {
-            if (!Script::Memory::IsValidPtr(data[dataIdx]))
+            if (!IsValidPtr(data[dataIdx]))
             {
                 const_cast<StringsTable&>(*this).size = idx * data.size() + dataIdx;
                 return size;
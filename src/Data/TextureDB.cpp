@@ -22,17 +22,17 @@ void S2Plugin::TextureDB::reloadCache()
     mTextureNamesStringList.clear();
     mHighestID = 0;
 
-    auto textureCount = Script::Memory::ReadQword(ptr - 0x8);
+    auto textureCount = Read<uintptr_t>(ptr - 0x8);
     constexpr uintptr_t textureSize = 0x40ull;
     for (size_t x = 0; x < (std::min)(500ull, textureCount); ++x)
     {
         uintptr_t offset = ptr + textureSize * x;
-        auto textureID = Script::Memory::ReadQword(offset);
+        auto textureID = Read<uintptr_t>(offset);
         mHighestID = std::max(mHighestID, textureID);
 
         auto nameOffset = offset + 0x8;
 
-        size_t value = (nameOffset == 0 ? 0 : Script::Memory::ReadQword(Script::Memory::ReadQword(nameOffset)));
+        size_t value = (nameOffset == 0 ? 0 : Read<uintptr_t>(Read<uintptr_t>(nameOffset)));
         if (value != 0)
         {
             std::string name = ReadConstString(value);
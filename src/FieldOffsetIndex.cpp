@@ -0,0 +1,156 @@
+#include "FieldOffsetIndex.h"
+
+#include "Configuration.h"
+#include "read_helpers.h"
+#include <charconv>
+
+namespace
+{
+    const std::vector<S2Plugin::MemoryField>* fieldsOfType(const S2Plugin::Configuration& config, S2Plugin::MemoryFieldType type, const std::string& jsonName)
+    {
+        if (jsonName.empty())
+        {
+            auto& fields = config.typeFields(type);
+            return fields.empty() ? nullptr : &fields;
+        }
+        if (config.isJsonStruct(jsonName))
+            return &config.typeFieldsOfDefaultStruct(jsonName);
+
+        return nullptr;
+    }
+
+    // parses "[3]" at the start of `str`, removes it from the view
+    bool parseIndex(std::string_view& str, size_t& index)
+    {
+        if (str.size() < 3 || str.front() != '[')
+            return false;
+
+        auto end = str.find(']');
+        if (end == std::string_view::npos)
+            return false;
+
+        auto result = std::from_chars(str.data() + 1, str.data() + end, index);
+        if (result.ec != std::errc{} || result.ptr != str.data() + end)
+            return false;
+
+        str.remove_prefix(end + 1);
+        return true;
+    }
+} // namespace
+
+void S2Plugin::FieldOffsetIndex::build(const Configuration& config)
+{
+    clear();
+    for (auto& [type, fields] : config.mTypeFieldsMain)
+        addFields(config, mStructs[&fields], fields, {}, 0);
+
+    for (auto& [name, fields] : config.mTypeFieldsStructs)
+        addFields(config, mStructs[&fields], fields, {}, 0);
+}
+
+void S2Plugin::FieldOffsetIndex::clear()
+{
+    mStructs.clear();
+    mPathNames.clear();
+}
+
+void S2Plugin::FieldOffsetIndex::addFields(const Configuration& config, Paths& paths, const std::vector<MemoryField>& fields, const std::string& prefix, uintptr_t offset)
+{
+    for (auto& field : fields)
+    {
+        auto& path = mPathNames.emplace_back(prefix + field.name);
+        Entry entry{offset, &field};
+        if (field.type == MemoryFieldType::Array || field.type == MemoryFieldType::Matrix)
+        {
+            size_t count = field.type == MemoryFieldType::Array ? field.numberOfElements : field.rows * field.getNumColumns();
+            if (count != 0 && !field.isPointer)
+                entry.elementSize = field.get_size() / count;
+
+            auto element = config.nameToMemoryField(field.firstParameterType);
+            entry.children = fieldsOfType(config, element.type, element.jsonName);
+            entry.elementIsPointer = element.isPointer;
+        }
+        else
+            entry.children = fieldsOfType(config, field.type, field.jsonName);
+
+        paths.emplace(path, entry);
+        // structs inside of the struct are part of the same memory block, add their fields with the full path
+        if (!field.isPointer && entry.elementSize == 0 && entry.children != nullptr)
+            addFields(config, paths, *entry.children, path + '.', offset);
+
+        offset += field.get_size();
+    }
+}
+
+std::optional<uintptr_t> S2Plugin::FieldOffsetIndex::resolve(const std::vector<MemoryField>& fields, std::string_view path, uintptr_t addr) const
+{
+    auto structIt = mStructs.find(&fields);
+    if (structIt == mStructs.end())
+        return std::nullopt;
+
+    const Paths* paths = &structIt->second;
+    size_t end = 0;
+    while (true)
+    {
+        // the static part of the path grows until it hits a pointer or an array element
+        end = path.find_first_of(".[", end);
+        auto it = paths->find(path.substr(0, end));
+        if (it == paths->end())
+            return std::nullopt;
+
+        auto& entry = it->second;
+        if (end == std::string_view::npos)
+            return addr + entry.offset;
+
+        if (path[end] == '.')
+        {
+            if (!entry.field->isPointer)
+            {
+                ++end;
+                continue;
+            }
+            if (entry.children == nullptr)
+                return std::nullopt;
+
+            addr = Read<uintptr_t>(addr + entry.offset);
+            paths = &mStructs.at(entry.children);
+            path.remove_prefix(end + 1);
+            end = 0;
+            continue;
+        }
+
+        // array or matrix element
+        if (entry.elementSize == 0)
+            return std::nullopt;
+
+        path.remove_prefix(end);
+        size_t index;
+        if (!parseIndex(path, index))
+            return std::nullopt;
+
+        if (entry.field->type == MemoryFieldType::Matrix)
+        {
+            size_t column;
+            if (index >= entry.field->rows || !parseIndex(path, column) || column >= entry.field->getNumColumns())
+                return std::nullopt;
+
+            index = index * entry.field->getNumColumns() + column;
+        }
+        else if (index >= entry.field->numberOfElements)
+            return std::nullopt;
+
+        addr += entry.offset + index * entry.elementSize;
+        if (path.empty())
+            return addr;
+
+        if (path.front() != '.' || entry.children == nullptr)
+            return std::nullopt;
+
+        if (entry.elementIsPointer)
+            addr = Read<uintptr_t>(addr);
+
+        paths = &mStructs.at(entry.children);
+        path.remove_prefix(1);
+        end = 0;
+    }
+}
@@ -0,0 +1,85 @@
+#include "InternedString.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+    // strings are stored in fixed size chunks that never move, so readers don't need the lock
+    constexpr size_t gsChunkSize = 4096;
+    constexpr size_t gsMaxChunks = 1024;
+
+    struct StringPool
+    {
+        std::mutex mutex;
+        std::array<std::unique_ptr<std::string[]>, gsMaxChunks> chunks;
+        // keys point to the strings in chunks
+        std::unordered_map<std::string_view, uint32_t> ids;
+        uint32_t count{0};
+
+        StringPool()
+        {
+            chunks[0] = std::make_unique<std::string[]>(gsChunkSize);
+            ids.emplace(std::string_view{}, count++);
+        }
+    };
+
+    StringPool& pool()
+    {
+        static StringPool gsPool;
+        return gsPool;
+    }
+} // namespace
+
+uint32_t S2Plugin::InternedString::intern(std::string_view str)
+{
+    if (str.empty())
+        return 0;
+
+    auto& strings = pool();
+    std::lock_guard lock{strings.mutex};
+    if (auto it = strings.ids.find(str); it != strings.ids.end())
+        return it->second;
+
+    uint32_t id = strings.count;
+    if (id / gsChunkSize >= gsMaxChunks)
+        throw std::length_error("InternedString pool is full");
+
+    auto& chunk = strings.chunks[id / gsChunkSize];
+    if (chunk == nullptr)
+        chunk = std::make_unique<std::string[]>(gsChunkSize);
+
+    auto& stored = chunk[id % gsChunkSize];
+    stored = str;
+    strings.ids.emplace(stored, id);
+    ++strings.count;
+    return id;
+}
+
+S2Plugin::InternedString S2Plugin::InternedString::lookup(std::string_view str)
+{
+    InternedString result;
+    if (str.empty())
+        return result;
+
+    auto& strings = pool();
+    std::lock_guard lock{strings.mutex};
+    if (auto it = strings.ids.find(str); it != strings.ids.end())
+        result.mID = it->second;
+
+    return result;
+}
+
+const std::string& S2Plugin::InternedString::str() const noexcept
+{
+    return pool().chunks[mID / gsChunkSize][mID % gsChunkSize];
+}
+
+std::ostream& S2Plugin::operator<<(std::ostream& stream, const InternedString& str)
+{
+    return stream << str.str();
+}
@@ -0,0 +1,126 @@
+#include "LookupCache.h"
+
+#include "log_helpers.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    constexpr uint64_t gsFNVOffsetBasis = 0xcbf29ce484222325ull;
+    constexpr uint64_t gsFNVPrime = 0x100000001b3ull;
+
+    struct CacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t count;
+    };
+
+    template <typename T>
+    bool readValue(const std::vector<uint8_t>& file, size_t& offset, T& value)
+    {
+        if (file.size() - offset < sizeof(T))
+            return false;
+
+        std::memcpy(&value, file.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream& file, const T& value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+} // namespace
+
+uint64_t S2Plugin::LookupCache::hashCode(const void* data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = gsFNVOffsetBasis;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= gsFNVPrime;
+    }
+    return hash;
+}
+
+std::vector<S2Plugin::LookupCache::Entry> S2Plugin::LookupCache::readEntries(const std::filesystem::path& path)
+{
+    std::vector<Entry> entries;
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open())
+        return entries;
+
+    std::vector<uint8_t> file{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    size_t offset = 0;
+    CacheHeader header;
+    if (!readValue(file, offset, header) || header.magic != magic || header.version != version)
+        return entries;
+
+    for (uint32_t i = 0; i < header.count; ++i)
+    {
+        Entry entry;
+        uint32_t count = 0;
+        if (!readValue(file, offset, entry.key.timestamp) || !readValue(file, offset, entry.key.codeHash) || !readValue(file, offset, count) ||
+            (file.size() - offset) / sizeof(uint32_t) < count)
+        {
+            dprintf("lookup cache is corrupted (%s)\n", path.string().c_str());
+            entries.clear();
+            return entries;
+        }
+        entry.rvas.resize(count);
+        std::memcpy(entry.rvas.data(), file.data() + offset, count * sizeof(uint32_t));
+        offset += count * sizeof(uint32_t);
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+bool S2Plugin::LookupCache::load(const std::filesystem::path& path, const Key& key, std::vector<uint32_t>& rvas)
+{
+    for (auto& entry : readEntries(path))
+    {
+        if (entry.key == key)
+        {
+            rvas = std::move(entry.rvas);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool S2Plugin::LookupCache::save(const std::filesystem::path& path, const Key& key, const std::vector<uint32_t>& rvas)
+{
+    auto entries = readEntries(path);
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&key](const Entry& entry) { return entry.key == key; }), entries.end());
+    entries.push_back(Entry{key, rvas});
+    if (entries.size() > maxBuilds)
+        entries.erase(entries.begin(), entries.end() - maxBuilds);
+
+    // write to temporary file first, so other instance never reads half written cache
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        writeValue(file, CacheHeader{magic, version, static_cast<uint32_t>(entries.size())});
+        for (auto& entry : entries)
+        {
+            writeValue(file, entry.key.timestamp);
+            writeValue(file, entry.key.codeHash);
+            writeValue(file, static_cast<uint32_t>(entry.rvas.size()));
+            file.write(reinterpret_cast<const char*>(entry.rvas.data()), static_cast<std::streamsize>(entry.rvas.size() * sizeof(uint32_t)));
+        }
+        if (!file.good())
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    return !ec;
+}
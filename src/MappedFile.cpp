@@ -0,0 +1,253 @@
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool S2Plugin::MappedFile::open(const std::string& path)
+{
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    mFile = file;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+    mMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mMapping == nullptr)
+    {
+        close();
+        return false;
+    }
+    mData = static_cast<uint8_t*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED)
+        {
+            mData = static_cast<uint8_t*>(view);
+            mSize = static_cast<size_t>(st.st_size);
+        }
+    }
+    // mapping stays valid after closing the descriptor
+    ::close(fd);
+#endif
+    if (mData == nullptr)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void S2Plugin::MappedFile::close()
+{
+#ifdef _WIN32
+    if (mData != nullptr)
+        UnmapViewOfFile(mData);
+    if (mMapping != nullptr)
+        CloseHandle(mMapping);
+    if (mFile != nullptr)
+        CloseHandle(mFile);
+    mMapping = nullptr;
+    mFile = nullptr;
+#else
+    if (mData != nullptr)
+        munmap(mData, mSize);
+#endif
+    mData = nullptr;
+    mSize = 0;
+}
+
+namespace
+{
+    // views have to start at multiple of this
+    size_t viewGranularity()
+    {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwAllocationGranularity;
+#else
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+} // namespace
+
+bool S2Plugin::MappedFileWriter::create(const std::string& path, size_t chunkSize)
+{
+    close();
+    auto granularity = viewGranularity();
+    mChunkSize = (std::max)((chunkSize + granularity - 1) / granularity * granularity, granularity);
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    mFile = file;
+#else
+    mFd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (mFd == -1)
+        return false;
+#endif
+    mSize = 0;
+    mFileSize = 0;
+    return true;
+}
+
+void S2Plugin::MappedFileWriter::close()
+{
+    if (!isOpen())
+        return;
+
+    unmapView();
+    // drop the unused part of the last chunk
+    resize(mSize);
+#ifdef _WIN32
+    CloseHandle(mFile);
+    mFile = nullptr;
+#else
+    ::close(mFd);
+    mFd = -1;
+#endif
+    mSize = 0;
+    mFileSize = 0;
+}
+
+uint8_t* S2Plugin::MappedFileWriter::append(size_t size)
+{
+    if (mView == nullptr || mSize + size > mViewOffset + mViewSize)
+    {
+        if (!mapView(mSize, size))
+            return nullptr;
+    }
+    uint8_t* dest = mView + (mSize - mViewOffset);
+    mSize += size;
+    return dest;
+}
+
+bool S2Plugin::MappedFileWriter::writeAt(uint64_t offset, const void* data, size_t size)
+{
+    if (offset + size > mSize)
+        return false;
+
+    if (mView != nullptr && offset >= mViewOffset && offset + size <= mViewOffset + mViewSize)
+    {
+        std::memcpy(mView + (offset - mViewOffset), data, size);
+        return true;
+    }
+    // outside of the current view, the file is already big enough so a temporary view is enough
+    uint64_t viewOffset = offset - offset % viewGranularity();
+    size_t viewSize = static_cast<size_t>(offset + size - viewOffset);
+#ifdef _WIN32
+    if (mMapping == nullptr)
+        return false;
+
+    void* view = MapViewOfFile(mMapping, FILE_MAP_WRITE, static_cast<DWORD>(viewOffset >> 32), static_cast<DWORD>(viewOffset), viewSize);
+    if (view == nullptr)
+        return false;
+
+    std::memcpy(static_cast<uint8_t*>(view) + (offset - viewOffset), data, size);
+    UnmapViewOfFile(view);
+#else
+    void* view = mmap(nullptr, viewSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, static_cast<off_t>(viewOffset));
+    if (view == MAP_FAILED)
+        return false;
+
+    std::memcpy(static_cast<uint8_t*>(view) + (offset - viewOffset), data, size);
+    munmap(view, viewSize);
+#endif
+    return true;
+}
+
+bool S2Plugin::MappedFileWriter::mapView(uint64_t offset, size_t size)
+{
+    unmapView();
+    uint64_t viewOffset = offset - offset % viewGranularity();
+    size_t viewSize = mChunkSize;
+    while (viewOffset + viewSize < offset + size)
+        viewSize += mChunkSize;
+
+    if (viewOffset + viewSize > mFileSize && !resize(viewOffset + viewSize))
+        return false;
+
+#ifdef _WIN32
+    if (mMapping == nullptr)
+    {
+        mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+        if (mMapping == nullptr)
+            return false;
+    }
+    void* view = MapViewOfFile(mMapping, FILE_MAP_WRITE, static_cast<DWORD>(viewOffset >> 32), static_cast<DWORD>(viewOffset), viewSize);
+    if (view == nullptr)
+        return false;
+#else
+    void* view = mmap(nullptr, viewSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, static_cast<off_t>(viewOffset));
+    if (view == MAP_FAILED)
+        return false;
+#endif
+    mView = static_cast<uint8_t*>(view);
+    mViewOffset = viewOffset;
+    mViewSize = viewSize;
+    return true;
+}
+
+void S2Plugin::MappedFileWriter::unmapView()
+{
+    if (mView == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mView);
+#else
+    munmap(mView, mViewSize);
+#endif
+    mView = nullptr;
+    mViewOffset = 0;
+    mViewSize = 0;
+}
+
+bool S2Plugin::MappedFileWriter::resize(uint64_t size)
+{
+#ifdef _WIN32
+    // file with an open mapping can't change size, the mapping is recreated for the new size in mapView
+    if (mMapping != nullptr)
+    {
+        CloseHandle(mMapping);
+        mMapping = nullptr;
+    }
+    LARGE_INTEGER newSize;
+    newSize.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(mFile, newSize, nullptr, FILE_BEGIN) || !SetEndOfFile(mFile))
+        return false;
+
+    mFileSize = size;
+#else
+    if (ftruncate(mFd, static_cast<off_t>(size)) != 0)
+        return false;
+
+    mFileSize = size;
+#endif
+    return true;
+}
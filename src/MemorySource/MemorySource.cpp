@@ -0,0 +1,32 @@
+#include "MemorySource/MemorySource.h"
+
+#include "MemorySource/SyntheticMemorySource.h"
+
+namespace
+{
+    std::unique_ptr<S2Plugin::MemorySource> gsMemorySource;
+}
+
+size_t S2Plugin::MemorySource::readBulk(const MemoryReadRequest* requests, size_t count)
+{
+    size_t success = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (read(requests[i].addr, requests[i].dest, requests[i].size))
+            ++success;
+    }
+    return success;
+}
+
+S2Plugin::MemorySource& S2Plugin::MemorySource::get()
+{
+    if (gsMemorySource == nullptr)
+        gsMemorySource = std::make_unique<SyntheticMemorySource>();
+
+    return *gsMemorySource;
+}
+
+void S2Plugin::MemorySource::set(std::unique_ptr<MemorySource> source)
+{
+    gsMemorySource = std::move(source);
+}
@@ -0,0 +1,62 @@
+#include "MemorySource/RegionMemorySource.h"
+
+#include <algorithm>
+#include <cstring>
+
+bool S2Plugin::RegionMemorySource::read(uintptr_t addr, void* dest, size_t size)
+{
+    auto out = static_cast<uint8_t*>(dest);
+    while (size != 0)
+    {
+        auto region = findRegion(addr);
+        if (region == nullptr)
+        {
+            std::memset(out, 0, size);
+            return false;
+        }
+        size_t offset = addr - region->base;
+        size_t chunk = std::min(size, region->size - offset);
+        std::memcpy(out, region->data + offset, chunk);
+        // read can span multiple adjacent regions
+        out += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+bool S2Plugin::RegionMemorySource::isValidPtr(uintptr_t addr)
+{
+    return findRegion(addr) != nullptr;
+}
+
+void S2Plugin::RegionMemorySource::addRegion(uintptr_t base, size_t size, uint8_t* data)
+{
+    auto it = std::upper_bound(mRegions.begin(), mRegions.end(), base, [](uintptr_t addr, const Region& region) { return addr < region.base; });
+    mRegions.insert(it, Region{base, size, data});
+    mLastRegion.store(0, std::memory_order_relaxed);
+}
+
+const S2Plugin::RegionMemorySource::Region* S2Plugin::RegionMemorySource::findRegion(uintptr_t addr) const
+{
+    if (mRegions.empty())
+        return nullptr;
+
+    if (size_t hint = mLastRegion.load(std::memory_order_relaxed); hint < mRegions.size())
+    {
+        auto& last = mRegions[hint];
+        if (addr >= last.base && addr - last.base < last.size)
+            return &last;
+    }
+
+    auto it = std::upper_bound(mRegions.begin(), mRegions.end(), addr, [](uintptr_t addr, const Region& region) { return addr < region.base; });
+    if (it == mRegions.begin())
+        return nullptr;
+
+    --it;
+    if (addr - it->base >= it->size)
+        return nullptr;
+
+    mLastRegion.store(static_cast<size_t>(it - mRegions.begin()), std::memory_order_relaxed);
+    return &*it;
+}
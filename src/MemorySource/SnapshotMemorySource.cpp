@@ -0,0 +1,88 @@
+#include "MemorySource/SnapshotMemorySource.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    struct SnapshotHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t regionCount;
+    };
+
+    struct SnapshotRegion
+    {
+        uint64_t base;
+        uint64_t size;
+        uint64_t fileOffset;
+    };
+} // namespace
+
+S2Plugin::SnapshotMemorySource::SnapshotMemorySource(const std::string& path)
+{
+    if (!mFile.open(path))
+        return;
+
+    SnapshotHeader header;
+    if (mFile.size() < sizeof(header))
+    {
+        close();
+        return;
+    }
+    std::memcpy(&header, mFile.data(), sizeof(header));
+    if (header.magic != magic || header.version != version || header.regionCount > (mFile.size() - sizeof(header)) / sizeof(SnapshotRegion))
+    {
+        close();
+        return;
+    }
+    for (uint64_t i = 0; i < header.regionCount; ++i)
+    {
+        SnapshotRegion region;
+        std::memcpy(&region, mFile.data() + sizeof(header) + i * sizeof(SnapshotRegion), sizeof(region));
+        if (region.fileOffset > mFile.size() || region.size > mFile.size() - region.fileOffset)
+        {
+            close();
+            return;
+        }
+        // the mapping is read only, the region data is never written to for snapshots
+        addRegion(region.base, region.size, const_cast<uint8_t*>(mFile.data()) + region.fileOffset);
+    }
+}
+
+void S2Plugin::SnapshotMemorySource::close()
+{
+    clearRegions();
+    mFile.close();
+}
+
+bool S2Plugin::SnapshotMemorySource::capture(const std::string& path, MemorySource& source, const std::vector<std::pair<uintptr_t, size_t>>& regions)
+{
+    std::vector<std::pair<uintptr_t, std::vector<uint8_t>>> data;
+    data.reserve(regions.size());
+    for (auto& [base, size] : regions)
+    {
+        std::vector<uint8_t> buffer(size);
+        if (source.read(base, buffer.data(), size))
+            data.emplace_back(base, std::move(buffer));
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    SnapshotHeader header{magic, version, data.size()};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t fileOffset = sizeof(header) + data.size() * sizeof(SnapshotRegion);
+    for (auto& [base, buffer] : data)
+    {
+        SnapshotRegion region{base, buffer.size(), fileOffset};
+        file.write(reinterpret_cast<const char*>(&region), sizeof(region));
+        fileOffset += buffer.size();
+    }
+    for (auto& [base, buffer] : data)
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+    return file.good();
+}
@@ -0,0 +1,36 @@
+#include "MemorySource/SyntheticMemorySource.h"
+
+#include <algorithm>
+#include <cstring>
+
+uint8_t* S2Plugin::SyntheticMemorySource::map(uintptr_t base, size_t size)
+{
+    auto& buffer = mBuffers.emplace_back(std::make_unique<uint8_t[]>(size));
+    addRegion(base, size, buffer.get());
+    return buffer.get();
+}
+
+bool S2Plugin::SyntheticMemorySource::write(uintptr_t addr, const void* src, size_t size)
+{
+    auto in = static_cast<const uint8_t*>(src);
+    while (size != 0)
+    {
+        auto region = findRegion(addr);
+        if (region == nullptr)
+            return false;
+
+        size_t offset = addr - region->base;
+        size_t chunk = std::min(size, region->size - offset);
+        std::memcpy(region->data + offset, in, chunk);
+        in += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+void S2Plugin::SyntheticMemorySource::clear()
+{
+    clearRegions();
+    mBuffers.clear();
+}
@@ -0,0 +1,19 @@
+#include "MemorySource/X64dbgMemorySource.h"
+
+#include "pluginmain.h"
+#include <cstring>
+
+bool S2Plugin::X64dbgMemorySource::read(uintptr_t addr, void* dest, size_t size)
+{
+    duint sizeRead = 0;
+    if (Script::Memory::Read(addr, dest, size, &sizeRead) && sizeRead == size)
+        return true;
+
+    std::memset(dest, 0, size);
+    return false;
+}
+
+bool S2Plugin::X64dbgMemorySource::isValidPtr(uintptr_t addr)
+{
+    return Script::Memory::IsValidPtr(addr);
+}
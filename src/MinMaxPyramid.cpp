@@ -0,0 +1,46 @@
+#include "MinMaxPyramid.h"
+
+void S2Plugin::MinMaxPyramid::append(double value)
+{
+    size_t index = mSize++;
+    bool finite = std::isfinite(value);
+
+    // the samples are not stored, so the first level has to exist from the first sample
+    if (mLevels.empty())
+        mLevels.emplace_back();
+
+    size_t blockSize = branching;
+    for (auto& blocks : mLevels)
+    {
+        size_t blockIndex = index / blockSize;
+        if (blockIndex == blocks.size())
+            blocks.emplace_back();
+        if (finite)
+        {
+            auto& block = blocks[blockIndex];
+            block.low = value < block.low ? value : block.low;
+            block.high = value > block.high ? value : block.high;
+        }
+        blockSize *= branching;
+    }
+
+    // new level once the top one has more than branching blocks
+    if (mLevels.back().size() > branching)
+    {
+        const auto& top = mLevels.back();
+        std::vector<Block> blocks((top.size() + branching - 1) / branching);
+        for (size_t i = 0; i < top.size(); ++i)
+        {
+            auto& block = blocks[i / branching];
+            block.low = top[i].low < block.low ? top[i].low : block.low;
+            block.high = top[i].high > block.high ? top[i].high : block.high;
+        }
+        mLevels.push_back(std::move(blocks));
+    }
+}
+
+void S2Plugin::MinMaxPyramid::clear()
+{
+    mLevels.clear();
+    mSize = 0;
+}
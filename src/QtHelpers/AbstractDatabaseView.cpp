@@ -1,11 +1,13 @@
 #include "QtHelpers/AbstractDatabaseView.h"
 
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/StyledItemDelegateHTML.h"
 #include "QtHelpers/TableWidgetItemNumeric.h"
 #include "QtHelpers/TreeWidgetItemNumeric.h"
 #include "QtPlugin.h"
+#include "ReadPlan.h"
+#include "StructPlan.h"
 #include "pluginmain.h"
-#include "read_helpers.h"
 #include <QCheckBox>
 #include <QComboBox>
 #include <QHash>
@@ -17,6 +19,7 @@
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
 #include <QVBoxLayout>
+#include <type_traits>
 
 namespace std
 {
@@ -34,11 +37,20 @@ struct ComparisonField
 {
     S2Plugin::MemoryFieldType type{S2Plugin::MemoryFieldType::None};
     size_t offset{0};
+    size_t size{0};
+    S2Plugin::FieldDecoder decoder{S2Plugin::FieldDecoder::None};
     std::string refName; // for flags
     uint8_t flagIndex{0};
 };
 Q_DECLARE_METATYPE(ComparisonField)
 
+namespace
+{
+    // the records are next to each other, the whole database is read in few bulk reads
+    constexpr size_t gsMaxRecordGap = 0x1000;
+    constexpr size_t gsMaxRangeSize = 0x100000;
+} // namespace
+
 S2Plugin::AbstractDatabaseView::AbstractDatabaseView(MemoryFieldType type, QWidget* parent) : QWidget(parent)
 {
     setWindowIcon(getCavemanIcon());
@@ -100,7 +112,7 @@ S2Plugin::AbstractDatabaseView::AbstractDatabaseView(MemoryFieldType type, QWidg
         auto topLayout = new QHBoxLayout();
         mCompareFieldComboBox = new QComboBox();
         mCompareFieldComboBox->addItem(QString::fromStdString(""));
-        populateComparisonComboBox(config->typeFields(type));
+        populateComparisonComboBox(config->structPlanId(config->typeFields(type)));
 
         QObject::connect(mCompareFieldComboBox, &QComboBox::currentTextChanged, this, &AbstractDatabaseView::comparisonFieldChosen);
         topLayout->addWidget(mCompareFieldComboBox);
@@ -289,24 +301,23 @@ void S2Plugin::AbstractDatabaseView::populateComparisonTableWidget(const QVarian
 {
     mCompareTableWidget->setSortingEnabled(false);
 
-    int row = 0;
-    for (ID_type x = 0; x <= highestRecordID(); ++x)
+    std::vector<ID_type> ids;
+    ReadPlan plan;
+    readComparisonValues(fieldData, ids, plan);
+    for (size_t i = 0; i < ids.size(); ++i)
     {
-        if (!isValidRecordID(x))
-            continue;
-
+        auto x = ids[i];
+        int row = static_cast<int>(i);
         auto item0 = new QTableWidgetItem(QString::asprintf("%03d", x));
         item0->setTextAlignment(Qt::AlignCenter);
         mCompareTableWidget->setItem(row, 0, item0);
         const auto name = recordNameForID(x);
         mCompareTableWidget->setItem(row, 1, new QTableWidgetItem(QString("<font color='blue'><u>%1</u></font>").arg(name)));
 
-        auto [caption, value] = valueForField(fieldData, addressOfRecordID(x));
+        auto [caption, value] = valueForField(fieldData, plan.data(i));
         auto item = new TableWidgetItemNumeric(caption);
         item->setData(Qt::UserRole, value);
         mCompareTableWidget->setItem(row, 2, item);
-
-        row++;
     }
     mCompareTableWidget->setSortingEnabled(true);
     mCompareTableWidget->sortItems(0);
@@ -316,23 +327,23 @@ void S2Plugin::AbstractDatabaseView::populateComparisonTreeWidget(const QVariant
 {
     mCompareTreeWidget->setSortingEnabled(false);
 
+    std::vector<ID_type> ids;
+    ReadPlan plan;
+    readComparisonValues(fieldData, ids, plan);
     std::unordered_map<QString, QVariant> rootValues;
     std::unordered_map<QString, std::vector<ID_type>> groupedValues; // valueString -> vector<id's>
-    for (ID_type x = 0; x <= highestRecordID(); ++x)
+    for (size_t i = 0; i < ids.size(); ++i)
     {
-        if (!isValidRecordID(x))
-            continue;
-
-        auto [caption, value] = valueForField(fieldData, addressOfRecordID(x));
+        auto [caption, value] = valueForField(fieldData, plan.data(i));
         rootValues[caption] = value;
 
         if (auto it = groupedValues.find(caption); it != groupedValues.end())
         {
-            it->second.push_back(x);
+            it->second.push_back(ids[i]);
         }
         else
         {
-            groupedValues[caption] = {x};
+            groupedValues[caption] = {ids[i]};
         }
     }
 
@@ -374,140 +385,88 @@ void S2Plugin::AbstractDatabaseView::groupedComparisonItemClicked(QTreeWidgetIte
     }
 }
 
-size_t S2Plugin::AbstractDatabaseView::populateComparisonComboBox(const std::vector<MemoryField>& fields, size_t offset, std::string prefix)
+void S2Plugin::AbstractDatabaseView::populateComparisonComboBox(uint32_t planId, size_t offset, std::string prefix)
 {
-    for (const auto& field : fields)
-    {
-        if (field.isPointer)
-        {
-            // we don't do pointers as i don't think there are any important ones for comparison in databases
+    if (planId == StructPlans::noPlan)
+        return;
 
-            offset += sizeof(uintptr_t);
+    auto& plans = Configuration::get()->structPlans();
+    for (const auto& instruction : plans.plan(planId).instructions)
+    {
+        // we don't do pointers as i don't think there are any important ones for comparison in databases
+        if (instruction.pointerHop)
             continue;
-        }
-        switch (field.type)
+
+        auto& field = *instruction.field;
+        if (instruction.decoder == FieldDecoder::None)
         {
-            case MemoryFieldType::Skip:
-                break;
-            case MemoryFieldType::Flags32:
-            case MemoryFieldType::Flags16:
-            case MemoryFieldType::Flags8:
-            {
-                ComparisonField parentFlag;
-                parentFlag.type = field.type;
-                parentFlag.offset = offset;
-                parentFlag.refName = field.firstParameterType;
-                mCompareFieldComboBox->addItem(QString::fromStdString(prefix + field.name), QVariant::fromValue(parentFlag));
-                break;
-            }
-            case MemoryFieldType::DefaultStructType:
-            {
-                offset = populateComparisonComboBox(Configuration::get()->typeFieldsOfDefaultStruct(field.jsonName), offset, prefix + field.name + ".");
-                continue;
-            }
-            default:
-            {
-                ComparisonField tmp;
-                tmp.offset = offset;
-                tmp.type = field.type;
-                mCompareFieldComboBox->addItem(QString::fromStdString(prefix + field.name), QVariant::fromValue(tmp));
-                break;
-            }
+            // structs inside of the record, fields that are not a single number can't be compared
+            populateComparisonComboBox(instruction.childPlan, offset + instruction.offset, prefix + field.name + ".");
+            continue;
         }
-        offset += field.get_size();
+        ComparisonField tmp;
+        tmp.type = field.type;
+        tmp.offset = offset + instruction.offset;
+        tmp.size = instruction.size;
+        tmp.decoder = instruction.decoder;
+        if (field.type == MemoryFieldType::Flags32 || field.type == MemoryFieldType::Flags16 || field.type == MemoryFieldType::Flags8)
+            tmp.refName = field.firstParameterType;
+
+        mCompareFieldComboBox->addItem(QString::fromStdString(prefix + field.name), QVariant::fromValue(tmp));
     }
-    return offset;
 }
 
-std::pair<QString, QVariant> S2Plugin::AbstractDatabaseView::valueForField(const QVariant& data, uintptr_t addr)
+void S2Plugin::AbstractDatabaseView::readComparisonValues(const QVariant& fieldData, std::vector<ID_type>& ids, ReadPlan& plan) const
 {
-    ComparisonField compData = qvariant_cast<ComparisonField>(data);
-
-    auto offset = addr + compData.offset;
-    switch (compData.type)
+    ComparisonField compData = qvariant_cast<ComparisonField>(fieldData);
+    for (ID_type x = 0; x <= highestRecordID(); ++x)
     {
-        // we only handle types that occur in the DB's
-        case MemoryFieldType::Byte:
-        case MemoryFieldType::State8:
-        {
-            int8_t value = Read<int8_t>(offset);
-            return std::make_pair(QString::asprintf("%d", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::CharacterDBID:
-        case MemoryFieldType::UnsignedByte:
-        case MemoryFieldType::Flags8:
-        {
-            uint8_t value = Read<uint8_t>(offset);
-            return std::make_pair(QString::asprintf("%u", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Word:
-        case MemoryFieldType::State16:
-        {
-            int16_t value = Read<int16_t>(offset);
-            return std::make_pair(QString::asprintf("%d", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::UnsignedWord:
-        case MemoryFieldType::Flags16:
-        {
-            uint16_t value = Read<uint16_t>(offset);
-            return std::make_pair(QString::asprintf("%u", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::TextureDBID:
-        case MemoryFieldType::Dword:
-        case MemoryFieldType::State32:
-        {
-            int32_t value = Read<int32_t>(offset);
-            return std::make_pair(QString::asprintf("%ld", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::ParticleDBID:
-        case MemoryFieldType::EntityDBID:
-        case MemoryFieldType::StringsTableID:
-        case MemoryFieldType::UnsignedDword:
-        case MemoryFieldType::Flags32:
-        {
-            uint32_t value = Read<uint32_t>(offset);
-            return std::make_pair(QString::asprintf("%lu", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Qword:
-        {
-            int64_t value = Read<int64_t>(offset);
-            return std::make_pair(QString::asprintf("%lld", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::UnsignedQword:
-        {
-            uint64_t value = Read<uint64_t>(offset);
-            return std::make_pair(QString::asprintf("%llu", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Float:
-        {
-            uint32_t dword = Script::Memory::ReadDword(offset);
-            float value = reinterpret_cast<float&>(dword);
-            return std::make_pair(QString::asprintf("%f", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Double:
-        {
-            uint64_t qword = Script::Memory::ReadQword(offset);
-            double value = reinterpret_cast<double&>(qword);
-            return std::make_pair(QString::asprintf("%lf", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Bool:
-        {
-            auto b = Read<bool>(offset);
-            return std::make_pair(b ? "True" : "False", QVariant::fromValue(b));
-        }
-        case MemoryFieldType::Flag:
-        {
-            uint8_t flagToCheck = compData.flagIndex;
-            bool isFlagSet = false;
-            if (flagToCheck > 15)
-                isFlagSet = ((Script::Memory::ReadDword(offset) & (1 << flagToCheck)) != 0);
-            else if (flagToCheck > 7)
-                isFlagSet = ((Script::Memory::ReadWord(offset) & (1 << flagToCheck)) != 0);
-            else
-                isFlagSet = ((Script::Memory::ReadByte(offset) & (1 << flagToCheck)) != 0);
-
-            return std::make_pair(isFlagSet ? "True" : "False", QVariant::fromValue(isFlagSet));
-        }
+        if (!isValidRecordID(x))
+            continue;
+
+        ids.push_back(x);
+        plan.add(addressOfRecordID(x) + compData.offset, compData.size);
     }
-    return std::make_pair("unknown", 0);
+    plan.build(gsMaxRecordGap, gsMaxRangeSize);
+    plan.execute();
+}
+
+std::pair<QString, QVariant> S2Plugin::AbstractDatabaseView::valueForField(const QVariant& data, const uint8_t* buffer)
+{
+    ComparisonField compData = qvariant_cast<ComparisonField>(data);
+
+    std::pair<QString, QVariant> result{"unknown", 0};
+    decodeField(compData.decoder, buffer,
+                [&](auto value)
+                {
+                    using T = decltype(value);
+                    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+                    {
+                        if (compData.type == MemoryFieldType::Flag)
+                        {
+                            bool isFlagSet = (static_cast<uint64_t>(value) & (1ull << compData.flagIndex)) != 0;
+                            result = std::make_pair(isFlagSet ? "True" : "False", QVariant::fromValue(isFlagSet));
+                            return;
+                        }
+                    }
+                    if constexpr (std::is_same_v<T, bool>)
+                        result = std::make_pair(value ? "True" : "False", QVariant::fromValue(value));
+                    else if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t>)
+                        result = std::make_pair(QString::asprintf("%d", value), QVariant::fromValue(value));
+                    else if constexpr (std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t>)
+                        result = std::make_pair(QString::asprintf("%u", value), QVariant::fromValue(value));
+                    else if constexpr (std::is_same_v<T, int32_t>)
+                        result = std::make_pair(QString::asprintf("%ld", value), QVariant::fromValue(value));
+                    else if constexpr (std::is_same_v<T, uint32_t>)
+                        result = std::make_pair(QString::asprintf("%lu", value), QVariant::fromValue(value));
+                    else if constexpr (std::is_same_v<T, int64_t>)
+                        result = std::make_pair(QString::asprintf("%lld", value), QVariant::fromValue(value));
+                    else if constexpr (std::is_same_v<T, uint64_t>)
+                        result = std::make_pair(QString::asprintf("%llu", value), QVariant::fromValue(value));
+                    else if constexpr (std::is_same_v<T, float>)
+                        result = std::make_pair(QString::asprintf("%f", value), QVariant::fromValue(value));
+                    else
+                        result = std::make_pair(QString::asprintf("%lf", value), QVariant::fromValue(value));
+                });
+    return result;
 }
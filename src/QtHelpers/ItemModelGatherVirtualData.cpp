@@ -1,8 +1,11 @@
 #include "QtHelpers/ItemModelGatherVirtualData.h"
 
 #include "Configuration.h"
+#include "Data/EntityList.h"
+#include "Data/EntitySnapshot.h"
 #include "Spelunky2.h"
 #include "pluginmain.h"
+#include "read_helpers.h"
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
@@ -94,40 +97,27 @@ void S2Plugin::ItemModelGatherVirtualData::gatherEntities()
     if (statePtr == 0)
         return;
 
-    auto processEntities = [&](size_t layerEntities, uint32_t count)
+    // only the vtable and the type are needed, read the headers of both layers in few bulk reads
+    EntitySnapshot snapshot;
+    auto layer0 = Read<uintptr_t>(config->offsetForField(config->typeFields(MemoryFieldType::State), "layer0", statePtr));
+    snapshot.addList(EntityList{layer0 + 0x8}, 10000u);
+    auto layer1 = Read<uintptr_t>(config->offsetForField(config->typeFields(MemoryFieldType::State), "layer1", statePtr));
+    snapshot.addList(EntityList{layer1 + 0x8}, 10000u);
+    snapshot.read();
+
+    beginResetModel();
+    for (size_t x = 0; x < snapshot.size(); ++x)
     {
-        uint32_t maximum = (std::min)(count, 10000u);
-        for (uint32_t x = 0; x < maximum; ++x)
+        auto entityType = snapshot.entityTypeID(x);
+        for (auto& entry : mEntries)
         {
-            auto entityPtr = layerEntities + (x * sizeof(size_t));
-            auto entity = Script::Memory::ReadQword(entityPtr);
-            auto entityVTableOffset = Script::Memory::ReadQword(entity);
-
-            auto entityType = Script::Memory::ReadDword(Script::Memory::ReadQword(entity + 0x8) + 0x14);
-
-            for (auto& entry : mEntries)
+            if (entry.virtualTableOffset == 0 && entry.id == entityType)
             {
-                if (entry.virtualTableOffset == 0 && entry.id == entityType)
-                {
-                    auto tableOffset = (entityVTableOffset - vtl.tableStartAddress()) / sizeof(size_t);
-                    entry.virtualTableOffset = tableOffset;
-                }
+                auto tableOffset = (snapshot.vtable(x) - vtl.tableStartAddress()) / sizeof(size_t);
+                entry.virtualTableOffset = tableOffset;
             }
         }
-    };
-
-    beginResetModel();
-    auto layer0Offset = config->offsetForField(config->typeFields(MemoryFieldType::State), "layer0", statePtr);
-    auto layer0 = Script::Memory::ReadQword(layer0Offset);
-    auto layer0Count = Script::Memory::ReadDword(layer0 + 28);
-    auto layer0Entities = Script::Memory::ReadQword(layer0 + 8);
-    processEntities(layer0Entities, layer0Count);
-
-    auto layer1Offset = config->offsetForField(config->typeFields(MemoryFieldType::State), "layer1", statePtr);
-    auto layer1 = Script::Memory::ReadQword(layer1Offset);
-    auto layer1Count = Script::Memory::ReadDword(layer1 + 28);
-    auto layer1Entities = Script::Memory::ReadQword(layer1 + 8);
-    processEntities(layer1Entities, layer1Count);
+    }
     endResetModel();
 }
 
@@ -568,7 +558,7 @@ void S2Plugin::ItemModelGatherVirtualData::gatherAvailableVirtuals()
     {
         if (entry.id < 1000 && entry.virtualTableOffset != 0)
         {
-            auto entityClassHierarchy = config->classHierarchyOfEntity(entry.name.toStdString());
+            auto& entityClassHierarchy = config->classHierarchyOfEntity(static_cast<uint32_t>(entry.id));
             bool isMovable = false;
             for (const auto& c : entityClassHierarchy)
             {
@@ -1,5 +1,4 @@
 #include "QtHelpers/ItemModelLoggerSamples.h"
-#include "Configuration.h"
 #include "Data/Logger.h"
 #include "QtHelpers/TableViewLogger.h"
 
@@ -7,71 +6,25 @@ QVariant S2Plugin::ItemModelLoggerSamples::data(const QModelIndex& index, int ro
 {
     if (role == Qt::DisplayRole)
     {
+        // captures are read a chunk of rows at a time, the rows around are in the same chunk
+        size_t rowIndex = static_cast<size_t>(index.row());
+        auto samples = mLogger->samples(Logger::SampleWindow::Table, rowIndex, rowIndex + 1);
+        if (rowIndex < samples.first || rowIndex - samples.first >= samples.sampleIndexes.size())
+            return QVariant();
+
+        size_t sample = rowIndex - samples.first;
         if (index.column() == 0)
         {
-            return index.row();
+            // sampler tick, skips the samples left out by the triggers
+            return static_cast<qulonglong>(samples.sampleIndexes[sample]);
         }
         else
         {
-            const auto& field = mLogger->fieldAt(static_cast<size_t>(index.column()) - 1);
-            const auto& samples = mLogger->samplesForField(field.uuid);
-            size_t rowIndex = static_cast<size_t>(index.row());
-            switch (field.type)
-            {
-                case MemoryFieldType::Byte:
-                {
-                    return std::any_cast<int8_t>(samples.at(rowIndex));
-                }
-                case MemoryFieldType::UnsignedByte:
-                case MemoryFieldType::Bool:
-                case MemoryFieldType::Flags8:
-                case MemoryFieldType::State8:
-                case MemoryFieldType::CharacterDBID:
-                {
-                    return std::any_cast<uint8_t>(samples.at(rowIndex));
-                }
-                case MemoryFieldType::Word:
-                {
-                    return std::any_cast<int16_t>(samples.at(rowIndex));
-                }
-                case MemoryFieldType::UnsignedWord:
-                case MemoryFieldType::Flags16:
-                case MemoryFieldType::State16:
-                {
-                    return std::any_cast<uint16_t>(samples.at(rowIndex));
-                }
-                case MemoryFieldType::Dword:
-                case MemoryFieldType::TextureDBID:
-                case MemoryFieldType::State32:
-                case MemoryFieldType::EntityUID:
-                {
-                    return std::any_cast<int32_t>(samples.at(rowIndex));
-                }
-                case MemoryFieldType::UnsignedDword:
-                case MemoryFieldType::Flags32:
-                case MemoryFieldType::EntityDBID:
-                case MemoryFieldType::ParticleDBID:
-                case MemoryFieldType::StringsTableID:
-                {
-                    return std::any_cast<uint32_t>(samples.at(rowIndex));
-                }
-                case MemoryFieldType::Float:
-                {
-                    return std::any_cast<float>(samples.at(rowIndex));
-                }
-                case MemoryFieldType::Double:
-                {
-                    return std::any_cast<double>(samples.at(rowIndex));
-                }
-                case MemoryFieldType::Qword:
-                {
-                    return std::any_cast<int64_t>(samples.at(rowIndex));
-                }
-                case MemoryFieldType::UnsignedQword:
-                {
-                    return std::any_cast<uint64_t>(samples.at(rowIndex));
-                }
-            }
+            size_t fieldIndex = static_cast<size_t>(index.column()) - 1;
+            if (fieldIndex >= samples.columns.size() || sample >= samples.columns[fieldIndex].size())
+                return QVariant();
+
+            return samples.columns[fieldIndex].visitAt(sample, [](auto value) -> QVariant { return value; });
         }
     }
     return QVariant();
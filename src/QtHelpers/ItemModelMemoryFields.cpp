@@ -0,0 +1,19 @@
+#include "QtHelpers/ItemModelMemoryFields.h"
+
+#include "QtHelpers/TreeViewMemoryFields.h"
+
+void S2Plugin::ItemModelMemoryFields::fetchMore(const QModelIndex& parent)
+{
+    mTree->fetchChildren(itemFromIndex(parent));
+}
+
+bool S2Plugin::ItemModelMemoryFields::takePendingChildren(const QStandardItem* item, PendingChildren& children)
+{
+    auto it = mPendingChildren.find(item);
+    if (it == mPendingChildren.end())
+        return false;
+
+    children = std::move(it->second);
+    mPendingChildren.erase(it);
+    return true;
+}
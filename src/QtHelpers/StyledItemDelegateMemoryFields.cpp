@@ -0,0 +1,153 @@
+#include "QtHelpers/StyledItemDelegateMemoryFields.h"
+
+#include "QtHelpers/ItemRoles.h"
+#include <QApplication>
+#include <QFontMetrics>
+#include <QModelIndex>
+#include <QPainter>
+#include <QStyle>
+#include <QStyleOptionViewItem>
+
+namespace
+{
+    // same as the margin around the text of the html documents
+    constexpr int gsTextMargin = 4;
+
+    QColor textColor(S2Plugin::CellStyle style, const QModelIndex& index, const QStyleOptionViewItem& option)
+    {
+        switch (style)
+        {
+            case S2Plugin::CellStyle::Link:
+                return QColor("blue");
+            case S2Plugin::CellStyle::CodeLink:
+            case S2Plugin::CellStyle::True:
+                return QColor("green");
+            case S2Plugin::CellStyle::False:
+                return QColor("red");
+            case S2Plugin::CellStyle::Muted:
+            case S2Plugin::CellStyle::MutedLink:
+                return QColor("#AAA");
+            case S2Plugin::CellStyle::CollapseLink:
+                return QColor("darkMagenta");
+            default:
+            {
+                auto color = index.data(Qt::TextColorRole);
+                if (!color.isNull())
+                    return color.value<QColor>();
+
+                return option.palette.color(QPalette::Text);
+            }
+        }
+    }
+
+    QFont textFont(S2Plugin::CellStyle style, QFont font)
+    {
+        switch (style)
+        {
+            case S2Plugin::CellStyle::Link:
+            case S2Plugin::CellStyle::CodeLink:
+            case S2Plugin::CellStyle::MutedLink:
+            case S2Plugin::CellStyle::CollapseLink:
+                font.setUnderline(true);
+                break;
+            case S2Plugin::CellStyle::Bold:
+                font.setBold(true);
+                break;
+            default:
+                break;
+        }
+        return font;
+    }
+
+    uint8_t flagsBitCount(const QModelIndex& index)
+    {
+        switch (index.sibling(index.row(), S2Plugin::gsColField).data(S2Plugin::gsRoleType).value<S2Plugin::MemoryFieldType>())
+        {
+            case S2Plugin::MemoryFieldType::Flags8:
+                return 8;
+            case S2Plugin::MemoryFieldType::Flags16:
+                return 16;
+            default:
+                return 32;
+        }
+    }
+
+    // "32: N N Y N 28: ..." from the highest bit, Y in green and N in red
+    // returns the width, draws only when painter is not null
+    int drawFlags(QPainter* painter, const QFontMetrics& metrics, QPoint pos, uint32_t value, uint8_t bitCount, const QColor& labelColor)
+    {
+        static const QColor setColor("green");
+        static const QColor unsetColor("red");
+        int x = pos.x();
+        auto draw = [&](const QString& text, const QColor& color)
+        {
+            if (painter != nullptr)
+            {
+                painter->setPen(color);
+                painter->drawText(QPoint(x, pos.y()), text);
+            }
+            x += metrics.width(text);
+        };
+        for (uint8_t bit = bitCount; bit > 0; --bit)
+        {
+            if ((bitCount - bit) % 4 == 0)
+                draw(QString::number(bit) + ": ", labelColor);
+
+            bool isSet = (value & (1u << (bit - 1u))) != 0;
+            draw(isSet ? "Y " : "N ", isSet ? setColor : unsetColor);
+        }
+        return x - pos.x();
+    }
+} // namespace
+
+void S2Plugin::StyledItemDelegateMemoryFields::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    QStyleOptionViewItem options = option;
+    initStyleOption(&options, index);
+    auto cellStyle = static_cast<CellStyle>(index.data(gsRoleCellStyle).toUInt());
+    auto text = options.text;
+
+    // background, selection and icon as usual, the text is drawn here
+    options.text.clear();
+    auto widgetStyle = options.widget != nullptr ? options.widget->style() : QApplication::style();
+    widgetStyle->drawControl(QStyle::CE_ItemViewItem, &options, painter, options.widget);
+
+    auto rect = widgetStyle->subElementRect(QStyle::SE_ItemViewItemText, &options, options.widget).adjusted(gsTextMargin, 0, -gsTextMargin, 0);
+    painter->save();
+    painter->setClipRect(rect);
+    auto font = textFont(cellStyle, options.font);
+    painter->setFont(font);
+    auto color = textColor(cellStyle, index, options);
+    if (cellStyle == CellStyle::Flags)
+    {
+        auto value = index.data(gsRoleRawValue);
+        if (value.isValid())
+        {
+            QFontMetrics metrics(font);
+            int baseline = rect.top() + (rect.height() + metrics.ascent() - metrics.descent()) / 2;
+            drawFlags(painter, metrics, QPoint(rect.left(), baseline), value.toUInt(), flagsBitCount(index), color);
+        }
+    }
+    else if (!text.isEmpty())
+    {
+        painter->setPen(color);
+        painter->drawText(rect, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine, text);
+    }
+    painter->restore();
+}
+
+QSize S2Plugin::StyledItemDelegateMemoryFields::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    QStyleOptionViewItem options = option;
+    initStyleOption(&options, index);
+    auto cellStyle = static_cast<CellStyle>(index.data(gsRoleCellStyle).toUInt());
+    options.font = textFont(cellStyle, options.font);
+    auto size = QStyledItemDelegate::sizeHint(options, index);
+    if (cellStyle == CellStyle::Flags)
+    {
+        auto value = index.data(gsRoleRawValue);
+        if (value.isValid())
+            size.setWidth(drawFlags(nullptr, QFontMetrics(options.font), {}, 0, flagsBitCount(index), {}) + 2 * gsTextMargin);
+    }
+    return size;
+}
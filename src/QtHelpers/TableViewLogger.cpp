@@ -3,6 +3,7 @@
 #include "Configuration.h" // for MemoryFieldType
 #include "Data/Logger.h"
 #include "QtHelpers/ItemModelLoggerFields.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/StyledItemDelegateColorPicker.h"
 #include "QtHelpers/TreeViewMemoryFields.h" // for gsDragDropMemoryField_UID, gsDragDropMemoryField_Type ...
 #include "QtPlugin.h"
@@ -53,43 +54,15 @@ void S2Plugin::TableViewLogger::dropEvent(QDropEvent* event)
 
     LoggerField field;
     field.type = event->mimeData()->property(gsDragDropMemoryField_Type).value<MemoryFieldType>();
-    switch (field.type)
+    if (!LoggerColumn::isSupported(field.type))
     {
-        // List allowed types
-        case MemoryFieldType::Byte:
-        case MemoryFieldType::UnsignedByte:
-        case MemoryFieldType::Bool:
-        case MemoryFieldType::Flags8:
-        case MemoryFieldType::State8:
-        case MemoryFieldType::CharacterDBID:
-        case MemoryFieldType::Word:
-        case MemoryFieldType::UnsignedWord:
-        case MemoryFieldType::Flags16:
-        case MemoryFieldType::State16:
-        case MemoryFieldType::Dword:
-        case MemoryFieldType::UnsignedDword:
-        case MemoryFieldType::Float:
-        case MemoryFieldType::Flags32:
-        case MemoryFieldType::State32:
-        case MemoryFieldType::EntityDBID:
-        case MemoryFieldType::EntityUID:
-        case MemoryFieldType::ParticleDBID:
-        case MemoryFieldType::TextureDBID:
-        case MemoryFieldType::StringsTableID:
-        case MemoryFieldType::Qword:
-        case MemoryFieldType::UnsignedQword:
-        case MemoryFieldType::Double:
-            break;
-        default:
-        {
-            QMessageBox msgBox;
-            msgBox.setIcon(QMessageBox::Critical);
-            msgBox.setWindowIcon(getCavemanIcon());
-            msgBox.setText("This field type is not supported for logging");
-            msgBox.setWindowTitle("Spelunky2");
-            msgBox.exec();
-            return;
-        }
+        QMessageBox msgBox;
+        msgBox.setIcon(QMessageBox::Critical);
+        msgBox.setWindowIcon(getCavemanIcon());
+        msgBox.setText("This field type is not supported for logging");
+        msgBox.setWindowTitle("Spelunky2");
+        msgBox.exec();
+        return;
     }
     field.uuid = QUuid::createUuid().toString().toStdString();
     field.memoryAddr = event->mimeData()->property(gsDragDropMemoryField_Address).toULongLong();
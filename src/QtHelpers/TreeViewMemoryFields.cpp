@@ -8,8 +8,11 @@
 #include "QtHelpers/DialogEditSimpleValue.h"
 #include "QtHelpers/DialogEditState.h"
 #include "QtHelpers/DialogEditString.h"
-#include "QtHelpers/StyledItemDelegateHTML.h"
+#include "QtHelpers/ItemModelMemoryFields.h"
+#include "QtHelpers/ItemRoles.h"
+#include "QtHelpers/StyledItemDelegateMemoryFields.h"
 #include "QtPlugin.h"
+#include "ReadCache.h"
 #include "Spelunky2.h"
 #include "Views/ViewCharacterDB.h"
 #include "Views/ViewEntity.h"
@@ -24,22 +27,44 @@
 #include <QDragEnterEvent>
 #include <QDragMoveEvent>
 #include <QDropEvent>
+#include <QKeyEvent>
 #include <QMimeData>
 #include <QModelIndex>
 #include <QPainter>
+#include <QScrollBar>
 #include <QStandardItem>
 #include <QStandardItemModel>
 #include <QString>
 #include <QTextCodec>
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <sstream>
 #include <string>
 
+// plain text, the delegate draws it in the style
+static void setCell(QStandardItem* item, const QString& text, S2Plugin::CellStyle style)
+{
+    item->setData(text, Qt::DisplayRole);
+    item->setData(static_cast<uint8_t>(style), S2Plugin::gsRoleCellStyle);
+}
+
+static void setCellStyle(QStandardItem* item, S2Plugin::CellStyle style)
+{
+    item->setData(static_cast<uint8_t>(style), S2Plugin::gsRoleCellStyle);
+}
+
+static void copyCell(QStandardItem* to, const QStandardItem* from)
+{
+    to->setData(from->data(Qt::DisplayRole), Qt::DisplayRole);
+    to->setData(from->data(S2Plugin::gsRoleCellStyle), S2Plugin::gsRoleCellStyle);
+}
+
 S2Plugin::TreeViewMemoryFields::TreeViewMemoryFields(QWidget* parent) : QTreeView(parent)
 {
-    setItemDelegate(new StyledItemDelegateHTML(this));
+    setItemDelegate(new StyledItemDelegateMemoryFields(this));
     setAlternatingRowColors(true);
-    mModel = new QStandardItemModel(this);
+    mModel = new ItemModelMemoryFields(this, this);
     setModel(mModel);
 
     setDragDropMode(QAbstractItemView::DragDropMode::DragDrop);
@@ -69,6 +94,12 @@ QTreeView::branch:open:has-children:has-siblings  {
 })");
 
     QObject::connect(this, &QTreeView::clicked, this, &TreeViewMemoryFields::cellClicked);
+    // rows under collapsed items were not updated, they can't be compared with the previous snapshot
+    QObject::connect(this, &QTreeView::expanded, this, [this]() { resetSnapshots(); });
+    // rows skipped while out of the view are updated once they show up, by scrolling, expanding, collapsing or resizing
+    QObject::connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this]() { refreshStaleRows(); });
+    QObject::connect(verticalScrollBar(), &QScrollBar::rangeChanged, this, [this]() { refreshStaleRows(); });
+    QObject::connect(this, &QTreeView::expanded, this, [this]() { refreshStaleRows(); });
 }
 
 void S2Plugin::TreeViewMemoryFields::addMemoryFields(const std::vector<MemoryField>& fields, const std::string& mainName, uintptr_t structAddr, size_t initialDelta, uint8_t deltaPrefixCount,
@@ -90,12 +121,26 @@ void S2Plugin::TreeViewMemoryFields::addMemoryFields(const std::vector<MemoryFie
 QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField& field, const std::string& fieldNameOverride, uintptr_t memoryAddress, size_t delta, uint8_t deltaPrefixCount,
                                                               QStandardItem* parent)
 {
-    auto createAndInsertItem = [&delta, &deltaPrefixCount](const MemoryField& field, const std::string& fieldNameUID, QStandardItem* itemParent, uintptr_t memAddr,
-                                                           bool showDelta = true) -> QStandardItem*
+    return addNamedMemoryField(field, field.name, fieldNameOverride, memoryAddress, delta, deltaPrefixCount, parent);
+}
+
+QStandardItem* S2Plugin::TreeViewMemoryFields::addNamedMemoryField(const MemoryField& field, const std::string& name, const std::string& fieldNameOverride, uintptr_t memoryAddress, size_t delta,
+                                                                   uint8_t deltaPrefixCount, QStandardItem* parent)
+{
+    if (parent == nullptr)
+    {
+        mRootDeltaBegin = (std::min)(mRootDeltaBegin, delta);
+        mRootDeltaEnd = (std::max)(mRootDeltaEnd, delta + field.get_size());
+    }
+    // new rows have to be updated at least once
+    resetSnapshots();
+
+    auto createAndInsertItem = [&delta, &deltaPrefixCount](const MemoryField& field, const std::string& displayName, const std::string& fieldNameUID, QStandardItem* itemParent,
+                                                           uintptr_t memAddr, bool showDelta = true) -> QStandardItem*
     {
         auto itemFieldName = new QStandardItem();
         itemFieldName->setEditable(false);
-        itemFieldName->setData(QString::fromStdString(field.name), Qt::DisplayRole);
+        itemFieldName->setData(QString::fromStdString(displayName), Qt::DisplayRole);
         itemFieldName->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
         itemFieldName->setData(QVariant::fromValue(field.type), gsRoleType);
         itemFieldName->setData(field.isPointer, gsRoleIsPointer);
@@ -119,7 +164,7 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
         itemFieldMemoryOffset->setEditable(false);
         if (memAddr != 0)
         {
-            itemFieldMemoryOffset->setData(QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", memAddr), Qt::DisplayRole);
+            setCell(itemFieldMemoryOffset, QString::asprintf("0x%016llX", memAddr), CellStyle::Link);
             // for click event. we could just use the itemFieldName(gsRoleMemoryAddress), but doing it this way for potential itemComparisonFieldMemoryOffset in the future
             itemFieldMemoryOffset->setData(memAddr, gsRoleRawValue);
         }
@@ -142,12 +187,12 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
 
         auto itemFieldComment = new QStandardItem();
         itemFieldComment->setEditable(false);
-        itemFieldComment->setData(QString::fromStdString(field.comment).toHtmlEscaped(), Qt::DisplayRole);
+        itemFieldComment->setData(QString::fromStdString(field.comment), Qt::DisplayRole);
 
         auto itemFieldType = new QStandardItem();
         itemFieldType->setEditable(false);
 
-        QString typeName = field.isPointer ? "<b>P</b>: " : ""; // add color?
+        QString typeName = field.isPointer ? "P: " : ""; // add color?
         if (field.type == MemoryFieldType::Matrix)
             typeName += QString("%1[%2][%3]").arg(QString::fromStdString(field.firstParameterType)).arg(field.rows).arg(field.getNumColumns());
         else if (field.type == MemoryFieldType::Array)
@@ -218,13 +263,13 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
         case MemoryFieldType::UTF16Char:
         case MemoryFieldType::IPv4Address:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
             break;
         }
         case MemoryFieldType::UTF16StringFixedSize:
         case MemoryFieldType::UTF8StringFixedSize:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
             returnField->setData(field.get_size(), gsRoleSize);
             break;
         }
@@ -232,14 +277,14 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
         case MemoryFieldType::State16:
         case MemoryFieldType::State32:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
-            returnField->setData(QVariant::fromValue(field.firstParameterType), gsRoleRefName);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
+            returnField->setData(QVariant::fromValue(field.firstParameterType.str()), gsRoleRefName);
             break;
         }
         case MemoryFieldType::VirtualFunctionTable:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
-            returnField->setData(QVariant::fromValue(field.firstParameterType), gsRoleRefName);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
+            returnField->setData(QVariant::fromValue(field.firstParameterType.str()), gsRoleRefName);
             break;
         }
         case MemoryFieldType::Flags32:
@@ -254,19 +299,19 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
             if (flags == 0)
                 flags = 8;
 
-            auto flagsParent = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
+            auto flagsParent = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
             MemoryField flagField;
             flagField.type = MemoryFieldType::Flag;
             for (uint8_t x = 1; x <= flags; ++x)
             {
-                flagField.name = "flag_" + std::to_string(x);
+                auto flagFieldName = "flag_" + std::to_string(x);
                 bool showDelta = false;
                 if ((x - 1) % 8 == 0)
                 {
                     delta += x == 1 ? 0 : 1;
                     showDelta = true;
                 }
-                auto flagFieldItem = createAndInsertItem(flagField, fieldNameOverride + "." + flagField.name, flagsParent, 0, showDelta);
+                auto flagFieldItem = createAndInsertItem(flagField, flagFieldName, fieldNameOverride + "." + flagFieldName, flagsParent, 0, showDelta);
                 flagFieldItem->setData(x, gsRoleFlagIndex);
                 auto flagName = config->flagTitle(field.firstParameterType, x);
                 QString realFlagName = QString::fromStdString(flagName.empty() ? config->flagTitle("unknown", x) : flagName); // TODO: don't show unknown unless it was chosen in settings
@@ -278,7 +323,7 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
         }
         case MemoryFieldType::UndeterminedThemeInfoPointer:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
             addMemoryFields(config->typeFieldsOfDefaultStruct("ThemeInfoPointer"), fieldNameOverride, 0, 0, deltaPrefixCount + 1u, returnField);
             break;
         }
@@ -286,31 +331,31 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
         case MemoryFieldType::StdList:
         case MemoryFieldType::StdVector:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
-            returnField->setData(QVariant::fromValue(field.firstParameterType), gsRoleStdContainerFirstParameterType);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
+            returnField->setData(QVariant::fromValue(field.firstParameterType.str()), gsRoleStdContainerFirstParameterType);
             if (field.isPointer)
-                addMemoryFields(config->typeFields(field.type), fieldNameOverride, 0, 0, deltaPrefixCount + 1u, returnField);
+                addChildFields(config->typeFields(field.type), fieldNameOverride, 0, deltaPrefixCount + 1u, returnField);
             else
-                addMemoryFields(config->typeFields(field.type), fieldNameOverride, memoryAddress, delta, deltaPrefixCount, returnField);
+                addChildFields(config->typeFields(field.type), fieldNameOverride, delta, deltaPrefixCount, returnField);
 
             break;
         }
         case MemoryFieldType::StdUnorderedMap:
         case MemoryFieldType::StdMap:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
-            returnField->setData(QVariant::fromValue(field.firstParameterType), gsRoleStdContainerFirstParameterType);
-            returnField->setData(QVariant::fromValue(field.secondParameterType), gsRoleStdContainerSecondParameterType);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
+            returnField->setData(QVariant::fromValue(field.firstParameterType.str()), gsRoleStdContainerFirstParameterType);
+            returnField->setData(QVariant::fromValue(field.secondParameterType.str()), gsRoleStdContainerSecondParameterType);
             if (field.isPointer)
-                addMemoryFields(config->typeFields(field.type), fieldNameOverride, 0, 0, deltaPrefixCount + 1u, returnField);
+                addChildFields(config->typeFields(field.type), fieldNameOverride, 0, deltaPrefixCount + 1u, returnField);
             else
-                addMemoryFields(config->typeFields(field.type), fieldNameOverride, memoryAddress, delta, deltaPrefixCount, returnField);
+                addChildFields(config->typeFields(field.type), fieldNameOverride, delta, deltaPrefixCount, returnField);
 
             break;
         }
         case MemoryFieldType::EntitySubclass:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, 0);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, 0);
             returnField->setData(memoryAddress, gsRoleMemoryAddress);
             addMemoryFields(config->typeFieldsOfEntitySubclass(field.jsonName), fieldNameOverride, memoryAddress, delta, deltaPrefixCount, returnField);
             break;
@@ -321,16 +366,16 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
                 returnField = parent;
             else
             {
-                returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
-                returnField->setData(QVariant::fromValue(field.firstParameterType), gsRoleStdContainerFirstParameterType);
+                returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
+                returnField->setData(QVariant::fromValue(field.firstParameterType.str()), gsRoleStdContainerFirstParameterType);
                 returnField->setData(field.numberOfElements, gsRoleSize);
             }
 
             if (field.numberOfElements <= 30 || field.secondParameterType == "#" || field.secondParameterType == "$") // TODO: get the number from settings when done
             {
                 MemoryField index = config->nameToMemoryField(field.firstParameterType);
-                index.name = field.name + '[';
-                auto initialNameSize = index.name.size();
+                std::string indexName = name + '[';
+                auto initialNameSize = indexName.size();
 
                 if (field.isPointer)
                     delta = 0;
@@ -344,10 +389,9 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
 
                 for (; idx < field.numberOfElements; ++idx)
                 {
-                    index.name.erase(initialNameSize);
-                    index.name += std::to_string(idx) + ']';
-
-                    addMemoryField(index, fieldNameOverride + index.name, field.isPointer ? 0 : memoryAddress, delta, field.isPointer ? deltaPrefixCount + 1u : deltaPrefixCount, returnField);
+                    indexName.erase(initialNameSize);
+                    indexName += std::to_string(idx) + ']';
+                    addNamedMemoryField(index, indexName, fieldNameOverride + indexName, field.isPointer ? 0 : memoryAddress, delta, field.isPointer ? deltaPrefixCount + 1u : deltaPrefixCount, returnField);
                     delta += index.get_size();
                     if (memoryAddress != 0)
                         memoryAddress += index.get_size();
@@ -357,44 +401,27 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
         }
         case MemoryFieldType::Matrix:
         {
-            if (!field.secondParameterType.empty())
-                returnField = parent;
-            else
-            {
-                returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
-                returnField->setData(QVariant::fromValue(field.firstParameterType), gsRoleStdContainerFirstParameterType);
-                returnField->setData(field.rows, gsRoleSize);
-                returnField->setData(field.getNumColumns(), gsRoleColumns);
-            }
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
+            returnField->setData(QVariant::fromValue(field.firstParameterType.str()), gsRoleStdContainerFirstParameterType);
+            returnField->setData(field.rows, gsRoleSize);
+            returnField->setData(field.getNumColumns(), gsRoleColumns);
 
-            if (field.rows <= 30 || !field.secondParameterType.empty()) // TODO: get the number from settings when done
-                                                                        // columns limit dealt by the array
+            if (field.rows <= 30) // TODO: get the number from settings when done
+                                  // columns limit dealt by the array
             {
-                MemoryField row;
-                row.numberOfElements = field.getNumColumns();
-                row.firstParameterType = field.firstParameterType;
-                row.secondParameterType = "$"; // just to let it know it should put all the elements in, no matrix element
-                                               // it can't be # since we still want the array to be placed normally, just no size limit
-                row.type = MemoryFieldType::Array;
-                row.name = field.name + '[';
-                auto initialNameSize = row.name.size();
+                MemoryField row = matrixRowField(field);
+                std::string rowName = name + '[';
+                auto initialNameSize = rowName.size();
 
                 if (field.isPointer)
                     delta = 0;
-                size_t idx = 0;
-                if (!field.secondParameterType.empty())
-                {
-                    auto rowStart = std::stoull(field.secondParameterType);
-                    delta += rowStart * row.get_size();
-                    memoryAddress += rowStart * row.get_size();
-                    idx = rowStart;
-                }
 
-                for (; idx < field.rows; ++idx)
+                for (size_t idx = 0; idx < field.rows; ++idx)
                 {
-                    row.name.erase(initialNameSize);
-                    row.name += std::to_string(idx) + ']';
-                    addMemoryField(row, fieldNameOverride + row.name, field.isPointer ? 0 : memoryAddress, delta, field.isPointer ? deltaPrefixCount + 1u : deltaPrefixCount, returnField);
+                    rowName.erase(initialNameSize);
+                    rowName += std::to_string(idx) + ']';
+                    addNamedMemoryField(row, rowName, fieldNameOverride + rowName, field.isPointer ? 0 : memoryAddress, delta, field.isPointer ? deltaPrefixCount + 1u : deltaPrefixCount,
+                                        returnField);
                     delta += row.get_size();
                     if (memoryAddress != 0)
                         memoryAddress += row.get_size();
@@ -404,14 +431,14 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
         }
         case MemoryFieldType::OnHeapPointer:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
             if (field.jsonName.empty())
                 break;
 
             // no isPointer check, for now
             auto addr = Spelunky2::get()->get_HeapBase(true);
             addr += addr == 0 ? 0 : Script::Memory::ReadQword(memoryAddress);
-            if (auto fields = config->typeFieldsOfDefaultStruct(field.jsonName); !fields.empty())
+            if (auto& fields = config->typeFieldsOfDefaultStruct(field.jsonName); !fields.empty())
             {
                 addMemoryFields(fields, fieldNameOverride, addr, 0, deltaPrefixCount + 1u, returnField);
             }
@@ -424,21 +451,21 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
         }
         case MemoryFieldType::DefaultStructType:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
             if (field.isPointer)
-                addMemoryFields(config->typeFieldsOfDefaultStruct(field.jsonName), fieldNameOverride, 0, 0, deltaPrefixCount + 1u, returnField);
+                addChildFields(config->typeFieldsOfDefaultStruct(field.jsonName), fieldNameOverride, 0, deltaPrefixCount + 1u, returnField);
             else
-                addMemoryFields(config->typeFieldsOfDefaultStruct(field.jsonName), fieldNameOverride, memoryAddress, delta, deltaPrefixCount, returnField);
+                addChildFields(config->typeFieldsOfDefaultStruct(field.jsonName), fieldNameOverride, delta, deltaPrefixCount, returnField);
 
             break;
         }
         default:
         {
-            returnField = createAndInsertItem(field, fieldNameOverride, parent, memoryAddress);
+            returnField = createAndInsertItem(field, name, fieldNameOverride, parent, memoryAddress);
             if (field.isPointer)
-                addMemoryFields(config->typeFields(field.type), fieldNameOverride, 0, 0, deltaPrefixCount + 1u, returnField);
+                addChildFields(config->typeFields(field.type), fieldNameOverride, 0, deltaPrefixCount + 1u, returnField);
             else
-                addMemoryFields(config->typeFields(field.type), fieldNameOverride, memoryAddress, delta, deltaPrefixCount, returnField);
+                addChildFields(config->typeFields(field.type), fieldNameOverride, delta, deltaPrefixCount, returnField);
 
             break;
         }
@@ -446,6 +473,71 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
     return returnField;
 }
 
+S2Plugin::MemoryField S2Plugin::TreeViewMemoryFields::matrixRowField(const MemoryField& matrix)
+{
+    MemoryField row;
+    row.numberOfElements = static_cast<uint32_t>(matrix.getNumColumns());
+    row.firstParameterType = matrix.firstParameterType;
+    row.secondParameterType = "$"; // just to let it know it should put all the elements in, no matrix element
+                                   // it can't be # since we still want the array to be placed normally, just no size limit
+    row.type = MemoryFieldType::Array;
+    return row;
+}
+
+void S2Plugin::TreeViewMemoryFields::addChildFields(const std::vector<MemoryField>& fields, const std::string& mainName, size_t delta, uint8_t deltaPrefixCount, QStandardItem* parent)
+{
+    if (!fields.empty())
+        mModel->setPendingChildren(parent, {fields, mainName, delta, deltaPrefixCount});
+}
+
+bool S2Plugin::TreeViewMemoryFields::fetchChildren(QStandardItem* item)
+{
+    ItemModelMemoryFields::PendingChildren children;
+    if (item == nullptr || !mModel->takePendingChildren(item, children))
+        return false;
+
+    auto parent = item->parent() == nullptr ? mModel->invisibleRootItem() : item->parent();
+    // the new rows get the same addresses as if they were updated together with the struct from the start
+    uintptr_t addr;
+    uintptr_t comparisonAddr;
+    if (item->data(gsRoleIsPointer).toBool())
+    {
+        addr = parent->child(item->row(), gsColValue)->data(gsRoleMemoryAddress).toULongLong();
+        comparisonAddr = parent->child(item->row(), gsColComparisonValue)->data(gsRoleMemoryAddress).toULongLong();
+        addMemoryFields(children.fields, children.name, 0, 0, children.deltaPrefixCount, item);
+    }
+    else
+    {
+        // delta of inline struct is relative to the same address as the deltas of its fields
+        uintptr_t structAddr = item->data(gsRoleMemoryAddress).toULongLong();
+        uintptr_t comparisonStructAddr = item->data(gsRoleComparisonMemoryAddress).toULongLong();
+        addr = structAddr == 0 ? 0 : structAddr - children.delta;
+        comparisonAddr = comparisonStructAddr == 0 ? 0 : comparisonStructAddr - children.delta;
+        addMemoryFields(children.fields, children.name, structAddr, children.delta, children.deltaPrefixCount, item);
+    }
+
+    ReadCache::Scope readCacheScope;
+    primeSnapshotReads();
+    for (int row = 0; row < item->rowCount(); ++row)
+    {
+        updateRow(row, addr == 0 ? std::nullopt : std::optional<uintptr_t>(addr), comparisonAddr == 0 ? std::nullopt : std::optional<uintptr_t>(comparisonAddr), item, true);
+    }
+    return true;
+}
+
+void S2Plugin::TreeViewMemoryFields::fetchAllChildren(QStandardItem* parent)
+{
+    if (parent == nullptr)
+        parent = mModel->invisibleRootItem();
+
+    for (int row = 0; row < parent->rowCount(); ++row)
+    {
+        auto item = parent->child(row, gsColField);
+        fetchChildren(item);
+        fetchAllChildren(item);
+    }
+}
+
 void S2Plugin::TreeViewMemoryFields::updateTableHeader(bool restoreColumnWidths)
 {
     mModel->setHorizontalHeaderLabels({"Field", "Value", "Value (hex)", "Comparison value", "Comparison value (hex)", "Memory Address", "Δ", "Type", "Comment"});
@@ -503,10 +595,118 @@ void S2Plugin::TreeViewMemoryFields::updateTableHeader(bool restoreColumnWidths)
 
 void S2Plugin::TreeViewMemoryFields::updateTree(uintptr_t newAddr, uintptr_t newComparisonAddr, bool initial)
 {
-    for (int row = 0; row < mModel->invisibleRootItem()->rowCount(); ++row)
+    auto start = std::chrono::steady_clock::now();
+    ReadCache::Scope readCacheScope;
+    auto root = mModel->invisibleRootItem();
+    bool comparisonActive = mActiveColumns.test(gsColComparisonValue) || mActiveColumns.test(gsColComparisonValueHex);
+    // comparison values are not updated when the columns are hidden
+    if (initial || comparisonActive != mSnapshotComparisonActive)
+        resetSnapshots();
+
+    mSnapshotComparisonActive = comparisonActive;
+    mRefreshStatistics = {};
+    // only the plain refresh can leave rows behind, new addresses have to reach every row
+    mRowRefresh.cull = !initial && newAddr == 0 && newComparisonAddr == 0 && collectVisibleRows();
+    if (root->rowCount() != 0)
+    {
+        // the delta of the first row is relative to the start of the root struct
+        auto rootAddress = [root](uintptr_t newBase, int role) -> uintptr_t
+        {
+            if (newBase != 0)
+                return newBase;
+
+            auto addr = root->child(0, gsColField)->data(role).toULongLong();
+            return addr == 0 ? 0 : addr - root->child(0, gsColMemoryAddressDelta)->data(gsRoleRawValue).toULongLong();
+        };
+        if (updateSnapshot(mSnapshot, rootAddress(newAddr, gsRoleMemoryAddress)))
+            mRowRefresh.snapshot = &mSnapshot;
+        if (comparisonActive && updateSnapshot(mComparisonSnapshot, rootAddress(newComparisonAddr, gsRoleComparisonMemoryAddress)))
+            mRowRefresh.comparisonSnapshot = &mComparisonSnapshot;
+    }
+
+    for (int row = 0; row < root->rowCount(); ++row)
     {
         updateRow(row, newAddr == 0 ? std::nullopt : std::optional<uintptr_t>(newAddr), newComparisonAddr == 0 ? std::nullopt : std::optional<uintptr_t>(newComparisonAddr), nullptr, initial);
     }
+    mRowRefresh = {};
+
+    mRefreshStatistics.changedBytes = mSnapshot.changedBytes();
+    mRefreshStatistics.snapshotSize = mSnapshot.size();
+    mRefreshStatistics.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (mShowRefreshStatistics)
+        viewport()->update();
+}
+
+bool S2Plugin::TreeViewMemoryFields::collectVisibleRows()
+{
+    mVisibleRows.clear();
+    if (!isVisible())
+        return false;
+
+    auto index = indexAt(QPoint(0, 0));
+    if (!index.isValid())
+        return true;
+
+    for (size_t i = 0; i < VisibleRowRange::margin; ++i)
+    {
+        auto above = indexAbove(index);
+        if (!above.isValid())
+            break;
+        index = above;
+    }
+    auto rowCount = VisibleRowRange::rowCount(viewport()->height(), rowHeight(index));
+    for (size_t i = 0; i < rowCount && index.isValid(); ++i)
+    {
+        mVisibleRows.insert(mModel->itemFromIndex(index.sibling(index.row(), gsColField)));
+        index = indexBelow(index);
+    }
+    return true;
+}
+
+void S2Plugin::TreeViewMemoryFields::refreshStaleRows()
+{
+    // inside of updateTree the rows are already being updated
+    if (mRowRefresh.cull || mModel->rowCount() == 0 || !collectVisibleRows())
+        return;
+
+    ReadCache::Scope readCacheScope;
+    primeSnapshotReads();
+    for (auto item : mVisibleRows)
+    {
+        if (item != nullptr && item->data(gsRoleStale).toBool())
+        {
+            // the value changed some time while it was out of the view, don't highlight it now
+            updateRow(item->row(), std::nullopt, std::nullopt, item->parent(), true);
+        }
+    }
+    mVisibleRows.clear();
+}
+
+void S2Plugin::TreeViewMemoryFields::primeSnapshotReads() const
+{
+    // a row read from live memory here could show a value that changes back before the next tick,
+    // the snapshot would report no change then and the row would be skipped with the wrong value
+    mSnapshot.primeReadCache();
+    if (mSnapshotComparisonActive)
+        mComparisonSnapshot.primeReadCache();
+}
+
+bool S2Plugin::TreeViewMemoryFields::updateSnapshot(SnapshotDiff& snapshot, uintptr_t rootAddr)
+{
+    // bigger structs are not worth copying every tick
+    constexpr size_t maxSnapshotSize = 0x100000;
+
+    if (rootAddr == 0 || mRootDeltaEnd <= mRootDeltaBegin || mRootDeltaEnd - mRootDeltaBegin > maxSnapshotSize)
+    {
+        snapshot.reset();
+        return false;
+    }
+    if (!snapshot.update(rootAddr + mRootDeltaBegin, mRootDeltaEnd - mRootDeltaBegin))
+        return false;
+
+    // the rows are read thru the cache, this makes all of the root struct reads free
+    snapshot.primeReadCache();
+    return true;
 }
 
 // this would be much better as lambda function, but lambda with templates is C++20 thing
@@ -560,21 +760,11 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         parent = mModel->invisibleRootItem();
 
     QStandardItem* itemField = parent->child(row, gsColField);
-    QStandardItem* itemValue = parent->child(row, gsColValue);
-    QStandardItem* itemValueHex = parent->child(row, gsColValueHex);
-    QStandardItem* itemComparisonValue = parent->child(row, gsColComparisonValue);
-    QStandardItem* itemComparisonValueHex = parent->child(row, gsColComparisonValueHex);
-
     if (itemField == nullptr)
     {
         dprintf("ERROR: tried to updateRow(%d) but did not find itemField in tree view\n", row);
         return;
     }
-    else if (itemValue == nullptr || itemValueHex == nullptr || itemComparisonValue == nullptr || itemComparisonValueHex == nullptr)
-    {
-        dprintf("ERROR: tried to updateRow(%d), field '%s', but did not find items in tree view\n", row, itemField->data(gsRoleUID).toString().toStdString().c_str());
-        return;
-    }
 
     MemoryFieldType fieldType = itemField->data(gsRoleType).value<MemoryFieldType>();
     if (fieldType == MemoryFieldType::Skip) // TODO: change when setting for it is available
@@ -587,6 +777,54 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
     }
 
     bool isPointer = itemField->data(gsRoleIsPointer).toBool();
+    bool comparisonActive = mActiveColumns.test(gsColComparisonValue) || mActiveColumns.test(gsColComparisonValueHex);
+    RowRefresh::Row refreshRow;
+    refreshRow.type = fieldType;
+    refreshRow.isPointer = isPointer;
+    refreshRow.newAddress = newAddr.has_value() || newAddrComparison.has_value();
+    refreshRow.stale = itemField->data(gsRoleStale).toBool();
+    // rows out of the view are updated when they are scrolled into the view
+    if (mRowRefresh.cull && RowRefresh::isCullable(refreshRow))
+        refreshRow.visible = mVisibleRows.count(itemField) != 0;
+
+    // the addresses are only needed when the row can be skipped
+    if (mRowRefresh.snapshot != nullptr && refreshRow.visible && !refreshRow.stale && RowRefresh::isValueOnly(refreshRow))
+    {
+        refreshRow.address = itemField->data(gsRoleMemoryAddress).toULongLong();
+        refreshRow.comparisonAddress = comparisonActive ? itemField->data(gsRoleComparisonMemoryAddress).toULongLong() : 0;
+    }
+    auto action = mRowRefresh.action(refreshRow);
+    if (action == RowRefreshAction::Cull)
+    {
+        if (!refreshRow.stale)
+            itemField->setData(true, gsRoleStale);
+
+        ++mRefreshStatistics.rowsCulled;
+        return;
+    }
+    if (refreshRow.stale)
+        itemField->setData({}, gsRoleStale);
+
+    // rows showing just their own bytes don't need to be touched when the bytes are the same as in the previous refresh
+    if (action == RowRefreshAction::Skip)
+    {
+        // change highlight only lasts one refresh
+        itemField->setBackground(Qt::transparent);
+        ++mRefreshStatistics.rowsSkipped;
+        return;
+    }
+    ++mRefreshStatistics.rowsTouched;
+
+    QStandardItem* itemValue = parent->child(row, gsColValue);
+    QStandardItem* itemValueHex = parent->child(row, gsColValueHex);
+    QStandardItem* itemComparisonValue = parent->child(row, gsColComparisonValue);
+    QStandardItem* itemComparisonValueHex = parent->child(row, gsColComparisonValueHex);
+    if (itemValue == nullptr || itemValueHex == nullptr || itemComparisonValue == nullptr || itemComparisonValueHex == nullptr)
+    {
+        dprintf("ERROR: tried to updateRow(%d), field '%s', but did not find items in tree view\n", row, itemField->data(gsRoleUID).toString().toStdString().c_str());
+        return;
+    }
+
     uintptr_t memoryOffset = 0;
     uintptr_t comparisonMemoryOffset = 0;
     const auto comparisonDifferenceColor = QColor::fromRgb(255, 221, 184);
@@ -600,7 +838,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         memoryOffset = newAddr.value() == 0 ? 0 : newAddr.value() + deltaData.toULongLong();
         if (!deltaData.isNull())
         {
-            itemMemoryOffset->setData(QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", memoryOffset), Qt::DisplayRole);
+            setCell(itemMemoryOffset, QString::asprintf("0x%016llX", memoryOffset), CellStyle::Link);
             itemMemoryOffset->setData(memoryOffset, gsRoleRawValue);
         }
         itemField->setData(memoryOffset, gsRoleMemoryAddress);
@@ -624,7 +862,6 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
 
     bool pointerUpdate = false;
     bool comparisonPointerUpdate = false;
-    bool comparisonActive = mActiveColumns.test(gsColComparisonValue) || mActiveColumns.test(gsColComparisonValueHex);
     uintptr_t valueMemoryOffset = memoryOffset;                     // 0, memory offset or pointer value (no bad values)
     uintptr_t valueComparisonMemoryOffset = comparisonMemoryOffset; // 0, memory offset or pointer value (no bad values)
 
@@ -641,29 +878,22 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             auto pointerTmp = pointerValue;
             if (oldData.isNull() || oldPointer != pointerValue)
             {
-                QString newHexValue;
                 if (pointerValue == 0)
-                    newHexValue = "<font color='#AAA'>nullptr</font>";
-                else if (!Script::Memory::IsValidPtr(pointerValue))
+                    setCell(valueHexField, "nullptr", CellStyle::Muted);
+                else if (!IsValidPtr(pointerValue))
                 {
-                    newHexValue = "<font color='#AAA'>bad ptr</font>";
+                    setCell(valueHexField, "bad ptr", CellStyle::Muted);
                     pointerValue = 0;
                 }
                 else
-                {
-                    if (fieldType == MemoryFieldType::CodePointer)
-                        newHexValue = QString::asprintf("<font color='green'><u>0x%016llX</u></font>", pointerValue);
-                    else
-                        newHexValue = QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", pointerValue);
-                }
+                    setCell(valueHexField, QString::asprintf("0x%016llX", pointerValue), fieldType == MemoryFieldType::CodePointer ? CellStyle::CodeLink : CellStyle::Link);
 
-                valueHexField->setData(newHexValue, Qt::DisplayRole);
                 valueHexField->setData(pointerTmp, gsRoleRawValue);
                 return true;
             }
             return false;
         };
-        newPointer = Script::Memory::ReadQword(memoryOffset);
+        newPointer = Read<uintptr_t>(memoryOffset);
         valueMemoryOffset = newPointer;
         pointerUpdate = checkAndUpdatePointer(valueMemoryOffset, itemValueHex);
         itemValue->setData(valueMemoryOffset, gsRoleMemoryAddress);
@@ -675,7 +905,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
 
         if (comparisonActive)
         {
-            newComparisonPointer = Script::Memory::ReadQword(comparisonMemoryOffset);
+            newComparisonPointer = Read<uintptr_t>(comparisonMemoryOffset);
             valueComparisonMemoryOffset = newComparisonPointer;
             comparisonPointerUpdate = checkAndUpdatePointer(valueComparisonMemoryOffset, itemComparisonValueHex);
             itemComparisonValue->setData(valueComparisonMemoryOffset, gsRoleMemoryAddress);
@@ -698,43 +928,18 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         }
     }
 
-    auto flagsString = [](uint32_t value, uint8_t size)
-    {
-        std::stringstream ss;
-        uint8_t counter = 0;
-        for (uint8_t x = size - 1u;; --x)
-        {
-            if (counter % 4 == 0)
-            {
-                ss << (x + 1) << ": ";
-            }
-            if ((value & (1u << x)) == (1u << x))
-            {
-                ss << "<font color='green'>Y</font> ";
-            }
-            else
-            {
-                ss << "<font color='red'>N</font> ";
-            }
-            counter++;
-            if (x == 0)
-                break;
-        }
-        return ss;
-    };
-
     switch (fieldType)
     {
         case MemoryFieldType::CodePointer:
         case MemoryFieldType::DataPointer:
         {
             if (pointerUpdate)
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
 
             if (comparisonActive)
             {
                 if (comparisonPointerUpdate)
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
 
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
             }
@@ -874,13 +1079,14 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         {
             std::optional<uint64_t> value;
             std::optional<uint64_t> comparisonValue;
-            value = updateField<uint64_t>(itemField, valueMemoryOffset, itemValue, "<font color='blue'><u>0x%016llX</u></font>", itemValueHex, isPointer, "0x%016llX", true, !pointerUpdate,
-                                          highlightColor);
+            value = updateField<uint64_t>(itemField, valueMemoryOffset, itemValue, "0x%016llX", itemValueHex, isPointer, "0x%016llX", true, !pointerUpdate, highlightColor);
+            setCellStyle(itemValue, CellStyle::Link);
 
             if (comparisonActive)
             {
-                comparisonValue = updateField<uint64_t>(itemField, valueComparisonMemoryOffset, itemComparisonValue, "<b>0x%016llX</b>", itemComparisonValueHex, isPointer, "0x%016llX", false, false,
-                                                        highlightColor);
+                comparisonValue =
+                    updateField<uint64_t>(itemField, valueComparisonMemoryOffset, itemComparisonValue, "0x%016llX", itemComparisonValueHex, isPointer, "0x%016llX", false, false, highlightColor);
+                setCellStyle(itemComparisonValue, CellStyle::Bold);
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
                 if (isPointer == false)
                     itemComparisonValueHex->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
@@ -951,14 +1157,14 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             std::optional<bool> value;
             value = updateField<bool>(itemField, valueMemoryOffset, itemValue, nullptr, itemValueHex, isPointer, "0x%02X", true, !pointerUpdate, highlightColor);
             if (value.has_value())
-                itemValue->setData(value.value() ? "<font color='green'>True</font>" : "<font color='red'>False</font>", Qt::DisplayRole);
+                setCell(itemValue, value.value() ? "True" : "False", value.value() ? CellStyle::True : CellStyle::False);
 
             if (comparisonActive)
             {
                 std::optional<bool> comparisonValue;
                 comparisonValue = updateField<bool>(itemField, valueComparisonMemoryOffset, itemComparisonValue, nullptr, itemComparisonValueHex, isPointer, "0x%02X", false, false, highlightColor);
                 if (comparisonValue.has_value())
-                    itemComparisonValue->setData(comparisonValue.value() ? "<font color='green'>True</font>" : "<font color='red'>False</font>", Qt::DisplayRole);
+                    setCell(itemComparisonValue, comparisonValue.value() ? "True" : "False", comparisonValue.value() ? CellStyle::True : CellStyle::False);
 
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
                 if (isPointer == false)
@@ -971,7 +1177,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             std::optional<uint32_t> value;
             value = updateField<uint32_t>(itemField, valueMemoryOffset, itemValue, nullptr, itemValueHex, isPointer, "0x%08X", true, !pointerUpdate, highlightColor);
             if (value.has_value())
-                itemValue->setData(QString::fromStdString(flagsString(value.value(), 32).str()), Qt::DisplayRole);
+                setCellStyle(itemValue, CellStyle::Flags);
 
             if (comparisonActive)
             {
@@ -979,7 +1185,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 comparisonValue =
                     updateField<uint32_t>(itemField, valueComparisonMemoryOffset, itemComparisonValue, nullptr, itemComparisonValueHex, isPointer, "0x%08X", false, false, highlightColor);
                 if (comparisonValue.has_value())
-                    itemComparisonValue->setData(QString::fromStdString(flagsString(comparisonValue.value(), 32).str()), Qt::DisplayRole);
+                    setCellStyle(itemComparisonValue, CellStyle::Flags);
 
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
                 if (isPointer == false)
@@ -999,7 +1205,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             std::optional<uint16_t> value;
             value = updateField<uint16_t>(itemField, valueMemoryOffset, itemValue, nullptr, itemValueHex, isPointer, "0x%04X", true, !pointerUpdate, highlightColor);
             if (value.has_value())
-                itemValue->setData(QString::fromStdString(flagsString(value.value(), 16).str()), Qt::DisplayRole);
+                setCellStyle(itemValue, CellStyle::Flags);
 
             if (comparisonActive)
             {
@@ -1007,7 +1213,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 comparisonValue =
                     updateField<uint16_t>(itemField, valueComparisonMemoryOffset, itemComparisonValue, nullptr, itemComparisonValueHex, isPointer, "0x%04X", false, false, highlightColor);
                 if (comparisonValue.has_value())
-                    itemComparisonValue->setData(QString::fromStdString(flagsString(comparisonValue.value(), 16).str()), Qt::DisplayRole);
+                    setCellStyle(itemComparisonValue, CellStyle::Flags);
 
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
                 if (isPointer == false)
@@ -1027,14 +1233,14 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             std::optional<uint8_t> value;
             value = updateField<uint8_t>(itemField, valueMemoryOffset, itemValue, nullptr, itemValueHex, isPointer, "0x%02X", true, !pointerUpdate, highlightColor);
             if (value.has_value())
-                itemValue->setData(QString::fromStdString(flagsString(value.value(), 8).str()), Qt::DisplayRole);
+                setCellStyle(itemValue, CellStyle::Flags);
 
             if (comparisonActive)
             {
                 std::optional<uint8_t> comparisonValue;
                 comparisonValue = updateField<uint8_t>(itemField, valueComparisonMemoryOffset, itemComparisonValue, nullptr, itemComparisonValueHex, isPointer, "0x%02X", false, false, highlightColor);
                 if (comparisonValue.has_value())
-                    itemComparisonValue->setData(QString::fromStdString(flagsString(comparisonValue.value(), 8).str()), Qt::DisplayRole);
+                    setCellStyle(itemComparisonValue, CellStyle::Flags);
 
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
                 if (isPointer == false)
@@ -1172,7 +1378,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             std::optional<uint16_t> value;
             value = updateField<uint16_t>(itemField, valueMemoryOffset, itemValue, nullptr, itemValueHex, isPointer, "0x%04X", true, !pointerUpdate, highlightColor);
             if (value.has_value())
-                itemValue->setData(QString("'<b>%1</b>' (%2)").arg(QString(QChar(value.value())).toHtmlEscaped()).arg(value.value()), Qt::DisplayRole);
+                itemValue->setData(QString("'%1' (%2)").arg(QString(QChar(value.value()))).arg(value.value()), Qt::DisplayRole);
 
             if (comparisonActive)
             {
@@ -1180,7 +1386,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 comparisonValue =
                     updateField<uint16_t>(itemField, valueComparisonMemoryOffset, itemComparisonValue, nullptr, itemComparisonValueHex, isPointer, "0x%04X", false, false, highlightColor);
                 if (comparisonValue.has_value())
-                    itemComparisonValue->setData(QString("'<b>%1</b>' (%2)").arg(QString(QChar(comparisonValue.value())).toHtmlEscaped()).arg(comparisonValue.value()), Qt::DisplayRole);
+                    itemComparisonValue->setData(QString("'%1' (%2)").arg(QString(QChar(comparisonValue.value()))).arg(comparisonValue.value()), Qt::DisplayRole);
 
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
                 if (isPointer == false)
@@ -1205,9 +1411,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             {
                 value = std::wstring();
                 value->resize(length);
-                Script::Memory::Read(valueMemoryOffset, value->data(), size, nullptr);
+                ReadMemory(valueMemoryOffset, value->data(), size);
                 auto buffer_w = reinterpret_cast<const ushort*>(value->c_str());
-                auto valueString = ('\"' + QString::fromUtf16(buffer_w) + '\"').toHtmlEscaped();
+                auto valueString = '\"' + QString::fromUtf16(buffer_w) + '\"';
 
                 auto valueOld = itemValue->data(Qt::DisplayRole); // no need for gsRoleRawValue
                 if (valueOld.isNull() || valueString != valueOld.toString())
@@ -1240,9 +1446,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 {
                     comparisonValue = std::wstring();
                     comparisonValue->resize(length);
-                    Script::Memory::Read(valueComparisonMemoryOffset, comparisonValue->data(), size, nullptr);
+                    ReadMemory(valueComparisonMemoryOffset, comparisonValue->data(), size);
                     auto buffer_w = reinterpret_cast<const ushort*>(comparisonValue->c_str());
-                    auto valueString = ('\"' + QString::fromUtf16(buffer_w) + '\"').toHtmlEscaped();
+                    auto valueString = '\"' + QString::fromUtf16(buffer_w) + '\"';
 
                     auto valueOld = itemComparisonValue->data(Qt::DisplayRole); // no need for gsRoleRawValue
                     if (valueOld.isNull() || valueString != valueOld.toString())
@@ -1280,8 +1486,8 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             {
                 value = std::string();
                 value->resize(size);
-                Script::Memory::Read(valueMemoryOffset, value->data(), size, nullptr);
-                auto valueString = ('\"' + QString::fromUtf8(value->c_str()) + '\"').toHtmlEscaped(); // using c_str and not fromStdString to ignore characters after null terminator
+                ReadMemory(valueMemoryOffset, value->data(), size);
+                auto valueString = '\"' + QString::fromUtf8(value->c_str()) + '\"'; // using c_str and not fromStdString to ignore characters after null terminator
 
                 auto valueOld = itemValue->data(Qt::DisplayRole); // no need for gsRoleRawValue
                 if (valueOld.isNull() || valueString != valueOld.toString())
@@ -1314,8 +1520,8 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 {
                     comparisonValue = std::string();
                     comparisonValue->resize(size);
-                    Script::Memory::Read(valueComparisonMemoryOffset, comparisonValue->data(), size, nullptr);
-                    auto valueString = ('\"' + QString::fromUtf8(comparisonValue->c_str()) + '\"').toHtmlEscaped();
+                    ReadMemory(valueComparisonMemoryOffset, comparisonValue->data(), size);
+                    auto valueString = '\"' + QString::fromUtf8(comparisonValue->c_str()) + '\"';
 
                     auto valueOld = itemComparisonValue->data(Qt::DisplayRole); // no need for gsRoleRawValue
                     if (valueOld.isNull() || valueString != valueOld.toString())
@@ -1348,7 +1554,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 if (entityName._Starts_with("UNKNOWN ID: "))
                     itemValue->setData(QString::asprintf("%u (%s)", value, entityName.c_str()), Qt::DisplayRole);
                 else
-                    itemValue->setData(QString::asprintf("<font color='blue'><u>%u (%s)</u></font>", value, entityName.c_str()), Qt::DisplayRole);
+                    setCell(itemValue, QString::asprintf("%u (%s)", value, entityName.c_str()), CellStyle::Link);
             }
 
             if (comparisonActive)
@@ -1362,7 +1568,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                     if (entityName._Starts_with("UNKNOWN ID: "))
                         itemComparisonValue->setData(QString::asprintf("%u (%s)", comparisonValue, entityName.c_str()), Qt::DisplayRole);
                     else
-                        itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>%u (%s)</u></font>", comparisonValue, entityName.c_str()), Qt::DisplayRole);
+                        setCell(itemComparisonValue, QString::asprintf("%u (%s)", comparisonValue, entityName.c_str()), CellStyle::Link);
                 }
 
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
@@ -1380,13 +1586,11 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 if (value.value() < 0)
                 {
                     // TODO: write better explanation
-                    itemValue->setData(QString::asprintf("<font color='blue'><u>%d (dynamically applied in ThemeInfo->get_dynamic_floor_texture_id())</u></font>", value.value()), Qt::DisplayRole);
+                    setCell(itemValue, QString::asprintf("%d (dynamically applied in ThemeInfo->get_dynamic_floor_texture_id())", value.value()), CellStyle::Link);
                 }
                 else
                 {
-                    itemValue->setData(
-                        QString::asprintf("<font color='blue'><u>%d (%s)</u></font>", value.value(), Spelunky2::get()->get_TextureDB().nameForID(static_cast<uint32_t>(value.value())).c_str()),
-                        Qt::DisplayRole);
+                    setCell(itemValue, QString::asprintf("%d (%s)", value.value(), Spelunky2::get()->get_TextureDB().nameForID(static_cast<uint32_t>(value.value())).c_str()), CellStyle::Link);
                 }
             }
             if (comparisonActive)
@@ -1397,14 +1601,13 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 {
                     if (comparisonValue.value() < 0)
                     {
-                        itemComparisonValue->setData(
-                            QString::asprintf("<font color='blue'><u>%d (dynamically applied in ThemeInfo->get_dynamic_floor_texture_id())</u></font>", comparisonValue.value()), Qt::DisplayRole);
+                        setCell(itemComparisonValue, QString::asprintf("%d (dynamically applied in ThemeInfo->get_dynamic_floor_texture_id())", comparisonValue.value()), CellStyle::Link);
                     }
                     else
                     {
-                        itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>%d (%s)</u></font>", comparisonValue.value(),
-                                                                       Spelunky2::get()->get_TextureDB().nameForID(static_cast<uint32_t>(comparisonValue.value())).c_str()),
-                                                     Qt::DisplayRole);
+                        setCell(itemComparisonValue,
+                                QString::asprintf("%d (%s)", comparisonValue.value(), Spelunky2::get()->get_TextureDB().nameForID(static_cast<uint32_t>(comparisonValue.value())).c_str()),
+                                CellStyle::Link);
                     }
                 }
 
@@ -1419,7 +1622,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             std::optional<uint32_t> value;
             value = updateField<uint32_t>(itemField, valueMemoryOffset, itemValue, nullptr, itemValueHex, isPointer, "0x%08X", true, !pointerUpdate, highlightColor);
             if (value.has_value())
-                itemValue->setData(QString("%1: %2").arg(value.value()).arg(Spelunky2::get()->get_StringsTable(true).stringForIndex(value.value())).toHtmlEscaped(), Qt::DisplayRole);
+                itemValue->setData(QString("%1: %2").arg(value.value()).arg(Spelunky2::get()->get_StringsTable(true).stringForIndex(value.value())), Qt::DisplayRole);
 
             if (comparisonActive)
             {
@@ -1428,7 +1631,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                     updateField<uint32_t>(itemField, valueComparisonMemoryOffset, itemComparisonValue, nullptr, itemComparisonValueHex, isPointer, "0x%08X", false, false, highlightColor);
                 if (comparisonValue.has_value())
                 {
-                    itemComparisonValue->setData(QString("%1: %2").arg(comparisonValue.value()).arg(Spelunky2::get()->get_StringsTable(true).stringForIndex(comparisonValue.value())).toHtmlEscaped(),
+                    itemComparisonValue->setData(QString("%1: %2").arg(comparisonValue.value()).arg(Spelunky2::get()->get_StringsTable(true).stringForIndex(comparisonValue.value())),
                                                  Qt::DisplayRole);
                 }
 
@@ -1445,7 +1648,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             if (value.has_value())
             {
                 std::string particleName = Configuration::get()->particleEmittersList().nameForID(value.value());
-                itemValue->setData(QString::asprintf("<font color='blue'><u>%u (%s)</u></font>", value.value(), particleName.c_str()), Qt::DisplayRole);
+                setCell(itemValue, QString::asprintf("%u (%s)", value.value(), particleName.c_str()), CellStyle::Link);
             }
 
             if (comparisonActive)
@@ -1456,7 +1659,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 if (comparisonValue.has_value())
                 {
                     std::string particleName = Configuration::get()->particleEmittersList().nameForID(comparisonValue.value());
-                    itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>%u (%s)</u></font>", comparisonValue.value(), particleName.c_str()), Qt::DisplayRole);
+                    setCell(itemComparisonValue, QString::asprintf("%u (%s)", comparisonValue.value(), particleName.c_str()), CellStyle::Link);
                 }
 
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
@@ -1482,7 +1685,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                     if (entityOffset != 0)
                     {
                         auto entityName = Configuration::get()->getEntityName(Entity{entityOffset}.entityTypeID());
-                        itemValue->setData(QString::asprintf("<font color='blue'><u>UID %u (%s)</u></font>", value.value(), entityName.c_str()), Qt::DisplayRole);
+                        setCell(itemValue, QString::asprintf("UID %u (%s)", value.value(), entityName.c_str()), CellStyle::Link);
                         itemValue->setData(entityOffset, gsRoleEntityAddress);
                     }
                     else
@@ -1510,7 +1713,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                         if (comparisonEntityOffset != 0)
                         {
                             auto entityName = Configuration::get()->getEntityName(Entity{comparisonEntityOffset}.entityTypeID());
-                            itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>UID %u (%s)</u></font>", comparisonValue.value(), entityName.c_str()), Qt::DisplayRole);
+                            setCell(itemComparisonValue, QString::asprintf("UID %u (%s)", comparisonValue.value(), entityName.c_str()), CellStyle::Link);
                             itemComparisonValue->setData(comparisonEntityOffset, gsRoleEntityAddress);
                         }
                         else
@@ -1530,22 +1733,22 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::EntityPointer:
         {
             if (valueMemoryOffset == 0) // nullptr or bad ptr
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             else
             {
                 // TODO: unknown entity?
                 auto entityName = Configuration::get()->getEntityName(Entity{valueMemoryOffset}.entityTypeID());
-                itemValue->setData(QString::asprintf("<font color='blue'><u>%s</u></font>", entityName.c_str()), Qt::DisplayRole);
+                setCell(itemValue, QString::asprintf("%s", entityName.c_str()), CellStyle::Link);
                 itemValue->setData(valueMemoryOffset, gsRoleRawValue); // set to 0/clear when unknown entity?
             }
             if (comparisonActive)
             {
                 if (valueComparisonMemoryOffset == 0)
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole));
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
                 else
                 {
                     auto comparisonEntityName = Configuration::get()->getEntityName(Entity{valueComparisonMemoryOffset}.entityTypeID());
-                    itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>%s</u></font>", comparisonEntityName.c_str()), Qt::DisplayRole);
+                    setCell(itemComparisonValue, QString::asprintf("%s", comparisonEntityName.c_str()), CellStyle::Link);
                     itemComparisonValue->setData(valueComparisonMemoryOffset, gsRoleRawValue); // set to 0/clear when unknown entity?
                 }
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
@@ -1555,22 +1758,22 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::EntityDBPointer:
         {
             if (valueMemoryOffset == 0) // nullptr or bad ptr
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             else
             {
-                auto id = Script::Memory::ReadDword(valueMemoryOffset + 0x14);
+                auto id = Read<uint32_t>(valueMemoryOffset + 0x14);
                 auto entityName = Configuration::get()->entityList().nameForID(id);
-                itemValue->setData(QString::asprintf("<font color='blue'><u>EntityDB %d %s</u></font>", id, entityName.c_str()), Qt::DisplayRole);
+                setCell(itemValue, QString::asprintf("EntityDB %d %s", id, entityName.c_str()), CellStyle::Link);
             }
             if (comparisonActive)
             {
                 if (valueComparisonMemoryOffset == 0)
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole));
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
                 else
                 {
-                    auto comparisonID = Script::Memory::ReadDword(valueComparisonMemoryOffset + 20);
+                    auto comparisonID = Read<uint32_t>(valueComparisonMemoryOffset + 20);
                     auto comparisonEntityName = Configuration::get()->entityList().nameForID(comparisonID);
-                    itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>EntityDB %d %s</u></font>", comparisonID, comparisonEntityName.c_str()), Qt::DisplayRole);
+                    setCell(itemComparisonValue, QString::asprintf("EntityDB %d %s", comparisonID, comparisonEntityName.c_str()), CellStyle::Link);
                 }
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
             }
@@ -1579,22 +1782,22 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::TextureDBPointer:
         {
             if (valueMemoryOffset == 0) // nullptr or bad ptr
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             else
             {
-                auto id = Script::Memory::ReadQword(valueMemoryOffset);
+                auto id = Read<uintptr_t>(valueMemoryOffset);
                 auto& textureName = Spelunky2::get()->get_TextureDB().nameForID(id);
-                itemValue->setData(QString::asprintf("<font color='blue'><u>TextureDB %d %s</u></font>", id, textureName.c_str()), Qt::DisplayRole);
+                setCell(itemValue, QString::asprintf("TextureDB %d %s", id, textureName.c_str()), CellStyle::Link);
             }
             if (comparisonActive)
             {
                 if (valueComparisonMemoryOffset == 0)
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole));
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
                 else
                 {
-                    auto comparisonID = Script::Memory::ReadQword(valueComparisonMemoryOffset);
+                    auto comparisonID = Read<uintptr_t>(valueComparisonMemoryOffset);
                     auto& comparisonTextureName = Spelunky2::get()->get_TextureDB().nameForID(comparisonID);
-                    itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>TextureDB %d %s</u></font>", comparisonID, comparisonTextureName.c_str()), Qt::DisplayRole);
+                    setCell(itemComparisonValue, QString::asprintf("TextureDB %d %s", comparisonID, comparisonTextureName.c_str()), CellStyle::Link);
                 }
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
             }
@@ -1603,16 +1806,16 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::LevelGenPointer:
         {
             if (valueMemoryOffset == 0) // nullptr or bad ptr
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             else
-                itemValue->setData("<font color='blue'><u>Show level gen</u></font>", Qt::DisplayRole);
+                setCell(itemValue, "Show level gen", CellStyle::Link);
 
             if (comparisonActive)
             {
                 if (valueComparisonMemoryOffset == 0)
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole));
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
                 else
-                    itemComparisonValue->setData("<font color='blue'><u>Show level gen</u></font>", Qt::DisplayRole);
+                    setCell(itemComparisonValue, "Show level gen", CellStyle::Link);
 
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
             }
@@ -1621,16 +1824,16 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::LiquidPhysicsPointer:
         {
             if (valueMemoryOffset == 0) // nullptr or bad ptr
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             else
-                itemValue->setData("<font color='blue'><u>Show liquid physics</u></font>", Qt::DisplayRole);
+                setCell(itemValue, "Show liquid physics", CellStyle::Link);
 
             if (comparisonActive)
             {
                 if (valueComparisonMemoryOffset == 0)
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole));
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
                 else
-                    itemComparisonValue->setData("<font color='blue'><u>Show liquid physics</u></font>", Qt::DisplayRole);
+                    setCell(itemComparisonValue, "Show liquid physics", CellStyle::Link);
 
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
             }
@@ -1639,22 +1842,22 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::ParticleDBPointer:
         {
             if (valueMemoryOffset == 0) // nullptr or bad ptr
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             else
             {
-                auto id = Script::Memory::ReadDword(valueMemoryOffset);
+                auto id = Read<uint32_t>(valueMemoryOffset);
                 auto particleName = Configuration::get()->particleEmittersList().nameForID(id);
-                itemValue->setData(QString::asprintf("<font color='blue'><u>ParticleDB %d %s</u></font>", id, particleName.c_str()), Qt::DisplayRole);
+                setCell(itemValue, QString::asprintf("ParticleDB %d %s", id, particleName.c_str()), CellStyle::Link);
             }
             if (comparisonActive)
             {
                 if (valueComparisonMemoryOffset == 0)
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole));
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
                 else
                 {
-                    auto comparisonID = Script::Memory::ReadQword(valueComparisonMemoryOffset);
+                    auto comparisonID = Read<uintptr_t>(valueComparisonMemoryOffset);
                     auto comparisonParticleName = Configuration::get()->particleEmittersList().nameForID(comparisonID);
-                    itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>ParticleDB %d %s</u></font>", comparisonID, comparisonParticleName.c_str()), Qt::DisplayRole);
+                    setCell(itemComparisonValue, QString::asprintf("ParticleDB %d %s", comparisonID, comparisonParticleName.c_str()), CellStyle::Link);
                 }
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
             }
@@ -1663,16 +1866,16 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::VirtualFunctionTable:
         {
             if (valueMemoryOffset == 0) // nullptr or bad ptr
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             else
-                itemValue->setData("<font color='blue'><u>Show functions</u></font>", Qt::DisplayRole);
+                setCell(itemValue, "Show functions", CellStyle::Link);
 
             if (comparisonActive)
             {
                 if (valueComparisonMemoryOffset == 0)
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole));
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
                 else
-                    itemComparisonValue->setData("<font color='blue'><u>Show functions</u></font>", Qt::DisplayRole);
+                    setCell(itemComparisonValue, "Show functions", CellStyle::Link);
 
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
             }
@@ -1687,7 +1890,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 auto& characterDB = Spelunky2::get()->get_CharacterDB();
                 bool isValidCharacter = value.value() < characterDB.charactersCount();
                 auto& characterName = isValidCharacter ? Spelunky2::get()->get_CharacterDB().characterNamesStringList().at(static_cast<int>(value.value())) : "";
-                itemValue->setData(QString("<font color='blue'><u>%1 (%2)</u></font>").arg(value.value()).arg(characterName), Qt::DisplayRole);
+                setCell(itemValue, QString("%1 (%2)").arg(value.value()).arg(characterName), CellStyle::Link);
             }
 
             if (comparisonActive)
@@ -1700,7 +1903,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                     auto& characterDB = Spelunky2::get()->get_CharacterDB();
                     bool isValidCharacter = comparisonValue.value() < characterDB.charactersCount();
                     auto& characterName = isValidCharacter ? Spelunky2::get()->get_CharacterDB().characterNamesStringList().at(static_cast<int>(comparisonValue.value())) : "";
-                    itemComparisonValue->setData(QString("<font color='blue'><u>%1 (%2)</u></font>").arg(comparisonValue.value()).arg(characterName), Qt::DisplayRole);
+                    setCell(itemComparisonValue, QString("%1 (%2)").arg(comparisonValue.value()).arg(characterName), CellStyle::Link);
                 }
 
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
@@ -1713,10 +1916,10 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         {
             // TODO: probably delete? it's actually a struct not just a pointer?
             if (valueMemoryOffset != 0)
-                valueMemoryOffset = Script::Memory::ReadQword(valueMemoryOffset);
+                valueMemoryOffset = Read<uintptr_t>(valueMemoryOffset);
 
             if (valueComparisonMemoryOffset != 0)
-                valueComparisonMemoryOffset = Script::Memory::ReadQword(valueComparisonMemoryOffset);
+                valueComparisonMemoryOffset = Read<uintptr_t>(valueComparisonMemoryOffset);
 
             [[fallthrough]];
         }
@@ -1724,24 +1927,24 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         {
             if (valueMemoryOffset == 0)
             {
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             }
             else
             {
                 std::string str = '\"' + ReadConstString(valueMemoryOffset) + '\"';
-                itemValue->setData(QString::fromStdString(str).toHtmlEscaped(), Qt::DisplayRole);
+                itemValue->setData(QString::fromStdString(str), Qt::DisplayRole);
             }
 
             if (comparisonActive)
             {
                 if (valueComparisonMemoryOffset == 0)
                 {
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
                 }
                 else
                 {
                     std::string comparisonStr = '\"' + ReadConstString(valueComparisonMemoryOffset) + '\"';
-                    itemComparisonValue->setData(QString::fromStdString(comparisonStr).toHtmlEscaped(), Qt::DisplayRole);
+                    itemComparisonValue->setData(QString::fromStdString(comparisonStr), Qt::DisplayRole);
                 }
                 // pointer compare
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
@@ -1763,11 +1966,11 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 StdString string{valueMemoryOffset};
                 // [Known Issue]: i don't think we will have pointer to std::string, but note just in case: this would override the pointer value in hex
                 auto ptr = string.string_ptr();
-                itemValueHex->setData(QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", ptr), Qt::DisplayRole);
+                setCell(itemValueHex, QString::asprintf("0x%016llX", ptr), CellStyle::Link);
                 itemValueHex->setData(ptr, gsRoleRawValue);
 
                 stringValue = '\"' + string.get_string() + '\"';
-                auto displayValue = QString::fromStdString(stringValue.value()).toHtmlEscaped();
+                auto displayValue = QString::fromStdString(stringValue.value());
                 itemField->setBackground(itemValue->data(Qt::DisplayRole).toString() == displayValue ? Qt::transparent : highlightColor);
                 itemValue->setData(displayValue, Qt::DisplayRole);
             }
@@ -1785,10 +1988,10 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 {
                     StdString comparisonString{valueComparisonMemoryOffset};
                     comparisonStringValue = '\"' + comparisonString.get_string() + '\"';
-                    itemComparisonValue->setData(QString::fromStdString(comparisonStringValue.value()).toHtmlEscaped(), Qt::DisplayRole);
+                    itemComparisonValue->setData(QString::fromStdString(comparisonStringValue.value()), Qt::DisplayRole);
 
                     auto ptr = comparisonString.string_ptr();
-                    itemComparisonValueHex->setData(QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", ptr), Qt::DisplayRole);
+                    setCell(itemComparisonValueHex, QString::asprintf("0x%016llX", ptr), CellStyle::Link);
                     itemComparisonValueHex->setData(ptr, gsRoleRawValue);
                 }
                 bool compare = stringValue != comparisonStringValue;
@@ -1823,11 +2026,11 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 StdWstring string{valueMemoryOffset};
                 // i don't think we will have pointer to std::string, but note just in case: this would override the pointer value in hex
                 auto ptr = string.string_ptr();
-                itemValueHex->setData(QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", ptr), Qt::DisplayRole);
+                setCell(itemValueHex, QString::asprintf("0x%016llX", ptr), CellStyle::Link);
                 itemValueHex->setData(ptr, gsRoleRawValue);
 
                 stringValue = quotationMark + string.get_string() + quotationMark;
-                auto displayValue = QString::fromUtf16(stringValue->c_str(), static_cast<int>(stringValue->size())).toHtmlEscaped();
+                auto displayValue = QString::fromUtf16(stringValue->c_str(), static_cast<int>(stringValue->size()));
                 itemField->setBackground(itemValue->data(Qt::DisplayRole).toString() == displayValue ? Qt::transparent : highlightColor);
                 itemValue->setData(displayValue, Qt::DisplayRole);
             }
@@ -1844,11 +2047,11 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 {
                     StdWstring comparisonString{valueComparisonMemoryOffset};
                     comparisonStringValue = quotationMark + comparisonString.get_string() + quotationMark;
-                    auto displayValue = QString::fromUtf16(comparisonStringValue->data(), static_cast<int>(comparisonStringValue->size())).toHtmlEscaped();
+                    auto displayValue = QString::fromUtf16(comparisonStringValue->data(), static_cast<int>(comparisonStringValue->size()));
                     itemComparisonValue->setData(displayValue, Qt::DisplayRole);
 
                     auto ptr = comparisonString.string_ptr();
-                    itemComparisonValueHex->setData(QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", ptr), Qt::DisplayRole);
+                    setCell(itemComparisonValueHex, QString::asprintf("0x%016llX", ptr), CellStyle::Link);
                     itemComparisonValueHex->setData(ptr, gsRoleRawValue);
                 }
                 bool compare = stringValue != comparisonStringValue;
@@ -1896,9 +2099,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::LevelGenRoomsMetaPointer:
         {
             if (valueMemoryOffset == 0)
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             else
-                itemValue->setData("<font color='blue'><u>Show rooms</u></font>", Qt::DisplayRole);
+                setCell(itemValue, "Show rooms", CellStyle::Link);
 
             if (comparisonActive)
             {
@@ -1914,17 +2117,17 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::JournalPagePointer:
         {
             if (valueMemoryOffset == 0)
-                itemValue->setData(itemValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemValue, itemValueHex);
             else
-                itemValue->setData("<font color='blue'><u>Show journal page</u></font>", Qt::DisplayRole);
+                setCell(itemValue, "Show journal page", CellStyle::Link);
 
             // just for completeness, there probably won't be comparison with this
             if (comparisonActive)
             {
                 if (valueComparisonMemoryOffset == 0)
-                    itemComparisonValue->setData(itemComparisonValueHex->data(Qt::DisplayRole), Qt::DisplayRole);
+                    copyCell(itemComparisonValue, itemComparisonValueHex);
                 else
-                    itemComparisonValue->setData("<font color='blue'><u>Show journal page</u></font>", Qt::DisplayRole);
+                    setCell(itemComparisonValue, "Show journal page", CellStyle::Link);
 
                 itemComparisonValue->setBackground(itemComparisonValueHex->background());
             }
@@ -1977,11 +2180,11 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             value = updateField<uintptr_t>(itemField, valueMemoryOffset == 0 ? 0 : valueMemoryOffset + 0x8, itemValue, nullptr, nullptr, true, nullptr, true, !pointerUpdate, highlightColor);
             if (value.has_value())
             {
-                uintptr_t beginPointer = Script::Memory::ReadQword(valueMemoryOffset);
+                uintptr_t beginPointer = Read<uintptr_t>(valueMemoryOffset);
                 if (beginPointer == value.value())
-                    itemValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                    setCell(itemValue, "Show contents (empty)", CellStyle::MutedLink);
                 else
-                    itemValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                    setCell(itemValue, "Show contents", CellStyle::Link);
 
                 // maybe show hex as the begin pointer ?
             }
@@ -1993,11 +2196,11 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 comparisonValue = updateField<uintptr_t>(itemField, addr, itemComparisonValue, nullptr, nullptr, true, nullptr, false, false, highlightColor);
                 if (comparisonValue.has_value())
                 {
-                    uintptr_t beginPointer = Script::Memory::ReadQword(valueComparisonMemoryOffset);
+                    uintptr_t beginPointer = Read<uintptr_t>(valueComparisonMemoryOffset);
                     if (beginPointer == comparisonValue.value())
-                        itemComparisonValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                        setCell(itemComparisonValue, "Show contents (empty)", CellStyle::MutedLink);
                     else
-                        itemComparisonValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                        setCell(itemComparisonValue, "Show contents", CellStyle::Link);
                 }
 
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
@@ -2021,9 +2224,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             if (value.has_value())
             {
                 if (value.value() == 0)
-                    itemValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                    setCell(itemValue, "Show contents (empty)", CellStyle::MutedLink);
                 else
-                    itemValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                    setCell(itemValue, "Show contents", CellStyle::Link);
                 // maybe show hex as the pointer ?
             }
 
@@ -2035,9 +2238,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 if (comparisonValue.has_value())
                 {
                     if (comparisonValue.value() == 0)
-                        itemComparisonValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                        setCell(itemComparisonValue, "Show contents (empty)", CellStyle::MutedLink);
                     else
-                        itemComparisonValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                        setCell(itemComparisonValue, "Show contents", CellStyle::Link);
                 }
                 // maybe it should be based on the pointer not size?
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
@@ -2069,7 +2272,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             {
                 value = {0};
                 value->resize(gsStdUnorderedMapSize);
-                Script::Memory::Read(valueMemoryOffset, value->data(), gsStdUnorderedMapSize, nullptr);
+                ReadMemory(valueMemoryOffset, value->data(), gsStdUnorderedMapSize);
                 auto dataOld = itemValue->data(gsRoleRawValue);
                 auto valueOld = dataOld.value<QByteArray>();
                 if (!dataOld.isValid() || value.value() != valueOld)
@@ -2078,9 +2281,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                     itemValue->setData(QVariant::fromValue(value.value()), gsRoleRawValue);
 
                     if (StdUnorderedMap{valueMemoryOffset, 0, 0}.empty())
-                        itemValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                        setCell(itemValue, "Show contents (empty)", CellStyle::MutedLink);
                     else
-                        itemValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                        setCell(itemValue, "Show contents", CellStyle::Link);
                 }
                 else if (!isPointer)
                     itemField->setBackground(Qt::transparent);
@@ -2101,7 +2304,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 {
                     comparisonValue = {0};
                     comparisonValue->resize(gsStdUnorderedMapSize);
-                    Script::Memory::Read(valueComparisonMemoryOffset, comparisonValue->data(), gsStdUnorderedMapSize, nullptr);
+                    ReadMemory(valueComparisonMemoryOffset, comparisonValue->data(), gsStdUnorderedMapSize);
                     auto dataOld = itemComparisonValue->data(gsRoleRawValue);
                     auto valueOld = dataOld.value<QByteArray>();
                     if (!dataOld.isValid() || comparisonValue.value() != valueOld)
@@ -2109,9 +2312,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                         itemComparisonValue->setData(QVariant::fromValue(comparisonValue.value()), gsRoleRawValue);
 
                         if (StdUnorderedMap{valueComparisonMemoryOffset, 0, 0}.empty())
-                            itemComparisonValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                            setCell(itemComparisonValue, "Show contents (empty)", CellStyle::MutedLink);
                         else
-                            itemComparisonValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                            setCell(itemComparisonValue, "Show contents", CellStyle::Link);
                     }
                 }
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
@@ -2143,7 +2346,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             else
             {
                 value = {0, 0};
-                Script::Memory::Read(valueMemoryOffset, &value.value(), 2 * sizeof(uintptr_t), nullptr);
+                ReadMemory(valueMemoryOffset, &value.value(), 2 * sizeof(uintptr_t));
                 auto dataOld = itemValue->data(gsRoleRawValue);
                 auto valueOld = dataOld.value<QPair<uintptr_t, uintptr_t>>();
                 if (!dataOld.isValid() || value.value() != valueOld)
@@ -2154,9 +2357,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                     bool empty = (fieldType == MemoryFieldType::OldStdList && OldStdList{valueMemoryOffset}.empty()) || (fieldType == MemoryFieldType::StdList && StdList{valueMemoryOffset}.empty());
 
                     if (empty)
-                        itemValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                        setCell(itemValue, "Show contents (empty)", CellStyle::MutedLink);
                     else
-                        itemValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                        setCell(itemValue, "Show contents", CellStyle::Link);
                 }
                 else if (!isPointer)
                     itemField->setBackground(Qt::transparent);
@@ -2176,7 +2379,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 else
                 {
                     comparisonValue = {0, 0};
-                    Script::Memory::Read(valueComparisonMemoryOffset, &comparisonValue.value(), 2 * sizeof(uintptr_t), nullptr);
+                    ReadMemory(valueComparisonMemoryOffset, &comparisonValue.value(), 2 * sizeof(uintptr_t));
                     auto dataOld = itemComparisonValue->data(gsRoleRawValue);
                     auto valueOld = dataOld.value<QPair<uintptr_t, uintptr_t>>();
                     if (!dataOld.isValid() || comparisonValue.value() != valueOld)
@@ -2187,9 +2390,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                                      (fieldType == MemoryFieldType::StdList && StdList{valueComparisonMemoryOffset}.empty());
 
                         if (empty)
-                            itemComparisonValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                            setCell(itemComparisonValue, "Show contents (empty)", CellStyle::MutedLink);
                         else
-                            itemComparisonValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                            setCell(itemComparisonValue, "Show contents", CellStyle::Link);
                     }
                 }
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
@@ -2213,9 +2416,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             if (value.has_value())
             {
                 if (value.value() == 0)
-                    itemValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                    setCell(itemValue, "Show contents (empty)", CellStyle::MutedLink);
                 else
-                    itemValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                    setCell(itemValue, "Show contents", CellStyle::Link);
             }
 
             if (comparisonActive)
@@ -2226,9 +2429,9 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 if (comparisonValue.has_value())
                 {
                     if (comparisonValue.value() == 0)
-                        itemComparisonValue->setData("<font color='#AAA'><u>Show contents (empty)</u></font>", Qt::DisplayRole);
+                        setCell(itemComparisonValue, "Show contents (empty)", CellStyle::MutedLink);
                     else
-                        itemComparisonValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                        setCell(itemComparisonValue, "Show contents", CellStyle::Link);
                 }
                 itemComparisonValue->setBackground(value != comparisonValue ? comparisonDifferenceColor : Qt::transparent);
                 if (isPointer == false)
@@ -2254,12 +2457,12 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
             if (itemField->hasChildren())
             {
                 if (isExpanded(itemField->index()))
-                    itemValue->setData("<font color='darkMagenta'><u>[Collapse]</u></font>", Qt::DisplayRole);
+                    setCell(itemValue, "[Collapse]", CellStyle::CollapseLink);
                 else
-                    itemValue->setData("<font color='#AAA'><u>[Expand]</u></font>", Qt::DisplayRole);
+                    setCell(itemValue, "[Expand]", CellStyle::MutedLink);
 
                 if (comparisonActive)
-                    itemComparisonValue->setData(itemValue->data(Qt::DisplayRole), Qt::DisplayRole);
+                    copyCell(itemComparisonValue, itemValue);
 
                 if (shouldUpdateChildren)
                 {
@@ -2280,7 +2483,7 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
                 if (valueMemoryOffset == 0)
                     itemValue->setData({}, Qt::DisplayRole);
                 else
-                    itemValue->setData("<font color='blue'><u>Show contents</u></font>", Qt::DisplayRole);
+                    setCell(itemValue, "Show contents", CellStyle::Link);
 
                 break;
             }
@@ -2289,12 +2492,12 @@ void S2Plugin::TreeViewMemoryFields::updateRow(int row, std::optional<uintptr_t>
         case MemoryFieldType::DefaultStructType:
         {
             if (isExpanded(itemField->index()))
-                itemValue->setData("<font color='darkMagenta'><u>[Collapse]</u></font>", Qt::DisplayRole);
+                setCell(itemValue, "[Collapse]", CellStyle::CollapseLink);
             else
-                itemValue->setData("<font color='#AAA'><u>[Expand]</u></font>", Qt::DisplayRole);
+                setCell(itemValue, "[Expand]", CellStyle::MutedLink);
 
             if (comparisonActive)
-                itemComparisonValue->setData(itemValue->data(Qt::DisplayRole), Qt::DisplayRole);
+                copyCell(itemComparisonValue, itemValue);
 
             if (shouldUpdateChildren)
             {
@@ -2810,6 +3013,10 @@ void S2Plugin::TreeViewMemoryFields::clear()
     mSavedColumnWidths[gsColType] = columnWidth(gsColType);
     mSavedColumnWidths[gsColComment] = columnWidth(gsColComment);
     mModel->clear();
+    mModel->clearPendingChildren();
+    mRootDeltaBegin = SIZE_MAX;
+    mRootDeltaEnd = 0;
+    resetSnapshots();
 }
 
 void S2Plugin::TreeViewMemoryFields::dragEnterEvent(QDragEnterEvent* event)
@@ -3083,7 +3290,7 @@ void S2Plugin::TreeViewMemoryFields::startDrag(Qt::DropActions)
                     return;
 
                 auto typeName = indexType.data(Qt::DisplayRole).toString();
-                auto colon = typeName.indexOf(':'); // to get rid of the "<b>P</b>: "
+                auto colon = typeName.indexOf(':'); // to get rid of the "P: "
                 if (colon == -1)
                     mimeData->setProperty(gsDragDropMemoryField_RefName, typeName);
                 else
@@ -3209,6 +3416,8 @@ static void labelChildren(QStandardItem* parent, std::string_view prefix)
 
 void S2Plugin::TreeViewMemoryFields::labelAll(std::string_view prefix)
 {
+    // labels are set for every field, not just the expanded ones
+    fetchAllChildren();
     auto parent = mModel->invisibleRootItem();
     labelChildren(parent, prefix);
 }
@@ -3363,3 +3572,44 @@ void S2Plugin::TreeViewMemoryFields::mouseMoveEvent(QMouseEvent* event)
 
     QTreeView::mouseMoveEvent(event);
 }
+
+void S2Plugin::TreeViewMemoryFields::keyPressEvent(QKeyEvent* event)
+{
+    // debug overlay with the cost of the last refresh
+    if (event->key() == Qt::Key_D && event->modifiers() == (Qt::ControlModifier | Qt::ShiftModifier))
+    {
+        setShowRefreshStatistics(!mShowRefreshStatistics);
+        event->setAccepted(true);
+        return;
+    }
+    QTreeView::keyPressEvent(event);
+}
+
+void S2Plugin::TreeViewMemoryFields::setShowRefreshStatistics(bool b)
+{
+    mShowRefreshStatistics = b;
+    viewport()->update();
+}
+
+void S2Plugin::TreeViewMemoryFields::paintEvent(QPaintEvent* event)
+{
+    QTreeView::paintEvent(event);
+
+    if (mShowRefreshStatistics)
+    {
+        QPainter painter(viewport());
+        auto& stats = mRefreshStatistics;
+        auto caption = QString("rows touched: %1, skipped: %2, out of view: %3\nchanged: %4 / %5 bytes\nrefresh: %6 ms")
+                           .arg(stats.rowsTouched)
+                           .arg(stats.rowsSkipped)
+                           .arg(stats.rowsCulled)
+                           .arg(stats.changedBytes)
+                           .arg(stats.snapshotSize)
+                           .arg(stats.milliseconds, 0, 'f', 2);
+        auto rect = painter.fontMetrics().boundingRect(QRect(0, 0, viewport()->width(), viewport()->height()), Qt::AlignRight | Qt::AlignBottom, caption).adjusted(-4, -4, 4, 4);
+        rect.moveBottomRight(QPoint(viewport()->width() - 4, viewport()->height() - 4));
+        painter.fillRect(rect, QColor(255, 255, 224, 220));
+        painter.setPen(Qt::darkGray);
+        painter.drawText(rect, Qt::AlignCenter, caption);
+    }
+}
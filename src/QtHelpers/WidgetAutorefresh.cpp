@@ -1,5 +1,6 @@
 #include "QtHelpers/WidgetAutorefresh.h"
 
+#include "ReadCache.h"
 #include <QCheckBox>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -13,10 +14,10 @@ S2Plugin::WidgetAutorefresh::WidgetAutorefresh(int initialInterval, QWidget* par
     refreshLayout->setMargin(0);
     mRefreshButton = new QPushButton("Refresh", this);
     refreshLayout->addWidget(mRefreshButton);
-    QObject::connect(mRefreshButton, &QPushButton::clicked, this, &WidgetAutorefresh::refresh);
+    QObject::connect(mRefreshButton, &QPushButton::clicked, this, &WidgetAutorefresh::refreshTick);
 
     mAutoRefreshTimer = new QTimer(this);
-    QObject::connect(mAutoRefreshTimer, &QTimer::timeout, this, &WidgetAutorefresh::refresh);
+    QObject::connect(mAutoRefreshTimer, &QTimer::timeout, this, &WidgetAutorefresh::refreshTick);
 
     mAutoRefreshCheckBox = new QCheckBox("Auto-refresh every", this);
     mAutoRefreshCheckBox->setCheckState(Qt::Checked);
@@ -56,3 +57,10 @@ void S2Plugin::WidgetAutorefresh::autoRefreshIntervalChanged(int val)
         mAutoRefreshTimer->setInterval(val);
     }
 }
+
+void S2Plugin::WidgetAutorefresh::refreshTick()
+{
+    // all the reads done during one refresh share the same cache
+    ReadCache::Scope readCacheScope;
+    emit refresh();
+}
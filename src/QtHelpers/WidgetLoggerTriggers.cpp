@@ -0,0 +1,139 @@
+#include "QtHelpers/WidgetLoggerTriggers.h"
+
+#include "Data/Logger.h"
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include <algorithm>
+
+static const int gsTriggerColField = 0;
+static const int gsTriggerColCondition = 1;
+static const int gsTriggerColValue = 2;
+// in the order of LoggerTrigger::Condition
+static const char* gsConditionNames[] = {"Value changed", "Rises above", "Falls below", "Bit set", "Bit cleared"};
+
+S2Plugin::WidgetLoggerTriggers::WidgetLoggerTriggers(Logger* logger, QWidget* parent) : QWidget(parent), mLogger(logger)
+{
+    auto mainLayout = new QVBoxLayout(this);
+    mainLayout->setMargin(5);
+
+    auto topLayout = new QHBoxLayout();
+    auto addButton = new QPushButton("Add trigger", this);
+    topLayout->addWidget(addButton);
+    QObject::connect(addButton, &QPushButton::clicked, this, &WidgetLoggerTriggers::addTrigger);
+    auto removeButton = new QPushButton("Remove trigger", this);
+    topLayout->addWidget(removeButton);
+    QObject::connect(removeButton, &QPushButton::clicked, this, &WidgetLoggerTriggers::removeTrigger);
+    topLayout->addStretch();
+
+    topLayout->addWidget(new QLabel("Keep", this));
+    mPreTriggerSpinBox = new QSpinBox(this);
+    mPreTriggerSpinBox->setRange(0, 1000000);
+    mPreTriggerSpinBox->setValue(100);
+    topLayout->addWidget(mPreTriggerSpinBox);
+    topLayout->addWidget(new QLabel("samples before and", this));
+    mPostTriggerSpinBox = new QSpinBox(this);
+    mPostTriggerSpinBox->setRange(0, 1000000);
+    mPostTriggerSpinBox->setValue(100);
+    topLayout->addWidget(mPostTriggerSpinBox);
+    topLayout->addWidget(new QLabel("after every trigger", this));
+    QObject::connect(mPreTriggerSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &WidgetLoggerTriggers::apply);
+    QObject::connect(mPostTriggerSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &WidgetLoggerTriggers::apply);
+    mainLayout->addLayout(topLayout);
+
+    mTable = new QTableWidget(0, 3, this);
+    mTable->setHorizontalHeaderLabels({"Field", "Condition", "Threshold / bit"});
+    mTable->verticalHeader()->hide();
+    mTable->horizontalHeader()->setStretchLastSection(true);
+    mTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    mTable->setColumnWidth(gsTriggerColField, 250);
+    mTable->setColumnWidth(gsTriggerColCondition, 150);
+    mainLayout->addWidget(mTable);
+
+    mainLayout->addWidget(new QLabel("Without triggers everything is kept. With triggers only the samples around them are kept, so the Logger can stay armed for a long time.", this));
+    apply();
+}
+
+void S2Plugin::WidgetLoggerTriggers::fieldsChanged()
+{
+    mTable->setRowCount(0);
+    for (const auto& trigger : mLogger->triggers().triggers)
+        addRow(trigger);
+}
+
+void S2Plugin::WidgetLoggerTriggers::addTrigger()
+{
+    if (mLogger->fieldCount() == 0)
+        return;
+
+    addRow(LoggerTrigger{});
+    apply();
+}
+
+void S2Plugin::WidgetLoggerTriggers::removeTrigger()
+{
+    auto row = mTable->currentRow();
+    if (row < 0)
+        return;
+
+    mTable->removeRow(row);
+    apply();
+}
+
+void S2Plugin::WidgetLoggerTriggers::apply()
+{
+    LoggerTriggerSettings settings;
+    settings.preTrigger = static_cast<size_t>(mPreTriggerSpinBox->value());
+    settings.postTrigger = static_cast<size_t>(mPostTriggerSpinBox->value());
+    for (int row = 0; row < mTable->rowCount(); ++row)
+    {
+        auto fieldComboBox = qobject_cast<QComboBox*>(mTable->cellWidget(row, gsTriggerColField));
+        auto conditionComboBox = qobject_cast<QComboBox*>(mTable->cellWidget(row, gsTriggerColCondition));
+        auto valueLineEdit = qobject_cast<QLineEdit*>(mTable->cellWidget(row, gsTriggerColValue));
+        if (fieldComboBox == nullptr || conditionComboBox == nullptr || valueLineEdit == nullptr || fieldComboBox->currentIndex() < 0)
+            continue;
+
+        LoggerTrigger trigger;
+        trigger.fieldIndex = static_cast<size_t>(fieldComboBox->currentIndex());
+        trigger.condition = static_cast<LoggerTrigger::Condition>(conditionComboBox->currentIndex());
+        if (trigger.condition == LoggerTrigger::Condition::BitSet || trigger.condition == LoggerTrigger::Condition::BitCleared)
+            trigger.bit = static_cast<uint8_t>(std::min(valueLineEdit->text().toUInt(), 63u));
+        else
+            trigger.threshold = valueLineEdit->text().toDouble();
+        settings.triggers.push_back(trigger);
+    }
+    mLogger->setTriggers(settings);
+}
+
+void S2Plugin::WidgetLoggerTriggers::addRow(const LoggerTrigger& trigger)
+{
+    int row = mTable->rowCount();
+    mTable->insertRow(row);
+
+    auto fieldComboBox = new QComboBox(mTable);
+    for (size_t i = 0; i < mLogger->fieldCount(); ++i)
+        fieldComboBox->addItem(QString::fromStdString(mLogger->fieldAt(i).name));
+    fieldComboBox->setCurrentIndex(static_cast<int>(trigger.fieldIndex));
+
+    auto conditionComboBox = new QComboBox(mTable);
+    for (auto name : gsConditionNames)
+        conditionComboBox->addItem(name);
+    conditionComboBox->setCurrentIndex(static_cast<int>(trigger.condition));
+
+    bool bitCondition = trigger.condition == LoggerTrigger::Condition::BitSet || trigger.condition == LoggerTrigger::Condition::BitCleared;
+    auto valueLineEdit = new QLineEdit(bitCondition ? QString::number(trigger.bit) : QString::number(trigger.threshold), mTable);
+
+    mTable->setCellWidget(row, gsTriggerColField, fieldComboBox);
+    mTable->setCellWidget(row, gsTriggerColCondition, conditionComboBox);
+    mTable->setCellWidget(row, gsTriggerColValue, valueLineEdit);
+    QObject::connect(fieldComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &WidgetLoggerTriggers::apply);
+    QObject::connect(conditionComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &WidgetLoggerTriggers::apply);
+    QObject::connect(valueLineEdit, &QLineEdit::editingFinished, this, &WidgetLoggerTriggers::apply);
+}
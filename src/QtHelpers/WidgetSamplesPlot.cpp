@@ -1,15 +1,34 @@
 #include "QtHelpers/WidgetSamplesPlot.h"
-#include "Configuration.h"
 #include "Data/Logger.h"
 #include <QFont>
 #include <QFontMetrics>
 #include <QPainter>
+#include <QPen>
 #include <QScrollArea>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
 
 static const uint8_t gsPlotMargin = 5;
+// long captures get more than one sample per pixel, the widget would be millions of pixels wide otherwise
+static const size_t gsMaxPlotWidth = 8192;
 
-void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent*)
+namespace
 {
+    // no sample was left out between the samples [first, last)
+    bool isContiguous(const std::vector<uint64_t>& sampleIndexes, size_t first, size_t last)
+    {
+        // sample indexes are strictly increasing, so any left out sample makes the span longer
+        return last - first < 2 || sampleIndexes[last - 1] - sampleIndexes[first] == last - 1 - first;
+    }
+} // namespace
+
+void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent* event)
+{
+    // pick up whatever the sampler thread collected since the last drain
+    mLogger->drain();
     auto painter = QPainter(this);
 
     painter.save();
@@ -17,98 +36,109 @@ void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent*)
     painter.fillRect(rect(), Qt::black);
     painter.setPen(Qt::darkGray);
     auto paintBounds = rect().adjusted(0, 0, -1, -1);
-    float drawHeight = paintBounds.height() - (2 * gsPlotMargin);
+    double drawHeight = paintBounds.height() - (2 * gsPlotMargin);
     painter.drawRect(paintBounds);
     painter.translate(gsPlotMargin, gsPlotMargin);
 
-    for (size_t i = 0; i < mLogger->fieldCount(); ++i)
+    // nothing sampled yet, or the fields changed since the last logging
+    size_t samplesPerPixel = this->samplesPerPixel();
+    size_t columnCount = (mLogger->sampleCount() + samplesPerPixel - 1) / samplesPerPixel;
+    auto toColumns = [columnCount](const QRect& rect) -> std::pair<size_t, size_t>
+    {
+        // one column further on both sides to connect the lines
+        int left = rect.left() - gsPlotMargin - 1;
+        int right = rect.right() - gsPlotMargin + 1;
+        return {left > 0 ? static_cast<size_t>(left) : 0, right >= 0 ? std::min(static_cast<size_t>(right) + 1, columnCount) : 0};
+    };
+    // only the exposed part is painted
+    auto [firstColumn, lastColumn] = toColumns(event->rect());
+
+    // a capture is only read for the visible part (and the mouse), its y axis is scaled to those samples
+    auto visibleRect = visibleRegion().boundingRect();
+    auto [firstVisibleColumn, lastVisibleColumn] = toColumns(visibleRect.united(event->rect()));
+    size_t firstSample = samplesInColumn(firstVisibleColumn, samplesPerPixel).first;
+    size_t lastSample = lastVisibleColumn > firstVisibleColumn ? samplesInColumn(lastVisibleColumn - 1, samplesPerPixel).second : firstSample;
+    // the sample before tells if there is a gap
+    auto samples = mLogger->samples(Logger::SampleWindow::Plot, firstSample > 0 ? firstSample - 1 : 0, lastSample);
+    const auto& sampleIndexes = samples.sampleIndexes;
+    size_t fieldCount = samples.columns.size() == mLogger->fieldCount() ? samples.columns.size() : 0;
+    // loaded samples [first, last) under the column, relative to the loaded ones
+    auto loadedInColumn = [&, samplesPerPixel = samplesPerPixel](size_t column) -> std::pair<size_t, size_t>
+    {
+        auto [first, last] = samplesInColumn(column, samplesPerPixel);
+        size_t loadedEnd = samples.first + sampleIndexes.size();
+        first = std::clamp(first, samples.first, loadedEnd) - samples.first;
+        last = std::clamp(last, samples.first, loadedEnd) - samples.first;
+        return {first, last};
+    };
+    // a different part of the capture is scaled differently, the parts painted before have to be painted again
+    if (samples.first != mPlottedFirst || sampleIndexes.size() != mPlottedCount)
+    {
+        mPlottedFirst = samples.first;
+        mPlottedCount = sampleIndexes.size();
+        if (!event->rect().contains(visibleRect))
+            update();
+    }
+
+    // gap markers where the triggers left samples out, behind the lines
+    if (fieldCount != 0)
+    {
+        QVector<QLineF> gaps;
+        for (size_t column = firstColumn; column < lastColumn; ++column)
+        {
+            auto [first, last] = loadedInColumn(column);
+            if (first != last && ((first != 0 && sampleIndexes[first] != sampleIndexes[first - 1] + 1) || !isContiguous(sampleIndexes, first, last)))
+                gaps.append(QLineF(static_cast<double>(column), 0.0, static_cast<double>(column), drawHeight));
+        }
+        painter.setPen(QPen(Qt::darkGray, 0, Qt::DotLine));
+        painter.drawLines(gaps);
+    }
+
+    QVector<QLineF> lines;
+    for (size_t i = 0; i < fieldCount; ++i)
     {
         const auto& field = mLogger->fieldAt(i);
         painter.setPen(field.color);
 
-        auto [lowerBound, upperBound] = mLogger->sampleBounds(field);
-        const auto& samples = mLogger->samplesForField(field.uuid);
-        int x = 0;
-        uint16_t mappedY = 0;
-        int prevX = 0, prevY = 0;
-        bool first = true;
-        for (const auto& sample : samples)
+        const auto& column = samples.columns[i];
+        auto [lowerBound, upperBound] = column.bounds();
+        double scale = upperBound > lowerBound ? drawHeight / static_cast<double>(upperBound - lowerBound) : 0.0;
+        auto mapY = [&, lowerBound = lowerBound](double value) { return drawHeight - (value - static_cast<double>(lowerBound)) * scale; };
+
+        lines.clear();
+        QPointF previous;
+        bool hasPrevious = false;
+        for (size_t plotColumn = firstColumn; plotColumn < lastColumn; ++plotColumn)
         {
-            switch (field.type)
+            auto [first, last] = loadedInColumn(plotColumn);
+            if (first == last)
             {
-                case MemoryFieldType::Byte:
-                {
-                    mappedY = ((std::any_cast<int8_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::UnsignedByte:
-                case MemoryFieldType::Bool:
-                case MemoryFieldType::Flags8:
-                case MemoryFieldType::State8:
-                case MemoryFieldType::CharacterDBID:
-                {
-                    mappedY = ((std::any_cast<uint8_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::Word:
-                {
-                    mappedY = ((std::any_cast<int16_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::UnsignedWord:
-                case MemoryFieldType::Flags16:
-                case MemoryFieldType::State16:
-                {
-                    mappedY = ((std::any_cast<uint16_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::Dword:
-                case MemoryFieldType::TextureDBID:
-                case MemoryFieldType::EntityUID:
-                case MemoryFieldType::State32:
-                {
-                    mappedY = ((std::any_cast<int32_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::UnsignedDword:
-                case MemoryFieldType::Flags32:
-                case MemoryFieldType::EntityDBID:
-                case MemoryFieldType::ParticleDBID:
-                case MemoryFieldType::StringsTableID:
-                {
-                    mappedY = ((std::any_cast<uint32_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::Float:
-                {
-                    mappedY = ((std::any_cast<float>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::Double:
-                {
-                    mappedY = ((std::any_cast<double>(sample) - lowerBound) / (double)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::Qword:
-                {
-                    mappedY = ((std::any_cast<int64_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::UnsignedQword:
-                {
-                    mappedY = ((std::any_cast<uint64_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
+                hasPrevious = false;
+                continue;
             }
-            if (!first)
+            double firstValue = column.valueAt(first);
+            double lastValue = column.valueAt(last - 1);
+            if (!std::isfinite(firstValue) || !std::isfinite(lastValue))
             {
-                painter.drawLine(prevX, prevY, x, drawHeight - mappedY);
+                hasPrevious = false;
+                continue;
             }
-            first = false;
-            prevX = x;
-            prevY = drawHeight - mappedY;
-            x++;
+            auto x = static_cast<double>(plotColumn);
+            // no line across the samples left out by the triggers
+            if (hasPrevious && first != 0 && sampleIndexes[first] == sampleIndexes[first - 1] + 1)
+                lines.append(QLineF(previous, QPointF(x, mapY(firstValue))));
+
+            // all the samples under this pixel as one vertical line
+            if (samplesPerPixel > 1)
+            {
+                auto [low, high] = column.minMax(first, last);
+                if (low < high)
+                    lines.append(QLineF(x, mapY(low), x, mapY(high)));
+            }
+            previous = QPointF(x, mapY(lastValue));
+            hasPrevious = true;
         }
+        painter.drawLines(lines);
     }
     painter.restore();
 
@@ -121,9 +151,11 @@ void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent*)
 
         painter.setPen(Qt::cyan);
         painter.drawLine(mCurrentMousePos.x(), 0, mCurrentMousePos.x(), paintBounds.height());
-        auto sampleIndex = mCurrentMousePos.x() - gsPlotMargin;
-        if (sampleIndex >= 0 && static_cast<size_t>(sampleIndex) < mLogger->sampleCount())
+        auto column = mCurrentMousePos.x() - gsPlotMargin;
+        auto [sample, lastSample] = column >= 0 && fieldCount != 0 ? loadedInColumn(static_cast<size_t>(column)) : std::pair<size_t, size_t>{0, 0};
+        if (sample != lastSample)
         {
+            auto sampleIndex = static_cast<qulonglong>(sampleIndexes[sample]);
             auto scrollArea = qobject_cast<QScrollArea*>(parent()->parent());
             auto drawOnLeftSide = (scrollArea->mapFromGlobal(QCursor::pos()).x() > (scrollArea->width() / 2));
 
@@ -139,78 +171,11 @@ void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent*)
             }
 
             uint16_t y = 15;
-            for (size_t i = 0; i < mLogger->fieldCount(); ++i)
+            for (size_t i = 0; i < fieldCount; ++i)
             {
                 const auto& field = mLogger->fieldAt(i);
-                const auto& samples = mLogger->samplesForField(field.uuid);
-                const auto& sample = samples.at(static_cast<size_t>(sampleIndex));
-                QString caption;
-                switch (field.type)
-                {
-                    case MemoryFieldType::Byte:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<int8_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedByte:
-                    case MemoryFieldType::Bool:
-                    case MemoryFieldType::Flags8:
-                    case MemoryFieldType::State8:
-                    case MemoryFieldType::CharacterDBID:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<uint8_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::Word:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<int16_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedWord:
-                    case MemoryFieldType::Flags16:
-                    case MemoryFieldType::State16:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<uint16_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::Dword:
-                    case MemoryFieldType::TextureDBID:
-                    case MemoryFieldType::EntityUID:
-                    case MemoryFieldType::State32:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<int32_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedDword:
-                    case MemoryFieldType::Flags32:
-                    case MemoryFieldType::EntityDBID:
-                    case MemoryFieldType::ParticleDBID:
-                    case MemoryFieldType::StringsTableID:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<uint32_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::Float:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<float>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::Double:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<double>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::Qword:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<int64_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedQword:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<uint64_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                }
+                auto value = samples.columns[i].visitAt(sample, [](auto sampleValue) { return QString::number(sampleValue); });
+                QString caption = QString("%1 (%2)").arg(value).arg(QString::fromStdString(field.name));
                 painter.setPen(field.color);
                 if (drawOnLeftSide)
                 {
@@ -230,5 +195,18 @@ void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent*)
 
 QSize S2Plugin::WidgetSamplesPlot::minimumSizeHint() const
 {
-    return QSize(static_cast<int>(mLogger->sampleCount() + (gsPlotMargin * 2) + 100), 50);
+    size_t samplesPerPixel = this->samplesPerPixel();
+    size_t columnCount = (mLogger->sampleCount() + samplesPerPixel - 1) / samplesPerPixel;
+    return QSize(static_cast<int>(columnCount + (gsPlotMargin * 2) + 100), 50);
+}
+
+size_t S2Plugin::WidgetSamplesPlot::samplesPerPixel() const
+{
+    return std::max<size_t>(1, (mLogger->sampleCount() + gsMaxPlotWidth - 1) / gsMaxPlotWidth);
+}
+
+std::pair<size_t, size_t> S2Plugin::WidgetSamplesPlot::samplesInColumn(size_t column, size_t samplesPerPixel) const
+{
+    size_t count = mLogger->sampleCount();
+    return {std::min(column * samplesPerPixel, count), std::min((column + 1) * samplesPerPixel, count)};
 }
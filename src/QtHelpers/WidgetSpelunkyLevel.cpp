@@ -2,9 +2,12 @@
 
 #include "Configuration.h"
 #include "Data/EntityList.h"
-#include "Data/StdMap.h"
+#include "Data/EntitySnapshot.h"
+#include "Data/StdMapSnapshot.h"
+#include "ReadCache.h"
 #include "Spelunky2.h"
 #include "pluginmain.h"
+#include "read_helpers.h"
 #include <QPainter>
 
 S2Plugin::WidgetSpelunkyLevel::WidgetSpelunkyLevel(uintptr_t main_entity, QWidget* parent) : QWidget(parent), mMainEntityAddr(main_entity)
@@ -147,41 +150,51 @@ QSize S2Plugin::WidgetSpelunkyLevel::sizeHint() const
 
 void S2Plugin::WidgetSpelunkyLevel::updateLevel()
 {
+    ReadCache::Scope readCacheScope;
     uint8_t layerToDraw = Entity{mMainEntityAddr}.layer();
     if (mPaintFloors)
     {
         auto gridAddr = layerToDraw == 0 ? mGridEntitiesAddr.first : mGridEntitiesAddr.second;
         // Maybe don't read the whole array?
         constexpr auto dataSize = static_cast<size_t>(msLevelMaxHeight + 1u) * ((msLevelMaxWidth + 1u) * sizeof(uintptr_t));
-        Script::Memory::Read(gridAddr, &mLevelFloors, dataSize, nullptr);
+        ReadMemory(gridAddr, &mLevelFloors, dataSize);
     }
 
+    // all the entities are read in one go, the painted ones first, then all the mask lists
+    EntitySnapshot snapshot;
     for (auto& entity : mEntitiesToPaint)
-        entity.pos = entity.ent.abs_position();
+        snapshot.addEntity(entity.ent.ptr());
 
+    std::array<std::pair<size_t, size_t>, std::tuple_size_v<decltype(mEntitiesMaskCoordinates)>> maskRanges{};
     if (mEntityMasksToPaint != 0)
     {
-        StdMap<uint32_t, size_t> maskMap{layerToDraw == 0 ? mMaskMapAddr.first : mMaskMapAddr.second};
-        for (auto [key, valuePtr] : maskMap)
+        StdMapSnapshot maskMap{sizeof(uint32_t), alignof(uint32_t), 0, alignof(size_t)};
+        maskMap.read(layerToDraw == 0 ? mMaskMapAddr.first : mMaskMapAddr.second);
+        for (size_t index = 0; index < maskMap.size(); ++index)
         {
+            auto key = maskMap.key<uint32_t>(index);
+            auto valuePtr = maskMap.valuePtr(index);
             uint8_t bit_number = std::log2(key);
             mEntitiesMaskCoordinates[bit_number].clear();
             if ((mEntityMasksToPaint & key) != 0)
             {
-                EntityList entityList{valuePtr};
-                mEntitiesMaskCoordinates[bit_number].reserve(entityList.size());
-                std::vector<uintptr_t> entities = entityList.getAllEntities();
-
-                for (auto entityAddr : entities)
-                {
-                    if (entityAddr == 0)
-                        continue;
-
-                    Entity ent{entityAddr};
-                    mEntitiesMaskCoordinates[bit_number].emplace_back(ent.abs_position());
-                }
+                maskRanges[bit_number].first = snapshot.size();
+                snapshot.addList(EntityList{valuePtr});
+                maskRanges[bit_number].second = snapshot.size();
             }
         }
     }
+    snapshot.read();
+
+    for (size_t i = 0; i < mEntitiesToPaint.size(); ++i)
+        mEntitiesToPaint[i].pos = snapshot.abs_position(i);
+
+    for (size_t bit_number = 0; bit_number < maskRanges.size(); ++bit_number)
+    {
+        auto [begin, end] = maskRanges[bit_number];
+        mEntitiesMaskCoordinates[bit_number].reserve(end - begin);
+        for (size_t i = begin; i < end; ++i)
+            mEntitiesMaskCoordinates[bit_number].emplace_back(snapshot.abs_position(i));
+    }
     update();
 }
@@ -72,13 +72,13 @@ void S2Plugin::WidgetSpelunkyRooms::paintEvent(QPaintEvent*)
             }
             else
             {
-                RoomCode currentRoomCode{0, "", QColor{}};
+                RoomCode currentRoomCode{0, "", 0};
                 if (counter % 2 == 0)
                 {
                     currentRoomCode = config->roomCodeForID(buffer.at(counter));
                     painter.setPen(Qt::transparent);
                     auto rect = QRect(x, y - mTextAdvance.height() + 5, 2 * mTextAdvance.width() + mSpaceAdvance, mTextAdvance.height() - 2);
-                    painter.setBrush(currentRoomCode.color);
+                    painter.setBrush(QColor::fromRgba(currentRoomCode.color));
                     painter.drawRoundedRect(rect, 4.0, 4.0);
                     mToolTipRects.emplace_back(ToolTipRect{rect, QString::fromStdString(currentRoomCode.name)});
                 }
@@ -98,6 +98,11 @@ struct S2Plugin::QtPluginStruct
     };
 };
 
+void QtPlugin::Attach()
+{
+    S2Plugin::Spelunky2::resolveInBackground();
+}
+
 void QtPlugin::Detach()
 {
     S2Plugin::QtPluginStruct::resetSpelunky2Data();
@@ -0,0 +1,189 @@
+#include "ReadCache.h"
+
+#include "MemorySource/MemorySource.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct Page
+    {
+        std::array<uint8_t, S2Plugin::ReadCache::pageSize> data;
+        bool valid{false};
+    };
+
+    struct CacheState
+    {
+        uint32_t scopeDepth{0};
+        uint32_t generation{0};
+        // incremented every time the cached data is dropped
+        uint64_t serial{1};
+        std::unordered_map<uintptr_t, Page*> pages;
+        // pages are reused between the refresh ticks to avoid allocations
+        std::vector<std::unique_ptr<Page>> pool;
+        size_t poolUsed{0};
+        // most of the reads are for the same page as the previous one
+        uintptr_t lastPageAddr{~0ull};
+        Page* lastPage{nullptr};
+        uint64_t hits{0};
+        uint64_t misses{0};
+
+        void clear()
+        {
+            ++serial;
+            pages.clear();
+            poolUsed = 0;
+            lastPageAddr = ~0ull;
+            lastPage = nullptr;
+        }
+        Page* newPage()
+        {
+            if (poolUsed == pool.size())
+                pool.emplace_back(std::make_unique<Page>());
+
+            return pool[poolUsed++].get();
+        }
+    };
+
+    thread_local CacheState gsCacheState;
+    std::atomic<uint32_t> gsGlobalGeneration{0};
+
+    void syncGeneration(CacheState& state)
+    {
+        if (auto generation = gsGlobalGeneration.load(std::memory_order_relaxed); generation != state.generation)
+        {
+            state.clear();
+            state.generation = generation;
+        }
+    }
+
+    const Page& getPage(CacheState& state, uintptr_t pageAddr)
+    {
+        syncGeneration(state);
+        if (pageAddr == state.lastPageAddr)
+        {
+            ++state.hits;
+            return *state.lastPage;
+        }
+        Page* page;
+        if (auto it = state.pages.find(pageAddr); it != state.pages.end())
+        {
+            ++state.hits;
+            page = it->second;
+        }
+        else
+        {
+            ++state.misses;
+            page = state.newPage();
+            page->valid = S2Plugin::MemorySource::get().read(pageAddr, page->data.data(), S2Plugin::ReadCache::pageSize);
+            state.pages.emplace(pageAddr, page);
+        }
+        state.lastPageAddr = pageAddr;
+        state.lastPage = page;
+        return *page;
+    }
+} // namespace
+
+S2Plugin::ReadCache::Scope::Scope()
+{
+    if (gsCacheState.scopeDepth++ == 0)
+        gsCacheState.clear();
+}
+
+S2Plugin::ReadCache::Scope::~Scope()
+{
+    if (--gsCacheState.scopeDepth == 0)
+        gsCacheState.clear();
+}
+
+bool S2Plugin::ReadCache::isActive() noexcept
+{
+    return gsCacheState.scopeDepth != 0;
+}
+
+bool S2Plugin::ReadCache::read(uintptr_t addr, void* dest, size_t size)
+{
+    if (size > pageSize)
+        return MemorySource::get().read(addr, dest, size);
+
+    auto& state = gsCacheState;
+    auto out = static_cast<uint8_t*>(dest);
+    bool success = true;
+    while (size != 0)
+    {
+        uintptr_t pageAddr = addr & ~(pageSize - 1);
+        size_t offset = addr - pageAddr;
+        size_t chunk = std::min(size, pageSize - offset);
+
+        const Page& page = getPage(state, pageAddr);
+        if (page.valid)
+            std::memcpy(out, page.data.data() + offset, chunk);
+        // page not fully readable (memory sources can have regions smaller than a page), read just the requested part
+        else if (!MemorySource::get().read(addr, out, chunk))
+            success = false;
+
+        out += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+    return success;
+}
+
+void S2Plugin::ReadCache::prime(uintptr_t addr, const void* data, size_t size)
+{
+    auto& state = gsCacheState;
+    if (state.scopeDepth == 0)
+        return;
+
+    syncGeneration(state);
+    auto src = static_cast<const uint8_t*>(data);
+    uintptr_t end = addr + size;
+    for (uintptr_t pageAddr = (addr + pageSize - 1) & ~(pageSize - 1); pageAddr + pageSize <= end; pageAddr += pageSize)
+    {
+        // already cached page is from the same tick
+        if (state.pages.find(pageAddr) != state.pages.end())
+            continue;
+
+        Page* page = state.newPage();
+        std::memcpy(page->data.data(), src + (pageAddr - addr), pageSize);
+        page->valid = true;
+        state.pages.emplace(pageAddr, page);
+    }
+}
+
+void S2Plugin::ReadCache::invalidate()
+{
+    gsCacheState.clear();
+}
+
+void S2Plugin::ReadCache::invalidateAll() noexcept
+{
+    gsGlobalGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t S2Plugin::ReadCache::serial() noexcept
+{
+    syncGeneration(gsCacheState);
+    return gsCacheState.serial;
+}
+
+uint64_t S2Plugin::ReadCache::hits() noexcept
+{
+    return gsCacheState.hits;
+}
+
+uint64_t S2Plugin::ReadCache::misses() noexcept
+{
+    return gsCacheState.misses;
+}
+
+void S2Plugin::ReadCache::resetCounters() noexcept
+{
+    gsCacheState.hits = 0;
+    gsCacheState.misses = 0;
+}
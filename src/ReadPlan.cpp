@@ -0,0 +1,77 @@
+#include "ReadPlan.h"
+
+#include <algorithm>
+#include <numeric>
+
+size_t S2Plugin::ReadPlan::add(uintptr_t addr, size_t size)
+{
+    mBlocks.push_back(Block{addr, size, 0});
+    return mBlocks.size() - 1;
+}
+
+void S2Plugin::ReadPlan::build(size_t maxGap, size_t maxRangeSize)
+{
+    mRequests.clear();
+    std::vector<size_t> order(mBlocks.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    auto byAddress = [this](size_t a, size_t b) { return mBlocks[a].addr < mBlocks[b].addr; };
+    // the blocks are often added already sorted
+    if (!std::is_sorted(order.begin(), order.end(), byAddress))
+        std::sort(order.begin(), order.end(), byAddress);
+
+    // the dest pointers are only known once the buffer is allocated, keep the buffer offsets for now
+    std::vector<size_t> rangeOffsets;
+    size_t bufferSize = 0;
+    for (auto index : order)
+    {
+        auto& block = mBlocks[index];
+        if (!mRequests.empty())
+        {
+            auto& last = mRequests.back();
+            uintptr_t lastEnd = last.addr + last.size;
+            // duplicates and overlapping blocks are read only once
+            if (block.addr < lastEnd || (block.addr - lastEnd <= maxGap && block.addr + block.size - last.addr <= maxRangeSize))
+            {
+                if (block.addr + block.size > lastEnd)
+                {
+                    size_t grow = block.addr + block.size - lastEnd;
+                    last.size += grow;
+                    bufferSize += grow;
+                }
+                block.bufferOffset = rangeOffsets.back() + (block.addr - last.addr);
+                continue;
+            }
+        }
+        mRequests.push_back(MemoryReadRequest{block.addr, nullptr, block.size});
+        rangeOffsets.push_back(bufferSize);
+        block.bufferOffset = bufferSize;
+        bufferSize += block.size;
+    }
+
+    // no need to zero the buffer, every byte is overwritten by the read
+    mBuffer.reset(new uint8_t[bufferSize]);
+    mBufferSize = bufferSize;
+    for (size_t i = 0; i < mRequests.size(); ++i)
+        mRequests[i].dest = mBuffer.get() + rangeOffsets[i];
+}
+
+bool S2Plugin::ReadPlan::execute()
+{
+    auto& memory = MemorySource::get();
+    if (memory.readBulk(mRequests.data(), mRequests.size()) == mRequests.size())
+        return true;
+
+    // some range crossed unreadable memory, it's not known which one, so fall back to reading every block alone
+    bool success = true;
+    for (auto& block : mBlocks)
+        success &= memory.read(block.addr, mBuffer.get() + block.bufferOffset, block.size);
+    return success;
+}
+
+void S2Plugin::ReadPlan::clear()
+{
+    mBlocks.clear();
+    mRequests.clear();
+    mBuffer.reset();
+    mBufferSize = 0;
+}
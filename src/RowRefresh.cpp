@@ -0,0 +1,45 @@
+#include "RowRefresh.h"
+
+bool S2Plugin::isSnapshotComparable(MemoryFieldType type)
+{
+    switch (type)
+    {
+        case MemoryFieldType::Byte:
+        case MemoryFieldType::UnsignedByte:
+        case MemoryFieldType::Word:
+        case MemoryFieldType::UnsignedWord:
+        case MemoryFieldType::Dword:
+        case MemoryFieldType::UnsignedDword:
+        case MemoryFieldType::Qword:
+        case MemoryFieldType::UnsignedQword:
+        case MemoryFieldType::Float:
+        case MemoryFieldType::Double:
+        case MemoryFieldType::Bool:
+        case MemoryFieldType::State8:
+        case MemoryFieldType::State16:
+        case MemoryFieldType::State32:
+        case MemoryFieldType::UTF16Char:
+            return true;
+        default:
+            return false;
+    }
+}
+
+S2Plugin::RowRefreshAction S2Plugin::RowRefresh::action(const Row& row) const
+{
+    if (cull && !row.visible && isCullable(row))
+        return RowRefreshAction::Cull;
+
+    if (snapshot == nullptr || row.stale || !isValueOnly(row))
+        return RowRefreshAction::Update;
+
+    auto size = Configuration::getBuiltInTypeSize(row.type);
+    if (snapshot->changed(row.address, size))
+        return RowRefreshAction::Update;
+
+    // comparison values are updated by the same call
+    if (row.comparisonAddress != 0 && (comparisonSnapshot == nullptr || comparisonSnapshot->changed(row.comparisonAddress, size)))
+        return RowRefreshAction::Update;
+
+    return RowRefreshAction::Skip;
+}
@@ -0,0 +1,42 @@
+#include "SampleRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+S2Plugin::SampleRingBuffer::SampleRingBuffer(size_t capacity, size_t recordWords) : mRecordWords(recordWords == 0 ? 1 : recordWords)
+{
+    size_t rounded = 1;
+    while (rounded < capacity)
+        rounded <<= 1;
+
+    mMask = rounded - 1;
+    mData.reset(new uint64_t[rounded * mRecordWords]);
+}
+
+bool S2Plugin::SampleRingBuffer::push(const uint64_t* record) noexcept
+{
+    const size_t head = mHead.load(std::memory_order_relaxed);
+    if (head - mCachedTail > mMask)
+    {
+        mCachedTail = mTail.load(std::memory_order_acquire);
+        if (head - mCachedTail > mMask)
+            return false;
+    }
+    std::memcpy(mData.get() + (head & mMask) * mRecordWords, record, mRecordWords * sizeof(uint64_t));
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+size_t S2Plugin::SampleRingBuffer::pop(uint64_t* dest, size_t maxRecords) noexcept
+{
+    const size_t tail = mTail.load(std::memory_order_relaxed);
+    if (mCachedHead - tail < maxRecords)
+        mCachedHead = mHead.load(std::memory_order_acquire);
+
+    const size_t count = std::min(mCachedHead - tail, maxRecords);
+    for (size_t i = 0; i < count; ++i)
+        std::memcpy(dest + i * mRecordWords, mData.get() + ((tail + i) & mMask) * mRecordWords, mRecordWords * sizeof(uint64_t));
+
+    mTail.store(tail + count, std::memory_order_release);
+    return count;
+}
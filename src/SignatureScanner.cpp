@@ -0,0 +1,228 @@
+#include "SignatureScanner.h"
+
+#include "read_helpers.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    // bytes that show up all over x86-64 code, bad candidates for the anchor
+    bool isCommonByte(uint8_t b)
+    {
+        return S2Plugin::BytePattern::commonness(b) >= 6;
+    }
+} // namespace
+
+size_t S2Plugin::SignatureScanner::add(std::string_view pattern)
+{
+    Signature signature;
+    signature.pattern.parse(pattern);
+    mSignatures.push_back(std::move(signature));
+    mIndexDirty = true;
+    return mSignatures.size() - 1;
+}
+
+size_t S2Plugin::SignatureScanner::add(std::string_view pattern, int32_t displacementOffset, int32_t instructionEnd)
+{
+    auto id = add(pattern);
+    auto& signature = mSignatures[id];
+    signature.displacementOffset = displacementOffset;
+    signature.instructionEnd = instructionEnd;
+    signature.hasTarget = true;
+    return id;
+}
+
+void S2Plugin::SignatureScanner::buildIndex()
+{
+    mAnchors.reset();
+    mUnanchored.clear();
+    mMaxAnchor = 0;
+    std::vector<uint32_t> counts(0x10001, 0);
+    std::vector<uint16_t> keys(mSignatures.size(), 0);
+    for (uint32_t id = 0; id < mSignatures.size(); ++id)
+    {
+        auto& signature = mSignatures[id];
+        auto& pattern = signature.pattern;
+        // the pair of fixed bytes with the least common bytes, the first one on a tie
+        signature.anchor = noAnchor;
+        int bestScore = 3;
+        for (size_t i = 0; i + 1 < pattern.size(); ++i)
+        {
+            if (pattern.mask[i] == 0 || pattern.mask[i + 1] == 0)
+                continue;
+
+            int score = (isCommonByte(pattern.bytes[i]) ? 1 : 0) + (isCommonByte(pattern.bytes[i + 1]) ? 1 : 0);
+            if (score < bestScore)
+            {
+                bestScore = score;
+                signature.anchor = i;
+            }
+        }
+        if (signature.anchor == noAnchor)
+        {
+            if (!pattern.bytes.empty())
+                mUnanchored.push_back(id);
+
+            continue;
+        }
+        mMaxAnchor = (std::max)(mMaxAnchor, signature.anchor);
+        keys[id] = static_cast<uint16_t>(pattern.bytes[signature.anchor] | pattern.bytes[signature.anchor + 1] << 8);
+        mAnchors.set(keys[id]);
+        ++counts[keys[id] + 1u];
+    }
+
+    mBucketStart.assign(0x10001, 0);
+    for (size_t key = 1; key < counts.size(); ++key)
+        mBucketStart[key] = mBucketStart[key - 1] + counts[key];
+
+    mBuckets.assign(mBucketStart.back(), 0);
+    std::vector<uint32_t> fill(mBucketStart.begin(), mBucketStart.end() - 1);
+    for (uint32_t id = 0; id < mSignatures.size(); ++id)
+        if (mSignatures[id].anchor != noAnchor)
+            mBuckets[fill[keys[id]]++] = id;
+
+    mIndexDirty = false;
+}
+
+void S2Plugin::SignatureScanner::clearResults()
+{
+    for (auto& signature : mSignatures)
+    {
+        signature.match = 0;
+        signature.target = 0;
+        signature.resolveTime = std::chrono::nanoseconds{0};
+    }
+}
+
+void S2Plugin::SignatureScanner::resolve(Signature& signature, const uint8_t* data, size_t size, uintptr_t base, size_t start)
+{
+    signature.match = base + start;
+    if (!signature.hasTarget)
+        return;
+
+    auto displacementAt = static_cast<int64_t>(start) + signature.displacementOffset;
+    if (displacementAt < 0 || static_cast<uint64_t>(displacementAt) + sizeof(int32_t) > size)
+        return;
+
+    int32_t displacement;
+    std::memcpy(&displacement, data + displacementAt, sizeof(displacement));
+    signature.target = base + start + signature.instructionEnd + displacement;
+}
+
+void S2Plugin::SignatureScanner::scanRange(const uint8_t* data, size_t size, size_t begin, size_t end, std::vector<size_t>& matches,
+                                           std::vector<std::chrono::nanoseconds>& times, std::chrono::steady_clock::time_point started) const
+{
+    size_t remaining = mSignatures.size() - mUnanchored.size();
+    // the anchor of a match starting just before the end can be up to mMaxAnchor bytes after it
+    size_t anchorEnd = (std::min)(size - 1, end + mMaxAnchor);
+    for (size_t i = begin; i < anchorEnd && remaining != 0; ++i)
+    {
+        uint16_t key = static_cast<uint16_t>(data[i] | data[i + 1] << 8);
+        if (!mAnchors.test(key))
+            continue;
+
+        for (uint32_t index = mBucketStart[key]; index < mBucketStart[key + 1u]; ++index)
+        {
+            auto id = mBuckets[index];
+            auto& signature = mSignatures[id];
+            if (matches[id] != notFound || i < begin + signature.anchor)
+                continue;
+
+            size_t start = i - signature.anchor;
+            if (start >= end || start + signature.pattern.size() > size || !signature.pattern.matches(data + start))
+                continue;
+
+            matches[id] = start;
+            times[id] = std::chrono::steady_clock::now() - started;
+            --remaining;
+        }
+    }
+
+    // only wildcards and lone fixed bytes, rare enough to not be worth a place in the single pass
+    for (auto id : mUnanchored)
+    {
+        auto& pattern = mSignatures[id].pattern;
+        for (size_t start = begin; start < end && start + pattern.size() <= size; ++start)
+        {
+            if (pattern.matches(data + start))
+            {
+                matches[id] = start;
+                times[id] = std::chrono::steady_clock::now() - started;
+                break;
+            }
+        }
+    }
+}
+
+void S2Plugin::SignatureScanner::scan(const uint8_t* data, size_t size, uintptr_t base, size_t from, size_t threads)
+{
+    if (mIndexDirty)
+        buildIndex();
+
+    clearResults();
+    if (from + 1 >= size)
+        return;
+
+    auto started = std::chrono::steady_clock::now();
+    size_t length = size - from;
+    size_t chunks = std::clamp<size_t>(length / minChunkSize, 1, (std::max)(threads, size_t{1}));
+    size_t chunkSize = (length + chunks - 1) / chunks;
+    std::vector<std::vector<size_t>> matches(chunks, std::vector<size_t>(mSignatures.size(), notFound));
+    std::vector<std::vector<std::chrono::nanoseconds>> times(chunks, std::vector<std::chrono::nanoseconds>(mSignatures.size()));
+    auto scanChunk = [&](size_t chunk)
+    {
+        size_t begin = from + chunk * chunkSize;
+        scanRange(data, size, begin, (std::min)(size, begin + chunkSize), matches[chunk], times[chunk], started);
+    };
+
+    // the first chunk on the calling thread
+    std::vector<std::thread> workers;
+    for (size_t chunk = 1; chunk < chunks; ++chunk)
+        workers.emplace_back(scanChunk, chunk);
+    scanChunk(0);
+    for (auto& worker : workers)
+        worker.join();
+
+    for (size_t id = 0; id < mSignatures.size(); ++id)
+    {
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            if (matches[chunk][id] == notFound)
+                continue;
+
+            resolve(mSignatures[id], data, size, base, matches[chunk][id]);
+            mSignatures[id].resolveTime = times[chunk][id];
+            break;
+        }
+    }
+}
+
+bool S2Plugin::SignatureScanner::probe(size_t id, uintptr_t match)
+{
+    auto& signature = mSignatures[id];
+    signature.match = 0;
+    signature.target = 0;
+    signature.resolveTime = std::chrono::nanoseconds{0};
+    if (match == 0 || signature.pattern.size() == 0)
+        return false;
+
+    // the pattern and the rel32 in one read
+    int64_t windowStart = 0;
+    int64_t windowEnd = static_cast<int64_t>(signature.pattern.size());
+    if (signature.hasTarget)
+    {
+        windowStart = (std::min)(windowStart, static_cast<int64_t>(signature.displacementOffset));
+        windowEnd = (std::max)(windowEnd, static_cast<int64_t>(signature.displacementOffset) + static_cast<int64_t>(sizeof(int32_t)));
+    }
+    std::vector<uint8_t> window(static_cast<size_t>(windowEnd - windowStart));
+    if (!ReadMemory(match + windowStart, window.data(), window.size()))
+        return false;
+
+    size_t start = static_cast<size_t>(-windowStart);
+    if (!signature.pattern.matches(window.data() + start))
+        return false;
+
+    resolve(signature, window.data(), window.size(), match + windowStart, start);
+    return true;
+}
@@ -0,0 +1,85 @@
+#include "SnapshotDiff.h"
+
+#include "MemorySource/MemorySource.h"
+#include "ReadCache.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+    // words compared at once before looking for the exact ones that changed, one bitmask worth
+    constexpr size_t gsWordsPerBlock = 64;
+} // namespace
+
+bool S2Plugin::SnapshotDiff::update(uintptr_t addr, size_t size)
+{
+    constexpr uintptr_t pageMask = ReadCache::pageSize - 1;
+    uintptr_t begin = addr & ~pageMask;
+    size_t alignedSize = ((addr + size + pageMask) & ~pageMask) - begin;
+    bool sameRange = mValid && begin == mAddr && alignedSize == mData.size();
+
+    std::swap(mData, mPrevious);
+    mData.resize(alignedSize);
+    mAddr = begin;
+    mValid = alignedSize != 0 && MemorySource::get().read(begin, mData.data(), alignedSize);
+    mAllChanged = !sameRange || !mValid;
+    mChangedWords = 0;
+    size_t words = alignedSize / sizeof(uint64_t);
+    mChanged.assign((words + gsWordsPerBlock - 1) / gsWordsPerBlock, 0);
+    if (mAllChanged)
+        return mValid;
+
+    const uint8_t* current = mData.data();
+    const uint8_t* previous = mPrevious.data();
+    for (size_t block = 0; block < mChanged.size(); ++block)
+    {
+        size_t first = block * gsWordsPerBlock;
+        size_t count = (std::min)(gsWordsPerBlock, words - first);
+        // most of the memory does not change between the ticks
+        if (std::memcmp(current + first * sizeof(uint64_t), previous + first * sizeof(uint64_t), count * sizeof(uint64_t)) == 0)
+            continue;
+
+        uint64_t bits = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t a;
+            uint64_t b;
+            std::memcpy(&a, current + (first + i) * sizeof(uint64_t), sizeof(uint64_t));
+            std::memcpy(&b, previous + (first + i) * sizeof(uint64_t), sizeof(uint64_t));
+            bits |= static_cast<uint64_t>(a != b) << i;
+        }
+        mChanged[block] = bits;
+        for (; bits != 0; bits &= bits - 1)
+            ++mChangedWords;
+    }
+    return true;
+}
+
+bool S2Plugin::SnapshotDiff::changed(uintptr_t addr, size_t size) const
+{
+    size = (std::max)(size, size_t{1});
+    if (mAllChanged || !contains(addr, size))
+        return true;
+
+    size_t firstWord = (addr - mAddr) / sizeof(uint64_t);
+    size_t lastWord = (addr - mAddr + size - 1) / sizeof(uint64_t);
+    for (size_t word = firstWord; word <= lastWord;)
+    {
+        size_t block = word / gsWordsPerBlock;
+        size_t bit = word % gsWordsPerBlock;
+        size_t bitCount = (std::min)(gsWordsPerBlock - bit, lastWord - word + 1);
+        uint64_t mask = bitCount == gsWordsPerBlock ? ~0ull : ((1ull << bitCount) - 1) << bit;
+        if ((mChanged[block] & mask) != 0)
+            return true;
+
+        word += bitCount;
+    }
+    return false;
+}
+
+void S2Plugin::SnapshotDiff::primeReadCache() const
+{
+    if (mValid)
+        ReadCache::prime(mAddr, mData.data(), mData.size());
+}
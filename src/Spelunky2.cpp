@@ -1,74 +1,191 @@
 #include "Spelunky2.h"
 
+#include "BytePattern.h"
 #include "Configuration.h"
+#include "Data/EntityUIDTable.h"
+#include "LookupCache.h"
+#include "ReadCache.h"
 #include "pluginmain.h"
+#include "read_helpers.h"
+#include "resource_helpers.h"
 #include <QStringList>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // PE timestamp and hash of the first and last page of the code, hashing the whole code would cost as much as the scan
+    S2Plugin::LookupCache::Key lookupCacheKey(uintptr_t moduleBase, uintptr_t codeStart, size_t codeSize)
+    {
+        S2Plugin::LookupCache::Key key;
+        auto ntHeaders = moduleBase + S2Plugin::Read<uint32_t>(moduleBase + 0x3C); // IMAGE_DOS_HEADER::e_lfanew
+        key.timestamp = S2Plugin::Read<uint32_t>(ntHeaders + 8);                   // IMAGE_NT_HEADERS64::FileHeader.TimeDateStamp
+
+        constexpr size_t pageSize = 0x1000;
+        size_t sampleSize = (std::min)(pageSize, codeSize);
+        std::vector<uint8_t> sample(sampleSize * 2 + sizeof(codeSize));
+        S2Plugin::ReadMemory(codeStart, sample.data(), sampleSize);
+        S2Plugin::ReadMemory(codeStart + codeSize - sampleSize, sample.data() + sampleSize, sampleSize);
+        std::memcpy(sample.data() + sampleSize * 2, &codeSize, sizeof(codeSize));
+        key.codeHash = S2Plugin::LookupCache::hashCode(sample.data(), sample.size());
+        return key;
+    }
+
+    // copies the range once and searches the copy, instead of the per byte compare of FindMem
+    uintptr_t findInMemory(const char* pattern, uintptr_t start, size_t size)
+    {
+        S2Plugin::BytePattern bytePattern;
+        if (start == 0 || !bytePattern.parse(pattern) || size < bytePattern.size())
+            return 0;
+
+        std::vector<uint8_t> code(size);
+        if (!S2Plugin::ReadMemory(start, code.data(), size))
+            return 0;
+
+        auto offset = bytePattern.find(code.data(), code.size());
+        return offset == S2Plugin::BytePattern::npos ? 0 : start + offset;
+    }
+} // namespace
 
 S2Plugin::Spelunky2* S2Plugin::Spelunky2::ptr = nullptr;
+std::future<S2Plugin::Spelunky2::Attached> S2Plugin::Spelunky2::attachJob;
 
 S2Plugin::Spelunky2* S2Plugin::Spelunky2::get()
 {
     if (ptr == nullptr)
     {
-        // see if we can get the main module
-        Script::Module::ModuleInfo moduleInfo;
-        if (!Script::Module::GetMainModuleInfo(&moduleInfo))
+        std::string error;
+        if (attachJob.valid())
         {
-            displayError("GetMainModuleInfo failed; Make sure spel2.exe is loaded");
-            return nullptr;
-        }
-        // see if the main module is Spelunky 2
-        if (std::string{"spel2.exe"}.compare(moduleInfo.name) != 0)
-        {
-            displayError("Main module is not spel2.exe");
-            return nullptr;
+            // the scan takes a while, the GUI thread should not wait for it
+            if (attachJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                displayError("Spelunky 2 is still being resolved in the background, try again in a moment");
+                return nullptr;
+            }
+            auto attached = attachJob.get();
+            ptr = attached.spelunky2;
+            error = std::move(attached.error);
         }
+        else
+            ptr = load(error);
 
-        // retrieve the memory map and loop every entry, until we find the .text section of spel2.exe
-        uintptr_t Spelunky2CodeSectionStart{0};
-        size_t Spelunky2CodeSectionSize{0};
-        uintptr_t Spelunky2AfterBundle{0};
+        if (ptr == nullptr)
+            displayError("%s", error.c_str());
+    }
+    return ptr;
+}
 
-        MEMMAP memoryMap = {0};
-        DbgMemMap(&memoryMap);
-        for (auto i = 0; i < memoryMap.count; ++i)
-        {
-            MEMORY_BASIC_INFORMATION mbi = (memoryMap.page)[i].mbi;
-            auto info = std::string((memoryMap.page)[i].info);
-            uintptr_t baseAddress = (uintptr_t)mbi.BaseAddress;
-
-            char name[MAX_MODULE_SIZE + 1] = {0};
-            Script::Module::NameFromAddr(baseAddress, name);
-            if (std::string{"spel2.exe"}.compare(name) != 0 || info.find(".text") == std::string::npos)
-                continue;
-
-            Spelunky2CodeSectionStart = baseAddress;
-            Spelunky2CodeSectionSize = mbi.RegionSize;
-            break;
-        }
+void S2Plugin::Spelunky2::resolveInBackground()
+{
+    if (ptr != nullptr || attachJob.valid())
+        return;
+
+    attachJob = std::async(std::launch::async,
+                           []()
+                           {
+                               Attached attached;
+                               attached.spelunky2 = load(attached.error);
+                               return attached;
+                           });
+}
 
-        if (Spelunky2CodeSectionStart == 0 && Spelunky2CodeSectionSize == 0)
+S2Plugin::Spelunky2* S2Plugin::Spelunky2::load(std::string& error)
+{
+    // see if we can get the main module
+    Script::Module::ModuleInfo moduleInfo;
+    if (!Script::Module::GetMainModuleInfo(&moduleInfo))
+    {
+        error = "GetMainModuleInfo failed; Make sure spel2.exe is loaded";
+        return nullptr;
+    }
+    // see if the main module is Spelunky 2
+    if (std::string{"spel2.exe"}.compare(moduleInfo.name) != 0)
+    {
+        error = "Main module is not spel2.exe";
+        return nullptr;
+    }
+
+    // retrieve the memory map and loop every entry, until we find the .text section of spel2.exe
+    uintptr_t Spelunky2CodeSectionStart{0};
+    size_t Spelunky2CodeSectionSize{0};
+    uintptr_t Spelunky2AfterBundle{0};
+
+    MEMMAP memoryMap = {0};
+    DbgMemMap(&memoryMap);
+    for (auto i = 0; i < memoryMap.count; ++i)
+    {
+        MEMORY_BASIC_INFORMATION mbi = (memoryMap.page)[i].mbi;
+        auto info = std::string((memoryMap.page)[i].info);
+        uintptr_t baseAddress = (uintptr_t)mbi.BaseAddress;
+
+        char name[MAX_MODULE_SIZE + 1] = {0};
+        Script::Module::NameFromAddr(baseAddress, name);
+        if (std::string{"spel2.exe"}.compare(name) != 0 || info.find(".text") == std::string::npos)
+            continue;
+
+        Spelunky2CodeSectionStart = baseAddress;
+        Spelunky2CodeSectionSize = mbi.RegionSize;
+        break;
+    }
+
+    if (Spelunky2CodeSectionStart == 0 && Spelunky2CodeSectionSize == 0)
+    {
+        error = "Could not locate the .text section in the loaded spel2.exe image";
+        return nullptr;
+    }
+
+    auto addr = new Spelunky2{};
+    addr->codeSectionStart = Spelunky2CodeSectionStart;
+    addr->codeSectionSize = Spelunky2CodeSectionSize;
+    addr->addSignatures();
+
+    // same build as in a previous session, the cached locations only need to be checked
+    uintptr_t moduleBase = moduleInfo.base;
+    auto cacheKey = lookupCacheKey(moduleBase, Spelunky2CodeSectionStart, Spelunky2CodeSectionSize);
+    auto cachePath = cacheDirectory() / "Spelunky2Lookups.cache";
+    std::vector<uint32_t> rvas;
+    if (!LookupCache::load(cachePath, cacheKey, rvas) || !addr->probeLookups(moduleBase, rvas))
+    {
+        // the after_bundle is in the last 7 MB of the code, copy it once and look for all the signatures in the copy
+        constexpr size_t sevenMegs = 7ull * 1024 * 1024;
+        size_t codeSize = (std::min)(sevenMegs, Spelunky2CodeSectionSize);
+        uintptr_t codeStart = Spelunky2CodeSectionStart + Spelunky2CodeSectionSize - codeSize;
+        std::vector<uint8_t> code(codeSize);
+        if (!ReadMemory(codeStart, code.data(), codeSize))
         {
-            displayError("Could not locate the .text section in the loaded spel2.exe image");
-            return false;
+            error = "Could not read the .text section of spel2.exe";
+            delete addr;
+            return nullptr;
         }
 
-        Spelunky2AfterBundle = getAfterBundle(Spelunky2CodeSectionStart, Spelunky2CodeSectionSize);
+        Spelunky2AfterBundle = getAfterBundle(code, codeStart);
         if (Spelunky2AfterBundle == 0)
-            return false;
+        {
+            error = "Lookup error: unable to find 'after_bundle' location";
+            delete addr;
+            return nullptr;
+        }
 
-        auto addr = new Spelunky2{};
-        addr->codeSectionStart = Spelunky2CodeSectionStart;
-        addr->codeSectionSize = Spelunky2CodeSectionSize;
         addr->afterBundle = Spelunky2AfterBundle;
         addr->afterBundleSize = Spelunky2CodeSectionStart + Spelunky2CodeSectionSize - Spelunky2AfterBundle;
-        ptr = addr;
+        addr->mSignatures.scan(code.data(), code.size(), codeStart, Spelunky2AfterBundle - codeStart, std::thread::hardware_concurrency());
+        addr->logResolveTimes();
+        if (!LookupCache::save(cachePath, cacheKey, addr->lookupRVAs(moduleBase)))
+            dprintf("could not save lookup cache (%s)\n", cachePath.string().c_str());
     }
-    return ptr;
+    return addr;
 }
 
 void S2Plugin::Spelunky2::reset()
 {
+    // the job can't be abandoned while it still reads from the process
+    if (attachJob.valid())
+        delete attachJob.get().spelunky2;
+
     if (ptr != nullptr)
     {
         delete ptr;
@@ -84,7 +201,7 @@ uintptr_t S2Plugin::Spelunky2::find(const char* pattern, uintptr_t start, size_t
     if (size == 0)
         size = afterBundleSize - (start == 0 ? 0 : start - afterBundle);
 
-    return Script::Pattern::FindMem(start, size, pattern);
+    return findInMemory(pattern, start, size);
 }
 
 uintptr_t S2Plugin::Spelunky2::find_between(const char* pattern, uintptr_t start, uintptr_t end) const
@@ -98,7 +215,7 @@ uintptr_t S2Plugin::Spelunky2::find_between(const char* pattern, uintptr_t start
     else
         size = end - start;
 
-    return Script::Pattern::FindMem(start, size, pattern);
+    return findInMemory(pattern, start, size);
 }
 
 uintptr_t S2Plugin::Spelunky2::get_SaveDataPtr(bool quiet)
@@ -107,7 +224,7 @@ uintptr_t S2Plugin::Spelunky2::get_SaveDataPtr(bool quiet)
     if (gm == 0)
         return 0;
 
-    auto heapOffsetSaveGame = Script::Memory::ReadQword(Script::Memory::ReadQword(gm + 8));
+    auto heapOffsetSaveGame = Read<uintptr_t>(Read<uintptr_t>(gm + 8));
     if (heapOffsetSaveGame == 0)
     {
         if (!quiet)
@@ -134,7 +251,7 @@ const QString& S2Plugin::Spelunky2::themeNameOfOffset(uintptr_t offset)
     {
         for (uint8_t idx = 0; idx < themeNames.size(); ++idx)
         {
-            uintptr_t testPtr = Script::Memory::ReadQword(firstThemeOffset + idx * 0x8ull);
+            uintptr_t testPtr = Read<uintptr_t>(firstThemeOffset + idx * 0x8ull);
             if (testPtr == offset)
                 return themeNames.at(idx);
         }
@@ -164,14 +281,14 @@ uintptr_t S2Plugin::Spelunky2::get_HeapBase(bool quiet)
             if (threadAllInfo.BasicInfo.ThreadNumber == 0) // main thread
             {
                 auto tebAddress = DbgGetTebAddress(threadAllInfo.BasicInfo.ThreadId);
-                auto tebAddress11Ptr = Script::Memory::ReadQword(tebAddress + (11 * sizeof(uintptr_t)));
-                auto tebAddress11Value = Script::Memory::ReadQword(tebAddress11Ptr);
+                auto tebAddress11Ptr = Read<uintptr_t>(tebAddress + (11 * sizeof(uintptr_t)));
+                auto tebAddress11Value = Read<uintptr_t>(tebAddress11Ptr);
                 heapBasePtrTemp = tebAddress11Value + TEB_offset;
-                heapBase = Script::Memory::ReadQword(heapBasePtrTemp);
+                heapBase = Read<uintptr_t>(heapBasePtrTemp);
                 break;
             }
         }
-        if (!Script::Memory::IsValidPtr(heapBasePtrTemp) || !Script::Memory::IsValidPtr(heapBase))
+        if (!IsValidPtr(heapBasePtrTemp) || !IsValidPtr(heapBase))
         {
             if (!quiet)
                 displayError("Could not retrieve heap base of the main thread!\nYou might be too fast, wait for the info in bottom left corner to change to \"Running\"");
@@ -180,62 +297,41 @@ uintptr_t S2Plugin::Spelunky2::get_HeapBase(bool quiet)
         }
         heapBasePtr = heapBasePtrTemp;
     }
-    return Script::Memory::ReadQword(heapBasePtr);
+    return Read<uintptr_t>(heapBasePtr);
 };
 
-static constexpr uint32_t lowbias32(uint32_t x)
+namespace
 {
-    x ^= x >> 16;
-    x *= 0x7feb352d;
-    x ^= x >> 15;
-    x *= 0x846ca68b;
-    x ^= x >> 16;
-    return x;
-}
-
-// Just for reference
-// struct RobinHoodTableEntry
-// {
-//    uint32_t uid_plus_one;
-//    uint32_t padding;
-//    Entity* entity;
-// };
+    // copy of the uid_to_entity table, valid for one ReadCache scope (refresh tick)
+    // per thread, same as the ReadCache
+    struct UIDTableCache
+    {
+        S2Plugin::EntityUIDTable table;
+        uint64_t cacheSerial{0};
+        uintptr_t maskAddr{0};
+    };
+    thread_local UIDTableCache gsUIDTableCache;
+} // namespace
 
 uintptr_t S2Plugin::Spelunky2::findEntityByUID(uint32_t uid, uintptr_t statePtr)
 {
     if (statePtr == 0)
         statePtr = get_StatePtr(true);
-    // ported from overlunky
-    if (uid == ~0 || statePtr == 0)
+    if (uid == ~0u || statePtr == 0)
         return 0;
 
-    // [Known Issue]: Static value, have to restart program for size to update
-    static size_t mask_offset = Configuration::get()->offsetForField(MemoryFieldType::State, "uid_to_entity_mask");
-
-    const uint32_t mask = Script::Memory::ReadDword(statePtr + mask_offset);
-    const uint32_t target_uid_plus_one = lowbias32(uid + 1u);
-    uint32_t cur_index = target_uid_plus_one & mask;
-    const uintptr_t uid_to_entity_data = Script::Memory::ReadQword(statePtr + mask_offset + 0x8u);
-
-    auto getEntry = [uid_to_entity_data](size_t index)
-    {
-        constexpr size_t robinHoodTableEntrySize = 0x10u;
-        return uid_to_entity_data + index * robinHoodTableEntrySize;
-    };
+    // offset lookup is cheap thanks to the FieldOffsetIndex, so it's always up to date with the configuration
+    const uintptr_t maskAddr = statePtr + Configuration::get()->offsetForField(MemoryFieldType::State, "uid_to_entity_mask");
+    // outside of the refresh tick just walk the table in the game memory
+    if (!ReadCache::isActive())
+        return EntityUIDTable::findInMemory(uid, maskAddr);
 
-    while (true)
+    auto& cache = gsUIDTableCache;
+    if (auto serial = ReadCache::serial(); cache.cacheSerial != serial || cache.maskAddr != maskAddr)
     {
-        auto entry = getEntry(cur_index);
-        auto uid_plus_one = Script::Memory::ReadDword(entry);
-        if (uid_plus_one == target_uid_plus_one)
-            return Script::Memory::ReadQword(entry + 0x8u);
-
-        if (uid_plus_one == 0)
-            return 0;
-
-        if (((cur_index - target_uid_plus_one) & mask) > ((cur_index - uid_plus_one) & mask))
-            return 0;
-
-        cur_index = (cur_index + 1u) & mask;
+        cache.table.read(maskAddr);
+        cache.cacheSerial = serial;
+        cache.maskAddr = maskAddr;
     }
+    return cache.table.find(uid);
 }
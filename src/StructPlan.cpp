@@ -0,0 +1,116 @@
+#include "StructPlan.h"
+
+#include "Configuration.h"
+
+namespace
+{
+    // same types as the database views compare, the game code uses these widths
+    S2Plugin::FieldDecoder decoderForType(S2Plugin::MemoryFieldType type)
+    {
+        using S2Plugin::FieldDecoder;
+        using S2Plugin::MemoryFieldType;
+        switch (type)
+        {
+            case MemoryFieldType::Byte:
+            case MemoryFieldType::State8:
+                return FieldDecoder::Int8;
+            case MemoryFieldType::UnsignedByte:
+            case MemoryFieldType::Flags8:
+            case MemoryFieldType::CharacterDBID:
+                return FieldDecoder::UInt8;
+            case MemoryFieldType::Word:
+            case MemoryFieldType::State16:
+                return FieldDecoder::Int16;
+            case MemoryFieldType::UnsignedWord:
+            case MemoryFieldType::Flags16:
+            case MemoryFieldType::UTF16Char:
+                return FieldDecoder::UInt16;
+            case MemoryFieldType::Dword:
+            case MemoryFieldType::State32:
+            case MemoryFieldType::TextureDBID:
+                return FieldDecoder::Int32;
+            case MemoryFieldType::UnsignedDword:
+            case MemoryFieldType::Flags32:
+            case MemoryFieldType::ParticleDBID:
+            case MemoryFieldType::EntityDBID:
+            case MemoryFieldType::StringsTableID:
+                return FieldDecoder::UInt32;
+            case MemoryFieldType::Qword:
+                return FieldDecoder::Int64;
+            case MemoryFieldType::UnsignedQword:
+                return FieldDecoder::UInt64;
+            case MemoryFieldType::Float:
+                return FieldDecoder::Float;
+            case MemoryFieldType::Double:
+                return FieldDecoder::Double;
+            case MemoryFieldType::Bool:
+                return FieldDecoder::Bool;
+            default:
+                return FieldDecoder::None;
+        }
+    }
+} // namespace
+
+void S2Plugin::StructPlans::build(const Configuration& config)
+{
+    clear();
+    // ids first, so the plans can refer to each other in any order
+    for (auto& [type, fields] : config.mTypeFieldsMain)
+        mIds.emplace(&fields, static_cast<uint32_t>(mIds.size()));
+    for (auto& [name, fields] : config.mTypeFieldsStructs)
+        mIds.emplace(&fields, static_cast<uint32_t>(mIds.size()));
+    for (auto& [name, fields] : config.mTypeFieldsEntitySubclasses)
+        mIds.emplace(&fields, static_cast<uint32_t>(mIds.size()));
+
+    mPlans.resize(mIds.size());
+    for (auto& [fields, id] : mIds)
+        compile(config, *fields, mPlans[id]);
+}
+
+void S2Plugin::StructPlans::clear()
+{
+    mPlans.clear();
+    mIds.clear();
+}
+
+void S2Plugin::StructPlans::compile(const Configuration& config, const std::vector<MemoryField>& fields, StructPlan& plan) const
+{
+    plan.instructions.reserve(fields.size());
+    size_t offset = 0;
+    for (auto& field : fields)
+    {
+        size_t size = field.get_size();
+        if (field.type != MemoryFieldType::Skip)
+        {
+            StructPlanInstruction instruction;
+            instruction.offset = static_cast<uint32_t>(offset);
+            instruction.size = static_cast<uint32_t>(size);
+            instruction.childPlan = childPlan(config, field);
+            instruction.decoder = field.isPointer ? FieldDecoder::UInt64 : decoderForType(field.type);
+            instruction.pointerHop = field.isPointer;
+            instruction.field = &field;
+            plan.instructions.push_back(instruction);
+        }
+        offset += size;
+    }
+    plan.size = offset;
+}
+
+uint32_t S2Plugin::StructPlans::childPlan(const Configuration& config, const MemoryField& field) const
+{
+    const std::vector<MemoryField>* fields = nullptr;
+    if (field.type == MemoryFieldType::DefaultStructType)
+        fields = config.findStruct(field.jsonName);
+    else if (field.type == MemoryFieldType::EntitySubclass)
+    {
+        if (config.isEntitySubclass(field.jsonName))
+            fields = &config.typeFieldsOfEntitySubclass(field.jsonName);
+    }
+    else if (field.jsonName.empty())
+        fields = &config.typeFields(field.type);
+
+    if (fields == nullptr || fields->empty())
+        return noPlan;
+
+    return id(*fields);
+}
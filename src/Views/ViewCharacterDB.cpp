@@ -1,6 +1,7 @@
 #include "Views/ViewCharacterDB.h"
 
 #include "Configuration.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "Spelunky2.h"
 #include <QCompleter>
@@ -2,12 +2,16 @@
 
 #include "Configuration.h"
 #include "Data/Entity.h"
+#include "Data/EntitySnapshot.h"
 #include "Data/Entitylist.h"
-#include "Data/StdMap.h"
+#include "Data/StdMapSnapshot.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtPlugin.h"
+#include "ReadCache.h"
 #include "Spelunky2.h"
 #include "pluginmain.h"
+#include "read_helpers.h"
 #include <QCheckBox>
 #include <QHeaderView>
 #include <QLabel>
@@ -89,6 +93,7 @@ S2Plugin::ViewEntities::ViewEntities(QWidget* parent) : QWidget(parent)
 
 void S2Plugin::ViewEntities::refreshEntities()
 {
+    ReadCache::Scope readCacheScope;
     mMainTreeView->clear();
 
     bool isUIDlookupSuccess = false;
@@ -102,10 +107,11 @@ void S2Plugin::ViewEntities::refreshEntities()
     MemoryField field;
     field.type = MemoryFieldType::EntityPointer;
     field.isPointer = true;
-    auto AddEntity = [&](size_t entity_ptr)
+    // collect the entities first, so all of them can be read in few bulk reads
+    EntitySnapshot snapshot;
+    auto AddEntity = [&](size_t index)
     {
-        auto entity = Entity{Script::Memory::ReadQword(entity_ptr)};
-        QString entityName = QString::fromStdString(Configuration::get()->getEntityName(entity.entityTypeID()));
+        QString entityName = QString::fromStdString(Configuration::get()->getEntityName(snapshot.entityTypeID(index)));
 
         if (!isUIDlookupSuccess && !mFilterLineEdit->text().isEmpty())
         {
@@ -113,14 +119,13 @@ void S2Plugin::ViewEntities::refreshEntities()
                 return;
         }
 
-        field.name = "entity_uid_" + std::to_string(entity.uid());
-        mMainTreeView->addMemoryField(field, {}, entity_ptr, 0);
+        mMainTreeView->addNamedMemoryField(field, "entity_uid_" + std::to_string(snapshot.uid(index)), {}, snapshot.slot(index), 0);
         ++entitiesShown;
     };
 
-    auto layer0 = Script::Memory::ReadQword(mLayer0Address);
+    auto layer0 = Read<uintptr_t>(mLayer0Address);
     EntityList entListLayer0{layer0 + 0x8};
-    auto layer1 = Script::Memory::ReadQword(mLayer1Address);
+    auto layer1 = Read<uintptr_t>(mLayer1Address);
     EntityList entListLayer1{layer1 + 0x8};
     mCheckboxLayer0->setText(QString("Front layer (%1)").arg(entListLayer0.size()));
     mCheckboxLayer1->setText(QString("Back layer (%1)").arg(entListLayer1.size()));
@@ -137,7 +142,8 @@ void S2Plugin::ViewEntities::refreshEntities()
         {
             if (enteredUID == uidList0[idx])
             {
-                AddEntity(entListLayer0.entities() + idx * sizeof(size_t));
+                auto slot = entListLayer0.entities() + idx * sizeof(size_t);
+                snapshot.addEntity(Read<uintptr_t>(slot), slot);
                 found_uid = true;
                 break;
             }
@@ -150,15 +156,21 @@ void S2Plugin::ViewEntities::refreshEntities()
             {
                 if (enteredUID == uidList1[idx])
                 {
-                    AddEntity(entListLayer1.entities() + idx * sizeof(size_t));
+                    auto slot = entListLayer1.entities() + idx * sizeof(size_t);
+                    snapshot.addEntity(Read<uintptr_t>(slot), slot);
                     break;
                 }
             }
         }
     }
 
-    StdMap<MASK, size_t> map0{layer0 + mLayerMapOffset};
-    StdMap<MASK, size_t> map1{layer1 + mLayerMapOffset};
+    // value is the EntityList, only its address is needed
+    StdMapSnapshot map0{sizeof(MASK), alignof(MASK), 0, alignof(size_t)};
+    StdMapSnapshot map1{sizeof(MASK), alignof(MASK), 0, alignof(size_t)};
+    if (check_layer0)
+        map0.read(layer0 + mLayerMapOffset);
+    if (check_layer1)
+        map1.read(layer1 + mLayerMapOffset);
 
     for (auto& checkbox : mCheckbox)
     {
@@ -166,36 +178,35 @@ void S2Plugin::ViewEntities::refreshEntities()
 
         if (check_layer0)
         {
-            auto itr = map0.find(checkbox.mask);
-            if (itr != map0.end())
+            auto index = map0.find(checkbox.mask);
+            if (index != StdMapSnapshot::npos)
             {
-                EntityList maskEntList{itr.value_ptr()};
+                EntityList maskEntList{map0.valuePtr(index)};
 
                 field_count += maskEntList.size();
-                // loop only if uid was not entered and the mask was chosen
+                // add only if uid was not entered and the mask was chosen
                 if (!isUIDlookupSuccess && checkbox.mCheckbox->checkState() == Qt::Checked)
-                {
-                    for (size_t i = 0; i < maskEntList.size(); ++i)
-                        AddEntity(maskEntList.entities() + i * sizeof(uintptr_t));
-                }
+                    snapshot.addList(maskEntList);
             }
         }
         if (check_layer1)
         {
-            auto itr = map1.find(checkbox.mask);
-            if (itr != map1.end())
+            auto index = map1.find(checkbox.mask);
+            if (index != StdMapSnapshot::npos)
             {
-                EntityList maskEntList{itr.value_ptr()};
+                EntityList maskEntList{map1.valuePtr(index)};
                 field_count += maskEntList.size();
                 if (!isUIDlookupSuccess && checkbox.mCheckbox->checkState() == Qt::Checked)
-                {
-                    for (size_t i = 0; i < maskEntList.size(); ++i)
-                        AddEntity(maskEntList.entities() + i * sizeof(uintptr_t));
-                }
+                    snapshot.addList(maskEntList);
             }
         }
         checkbox.mCheckbox->setText(QString(checkbox.name + " (%1)").arg(field_count));
     }
+
+    snapshot.read();
+    for (size_t i = 0; i < snapshot.size(); ++i)
+        AddEntity(i);
+
     setWindowTitle(QString("%1 Entities").arg(entitiesShown));
     mMainTreeView->updateTableHeader();
     mMainTreeView->updateTree();
@@ -4,6 +4,7 @@
 #include "Data/CPPGenerator.h"
 #include "Data/Entity.h"
 #include "QtHelpers/CPPSyntaxHighlighter.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetAutorefresh.h"
 #include "QtHelpers/WidgetMemoryView.h"
@@ -251,9 +252,10 @@ void S2Plugin::ViewEntity::interpretAsChanged(const QString& classType)
             if (colorIndex > colors.size())
                 colorIndex = 0;
 
-            headerField.name = "<b>" + *it + "</b>";
+            headerField.name = *it;
             headerField.jsonName = *it;
-            mMainTreeView->addMemoryField(headerField, *it, mEntityPtr + delta, delta);
+            auto headerItem = mMainTreeView->addMemoryField(headerField, *it, mEntityPtr + delta, delta);
+            headerItem->setData(static_cast<uint8_t>(CellStyle::Bold), gsRoleCellStyle);
             // highlights fields in memory view, also updates delta
             recursiveHighlight(*it + ".", config->typeFieldsOfEntitySubclass(*it), recursiveHighlight);
         }
@@ -294,7 +296,9 @@ void S2Plugin::ViewEntity::updateComparedMemoryViewHighlights()
             type = field->data(gsRoleType).value<MemoryFieldType>();
             bool isPointer = field->data(gsRoleIsPointer).toBool();
             // [Known Issue]: This may need update if we ever add field types that have children with not actual memory representation
-            if (!isPointer && field->hasChildren() && type != MemoryFieldType::Flags8 && type != MemoryFieldType::Flags16 && type != MemoryFieldType::Flags32)
+            // inline structs are added to the tree on expand, the fields are needed here regardless
+            if (!isPointer && (field->hasChildren() || mMainTreeView->fetchChildren(field)) && type != MemoryFieldType::Flags8 && type != MemoryFieldType::Flags16 &&
+                type != MemoryFieldType::Flags32)
             {
                 self(field, self);
                 continue;
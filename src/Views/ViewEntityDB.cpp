@@ -2,16 +2,22 @@
 
 #include "Configuration.h"
 #include "Data/EntityDB.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtPlugin.h"
 #include "Spelunky2.h"
 #include <QCompleter>
+#include <QStringList>
 
 S2Plugin::ViewEntityDB::ViewEntityDB(QWidget* parent) : AbstractDatabaseView(MemoryFieldType::EntityDB, parent)
 {
     auto config = Configuration::get();
     setWindowTitle(QString("Entity DB (%1 entities)").arg(config->entityList().count()));
-    auto entityNameCompleter = new QCompleter(config->entityList().names(), this);
+    QStringList entityNames;
+    for (auto& name : config->entityList().names())
+        entityNames << QString::fromStdString(name);
+
+    auto entityNameCompleter = new QCompleter(entityNames, this);
     entityNameCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     entityNameCompleter->setFilterMode(Qt::MatchContains);
     QObject::connect(entityNameCompleter, static_cast<void (QCompleter::*)(const QString&)>(&QCompleter::activated), this, &ViewEntityDB::searchFieldCompleterActivated);
@@ -1,6 +1,7 @@
 #include "Views/ViewEntityList.h"
 
 #include "Data/EntityList.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetPagination.h"
 #include <QString>
@@ -36,8 +37,7 @@ void S2Plugin::ViewEntityList::reloadContainer()
     auto range = mPagination->getRange();
     for (size_t idx = range.first; idx < range.second; ++idx)
     {
-        mEntityField.name = "uid_" + std::to_string(uids[idx]);
-        mMainTreeView->addMemoryField(mEntityField, {}, entities + idx * sizeof(uintptr_t), idx * sizeof(uintptr_t));
+        mMainTreeView->addNamedMemoryField(mEntityField, "uid_" + std::to_string(uids[idx]), {}, entities + idx * sizeof(uintptr_t), idx * sizeof(uintptr_t));
     }
 
     mMainTreeView->updateTableHeader();
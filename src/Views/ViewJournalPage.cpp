@@ -1,6 +1,7 @@
 #include "Views/ViewJournalPage.h"
 
 #include "Configuration.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetAutorefresh.h"
 #include "QtPlugin.h"
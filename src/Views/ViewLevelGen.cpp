@@ -1,6 +1,7 @@
 #include "Views/ViewLevelGen.h"
 
 #include "Configuration.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetAutorefresh.h"
 #include "QtHelpers/WidgetSpelunkyRooms.h"
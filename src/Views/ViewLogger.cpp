@@ -4,9 +4,12 @@
 #include "QtHelpers/ItemModelLoggerFields.h"
 #include "QtHelpers/ItemModelLoggerSamples.h"
 #include "QtHelpers/TableViewLogger.h"
+#include "QtHelpers/WidgetLoggerTriggers.h"
 #include "QtHelpers/WidgetSamplesPlot.h"
 #include "QtHelpers/WidgetSampling.h"
 #include "QtPlugin.h"
+#include <QCheckBox>
+#include <QFileDialog>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QLineEdit>
@@ -31,7 +34,8 @@ S2Plugin::ViewLogger::ViewLogger(QWidget* parent) : QWidget(parent)
     topLayout->addWidget(new QLabel("Sample period:", this));
     mSamplePeriodLineEdit = new QLineEdit("8", this);
     mSamplePeriodLineEdit->setFixedWidth(50);
-    mSamplePeriodLineEdit->setValidator(new QIntValidator(5, 5000, this));
+    // sampling runs on its own thread, so even the short periods are kept
+    mSamplePeriodLineEdit->setValidator(new QIntValidator(1, 5000, this));
     topLayout->addWidget(mSamplePeriodLineEdit);
     topLayout->addWidget(new QLabel("milliseconds", this));
 
@@ -41,18 +45,43 @@ S2Plugin::ViewLogger::ViewLogger(QWidget* parent) : QWidget(parent)
     mDurationLineEdit = new QLineEdit("5", this);
     topLayout->addWidget(mDurationLineEdit);
     mDurationLineEdit->setFixedWidth(50);
-    mDurationLineEdit->setValidator(new QIntValidator(1, 500, this));
+    // 0 samples until stopped, only when streaming to a file
+    mDurationLineEdit->setValidator(new QIntValidator(0, 500, this));
     topLayout->addWidget(new QLabel("seconds", this));
 
     topLayout->addStretch();
 
+    mCaptureCheckBox = new QCheckBox("Stream to file", this);
+    mCaptureCheckBox->setToolTip("Write the samples into a capture file while sampling, the duration can be 0 (until stopped)");
+    topLayout->addWidget(mCaptureCheckBox);
+
     mStartButton = new QPushButton(this);
     mStartButton->setText("Start");
     topLayout->addWidget(mStartButton);
     QObject::connect(mStartButton, &QPushButton::clicked, this, &ViewLogger::startLogging);
 
+    mStopButton = new QPushButton(this);
+    mStopButton->setText("Stop");
+    mStopButton->setHidden(true);
+    topLayout->addWidget(mStopButton);
+    QObject::connect(mStopButton, &QPushButton::clicked, mLogger, &Logger::stop);
+
+    mOpenCaptureButton = new QPushButton(this);
+    mOpenCaptureButton->setText("Open capture");
+    topLayout->addWidget(mOpenCaptureButton);
+    QObject::connect(mOpenCaptureButton, &QPushButton::clicked, this, &ViewLogger::openCapture);
+
+    mExportButton = new QPushButton(this);
+    mExportButton->setText("Export");
+    topLayout->addWidget(mExportButton);
+    QObject::connect(mExportButton, &QPushButton::clicked, this, &ViewLogger::exportSamples);
+
     mainLayout->addLayout(topLayout);
 
+    mStatisticsLabel = new QLabel(this);
+    mStatisticsLabel->setHidden(true);
+    mainLayout->addWidget(mStatisticsLabel);
+
     // TABS
     mMainTabWidget = new QTabWidget(this);
     mMainTabWidget->setDocumentMode(false);
@@ -61,16 +90,20 @@ S2Plugin::ViewLogger::ViewLogger(QWidget* parent) : QWidget(parent)
     auto tabFields = new QWidget();
     auto tabSamples = new QWidget();
     auto tabPlot = new QWidget();
+    auto tabTriggers = new QWidget();
     tabFields->setLayout(new QVBoxLayout());
     tabFields->layout()->setMargin(0);
     tabSamples->setLayout(new QVBoxLayout());
     tabSamples->layout()->setMargin(0);
     tabPlot->setLayout(new QVBoxLayout());
     tabPlot->layout()->setMargin(0);
+    tabTriggers->setLayout(new QVBoxLayout());
+    tabTriggers->layout()->setMargin(0);
 
     mMainTabWidget->addTab(tabFields, "Fields");
     mMainTabWidget->addTab(tabSamples, "Samples");
     mMainTabWidget->addTab(tabPlot, "Plot");
+    mMainTabWidget->addTab(tabTriggers, "Triggers");
 
     // TAB Fields
     {
@@ -105,6 +138,13 @@ S2Plugin::ViewLogger::ViewLogger(QWidget* parent) : QWidget(parent)
         tabPlot->layout()->addWidget(samplesPlotScroll);
     }
 
+    // TAB Triggers
+    {
+        auto triggersWidget = new WidgetLoggerTriggers(mLogger, this);
+        tabTriggers->layout()->addWidget(triggersWidget);
+        QObject::connect(mLogger, &Logger::fieldsChanged, triggersWidget, &WidgetLoggerTriggers::fieldsChanged);
+    }
+
     QObject::connect(mLogger, &Logger::samplingEnded, this, &ViewLogger::samplingEnded);
     QObject::connect(mLogger, &Logger::fieldsChanged, this, &ViewLogger::fieldsChanged);
 
@@ -125,37 +165,110 @@ QSize S2Plugin::ViewLogger::minimumSizeHint() const
 
 void S2Plugin::ViewLogger::startLogging()
 {
-    if (mLogger->fieldCount() > 0)
+    if (mLogger->fieldCount() == 0)
+    {
+        showError("Please specify one or more fields to log");
+        return;
+    }
+    int duration = mDurationLineEdit->text().toInt();
+    std::string capturePath;
+    if (mCaptureCheckBox->isChecked())
     {
-        mSamplePeriodLineEdit->setEnabled(false);
-        mDurationLineEdit->setEnabled(false);
-        mStartButton->setEnabled(false);
-        mMainTabWidget->setHidden(true);
-        mSamplingWidget->setHidden(false);
-        mLogger->start(mSamplePeriodLineEdit->text().toInt(), mDurationLineEdit->text().toInt());
+        auto fileName = QFileDialog::getSaveFileName(this, "Save capture", "Spelunky2LoggerCapture.s2capture", "Logger captures (*.s2capture)");
+        if (fileName.isEmpty())
+            return;
+
+        capturePath = fileName.toStdString();
     }
-    else
+    else if (duration == 0)
+    {
+        showError("Sampling until stopped is only available when streaming to a file");
+        return;
+    }
+
+    if (!mLogger->start(mSamplePeriodLineEdit->text().toInt(), duration, capturePath))
     {
-        QMessageBox msgBox;
-        msgBox.setIcon(QMessageBox::Warning);
-        msgBox.setWindowIcon(getCavemanIcon());
-        msgBox.setText("Please specify one or more fields to log");
-        msgBox.setWindowTitle("Spelunky2");
-        msgBox.exec();
+        showError("The capture file could not be created");
+        return;
     }
+    mSamplePeriodLineEdit->setEnabled(false);
+    mDurationLineEdit->setEnabled(false);
+    mCaptureCheckBox->setEnabled(false);
+    mStartButton->setEnabled(false);
+    mOpenCaptureButton->setEnabled(false);
+    mExportButton->setEnabled(false);
+    mStopButton->setHidden(false);
+    mMainTabWidget->setHidden(true);
+    mSamplingWidget->setHidden(false);
+    mStatisticsLabel->setText(QString("Sampling %1 fields, %2 reads per sample").arg(mLogger->fieldCount()).arg(mLogger->samplingStatistics().readsPerSample));
+    mStatisticsLabel->setHidden(false);
 }
 
 void S2Plugin::ViewLogger::samplingEnded()
 {
     mSamplePeriodLineEdit->setEnabled(true);
     mDurationLineEdit->setEnabled(true);
+    mCaptureCheckBox->setEnabled(true);
     mStartButton->setEnabled(true);
+    mOpenCaptureButton->setEnabled(true);
+    mExportButton->setEnabled(true);
+    mStopButton->setHidden(true);
     mSamplingWidget->setHidden(true);
     mMainTabWidget->setHidden(false);
     mSamplesTableModel->reset();
+
+    auto& stats = mLogger->samplingStatistics();
+    mStatisticsLabel->setText(QString("Last run: %1 samples, period %2 ms (requested %3 ms), jitter %4 ms, min %5 ms, max %6 ms, dropped %7, missed ticks %8, %9 reads per sample")
+                                  .arg(stats.samples)
+                                  .arg(stats.meanPeriod, 0, 'f', 3)
+                                  .arg(stats.requestedPeriod, 0, 'f', 0)
+                                  .arg(stats.jitter, 0, 'f', 3)
+                                  .arg(stats.minPeriod, 0, 'f', 3)
+                                  .arg(stats.maxPeriod, 0, 'f', 3)
+                                  .arg(stats.dropped)
+                                  .arg(stats.missed)
+                                  .arg(stats.readsPerSample));
+    if (!mLogger->triggers().triggers.empty())
+        mStatisticsLabel->setText(mStatisticsLabel->text() + QString(", %1 triggers, %2 samples discarded").arg(stats.triggers).arg(stats.discarded));
+    mStatisticsLabel->setHidden(false);
 }
 
 void S2Plugin::ViewLogger::fieldsChanged()
 {
     mSamplesTableModel->reset();
 }
+
+void S2Plugin::ViewLogger::openCapture()
+{
+    auto fileName = QFileDialog::getOpenFileName(this, "Open capture", {}, "Logger captures (*.s2capture)");
+    if (fileName.isEmpty())
+        return;
+
+    if (!mLogger->openCapture(fileName.toStdString()))
+    {
+        showError("The file is not a valid Logger capture");
+        return;
+    }
+    mStatisticsLabel->setText(QString("Capture: %1 fields, %2 samples").arg(mLogger->fieldCount()).arg(mLogger->sampleCount()));
+    mStatisticsLabel->setHidden(false);
+}
+
+void S2Plugin::ViewLogger::exportSamples()
+{
+    auto fileName = QFileDialog::getSaveFileName(this, "Export samples", "Spelunky2LoggerSamples.csv", "CSV files (*.csv);;JSON files (*.json)");
+    if (fileName.isEmpty())
+        return;
+
+    if (!mLogger->exportSamples(fileName.toStdString()))
+        showError("The file could not be written");
+}
+
+void S2Plugin::ViewLogger::showError(const QString& text)
+{
+    QMessageBox msgBox;
+    msgBox.setIcon(QMessageBox::Warning);
+    msgBox.setWindowIcon(getCavemanIcon());
+    msgBox.setText(text);
+    msgBox.setWindowTitle("Spelunky2");
+    msgBox.exec();
+}
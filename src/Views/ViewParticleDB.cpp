@@ -1,15 +1,21 @@
 #include "Views/ViewParticleDB.h"
 
 #include "Configuration.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "Spelunky2.h"
 #include <QCompleter>
+#include <QStringList>
 
 S2Plugin::ViewParticleDB::ViewParticleDB(QWidget* parent) : AbstractDatabaseView(MemoryFieldType::ParticleDB, parent)
 {
     auto& particleEmitters = Configuration::get()->particleEmittersList();
     setWindowTitle(QString("Particle DB (%1 particles)").arg(particleEmitters.count()));
-    auto particleNameCompleter = new QCompleter(particleEmitters.names(), this);
+    QStringList particleNames;
+    for (auto& name : particleEmitters.names())
+        particleNames << QString::fromStdString(name);
+
+    auto particleNameCompleter = new QCompleter(particleNames, this);
     particleNameCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     particleNameCompleter->setFilterMode(Qt::MatchContains);
     QObject::connect(particleNameCompleter, static_cast<void (QCompleter::*)(const QString&)>(&QCompleter::activated), this, &ViewParticleDB::searchFieldCompleterActivated);
@@ -1,5 +1,6 @@
 #include "Views/ViewSaveStates.h"
 
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/StyledItemDelegateHTML.h"
 #include "QtHelpers/WidgetAutorefresh.h"
 #include "QtPlugin.h"
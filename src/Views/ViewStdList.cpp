@@ -1,6 +1,7 @@
 #include "Views/ViewStdList.h"
 
 #include "Data/StdList.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetPagination.h"
 #include "pluginmain.h"
@@ -50,8 +51,8 @@ void S2Plugin::ViewStdList::reloadContainer()
             if (x < currentPageIndex * perPage)
                 continue;
 
-            mValueField.name = "val_" + std::to_string(x);
-            mMainTreeView->addMemoryField(mValueField, mValueField.name, cur.value_ptr(), 0);
+            auto valueName = "val_" + std::to_string(x);
+            mMainTreeView->addNamedMemoryField(mValueField, valueName, valueName, cur.value_ptr(), 0);
         }
         if (cur != theList.end())
             mPagination->setSize(x + perPage - 1); // to add at least one more page
@@ -80,8 +81,8 @@ void S2Plugin::ViewStdList::reloadContainer()
             if (x < range.first)
                 continue;
 
-            mValueField.name = "val_" + std::to_string(x);
-            mMainTreeView->addMemoryField(mValueField, mValueField.name, cur.value_ptr(), 0);
+            auto valueName = "val_" + std::to_string(x);
+            mMainTreeView->addNamedMemoryField(mValueField, valueName, valueName, cur.value_ptr(), 0);
         }
     }
 
@@ -1,6 +1,7 @@
 #include "Views/ViewStdMap.h"
 
-#include "Data/StdMap.h"
+#include "Data/StdMapSnapshot.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetPagination.h"
 #include "pluginmain.h"
@@ -48,7 +49,20 @@ void S2Plugin::ViewStdMap::reloadContainer()
         return;
     }
 
-    StdMap the_map{mMapAddress, mMapKeyAlignment, mMapValueAlignment, mKeyField.get_size()};
+    // only the keys and node addresses are needed, the tree view reads the fields itself
+    StdMapSnapshot the_map{mKeyField.get_size(), mMapKeyAlignment, 0, mMapValueAlignment};
+    // the game can be changing the tree while it's walked, try again before giving up
+    constexpr int maxAttempts = 3;
+    bool read = false;
+    for (int attempt = 0; attempt < maxAttempts && !read; ++attempt)
+        read = the_map.read(mMapAddress);
+
+    if (!read)
+    {
+        mPagination->setSize(0);
+        displayError("Could not read the map at 0x%016llX, the tree is broken or was changing while being read. Press Reload to try again.", static_cast<unsigned long long>(mMapAddress));
+        return;
+    }
     mPagination->setSize(the_map.size());
 
     if (the_map.size() == 0)
@@ -63,26 +77,21 @@ void S2Plugin::ViewStdMap::reloadContainer()
     if (mValueField.type != MemoryFieldType::None) // if not StdSet
         mValueField.name = "value";
 
-    auto _end = the_map.end();
-    auto _cur = the_map.begin();
     MemoryField parent_field;
     parent_field.type = MemoryFieldType::Dummy;
-    for (size_t x = 0; _cur != _end && x < range.second; ++x, ++_cur)
+    for (size_t x = range.first; x < the_map.size() && x < range.second; ++x)
     {
-        if (x < range.first)
-            continue;
-
         if (mValueField.type == MemoryFieldType::None) // StdSet
         {
-            mKeyField.name = "key_" + std::to_string(x);
-            mMainTreeView->addMemoryField(mKeyField, mKeyField.name, _cur.key_ptr(), 0);
+            auto keyName = "key_" + std::to_string(x);
+            mMainTreeView->addNamedMemoryField(mKeyField, keyName, keyName, the_map.keyPtr(x), 0);
         }
         else // StdMap
         {
-            parent_field.name = "obj_" + std::to_string(x);
-            QStandardItem* parent = mMainTreeView->addMemoryField(parent_field, parent_field.name, 0, 0);
-            mMainTreeView->addMemoryField(mKeyField, mKeyField.name, _cur.key_ptr(), 0, 0, parent);
-            mMainTreeView->addMemoryField(mValueField, mValueField.name, _cur.value_ptr(), 0, 0, parent);
+            auto parentName = "obj_" + std::to_string(x);
+            QStandardItem* parent = mMainTreeView->addNamedMemoryField(parent_field, parentName, parentName, 0, 0);
+            mMainTreeView->addMemoryField(mKeyField, mKeyField.name, the_map.keyPtr(x), 0, 0, parent);
+            mMainTreeView->addMemoryField(mValueField, mValueField.name, the_map.valuePtr(x), 0, 0, parent);
             mMainTreeView->setExpanded(parent->index(), true);
         }
     }
@@ -1,6 +1,7 @@
 #include "Views/ViewStdUnorderedMap.h"
 
 #include "Data/StdUnorderedMap.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetPagination.h"
 #include "pluginmain.h"
@@ -75,13 +76,13 @@ void S2Plugin::ViewStdUnorderedMap::reloadContainer()
 
         if (mValueField.type == MemoryFieldType::None) // StdSet
         {
-            mKeyField.name = "key_" + std::to_string(x);
-            mMainTreeView->addMemoryField(mKeyField, mKeyField.name, _cur.key_ptr(), 0);
+            auto keyName = "key_" + std::to_string(x);
+            mMainTreeView->addNamedMemoryField(mKeyField, keyName, keyName, _cur.key_ptr(), 0);
         }
         else // StdMap
         {
-            parent_field.name = "obj_" + std::to_string(x);
-            QStandardItem* parent = mMainTreeView->addMemoryField(parent_field, parent_field.name, 0, 0);
+            auto parentName = "obj_" + std::to_string(x);
+            QStandardItem* parent = mMainTreeView->addNamedMemoryField(parent_field, parentName, parentName, 0, 0);
             mMainTreeView->addMemoryField(mKeyField, mKeyField.name, _cur.key_ptr(), 0, 0, parent);
             mMainTreeView->addMemoryField(mValueField, mValueField.name, _cur.value_ptr(), 0, 0, parent);
             mMainTreeView->setExpanded(parent->index(), true);
@@ -1,5 +1,6 @@
 #include "Views/ViewStdVector.h"
 
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetPagination.h"
 #include "pluginmain.h"
@@ -56,8 +57,8 @@ void S2Plugin::ViewStdVector::reloadContainer()
 
     for (auto x = range.first; x < range.second; ++x)
     {
-        mValueField.name = "obj_" + std::to_string(x);
-        mMainTreeView->addMemoryField(mValueField, mValueField.name, vectorBegin + x * mValueField.get_size(), x * mValueField.get_size());
+        auto valueName = "obj_" + std::to_string(x);
+        mMainTreeView->addNamedMemoryField(mValueField, valueName, valueName, vectorBegin + x * mValueField.get_size(), x * mValueField.get_size());
     }
     mMainTreeView->updateTableHeader();
     mMainTreeView->updateTree(0, 0, true);
@@ -1,6 +1,7 @@
 #include "Views/ViewStringsTable.h"
 
 #include "Data/StringsTable.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/SortFilterProxyModelStringsTable.h"
 #include "QtHelpers/StyledItemDelegateHTML.h"
 #include "QtPlugin.h"
@@ -1,6 +1,7 @@
 #include "Views/ViewStruct.h"
 
 #include "Configuration.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetAutorefresh.h"
 #include "QtHelpers/WidgetPagination.h"
@@ -46,14 +47,12 @@ S2Plugin::ViewStruct::ViewStruct(uintptr_t address, const std::vector<MemoryFiel
 }
 
 S2Plugin::ViewArray::ViewArray(uintptr_t address, std::string arrayTypeName, size_t num, std::string name, QWidget* parent)
-    : ViewStruct(0, {}, arrayTypeName + " " + name + '[' + std::to_string(num) + ']', parent), mArrayAddress(address)
+    : ViewStruct(0, {}, arrayTypeName + " " + name + '[' + std::to_string(num) + ']', parent), mArrayName(std::move(name)), mArrayAddress(address)
 {
-
-    mArray.name = name;
     mArray.type = MemoryFieldType::Array;
     mArray.firstParameterType = arrayTypeName;
     mArray.secondParameterType = '#'; // just to let it know it should put all the elements in, no array element
-    mArray.numberOfElements = num;
+    mArray.numberOfElements = static_cast<uint32_t>(num);
 
     mPagination = new WidgetPagination(this);
     layout()->addWidget(mPagination);
@@ -69,18 +68,19 @@ void S2Plugin::ViewArray::pageListUpdate()
     auto range = mPagination->getRange();
     // using columns to store the initial index
     mArray.setNumColumns(range.first);
-    mArray.numberOfElements = range.second;
-    mMainTreeView->addMemoryField(mArray, {}, mArrayAddress, 0);
+    mArray.numberOfElements = static_cast<uint32_t>(range.second);
+    mMainTreeView->addNamedMemoryField(mArray, mArrayName, {}, mArrayAddress, 0);
 }
 
 S2Plugin::ViewMatrix::ViewMatrix(uintptr_t address, std::string arrayTypeName, size_t rows, size_t columns, std::string name, QWidget* parent)
-    : ViewStruct(0, {}, arrayTypeName + " " + name + '[' + std::to_string(rows) + "][" + std::to_string(columns) + ']', parent), mMatrixAddress(address)
+    : ViewStruct(0, {}, arrayTypeName + " " + name + '[' + std::to_string(rows) + "][" + std::to_string(columns) + ']', parent), mMatrixName(std::move(name)), mMatrixAddress(address)
 {
-    mMatrix.name = name;
-    mMatrix.type = MemoryFieldType::Matrix;
-    mMatrix.firstParameterType = arrayTypeName;
-    mMatrix.rows = rows;
-    mMatrix.setNumColumns(columns);
+    MemoryField matrix;
+    matrix.type = MemoryFieldType::Matrix;
+    matrix.firstParameterType = arrayTypeName;
+    matrix.rows = static_cast<uint32_t>(rows);
+    matrix.setNumColumns(columns);
+    mMatrixRow = TreeViewMemoryFields::matrixRowField(matrix);
 
     mPagination = new WidgetPagination(this);
     layout()->addWidget(mPagination);
@@ -94,10 +94,13 @@ void S2Plugin::ViewMatrix::pageListUpdate()
     mMainTreeView->clear();
     mMainTreeView->updateTableHeader();
     auto range = mPagination->getRange();
-    // dirty way to transfer the first index
-    mMatrix.secondParameterType = std::to_string(range.first);
-    mMatrix.rows = range.second;
-    mMainTreeView->addMemoryField(mMatrix, {}, mMatrixAddress, 0);
+    // only the rows of the current page, without the matrix itself
+    auto rowSize = mMatrixRow.get_size();
+    for (size_t idx = range.first; idx < range.second; ++idx)
+    {
+        auto rowName = mMatrixName + '[' + std::to_string(idx) + ']';
+        mMainTreeView->addNamedMemoryField(mMatrixRow, rowName, rowName, mMatrixAddress + idx * rowSize, idx * rowSize);
+    }
 }
 
 QSize S2Plugin::ViewStruct::sizeHint() const
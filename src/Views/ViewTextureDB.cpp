@@ -2,6 +2,7 @@
 
 #include "Configuration.h"
 #include "Data/TextureDB.h"
+#include "QtHelpers/ItemRoles.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "Spelunky2.h"
 #include <QCompleter>
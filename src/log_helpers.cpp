@@ -0,0 +1,30 @@
+#include "log_helpers.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+// console version for the headless executables (s2console), the plugin version is in pluginmain.cpp
+
+void logPrintf(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    std::fputs("[Spelunky2] ", stderr);
+    std::vfprintf(stderr, fmt, args);
+    va_end(args);
+}
+
+void displayError(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    std::fputs("[Spelunky2] ERROR: ", stderr);
+    std::vfprintf(stderr, fmt, args);
+    std::fputc('\n', stderr);
+    va_end(args);
+}
+
+void displayError(std::string message)
+{
+    std::fprintf(stderr, "[Spelunky2] ERROR: %s\n", message.c_str());
+}
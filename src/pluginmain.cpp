@@ -1,6 +1,8 @@
 #include "pluginmain.h"
 
+#include "MemorySource/X64dbgMemorySource.h"
 #include "QtPlugin.h"
+#include "ReadCache.h"
 #include <QMessageBox>
 
 int S2Plugin::handle;
@@ -16,6 +18,7 @@ PLUG_EXPORT bool pluginit(PLUG_INITSTRUCT* initStruct)
     initStruct->sdkVersion = PLUG_SDKVERSION;
     strncpy_s(initStruct->pluginName, PLUGIN_NAME, _TRUNCATE);
     S2Plugin::handle = initStruct->pluginHandle;
+    S2Plugin::MemorySource::set(std::make_unique<S2Plugin::X64dbgMemorySource>());
     QtPlugin::Init();
     return true;
 }
@@ -38,6 +41,12 @@ PLUG_EXPORT void plugsetup(PLUG_SETUPSTRUCT* setupStruct)
     QtPlugin::WaitForSetup();
 }
 
+// the process is initialized after attaching or starting it, the game's code is there to look for the lookups in
+PLUG_EXPORT void CBSYSTEMBREAKPOINT([[maybe_unused]] CBTYPE cbType, [[maybe_unused]] PLUG_CB_SYSTEMBREAKPOINT* info)
+{
+    GuiExecuteOnGuiThread(QtPlugin::Attach);
+}
+
 PLUG_EXPORT void CBDETACH([[maybe_unused]] CBTYPE cbType, [[maybe_unused]] PLUG_CB_DETACH* info)
 {
     GuiExecuteOnGuiThread(QtPlugin::Detach);
@@ -48,6 +57,16 @@ PLUG_EXPORT void CBEXITPROCESS([[maybe_unused]] CBTYPE cbType, [[maybe_unused]]
     GuiExecuteOnGuiThread(QtPlugin::Detach);
 }
 
+PLUG_EXPORT void CBPAUSEDEBUG([[maybe_unused]] CBTYPE cbType, [[maybe_unused]] PLUG_CB_PAUSEDEBUG* info)
+{
+    S2Plugin::ReadCache::invalidateAll();
+}
+
+PLUG_EXPORT void CBRESUMEDEBUG([[maybe_unused]] CBTYPE cbType, [[maybe_unused]] PLUG_CB_RESUMEDEBUG* info)
+{
+    S2Plugin::ReadCache::invalidateAll();
+}
+
 PLUG_EXPORT void CBMENUPREPARE([[maybe_unused]] CBTYPE cbType, PLUG_CB_MENUPREPARE* info)
 {
     QtPlugin::MenuPrepare(info->hMenu);
@@ -58,6 +77,21 @@ PLUG_EXPORT void CBMENUENTRY([[maybe_unused]] CBTYPE cbType, PLUG_CB_MENUENTRY*
     QtPlugin::MenuEntry(info->hEntry);
 }
 
+void logPrintf(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    int length = vsnprintf(nullptr, 0, fmt, argsCopy);
+    va_end(argsCopy);
+    std::string buffer(length > 0 ? static_cast<size_t>(length) : 0, '\0');
+    if (length > 0)
+        vsnprintf(buffer.data(), buffer.size() + 1, fmt, args);
+    va_end(args);
+    _plugin_logprintf("[" PLUGIN_NAME "] %s", buffer.c_str());
+}
+
 void displayError(const char* fmt, ...)
 {
     char buffer[1024] = {0};
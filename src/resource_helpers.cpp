@@ -0,0 +1,46 @@
+#include "resource_helpers.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace
+{
+    std::filesystem::path gsResourcesDirectory;
+    std::filesystem::path gsCacheDirectory;
+}
+
+const std::filesystem::path& S2Plugin::resourcesDirectory()
+{
+    if (gsResourcesDirectory.empty())
+    {
+#ifdef _WIN32
+        char buffer[MAX_PATH + 1] = {0};
+        GetModuleFileNameA(nullptr, buffer, MAX_PATH);
+        std::filesystem::path executable{buffer};
+#else
+        std::error_code ec;
+        auto executable = std::filesystem::read_symlink("/proc/self/exe", ec);
+#endif
+        gsResourcesDirectory = executable.parent_path() / "plugins";
+    }
+    return gsResourcesDirectory;
+}
+
+void S2Plugin::setResourcesDirectory(std::filesystem::path path)
+{
+    gsResourcesDirectory = std::move(path);
+}
+
+const std::filesystem::path& S2Plugin::cacheDirectory()
+{
+    if (gsCacheDirectory.empty())
+        return resourcesDirectory();
+
+    return gsCacheDirectory;
+}
+
+void S2Plugin::setCacheDirectory(std::filesystem::path path)
+{
+    gsCacheDirectory = std::move(path);
+}
@@ -0,0 +1,53 @@
+#include "Test.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    size_t gsFailedChecks = 0;
+} // namespace
+
+void S2Test::fail(const char* file, int line, const char* expression)
+{
+    ++gsFailedChecks;
+    std::printf("    %s:%d: check failed: %s\n", file, line, expression);
+}
+
+std::vector<S2Test::RegisteredTest>& S2Test::registeredTests()
+{
+    static std::vector<RegisteredTest> tests;
+    return tests;
+}
+
+bool S2Test::registerTest(const char* name, TestFunction function)
+{
+    registeredTests().push_back(RegisteredTest{name, function});
+    return true;
+}
+
+// usage: s2tests [filter]
+int main(int argc, char* argv[])
+{
+    std::string filter = argc > 1 ? argv[1] : "";
+    auto tests = S2Test::registeredTests();
+    std::sort(tests.begin(), tests.end(), [](auto& a, auto& b) { return std::strcmp(a.name, b.name) < 0; });
+    size_t failedTests = 0;
+    size_t ran = 0;
+    for (auto& test : tests)
+    {
+        if (!filter.empty() && std::string(test.name).find(filter) == std::string::npos)
+            continue;
+
+        auto failedBefore = gsFailedChecks;
+        test.function();
+        ++ran;
+        bool failed = gsFailedChecks != failedBefore;
+        failedTests += failed ? 1 : 0;
+        std::printf("%s %s\n", failed ? "FAIL" : "ok  ", test.name);
+    }
+    std::printf("%zu tests, %zu failed\n", ran, failedTests);
+    return failedTests == 0 ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace S2Test
+{
+    using TestFunction = void (*)();
+
+    // records the failure of the running test, the test keeps going so all the failed checks are printed
+    void fail(const char* file, int line, const char* expression);
+
+    // used by the S2_TEST macro
+    bool registerTest(const char* name, TestFunction function);
+
+    struct RegisteredTest
+    {
+        const char* name;
+        TestFunction function;
+    };
+    std::vector<RegisteredTest>& registeredTests();
+} // namespace S2Test
+
+#define S2_TEST(name)                                                                \
+    static void name();                                                              \
+    [[maybe_unused]] static bool name##Registered = S2Test::registerTest(#name, name); \
+    static void name()
+
+#define S2_CHECK(expression)                                \
+    do                                                      \
+    {                                                       \
+        if (!(expression))                                  \
+            S2Test::fail(__FILE__, __LINE__, #expression);  \
+    } while (false)
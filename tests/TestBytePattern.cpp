@@ -0,0 +1,152 @@
+#include "Test.h"
+
+#include "BytePattern.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    // engines not supported by the cpu fall back to the best one, still checked
+    constexpr PatternEngine gsEngines[] = {PatternEngine::Scalar, PatternEngine::SSE2, PatternEngine::AVX2, PatternEngine::Best};
+
+    size_t naiveFind(const BytePattern& pattern, const uint8_t* data, size_t size)
+    {
+        for (size_t i = 0; i + pattern.size() <= size; ++i)
+            if (pattern.matches(data + i))
+                return i;
+
+        return BytePattern::npos;
+    }
+
+    struct Random
+    {
+        uint64_t x{0x2545F4914F6CDD1Dull};
+        uint64_t operator()()
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            return x;
+        }
+    };
+
+    // every engine has to agree with the naive matcher
+    bool allEnginesFind(const BytePattern& pattern, const std::vector<uint8_t>& data, size_t expected)
+    {
+        if (naiveFind(pattern, data.data(), data.size()) != expected)
+            return false;
+
+        for (auto engine : gsEngines)
+            if (pattern.find(data.data(), data.size(), engine) != expected)
+                return false;
+
+        return true;
+    }
+
+    BytePattern parsed(const char* text)
+    {
+        BytePattern pattern;
+        pattern.parse(text);
+        return pattern;
+    }
+} // namespace
+
+S2_TEST(BytePatternParse)
+{
+    BytePattern pattern;
+    S2_CHECK(pattern.parse("48 8B 05 ?? ? 80"));
+    S2_CHECK(pattern.size() == 6);
+    S2_CHECK(pattern.bytes[1] == 0x8B && pattern.mask[1] == 0xFF);
+    S2_CHECK(pattern.mask[3] == 0 && pattern.mask[4] == 0);
+    S2_CHECK(pattern.firstFixed == 0);
+    S2_CHECK(pattern.rareFixed == 5);
+
+    S2_CHECK(!pattern.parse("48 8G"));
+    S2_CHECK(pattern.size() == 0);
+    S2_CHECK(!pattern.parse(""));
+}
+
+S2_TEST(BytePatternBestEngine)
+{
+    // SSE2 is slower than the memchr based scalar search on some cpus, it's only used when asked for
+    auto best = BytePattern::bestEngine();
+    S2_CHECK(best == PatternEngine::AVX2 || best == PatternEngine::Scalar);
+}
+
+S2_TEST(BytePatternSingleFixedByte)
+{
+    std::vector<uint8_t> data(100, 0x11);
+    auto pattern = parsed("CC");
+    S2_CHECK(allEnginesFind(pattern, data, BytePattern::npos));
+    // at every offset, in the vector body and in the tails
+    for (size_t at : {0, 1, 15, 16, 31, 32, 33, 63, 64, 99})
+    {
+        data[at] = 0xCC;
+        S2_CHECK(allEnginesFind(pattern, data, at));
+        data[at] = 0x11;
+    }
+    // surrounded by wildcards
+    data[40] = 0xCC;
+    S2_CHECK(allEnginesFind(parsed("?? ?? CC ??"), data, 38));
+    S2_CHECK(allEnginesFind(parsed("?? CC"), std::vector<uint8_t>{0xCC}, BytePattern::npos));
+}
+
+S2_TEST(BytePatternOnlyWildcards)
+{
+    std::vector<uint8_t> data(40, 0x90);
+    S2_CHECK(allEnginesFind(parsed("??"), data, 0));
+    S2_CHECK(allEnginesFind(parsed("?? ?? ?? ??"), data, 0));
+    S2_CHECK(allEnginesFind(parsed("?? ?? ?? ??"), std::vector<uint8_t>(3, 0x90), BytePattern::npos));
+    S2_CHECK(allEnginesFind(parsed("??"), std::vector<uint8_t>{}, BytePattern::npos));
+}
+
+S2_TEST(BytePatternShorterThanVectorWidth)
+{
+    // data smaller than 16 and 32 bytes is only searched by the tail code
+    auto pattern = parsed("8B 05 ?? 80");
+    for (size_t size = 0; size < 40; ++size)
+    {
+        std::vector<uint8_t> data(size, 0x8B);
+        S2_CHECK(allEnginesFind(pattern, data, BytePattern::npos));
+        if (size < pattern.size())
+            continue;
+
+        size_t at = size - pattern.size();
+        data[at + 1] = 0x05;
+        data[at + 3] = 0x80;
+        S2_CHECK(allEnginesFind(pattern, data, at));
+    }
+}
+
+S2_TEST(BytePatternMatchesNaive)
+{
+    // patterns cut out of the data with some bytes turned to wildcards, so they are found at various offsets,
+    // and random ones that mostly are not, on sizes around the vector widths
+    Random next;
+    size_t mismatches = 0;
+    for (size_t round = 0; round < 4000; ++round)
+    {
+        std::vector<uint8_t> data(next() % 200);
+        for (auto& b : data)
+            b = round % 2 == 0 ? static_cast<uint8_t>(next()) : static_cast<uint8_t>(0x40 + next() % 8);
+
+        size_t length = 1 + next() % 18;
+        size_t from = data.size() > length ? next() % (data.size() - length + 1) : 0;
+        std::string text;
+        for (size_t b = 0; b < length; ++b)
+        {
+            char hex[4];
+            uint8_t value = round % 3 != 2 && from + b < data.size() ? data[from + b] : static_cast<uint8_t>(next());
+            std::snprintf(hex, sizeof(hex), "%02X ", static_cast<unsigned>(value));
+            text += next() % 4 == 0 ? "?? " : hex;
+        }
+        BytePattern pattern;
+        pattern.parse(text);
+        if (!allEnginesFind(pattern, data, naiveFind(pattern, data.data(), data.size())))
+            ++mismatches;
+    }
+    S2_CHECK(mismatches == 0);
+}
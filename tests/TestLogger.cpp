@@ -0,0 +1,228 @@
+#include "Test.h"
+
+#include "Configuration.h"
+#include "Data/LoggerCapture.h"
+#include "Data/LoggerColumn.h"
+#include "Data/LoggerSampler.h"
+#include "Data/LoggerTrigger.h"
+#include "MemorySource/SyntheticMemorySource.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace S2Plugin;
+
+namespace
+{
+    // one Dword field, the value changes at the given ticks
+    std::vector<std::vector<uint64_t>> changingRecords(size_t count, const std::vector<size_t>& changes)
+    {
+        std::vector<std::vector<uint64_t>> records;
+        uint64_t value = 0;
+        for (size_t tick = 0; tick < count; ++tick)
+        {
+            for (auto change : changes)
+                value += change == tick ? 1 : 0;
+            // value followed by the sample index
+            records.push_back({value, tick});
+        }
+        return records;
+    }
+} // namespace
+
+S2_TEST(LoggerTriggerWindowKeepsSampleIndexes)
+{
+    std::vector<LoggerColumn> columns;
+    columns.emplace_back(0, MemoryFieldType::Dword);
+    LoggerTriggerSettings settings;
+    settings.triggers.push_back(LoggerTrigger{0, LoggerTrigger::Condition::Changed});
+    settings.preTrigger = 2;
+    settings.postTrigger = 1;
+
+    LoggerTriggerWindow window{settings, columns};
+    S2_CHECK(window.active());
+    std::vector<uint64_t> kept;
+    for (auto& record : changingRecords(40, {10, 12, 30}))
+        window.process(record.data(), [&kept](const uint64_t* data) { kept.push_back(data[1]); });
+
+    // 8-9 before, 10 and 11 after, extended by the trigger at 12, then 28-31 around the last one
+    std::vector<uint64_t> expected{8, 9, 10, 11, 12, 13, 28, 29, 30, 31};
+    S2_CHECK(kept == expected);
+    S2_CHECK(window.triggerCount() == 3);
+    S2_CHECK(window.discarded() == 40 - expected.size());
+}
+
+S2_TEST(LoggerCaptureRoundTripKeepsSampleIndexes)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "s2tests.s2capture").string();
+    std::vector<LoggerCaptureField> fields{{0x1000, MemoryFieldType::Word, 0xFF00FF00, "word"}, {0x2000, MemoryFieldType::Float, 0xFFFF0000, "float"}};
+    const std::vector<uint64_t> indexes{3, 4, 5, 100, 101};
+    {
+        LoggerCaptureWriter writer;
+        S2_CHECK(writer.create(path, fields, std::chrono::milliseconds(2)));
+        for (auto index : indexes)
+        {
+            float value = static_cast<float>(index) * 0.5f;
+            uint64_t raw = 0;
+            std::memcpy(&raw, &value, sizeof(value));
+            uint64_t record[] = {index * 3, raw, index};
+            S2_CHECK(writer.append(record));
+        }
+        writer.close();
+    }
+
+    LoggerCaptureReader reader;
+    S2_CHECK(reader.open(path));
+    S2_CHECK(reader.frameCount() == indexes.size());
+    auto columns = reader.readColumns();
+    auto sampleIndexes = reader.readSampleIndexes();
+    S2_CHECK(sampleIndexes == indexes);
+    S2_CHECK(columns.size() == 2 && columns[0].size() == indexes.size());
+    S2_CHECK(columns[0].valueAt(3) == 300.0);
+    S2_CHECK(columns[1].valueAt(4) == 50.5);
+    S2_CHECK(reader.readSampleIndexes(3, 1) == std::vector<uint64_t>{100});
+
+    // time of the sample comes from its index, not the row
+    std::ostringstream csv;
+    S2_CHECK(exportLoggerCSV(csv, reader.fields(), columns, sampleIndexes, reader.samplePeriod()));
+    S2_CHECK(csv.str() == "time_ms,word,float\n6,9,1.5\n8,12,2\n10,15,2.5\n200,300,50\n202,303,50.5\n");
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+S2_TEST(LoggerCaptureWindowReadsOnlyTheRequestedChunks)
+{
+    const auto path = (std::filesystem::temp_directory_path() / "s2tests_window.s2capture").string();
+    constexpr uint64_t frames = 3 * LoggerCaptureWindow::chunk + 100;
+    {
+        LoggerCaptureWriter writer;
+        S2_CHECK(writer.create(path, {{0x1000, MemoryFieldType::UnsignedDword, 0xFF00FF00, "dword"}}, std::chrono::milliseconds(1)));
+        // every other tick, so the sample index differs from the position
+        for (uint64_t i = 0; i < frames; ++i)
+        {
+            uint64_t record[] = {i % 1000, i * 2};
+            writer.append(record);
+        }
+        writer.close();
+    }
+    LoggerCaptureReader reader;
+    S2_CHECK(reader.open(path));
+
+    LoggerCaptureWindow window;
+    constexpr uint64_t chunk = LoggerCaptureWindow::chunk;
+    S2_CHECK(window.load(reader, chunk + 10, chunk + 20));
+    S2_CHECK(window.first() == chunk);
+    S2_CHECK(window.sampleIndexes().size() == chunk);
+    S2_CHECK(window.columns().size() == 1 && window.columns()[0].size() == chunk);
+    S2_CHECK(window.sampleIndexes()[10] == (chunk + 10) * 2);
+    S2_CHECK(window.columns()[0].valueAt(10) == static_cast<double>((chunk + 10) % 1000));
+    // the min/max pyramid is built for the loaded samples
+    auto [low, high] = window.columns()[0].minMax(0, chunk);
+    S2_CHECK(low == 0.0 && high == 999.0);
+
+    // inside of the loaded chunk
+    S2_CHECK(!window.load(reader, chunk, 2 * chunk));
+    // across the chunk border and the end of the capture
+    S2_CHECK(window.load(reader, 2 * chunk - 1, frames + 50));
+    S2_CHECK(window.first() == chunk);
+    S2_CHECK(window.first() + window.sampleIndexes().size() == frames);
+    S2_CHECK(window.sampleIndexes().back() == (frames - 1) * 2);
+
+    window.clear();
+    S2_CHECK(window.load(reader, 0, 1));
+    S2_CHECK(window.first() == 0 && window.sampleIndexes().size() == chunk);
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+S2_TEST(LoggerColumnMinMaxIsExact)
+{
+    // values a float can't hold, the min/max from the pyramid levels has to be the same as the samples
+    LoggerColumn column{0, MemoryFieldType::UnsignedDword};
+    for (uint64_t i = 0; i < 1000; ++i)
+        column.append(16777217 + (i % 3) * 2);
+    auto [low, high] = column.minMax(0, 1000);
+    S2_CHECK(low == 16777217.0 && high == 16777221.0);
+    std::tie(low, high) = column.minMax(64, 512);
+    S2_CHECK(low == 16777217.0 && high == 16777221.0);
+
+    LoggerColumn qwords{0, MemoryFieldType::Qword};
+    for (int64_t i = 0; i < 100; ++i)
+        qwords.append(static_cast<uint64_t>((int64_t{1} << 40) + i));
+    std::tie(low, high) = qwords.minMax(8, 72);
+    S2_CHECK(low == static_cast<double>((int64_t{1} << 40) + 8) && high == static_cast<double>((int64_t{1} << 40) + 71));
+}
+
+S2_TEST(LoggerSamplerProducesSampleIndexes)
+{
+    auto memory = std::make_unique<SyntheticMemorySource>();
+    memory->map(0x1000, 0x10);
+    memory->write<uint32_t>(0x1000, 7);
+    MemorySource::set(std::move(memory));
+
+    std::vector<LoggerColumn> columns;
+    columns.emplace_back(0x1000, MemoryFieldType::UnsignedDword);
+    std::vector<uint64_t> sampleIndexes;
+    LoggerSampler sampler;
+    sampler.start(columns, std::chrono::milliseconds(1), std::chrono::milliseconds(30));
+    while (!sampler.finished())
+        sampler.drain(columns, sampleIndexes);
+    sampler.stop();
+    sampler.drain(columns, sampleIndexes);
+
+    // no triggers, every sampled tick is kept, ticks missed by a stall are skipped by the index
+    S2_CHECK(!sampleIndexes.empty());
+    S2_CHECK(sampleIndexes.size() == columns[0].size());
+    S2_CHECK(sampleIndexes.front() == 0);
+    for (size_t i = 1; i < sampleIndexes.size(); ++i)
+        S2_CHECK(sampleIndexes[i] > sampleIndexes[i - 1]);
+    // ticks skipped after the last sample are counted too
+    S2_CHECK(sampleIndexes.back() + 1 <= sampleIndexes.size() + sampler.statistics().missed);
+    S2_CHECK(columns[0].valueAt(0) == 7.0);
+    MemorySource::set(nullptr);
+}
+
+S2_TEST(LoggerSamplerSkipsMissedTicks)
+{
+    // one read takes 5 periods, like the debugger pausing the game
+    struct StallingMemorySource : SyntheticMemorySource
+    {
+        bool read(uintptr_t addr, void* dest, size_t size) override
+        {
+            if (++mReads == 5)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return SyntheticMemorySource::read(addr, dest, size);
+        }
+        uint64_t mReads{0};
+    };
+    auto memory = std::make_unique<StallingMemorySource>();
+    memory->map(0x1000, 0x10);
+    MemorySource::set(std::move(memory));
+
+    std::vector<LoggerColumn> columns;
+    columns.emplace_back(0x1000, MemoryFieldType::UnsignedDword);
+    std::vector<uint64_t> sampleIndexes;
+    LoggerSampler sampler;
+    sampler.start(columns, std::chrono::milliseconds(2), std::chrono::milliseconds(40));
+    while (!sampler.finished())
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    sampler.stop();
+    sampler.drain(columns, sampleIndexes);
+
+    auto& stats = sampler.statistics();
+    S2_CHECK(stats.missed >= 4);
+    // no burst after the stall, a catch up sample would come right after the slow one
+    S2_CHECK(stats.minPeriod > 1.0);
+    // the index jumps over the missed ticks
+    bool jumped = false;
+    for (size_t i = 1; i < sampleIndexes.size(); ++i)
+        jumped |= sampleIndexes[i] > sampleIndexes[i - 1] + 1;
+    S2_CHECK(jumped);
+    MemorySource::set(nullptr);
+}
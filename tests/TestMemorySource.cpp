@@ -0,0 +1,63 @@
+#include "Test.h"
+
+#include "MemorySource/SyntheticMemorySource.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace S2Plugin;
+
+S2_TEST(RegionMemorySourceReadsAcrossRegions)
+{
+    SyntheticMemorySource memory;
+    memory.map(0x1000, 0x10);
+    memory.map(0x1010, 0x10);
+    memory.map(0x2000, 0x10);
+    S2_CHECK(memory.write<uint64_t>(0x100C, 0x1122334455667788ull));
+
+    uint64_t value = 0;
+    S2_CHECK(memory.read(0x100C, &value, sizeof(value)));
+    S2_CHECK(value == 0x1122334455667788ull);
+    S2_CHECK(!memory.read(0x101C, &value, sizeof(value)));
+    S2_CHECK(value == 0);
+    S2_CHECK(memory.isValidPtr(0x2000));
+    S2_CHECK(!memory.isValidPtr(0x2010));
+
+    // the last region hint must not point past the regions after clear
+    memory.clear();
+    S2_CHECK(!memory.isValidPtr(0x1000));
+}
+
+S2_TEST(RegionMemorySourceConcurrentReads)
+{
+    // every thread alternates between regions, so the shared last region hint keeps changing under the other threads
+    constexpr uint32_t regionCount = 8;
+    constexpr size_t regionSize = 0x100;
+    SyntheticMemorySource memory;
+    for (uint32_t region = 0; region < regionCount; ++region)
+    {
+        memory.map(0x10000 * (region + 1), regionSize);
+        memory.write<uint32_t>(0x10000 * (region + 1), region);
+    }
+
+    std::atomic<uint32_t> wrong{0};
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&memory, &wrong, t]()
+            {
+                for (uint32_t i = 0; i < 100000; ++i)
+                {
+                    uint32_t region = (i + t) % regionCount;
+                    uint32_t value = ~0u;
+                    if (!memory.read(0x10000 * (region + 1), &value, sizeof(value)) || value != region)
+                        ++wrong;
+                }
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    S2_CHECK(wrong == 0);
+}
@@ -0,0 +1,193 @@
+#include "Test.h"
+
+#include "MemorySource/SyntheticMemorySource.h"
+#include "ReadCache.h"
+#include "read_helpers.h"
+#include <cstring>
+#include <memory>
+
+using namespace S2Plugin;
+
+namespace
+{
+    constexpr uintptr_t gsBase = 0x10000;
+    constexpr size_t gsPage = ReadCache::pageSize;
+
+    // fake debugger: two readable pages, a gap, then a region smaller than a page
+    class FakeMemorySource : public SyntheticMemorySource
+    {
+      public:
+        FakeMemorySource()
+        {
+            auto data = map(gsBase, 2 * gsPage);
+            for (size_t i = 0; i < 2 * gsPage; ++i)
+                data[i] = static_cast<uint8_t>(i * 7);
+            map(gsBase + 4 * gsPage, 0x100);
+        }
+        bool read(uintptr_t addr, void* dest, size_t size) override
+        {
+            ++mReads;
+            return SyntheticMemorySource::read(addr, dest, size);
+        }
+        uint64_t mReads{0};
+    };
+
+    // installs a fresh fake source and clears the counters, restores the default source when done
+    struct Fixture
+    {
+        Fixture()
+        {
+            auto source = std::make_unique<FakeMemorySource>();
+            fake = source.get();
+            MemorySource::set(std::move(source));
+            ReadCache::invalidate();
+            ReadCache::resetCounters();
+        }
+        ~Fixture()
+        {
+            MemorySource::set(nullptr);
+        }
+        FakeMemorySource* fake;
+    };
+} // namespace
+
+S2_TEST(ReadCacheHitsAndMisses)
+{
+    Fixture fixture;
+    ReadCache::Scope scope;
+    S2_CHECK(ReadCache::isActive());
+    S2_CHECK(Read<uint32_t>(gsBase + 0x10) == Read<uint32_t>(gsBase + 0x10));
+    (void)Read<uint8_t>(gsBase + 0x800);
+    S2_CHECK(ReadCache::misses() == 1);
+    S2_CHECK(ReadCache::hits() == 2);
+    S2_CHECK(fixture.fake->mReads == 1);
+
+    (void)Read<uint8_t>(gsBase + gsPage);
+    S2_CHECK(ReadCache::misses() == 2);
+    S2_CHECK(fixture.fake->mReads == 2);
+}
+
+S2_TEST(ReadCacheOutsideScopeReadsDirectly)
+{
+    Fixture fixture;
+    S2_CHECK(!ReadCache::isActive());
+    (void)Read<uint32_t>(gsBase);
+    (void)Read<uint32_t>(gsBase);
+    S2_CHECK(fixture.fake->mReads == 2);
+    S2_CHECK(ReadCache::hits() == 0 && ReadCache::misses() == 0);
+}
+
+S2_TEST(ReadCacheAcrossPageBoundary)
+{
+    Fixture fixture;
+    ReadCache::Scope scope;
+    uint64_t cached = 0;
+    S2_CHECK(ReadMemory(gsBase + gsPage - 4, &cached, sizeof(cached)));
+    S2_CHECK(ReadCache::misses() == 2);
+
+    uint64_t direct = 0;
+    fixture.fake->SyntheticMemorySource::read(gsBase + gsPage - 4, &direct, sizeof(direct));
+    S2_CHECK(cached == direct);
+}
+
+S2_TEST(ReadCacheUnreadableMemory)
+{
+    Fixture fixture;
+    ReadCache::Scope scope;
+    // not mapped at all, zeroed and reported
+    uint32_t value = 0xFFFFFFFF;
+    S2_CHECK(!ReadMemory(gsBase + 2 * gsPage + 0x10, &value, sizeof(value)));
+    S2_CHECK(value == 0);
+    // read crossing from a readable page into the unmapped one keeps the readable part
+    uint8_t bytes[8];
+    std::memset(bytes, 0xAA, sizeof(bytes));
+    S2_CHECK(!ReadMemory(gsBase + 2 * gsPage - 4, bytes, sizeof(bytes)));
+    S2_CHECK(bytes[0] == static_cast<uint8_t>((2 * gsPage - 4) * 7));
+    S2_CHECK(bytes[4] == 0 && bytes[7] == 0);
+
+    // region smaller than a page, the page can't be cached but the mapped part is still readable
+    fixture.fake->write<uint32_t>(gsBase + 4 * gsPage + 0x20, 0x12345678);
+    S2_CHECK(Read<uint32_t>(gsBase + 4 * gsPage + 0x20) == 0x12345678);
+    S2_CHECK(!ReadMemory(gsBase + 4 * gsPage + 0x100, &value, sizeof(value)));
+}
+
+S2_TEST(ReadCacheBigReadsBypassCache)
+{
+    Fixture fixture;
+    ReadCache::Scope scope;
+    std::unique_ptr<uint8_t[]> buffer{new uint8_t[gsPage + 1]};
+    S2_CHECK(ReadMemory(gsBase, buffer.get(), gsPage + 1));
+    S2_CHECK(ReadCache::misses() == 0);
+    S2_CHECK(fixture.fake->mReads == 1);
+}
+
+S2_TEST(ReadCacheNestedScopes)
+{
+    Fixture fixture;
+    uint64_t outerSerial;
+    {
+        ReadCache::Scope outer;
+        outerSerial = ReadCache::serial();
+        (void)Read<uint32_t>(gsBase);
+        {
+            ReadCache::Scope inner;
+            // inner scope keeps the outer data
+            S2_CHECK(ReadCache::serial() == outerSerial);
+            (void)Read<uint32_t>(gsBase);
+            S2_CHECK(ReadCache::hits() == 1);
+        }
+        S2_CHECK(ReadCache::isActive());
+        (void)Read<uint32_t>(gsBase);
+        S2_CHECK(ReadCache::hits() == 2);
+        S2_CHECK(fixture.fake->mReads == 1);
+    }
+    S2_CHECK(!ReadCache::isActive());
+
+    // next outermost scope starts empty
+    ReadCache::Scope next;
+    S2_CHECK(ReadCache::serial() != outerSerial);
+    (void)Read<uint32_t>(gsBase);
+    S2_CHECK(ReadCache::misses() == 2);
+    S2_CHECK(fixture.fake->mReads == 2);
+}
+
+S2_TEST(ReadCacheInvalidation)
+{
+    Fixture fixture;
+    ReadCache::Scope scope;
+    fixture.fake->write<uint32_t>(gsBase, 1);
+    S2_CHECK(Read<uint32_t>(gsBase) == 1);
+
+    // cached data stays the same for the whole tick
+    fixture.fake->write<uint32_t>(gsBase, 2);
+    S2_CHECK(Read<uint32_t>(gsBase) == 1);
+
+    // debug event, generation changes for all threads
+    auto serial = ReadCache::serial();
+    ReadCache::invalidateAll();
+    S2_CHECK(ReadCache::serial() != serial);
+    S2_CHECK(Read<uint32_t>(gsBase) == 2);
+
+    fixture.fake->write<uint32_t>(gsBase, 3);
+    serial = ReadCache::serial();
+    ReadCache::invalidate();
+    S2_CHECK(ReadCache::serial() != serial);
+    S2_CHECK(Read<uint32_t>(gsBase) == 3);
+    S2_CHECK(ReadCache::misses() == 3);
+}
+
+S2_TEST(ReadCachePrime)
+{
+    Fixture fixture;
+    uint8_t bulk[3 * gsPage] = {};
+    // outside of a scope priming does nothing
+    ReadCache::prime(gsBase, bulk, 2 * gsPage);
+
+    ReadCache::Scope scope;
+    // only the page fully inside of the range is cached
+    ReadCache::prime(gsBase + 0x10, bulk, 2 * gsPage);
+    S2_CHECK(Read<uint8_t>(gsBase + gsPage + 1) == 0);
+    S2_CHECK(fixture.fake->mReads == 0);
+    S2_CHECK(Read<uint8_t>(gsBase + 1) == 7);
+    S2_CHECK(fixture.fake->mReads == 1);
+}
@@ -0,0 +1,207 @@
+#include "Test.h"
+
+#include "MemorySource/SyntheticMemorySource.h"
+#include "ReadCache.h"
+#include "RowRefresh.h"
+#include "SnapshotDiff.h"
+#include <memory>
+
+using namespace S2Plugin;
+
+namespace
+{
+    constexpr uintptr_t gsStruct = 0x30000;
+    constexpr uintptr_t gsComparison = gsStruct + ReadCache::pageSize;
+
+    // root struct and the comparison one, a page each
+    struct Fixture
+    {
+        Fixture()
+        {
+            auto source = std::make_unique<SyntheticMemorySource>();
+            memory = source.get();
+            memory->map(gsStruct, 2 * ReadCache::pageSize);
+            MemorySource::set(std::move(source));
+        }
+        ~Fixture()
+        {
+            MemorySource::set(nullptr);
+        }
+        // two updates, so only the bytes written in between are reported as changed
+        void tick()
+        {
+            snapshot.update(gsStruct, 0x100);
+            comparison.update(gsComparison, 0x100);
+        }
+        RowRefresh::Row row(MemoryFieldType type, uintptr_t offset) const
+        {
+            RowRefresh::Row row;
+            row.type = type;
+            row.address = gsStruct + offset;
+            return row;
+        }
+        SyntheticMemorySource* memory;
+        SnapshotDiff snapshot;
+        SnapshotDiff comparison;
+    };
+} // namespace
+
+S2_TEST(RowRefreshSnapshotComparableTypes)
+{
+    S2_CHECK(isSnapshotComparable(MemoryFieldType::Dword));
+    S2_CHECK(isSnapshotComparable(MemoryFieldType::Float));
+    S2_CHECK(isSnapshotComparable(MemoryFieldType::State8));
+    // shows other memory or has children
+    S2_CHECK(!isSnapshotComparable(MemoryFieldType::EntityPointer));
+    S2_CHECK(!isSnapshotComparable(MemoryFieldType::EntityDBID));
+    S2_CHECK(!isSnapshotComparable(MemoryFieldType::Flags32));
+    S2_CHECK(!isSnapshotComparable(MemoryFieldType::DefaultStructType));
+    S2_CHECK(!isSnapshotComparable(MemoryFieldType::Flag));
+}
+
+S2_TEST(RowRefreshSkipsUnchangedRows)
+{
+    Fixture fixture;
+    fixture.tick();
+    fixture.memory->write<uint32_t>(gsStruct + 0x10, 5);
+    fixture.tick();
+
+    RowRefresh refresh;
+    refresh.snapshot = &fixture.snapshot;
+    S2_CHECK(refresh.action(fixture.row(MemoryFieldType::Dword, 0x10)) == RowRefreshAction::Update);
+    S2_CHECK(refresh.action(fixture.row(MemoryFieldType::Dword, 0x40)) == RowRefreshAction::Skip);
+    // a qword over the changed dword
+    S2_CHECK(refresh.action(fixture.row(MemoryFieldType::Qword, 0x10)) == RowRefreshAction::Update);
+    // past the requested range but still in the page the snapshot read
+    S2_CHECK(refresh.action(fixture.row(MemoryFieldType::Dword, 0x800)) == RowRefreshAction::Skip);
+    // outside of the snapshot
+    S2_CHECK(refresh.action(fixture.row(MemoryFieldType::Dword, ReadCache::pageSize + 0x10)) == RowRefreshAction::Update);
+
+    // without a snapshot every row is updated
+    S2_CHECK(RowRefresh{}.action(fixture.row(MemoryFieldType::Dword, 0x40)) == RowRefreshAction::Update);
+}
+
+S2_TEST(RowRefreshUpdatesRowsTheSnapshotCantTell)
+{
+    Fixture fixture;
+    fixture.tick();
+    fixture.tick();
+    RowRefresh refresh;
+    refresh.snapshot = &fixture.snapshot;
+
+    auto row = fixture.row(MemoryFieldType::Dword, 0x20);
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Skip);
+    row.stale = true;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+    row.stale = false;
+    row.newAddress = true;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+    row.newAddress = false;
+    row.isPointer = true;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+    S2_CHECK(refresh.action(fixture.row(MemoryFieldType::EntityPointer, 0x20)) == RowRefreshAction::Update);
+}
+
+S2_TEST(RowRefreshRowsUpdatedBetweenTicksReadTheSnapshot)
+{
+    Fixture fixture;
+    fixture.tick();
+    fixture.tick();
+    auto readShown = []()
+    {
+        uint32_t value = 0;
+        ReadCache::read(gsStruct + 0x20, &value, sizeof(value));
+        return value;
+    };
+
+    // a stale row scrolled into the view after the value changed, the value changes back before the next tick
+    fixture.memory->write<uint32_t>(gsStruct + 0x20, 9);
+    {
+        ReadCache::Scope readCacheScope;
+        fixture.snapshot.primeReadCache();
+        S2_CHECK(readShown() == 0);
+    }
+    fixture.memory->write<uint32_t>(gsStruct + 0x20, 0);
+    fixture.tick();
+
+    // skipped, which is right only because the row shows the bytes the snapshot compared against
+    RowRefresh refresh;
+    refresh.snapshot = &fixture.snapshot;
+    S2_CHECK(refresh.action(fixture.row(MemoryFieldType::Dword, 0x20)) == RowRefreshAction::Skip);
+
+    // nothing to compare against after a reset, the live memory is read
+    fixture.memory->write<uint32_t>(gsStruct + 0x20, 9);
+    fixture.snapshot.reset();
+    {
+        ReadCache::Scope readCacheScope;
+        fixture.snapshot.primeReadCache();
+        S2_CHECK(readShown() == 9);
+    }
+}
+
+S2_TEST(RowRefreshComparisonSnapshot)
+{
+    Fixture fixture;
+    fixture.tick();
+    fixture.memory->write<uint16_t>(gsComparison + 0x30, 7);
+    fixture.tick();
+
+    RowRefresh refresh;
+    refresh.snapshot = &fixture.snapshot;
+    auto row = fixture.row(MemoryFieldType::Word, 0x30);
+    row.comparisonAddress = gsComparison + 0x30;
+    // comparison shown but not snapshotted
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+
+    refresh.comparisonSnapshot = &fixture.comparison;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+    row.comparisonAddress = gsComparison + 0x80;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Skip);
+}
+
+S2_TEST(RowRefreshCullsRowsOutOfTheView)
+{
+    RowRefresh refresh;
+    refresh.cull = true;
+    RowRefresh::Row row;
+    row.type = MemoryFieldType::Float;
+    row.visible = false;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Cull);
+    row.stale = true;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Cull);
+    row.visible = true;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+
+    // flag rows only show the parent value, rows with children or other memory are always updated
+    row.visible = false;
+    row.type = MemoryFieldType::Flag;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Cull);
+    row.type = MemoryFieldType::Flags32;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+    row.type = MemoryFieldType::Dword;
+    row.isPointer = true;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+    row.isPointer = false;
+    row.newAddress = true;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+
+    row.newAddress = false;
+    refresh.cull = false;
+    S2_CHECK(refresh.action(row) == RowRefreshAction::Update);
+}
+
+S2_TEST(RowRefreshVisibleRowRange)
+{
+    constexpr auto margin = VisibleRowRange::margin;
+    // 10 rows fit in the viewport, plus the partly shown one
+    S2_CHECK(VisibleRowRange::rowCount(200, 20) == 11 + 2 * margin);
+    S2_CHECK(VisibleRowRange::rowCount(0, 0) == 1 + 2 * margin);
+
+    auto top = VisibleRowRange::around(0, 200, 20);
+    S2_CHECK(top.begin == 0 && top.end == 11 + 2 * margin);
+    auto scrolled = VisibleRowRange::around(100, 200, 20);
+    S2_CHECK(scrolled.begin == 100 - margin);
+    S2_CHECK(!scrolled.contains(100 - margin - 1));
+    S2_CHECK(scrolled.contains(100) && scrolled.contains(110 + margin));
+    S2_CHECK(!scrolled.contains(111 + margin));
+}